@@ -0,0 +1,125 @@
+# Automatically generated by configure - DO NOT EDIT!
+CONFIGURE_ARGS = --disable-dvbscan --disable-ffmpeg_static --disable-libav --disable-hdhomerun_static --disable-pcloud_cache --disable-bintray_cache --disable-dvbcsa --disable-tvhcsa
+ROOTDIR  ?= /root/repo
+BUILDDIR ?= /root/repo/build.linux
+PLATFORM ?= linux
+OSENV    ?= posix
+ARCH     ?= x86_64
+CPU      ?= generic
+COMPILER ?= gcc
+ifeq ($(origin CC),default)
+CC        = cc
+endif
+PYTHON   ?= python
+GZIPCMD  ?= gzip
+BZIP2    ?= bzip2
+XGETTEXT ?= xgettext
+MSGMERGE ?= msgmerge
+PKG_CONFIG ?= pkg-config
+CFLAGS   += 
+LDFLAGS  += 
+prefix    = /usr/local
+bindir    = ${prefix}/bin
+mandir    = ${datadir}/man
+datadir   = ${prefix}/share
+libdir    = ${prefix}/lib
+LDFLAGS += -lssl -lcrypto 
+CFLAGS  += 
+LDFLAGS += -lz 
+CFLAGS  += 
+CONFIG_PIE = yes
+CONFIG_CCDEBUG = no
+CONFIG_CARDCLIENT = yes
+CONFIG_CWC = yes
+CONFIG_CCCAM = yes
+CONFIG_CAPMT = yes
+CONFIG_CONSTCW = yes
+CONFIG_LINUXDVB = yes
+CONFIG_SATIP_SERVER = yes
+CONFIG_SATIP_CLIENT = yes
+CONFIG_HDHOMERUN_CLIENT = no
+CONFIG_HDHOMERUN_SERVER = yes
+CONFIG_HDHOMERUN_STATIC = no
+CONFIG_IPTV = yes
+CONFIG_TSFILE = yes
+CONFIG_DVBSCAN = no
+CONFIG_TIMESHIFT = yes
+CONFIG_TRACE = yes
+CONFIG_AVAHI = no
+CONFIG_ZLIB = yes
+CONFIG_LIBAV = no
+CONFIG_FFMPEG_STATIC = no
+CONFIG_LIBX264 = yes
+CONFIG_LIBX264_STATIC = yes
+CONFIG_LIBX265 = yes
+CONFIG_LIBX265_STATIC = yes
+CONFIG_LIBVPX = yes
+CONFIG_LIBVPX_STATIC = yes
+CONFIG_LIBTHEORA = yes
+CONFIG_LIBTHEORA_STATIC = yes
+CONFIG_LIBVORBIS = yes
+CONFIG_LIBVORBIS_STATIC = yes
+CONFIG_LIBFDKAAC = no
+CONFIG_LIBFDKAAC_STATIC = yes
+CONFIG_LIBOPUS = yes
+CONFIG_LIBOPUS_STATIC = yes
+CONFIG_NVENC = no
+CONFIG_VAAPI = no
+CONFIG_MMAL = no
+CONFIG_OMX = no
+CONFIG_INOTIFY = yes
+CONFIG_EPOLL = yes
+CONFIG_PCRE = no
+CONFIG_PCRE2 = no
+CONFIG_URIPARSER = no
+CONFIG_CCACHE = no
+CONFIG_TVHCSA = no
+CONFIG_BUNDLE = no
+CONFIG_PNGQUANT = no
+CONFIG_KQUEUE = no
+CONFIG_DBUS_1 = no
+CONFIG_ANDROID = no
+CONFIG_GTIMER_CHECK = no
+CONFIG_SLOW_MEMORYINFO = no
+CONFIG_LIBSYSTEMD_DAEMON = no
+CONFIG_PCLOUD_CACHE = no
+CONFIG_DDCI = yes
+CONFIG_CCLANG_THREADSAN = no
+CONFIG_GPERFTOOLS = no
+CONFIG_EXECINFO = yes
+CONFIG_MMX = yes
+CONFIG_SSE2 = yes
+CONFIG_W_UNUSED_RESULT = yes
+CONFIG_F_STACK_PROTECTOR = yes
+CONFIG_F_STACK_PROTECTOR_STRONG = yes
+CONFIG_F_STACK_CHECK = yes
+CONFIG_F_PIE = yes
+CONFIG_FDATASYNC = yes
+CONFIG_GETLOADAVG = yes
+CONFIG_ATOMIC32 = yes
+CONFIG_ATOMIC64 = yes
+CONFIG_ATOMIC_TIME_T = yes
+CONFIG_ATOMIC_PTR = yes
+CONFIG_BITOPS64 = yes
+CONFIG_LOCKOWNER = yes
+CONFIG_QSORT_R = yes
+CONFIG_TIME_LD = yes
+CONFIG_GMTOFF = yes
+CONFIG_RECVMMSG = yes
+CONFIG_SENDMMSG = yes
+CONFIG_IFNAMES = yes
+CONFIG_PY_GZIP = yes
+CONFIG_BIN_PKG_CONFIG = yes
+CONFIG_BIN_XGETTEXT = yes
+CONFIG_BIN_MSGMERGE = yes
+CONFIG_BIN_GZIP = yes
+CONFIG_BIN_BZIP2 = yes
+CONFIG_SSL = yes
+CONFIG_LINUXDVBAPI = yes
+CONFIG_LINUXDVB_CA = yes
+CONFIG_UPNP = yes
+CONFIG_INOTIFY_H = yes
+CONFIG_INOTIFY_INIT1 = yes
+CONFIG_EPOLL_CREATE1 = yes
+CONFIG_MPEGTS = yes
+CONFIG_MPEGTS_DVB = yes
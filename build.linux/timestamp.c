@@ -0,0 +1,2 @@
+#include "build.h"
+const char* build_timestamp = "2026-10-17T03:16:54+0000";
@@ -68,6 +68,9 @@ typedef struct channel
   LIST_HEAD(, channel)  ch_epg_slaves;
   LIST_ENTRY(channel)   ch_epg_slave_link;
   epg_broadcast_tree_t  ch_epg_schedule;
+  epg_broadcast_t     **ch_epg_index;     /* schedule sorted by start */
+  uint32_t              ch_epg_count;
+  uint32_t              ch_epg_alloc;
   epg_broadcast_t      *ch_epg_now;
   epg_broadcast_t      *ch_epg_next;
   gtimer_t              ch_epg_timer;
@@ -1762,9 +1762,11 @@ config_boot
   config.realm = strdup("tvheadend");
   config.info_area = strdup("login,storage,time");
   config.cookie_expires = 7;
+  config.http_stream_share = 1;
   config.ticket_expires = 5 * 60;
   config.dscp = -1;
   config.descrambler_buffer = 9000;
+  config.descrambler_deadline = 100;
   config.epg_compress = 1;
   config.epg_cut_window = 5*60;
   config.epg_update_window = 24*3600;
@@ -2534,6 +2536,32 @@ const idclass_t config_class = {
       .opts   = PO_EXPERT,
       .group  = 5
     },
+    {
+      .type   = PT_INT,
+      .id     = "http_stream_threads",
+      .name   = N_("HTTP streaming threads"),
+      .desc   = N_("Set the number of threads which send the HTTP "
+                   "streams (/stream URLs) to the clients. One thread "
+                   "serves many clients using non-blocking writes. "
+                   "Zero means that each client uses its own thread. "
+                   "Restart is required to apply the change."),
+      .off    = offsetof(config_t, http_stream_threads),
+      .opts   = PO_EXPERT,
+      .group  = 5
+    },
+    {
+      .type   = PT_BOOL,
+      .id     = "http_stream_share",
+      .name   = N_("Share HTTP stream output"),
+      .desc   = N_("Identical pass-through stream requests (the same "
+                   "channel or service and profile) share one "
+                   "subscription and one muxer. New clients join the "
+                   "running stream at the next PAT. Only used with "
+                   "the HTTP streaming threads."),
+      .off    = offsetof(config_t, http_stream_share),
+      .opts   = PO_EXPERT,
+      .group  = 5
+    },
     {
       .type   = PT_STR,
       .id     = "hdhomerun_ip",
@@ -2686,6 +2714,29 @@ const idclass_t config_class = {
       .opts   = PO_EXPERT,
       .group  = 7,
     },
+    {
+      .type   = PT_U32,
+      .id     = "descrambler_deadline",
+      .name   = N_("Descrambler batch deadline (ms)"),
+      .desc   = N_("The maximum time the CSA packets are held to share "
+                   "the descrambling batches with other services using "
+                   "the same control word."),
+      .off    = offsetof(config_t, descrambler_deadline),
+      .opts   = PO_EXPERT,
+      .group  = 7,
+    },
+    {
+      .type   = PT_INT,
+      .id     = "descrambler_threads",
+      .name   = N_("Descrambler threads"),
+      .desc   = N_("Set the number of threads for the CSA decryption. "
+                   "Zero means that the packets are decrypted by the "
+                   "input threads. Restart is required to apply "
+                   "the change."),
+      .off    = offsetof(config_t, descrambler_threads),
+      .opts   = PO_EXPERT,
+      .group  = 7,
+    },
     {
       .type   = PT_BOOL,
       .id     = "parser_backlog",
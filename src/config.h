@@ -61,8 +61,12 @@ typedef struct config {
   uint32_t tvhtime_tolerance;
   char *cors_origin;
   uint32_t cookie_expires;
+  int http_stream_threads;
+  int http_stream_share;
   int dscp;
   uint32_t descrambler_buffer;
+  uint32_t descrambler_deadline;
+  int descrambler_threads;
   int caclient_ui;
   int parser_backlog;
   int epg_compress;
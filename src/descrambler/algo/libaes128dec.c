@@ -14,21 +14,147 @@
 
 #include "libaes128dec.h"
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define AES128_NI 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 /* key structure */
 typedef struct aes128_priv {
   AES_KEY keys[2]; /* 0 = even, 1 = odd */
+#if AES128_NI
+  uint8_t ni_keys[2][11][16]; /* AES-NI decryption round keys */
+#endif
 } aes128_priv_t;
 
+#if AES128_NI
+
+static int aes128_ni = -1;
+
+static int aes128_ni_detect(void)
+{
+  unsigned int eax, ebx, ecx, edx;
+
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return 0;
+  return (ecx & bit_AES) != 0 && (edx & bit_SSE2) != 0;
+}
+
+__attribute__((target("aes,sse2")))
+static inline __m128i aes128_ni_expand(__m128i k, __m128i t)
+{
+  t = _mm_shuffle_epi32(t, 0xff);
+  k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+  k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+  k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+  return _mm_xor_si128(k, t);
+}
+
+#define AES128_NI_EXPAND(k, rcon) \
+  aes128_ni_expand(k, _mm_aeskeygenassist_si128(k, rcon))
+
+/* build the decryption round keys (equivalent inverse cipher) */
+__attribute__((target("aes,sse2")))
+static void aes128_ni_set_key(uint8_t (*dk)[16], const uint8_t *pk)
+{
+  __m128i ek[11];
+  int i;
+
+  ek[0]  = _mm_loadu_si128((const __m128i *)pk);
+  ek[1]  = AES128_NI_EXPAND(ek[0], 0x01);
+  ek[2]  = AES128_NI_EXPAND(ek[1], 0x02);
+  ek[3]  = AES128_NI_EXPAND(ek[2], 0x04);
+  ek[4]  = AES128_NI_EXPAND(ek[3], 0x08);
+  ek[5]  = AES128_NI_EXPAND(ek[4], 0x10);
+  ek[6]  = AES128_NI_EXPAND(ek[5], 0x20);
+  ek[7]  = AES128_NI_EXPAND(ek[6], 0x40);
+  ek[8]  = AES128_NI_EXPAND(ek[7], 0x80);
+  ek[9]  = AES128_NI_EXPAND(ek[8], 0x1b);
+  ek[10] = AES128_NI_EXPAND(ek[9], 0x36);
+  _mm_storeu_si128((__m128i *)dk[0], ek[10]);
+  for (i = 1; i < 10; i++)
+    _mm_storeu_si128((__m128i *)dk[i], _mm_aesimc_si128(ek[10 - i]));
+  _mm_storeu_si128((__m128i *)dk[10], ek[0]);
+}
+
+#define AES128_NI_ROUNDS(op, k) do { \
+  b0 = op(b0, k); b1 = op(b1, k); b2 = op(b2, k); b3 = op(b3, k); \
+} while (0)
+
+/* decrypt the whole chunk, four blocks are interleaved in the pipeline */
+__attribute__((target("aes,sse2")))
+static void aes128_ni_decrypt_packets(aes128_priv_t *priv, uint8_t *tsb, int len)
+{
+  __m128i k[2][11], *kp, b0, b1, b2, b3;
+  uint8_t *end = tsb + len, *p;
+  uint_fast8_t xc0, offset, ev_od;
+  int i, n;
+
+  for (i = 0; i < 11; i++) {
+    k[0][i] = _mm_loadu_si128((const __m128i *)priv->ni_keys[0][i]);
+    k[1][i] = _mm_loadu_si128((const __m128i *)priv->ni_keys[1][i]);
+  }
+
+  for ( ; tsb < end; tsb += 188) {
+    if (((xc0 = tsb[3]) & 0x80) == 0)
+      continue;
+    ev_od = (xc0 & 0x40) >> 6;
+    tsb[3] = xc0 & 0x3f;
+    if (xc0 & 0x20) {
+      offset = 4 + tsb[4] + 1;
+      if (offset + 16 > 188)
+        continue;
+    } else {
+      offset = 4;
+    }
+    kp = k[ev_od];
+    p = tsb + offset;
+    n = (188 - offset) / 16;
+    for ( ; n >= 4; n -= 4, p += 64) {
+      b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p +  0)), kp[0]);
+      b1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + 16)), kp[0]);
+      b2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + 32)), kp[0]);
+      b3 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + 48)), kp[0]);
+      for (i = 1; i < 10; i++)
+        AES128_NI_ROUNDS(_mm_aesdec_si128, kp[i]);
+      AES128_NI_ROUNDS(_mm_aesdeclast_si128, kp[10]);
+      _mm_storeu_si128((__m128i *)(p +  0), b0);
+      _mm_storeu_si128((__m128i *)(p + 16), b1);
+      _mm_storeu_si128((__m128i *)(p + 32), b2);
+      _mm_storeu_si128((__m128i *)(p + 48), b3);
+    }
+    for ( ; n > 0; n--, p += 16) {
+      b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), kp[0]);
+      for (i = 1; i < 10; i++)
+        b0 = _mm_aesdec_si128(b0, kp[i]);
+      b0 = _mm_aesdeclast_si128(b0, kp[10]);
+      _mm_storeu_si128((__m128i *)p, b0);
+    }
+  }
+}
+
+#endif /* AES128_NI */
+
+static void aes128_set_key(aes128_priv_t *priv, int ev_od, const uint8_t *pk)
+{
+  AES_set_decrypt_key(pk, 128, &priv->keys[ev_od]);
+#if AES128_NI
+  if (aes128_ni)
+    aes128_ni_set_key(priv->ni_keys[ev_od], pk);
+#endif
+}
+
 /* even cw represents one full 128-bit AES key */
 void aes128_set_even_control_word(void *keys, const uint8_t *pk)
 {
-  AES_set_decrypt_key(pk, 128, &((aes128_priv_t *) keys)->keys[0]);
+  aes128_set_key((aes128_priv_t *) keys, 0, pk);
 }
 
 /* odd cw represents one full 128-bit AES key */
 void aes128_set_odd_control_word(void *keys, const uint8_t *pk)
 {
-  AES_set_decrypt_key(pk, 128, &((aes128_priv_t *) keys)->keys[1]);
+  aes128_set_key((aes128_priv_t *) keys, 1, pk);
 }
 
 /* set control words */
@@ -36,8 +162,8 @@ void aes128_set_control_words(void *keys,
                            const uint8_t *ev,
                            const uint8_t *od)
 {
-  AES_set_decrypt_key(ev, 128, &((aes128_priv_t *) keys)->keys[0]);
-  AES_set_decrypt_key(od, 128, &((aes128_priv_t *) keys)->keys[1]);
+  aes128_set_key((aes128_priv_t *) keys, 0, ev);
+  aes128_set_key((aes128_priv_t *) keys, 1, od);
 }
 
 /* allocate key structure */
@@ -45,6 +171,10 @@ void * aes128_get_priv_struct(void)
 {
   aes128_priv_t *keys;
 
+#if AES128_NI
+  if (aes128_ni < 0)
+    aes128_ni = aes128_ni_detect();
+#endif
   keys = (aes128_priv_t *) malloc(sizeof(aes128_priv_t));
   if (keys) {
     static const uint8_t pk[16] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
@@ -86,3 +216,18 @@ void aes128_decrypt_packet(void *keys, const uint8_t *pkt)
     AES_ecb_encrypt(pkt + offset, (uint8_t *)(pkt + offset), k, AES_DECRYPT);
   }
 }
+
+/* decrypt all packets in the chunk */
+void aes128_decrypt_packets(void *keys, const uint8_t *tsb, int len)
+{
+  const uint8_t *end = tsb + len;
+
+#if AES128_NI
+  if (aes128_ni) {
+    aes128_ni_decrypt_packets((aes128_priv_t *) keys, (uint8_t *)tsb, len);
+    return;
+  }
+#endif
+  for ( ; tsb < end; tsb += 188)
+    aes128_decrypt_packet(keys, tsb);
+}
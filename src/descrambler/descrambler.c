@@ -337,6 +337,7 @@ descrambler_init ( void )
   ca_hints_quickecm = 0;
 
   caclient_init();
+  tvhcsa_pool_start(config.descrambler_threads);
 
   if ((c = hts_settings_load("descrambler")) != NULL) {
     m = htsmsg_get_list(c, "caid");
@@ -352,6 +353,7 @@ descrambler_done ( void )
   th_descrambler_hint_t *hint;
 
   caclient_done();
+  tvhcsa_pool_stop();
   while ((hint = TAILQ_FIRST(&ca_hints)) != NULL) {
     TAILQ_REMOVE(&ca_hints, hint, dh_link);
     free(hint);
@@ -384,6 +386,34 @@ descrambler_quick_ecm ( mpegts_service_t *t, int pid )
   return 0;
 }
 
+/*
+ * Deliver the CSA packets held over the batch deadline, the services
+ * with a low bitrate may not receive the next packet in time
+ */
+static void
+descrambler_deadline_cb ( void *aux )
+{
+  service_t *t = aux;
+  th_descrambler_runtime_t *dr;
+  int64_t next = 0, n;
+  int i;
+
+  tvh_mutex_lock(&t->s_stream_mutex);
+  dr = t->s_descramble;
+  for (i = 0; dr && i < DESCRAMBLER_MAX_KEYS; i++) {
+    n = tvhcsa_expire(&dr->dr_keys[i].key_csa, (mpegts_service_t *)t);
+    if (n && (next == 0 || n < next))
+      next = n;
+    if (!dr->dr_key_multipid) break;
+  }
+  tvh_mutex_unlock(&t->s_stream_mutex);
+  if (dr == NULL)
+    return;
+  if (next == 0)
+    next = getmonoclock() + ms2mono(MAX(config.descrambler_deadline, 10));
+  mtimer_arm_abs(&dr->dr_deadline_timer, descrambler_deadline_cb, t, next);
+}
+
 /*
  * This routine is called from two places
  * a) start a new service
@@ -465,6 +495,9 @@ descrambler_service_start ( service_t *t )
     dr->dr_force_skip = 0;
     if (t->s_dvb_forcecaid == 0xffff)
       dr->dr_descramble = descrambler_pass;
+    else
+      mtimer_arm_abs(&dr->dr_deadline_timer, descrambler_deadline_cb, t,
+                     getmonoclock() + ms2mono(MAX(config.descrambler_deadline, 10)));
   }
   tvh_mutex_unlock(&t->s_stream_mutex);
 
@@ -493,6 +526,7 @@ descrambler_service_stop ( service_t *t )
   tvh_mutex_unlock(&t->s_stream_mutex);
   free(p);
   if (dr) {
+    mtimer_disarm(&dr->dr_deadline_timer);
     for (i = 0; i < DESCRAMBLER_MAX_KEYS; i++) {
       tk = &dr->dr_keys[i];
       tvhcsa_destroy(&tk->key_csa);
@@ -504,6 +538,39 @@ descrambler_service_stop ( service_t *t )
   }
 }
 
+void
+descrambler_status ( service_t *t, htsmsg_t *m )
+{
+  static const uint32_t bounds[] = TVHCSA_LATENCY_BOUNDS;
+  th_descrambler_runtime_t *dr = t->s_descramble;
+  uint32_t fill = 0, rate = 0, latency[TVHCSA_LATENCY_BUCKETS];
+  htsmsg_t *l, *e;
+  int i;
+
+  lock_assert(&t->s_stream_mutex);
+
+  if (dr == NULL || dr->dr_descramble)
+    return;
+  memset(latency, 0, sizeof(latency));
+  for (i = 0; i < DESCRAMBLER_MAX_KEYS; i++) {
+    tvhcsa_stats(&dr->dr_keys[i].key_csa, &fill, &rate, latency);
+    if (!dr->dr_key_multipid) break;
+  }
+  if (rate == 0)
+    return;
+  htsmsg_add_u32(m, "descramble_fill", fill);
+  htsmsg_add_u32(m, "descramble_rate", rate);
+  l = htsmsg_create_list();
+  for (i = 0; i < TVHCSA_LATENCY_BUCKETS; i++) {
+    e = htsmsg_create_map();
+    if (bounds[i])
+      htsmsg_add_u32(e, "ms", bounds[i]);
+    htsmsg_add_u32(e, "count", latency[i]);
+    htsmsg_add_msg(l, NULL, e);
+  }
+  htsmsg_add_msg(m, "descramble_latency", l);
+}
+
 void
 descrambler_caid_changed ( service_t *t )
 {
@@ -30,6 +30,7 @@ struct tvhcsa;
 struct mpegts_table;
 struct mpegts_mux;
 struct th_descrambler_data;
+struct htsmsg;
 
 #define DESCRAMBLER_NONE	0
 /* 64-bit keys */
@@ -112,6 +113,7 @@ typedef struct th_descrambler_runtime {
   uint32_t dr_paritycheck;
   uint32_t dr_initial_paritycheck;
   tvhlog_limit_t dr_loglimit_key;
+  mtimer_t dr_deadline_timer;
 } th_descrambler_runtime_t;
 
 typedef void (*descrambler_section_callback_t)
@@ -190,6 +192,7 @@ const char *descrambler_keytype2str( th_descrambler_keystate_t keytype );
 void descrambler_service_start ( struct service *t );
 void descrambler_service_stop  ( struct service *t );
 void descrambler_caid_changed  ( struct service *t );
+void descrambler_status        ( struct service *t, struct htsmsg *m );
 int  descrambler_resolved      ( struct service *t, th_descrambler_t *ignore );
 int  descrambler_multi_pid     ( th_descrambler_t *t );
 void descrambler_keys          ( th_descrambler_t *t, int type, uint16_t pid,
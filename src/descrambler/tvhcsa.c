@@ -25,6 +25,7 @@
 #include <dlfcn.h>
 
 #include "tvhcsa.h"
+#include "config.h"
 #include "input.h"
 #include "input/mpegts/tsdemux.h"
 
@@ -59,10 +60,7 @@ static void
 tvhcsa_aes128_ecb_descramble
   ( tvhcsa_t *csa, struct mpegts_service *s, const uint8_t *tsb, int len )
 {
-  const uint8_t *tsb2, *end2;
-
-  for (tsb2 = tsb, end2 = tsb + len; tsb2 < end2; tsb2 += 188)
-    aes128_decrypt_packet(csa->csa_priv, tsb2);
+  aes128_decrypt_packets(csa->csa_priv, tsb, len);
   ts_recv_packet2(s, tsb, len);
 }
 
@@ -77,58 +75,448 @@ tvhcsa_des_ncb_descramble
   ts_recv_packet2(s, tsb, len);
 }
 
+#if ENABLE_DVBCSA
+
+/*
+ * Shared CSA engines
+ *
+ * The bitslice decryption is efficient only for full batches. The
+ * services descrambled with the same control word (usually all services
+ * from one package on the mux) share one batch, so the low bitrate
+ * services do not flush the mostly empty batches.
+ *
+ * The payload pointers in the batch point to the cluster buffers of
+ * the owning services. A filled cluster is delivered only when all its
+ * packets are decrypted. The batches are decrypted inline or by the
+ * descrambler threads, the owner keeps up to TVHCSA_CLUSTERS clusters
+ * in flight and delivers them in order.
+ */
+typedef struct tvhcsa_engine_slot {
+  tvhcsa_t         *ces_csa;
+  tvhcsa_cluster_t *ces_cluster;
+  uint8_t           ces_parity;
+} tvhcsa_engine_slot_t;
+
+typedef struct tvhcsa_job {
+  TAILQ_ENTRY(tvhcsa_job) cj_link;
+  struct tvhcsa_engine *cj_engine;
+  int      cj_fill;
+  struct dvbcsa_bs_batch_s *cj_batch;
+  tvhcsa_engine_slot_t *cj_slot;
+} tvhcsa_job_t;
+
+typedef struct tvhcsa_engine {
+  LIST_ENTRY(tvhcsa_engine) ce_link;
+  tvh_mutex_t ce_lock;
+  int      ce_refcount;
+  int      ce_size;
+  uint8_t  ce_ecm;
+  uint8_t  ce_cw[8];
+  struct dvbcsa_bs_key_s *ce_key;
+  tvhcsa_job_t *ce_job;
+} tvhcsa_engine_t;
+
+static LIST_HEAD(, tvhcsa_engine) tvhcsa_engines;
+static tvh_mutex_t tvhcsa_engines_lock = TVH_THREAD_MUTEX_INITIALIZER;
+
+/* descrambler threads */
+static TAILQ_HEAD(, tvhcsa_job) tvhcsa_pool_jobs;
+static tvh_mutex_t tvhcsa_pool_lock = TVH_THREAD_MUTEX_INITIALIZER;
+static tvh_cond_t tvhcsa_pool_cond;
+static tvh_cond_t tvhcsa_pool_done;
+static pthread_t *tvhcsa_pool_tids;
+static int tvhcsa_pool_threads;
+static int tvhcsa_pool_running;
+
+static const uint32_t tvhcsa_latency_bounds[] = TVHCSA_LATENCY_BOUNDS;
+
+static tvhcsa_job_t *
+tvhcsa_job_alloc ( int size )
+{
+  tvhcsa_job_t *cj;
+
+  cj = malloc(sizeof(*cj) + (size + 1) * sizeof(struct dvbcsa_bs_batch_s) +
+              size * sizeof(tvhcsa_engine_slot_t));
+  cj->cj_engine = NULL;
+  cj->cj_fill = 0;
+  cj->cj_batch = (struct dvbcsa_bs_batch_s *)(cj + 1);
+  cj->cj_slot = (tvhcsa_engine_slot_t *)(cj->cj_batch + size + 1);
+  return cj;
+}
+
 static void
-tvhcsa_csa_cbc_flush
-  ( tvhcsa_t *csa, struct mpegts_service *s )
+tvhcsa_job_run ( tvhcsa_job_t *cj, struct dvbcsa_bs_key_s *key )
 {
-#if ENABLE_DVBCSA
-  tvhtrace(LS_CSA, "%p: CSA flush - descramble packets for service \"%s\" MAX=%d even=%d odd=%d fill=%d",
-           csa,((mpegts_service_t *)s)->s_dvb_svcname, csa->csa_cluster_size,csa->csa_fill_even,csa->csa_fill_odd,csa->csa_fill);
+  tvhcsa_engine_slot_t *ces, *end;
+  tvhcsa_cluster_t *csc;
+  tvhcsa_t *csa;
+  int fill = cj->cj_fill, count;
+
+  cj->cj_batch[fill].data = NULL;
+  dvbcsa_bs_decrypt(key, cj->cj_batch, 184);
+  for (ces = cj->cj_slot, end = ces + fill; ces < end; ) {
+    csa = ces->ces_csa;
+    csc = ces->ces_cluster;
+    for (count = 0; ces < end && ces->ces_cluster == csc; ces++, count++);
+    atomic_add_u64(&csa->csa_stat_packets, count);
+    atomic_add_u64(&csa->csa_stat_slots, (uint64_t)count * fill);
+    atomic_dec(&csc->csc_pending, count);
+  }
+  cj->cj_fill = 0;
+}
+
+static void
+tvhcsa_engine_free ( tvhcsa_engine_t *ce )
+{
+  dvbcsa_bs_key_free(ce->ce_key);
+  free(ce->ce_job);
+  tvh_mutex_destroy(&ce->ce_lock);
+  free(ce);
+}
+
+static void
+tvhcsa_engine_unref ( tvhcsa_engine_t *ce )
+{
+  tvh_mutex_lock(&tvhcsa_engines_lock);
+  if (--ce->ce_refcount > 0) {
+    ce = NULL;
+  } else {
+    LIST_REMOVE(ce, ce_link);
+  }
+  tvh_mutex_unlock(&tvhcsa_engines_lock);
+  if (ce)
+    tvhcsa_engine_free(ce);
+}
+
+static void *
+tvhcsa_pool_thread ( void *aux )
+{
+  tvhcsa_job_t *cj;
+  tvhcsa_engine_t *ce;
+
+  tvh_mutex_lock(&tvhcsa_pool_lock);
+  while (tvhcsa_pool_running) {
+    if ((cj = TAILQ_FIRST(&tvhcsa_pool_jobs)) == NULL) {
+      tvh_cond_wait(&tvhcsa_pool_cond, &tvhcsa_pool_lock);
+      continue;
+    }
+    TAILQ_REMOVE(&tvhcsa_pool_jobs, cj, cj_link);
+    tvh_mutex_unlock(&tvhcsa_pool_lock);
+    ce = cj->cj_engine;
+    tvhcsa_job_run(cj, ce->ce_key);
+    free(cj);
+    tvhcsa_engine_unref(ce);
+    tvh_mutex_lock(&tvhcsa_pool_lock);
+    tvh_cond_signal(&tvhcsa_pool_done, 1);
+  }
+  tvh_mutex_unlock(&tvhcsa_pool_lock);
+  return NULL;
+}
+
+/* called with ce_lock held */
+static void
+tvhcsa_engine_submit ( tvhcsa_engine_t *ce )
+{
+  tvhcsa_job_t *cj = ce->ce_job;
+  tvhcsa_engine_slot_t *ces, *end;
+
+  if (cj->cj_fill == 0)
+    return;
+  for (ces = cj->cj_slot, end = ces + cj->cj_fill; ces < end; ces++)
+    ces->ces_csa->csa_queued[ces->ces_parity] = 0;
+  if (!tvhcsa_pool_running) {
+    tvhcsa_job_run(cj, ce->ce_key);
+    return;
+  }
+  ce->ce_job = tvhcsa_job_alloc(ce->ce_size);
+  cj->cj_engine = ce;
+  tvh_mutex_lock(&tvhcsa_engines_lock);
+  ce->ce_refcount++;
+  tvh_mutex_unlock(&tvhcsa_engines_lock);
+  tvh_mutex_lock(&tvhcsa_pool_lock);
+  TAILQ_INSERT_TAIL(&tvhcsa_pool_jobs, cj, cj_link);
+  tvh_cond_signal(&tvhcsa_pool_cond, 0);
+  tvh_mutex_unlock(&tvhcsa_pool_lock);
+}
+
+static tvhcsa_engine_t *
+tvhcsa_engine_get ( int size, uint8_t ecm, const uint8_t *cw )
+{
+  tvhcsa_engine_t *ce;
+
+  tvh_mutex_lock(&tvhcsa_engines_lock);
+  LIST_FOREACH(ce, &tvhcsa_engines, ce_link)
+    if (ce->ce_ecm == ecm && ce->ce_size == size && !memcmp(ce->ce_cw, cw, 8))
+      break;
+  if (ce == NULL) {
+    ce = calloc(1, sizeof(*ce));
+    tvh_mutex_init(&ce->ce_lock, NULL);
+    ce->ce_size  = size;
+    ce->ce_ecm   = ecm;
+    memcpy(ce->ce_cw, cw, 8);
+    ce->ce_key   = dvbcsa_bs_key_alloc();
+    ce->ce_job   = tvhcsa_job_alloc(size);
+    dvbcsa_bs_key_set_wrap(ecm, cw, ce->ce_key);
+    LIST_INSERT_HEAD(&tvhcsa_engines, ce, ce_link);
+  }
+  ce->ce_refcount++;
+  tvh_mutex_unlock(&tvhcsa_engines_lock);
+  return ce;
+}
+
+static void
+tvhcsa_engine_put ( tvhcsa_t *csa, int parity )
+{
+  tvhcsa_engine_t *ce = csa->csa_engine[parity];
+
+  if (ce == NULL)
+    return;
+  csa->csa_engine[parity] = NULL;
+  /* our packets must not stay in the batch */
+  tvh_mutex_lock(&ce->ce_lock);
+  if (csa->csa_queued[parity])
+    tvhcsa_engine_submit(ce);
+  tvh_mutex_unlock(&ce->ce_lock);
+  tvhcsa_engine_unref(ce);
+}
+
+static void
+tvhcsa_engine_set_key ( tvhcsa_t *csa, int parity, const uint8_t *cw )
+{
+  tvhcsa_engine_t *ce = csa->csa_engine[parity];
+
+  if (ce && ce->ce_ecm == csa->csa_ecm && !memcmp(ce->ce_cw, cw, 8))
+    return;
+  tvhcsa_engine_put(csa, parity);
+  csa->csa_engine[parity] =
+    tvhcsa_engine_get(csa->csa_cluster_size, csa->csa_ecm, cw);
+}
+
+static void
+tvhcsa_cluster_wait ( tvhcsa_cluster_t *csc )
+{
+  if (atomic_get(&csc->csc_pending) == 0)
+    return;
+  tvh_mutex_lock(&tvhcsa_pool_lock);
+  while (atomic_get(&csc->csc_pending))
+    tvh_cond_wait(&tvhcsa_pool_done, &tvhcsa_pool_lock);
+  tvh_mutex_unlock(&tvhcsa_pool_lock);
+}
+
+static inline tvhcsa_cluster_t *
+tvhcsa_cluster_current ( tvhcsa_t *csa )
+{
+  return &csa->csa_cluster[(csa->csa_cluster_head + csa->csa_cluster_count) %
+                           TVHCSA_CLUSTERS];
+}
+
+/*
+ * Close the current cluster - hand all its packets over for decryption
+ */
+static void
+tvhcsa_cluster_close ( tvhcsa_t *csa )
+{
+  tvhcsa_engine_t *ce;
+  int parity;
+
+  for (parity = 0; parity < 2; parity++) {
+    if ((ce = csa->csa_engine[parity]) == NULL)
+      continue;
+    tvh_mutex_lock(&ce->ce_lock);
+    if (csa->csa_queued[parity])
+      tvhcsa_engine_submit(ce);
+    tvh_mutex_unlock(&ce->ce_lock);
+  }
+  csa->csa_cluster_count++;
+}
+
+/*
+ * Deliver the decrypted clusters in order, wait while more than
+ * 'inflight' clusters are queued
+ */
+static void
+tvhcsa_cluster_deliver ( tvhcsa_t *csa, struct mpegts_service *s, int inflight )
+{
+  tvhcsa_cluster_t *csc;
+  int64_t latency;
+  int i;
+
+  while (csa->csa_cluster_count > 0) {
+    csc = &csa->csa_cluster[csa->csa_cluster_head];
+    if (atomic_get(&csc->csc_pending)) {
+      if (csa->csa_cluster_count <= inflight)
+        break;
+      tvhcsa_cluster_wait(csc);
+    }
+    ts_recv_packet2(s, csc->csc_data, csc->csc_fill * 188);
+    latency = mono2ms(getmonoclock() - csc->csc_first);
+    for (i = 0; i < TVHCSA_LATENCY_BUCKETS - 1; i++)
+      if (latency < tvhcsa_latency_bounds[i])
+        break;
+    csa->csa_stat_latency[i]++;
+    csc->csc_fill = 0;
+    csa->csa_cluster_head = (csa->csa_cluster_head + 1) % TVHCSA_CLUSTERS;
+    csa->csa_cluster_count--;
+  }
+}
 
-  if(csa->csa_fill_even) {
-    csa->csa_tsbbatch_even[csa->csa_fill_even].data = NULL;
-    dvbcsa_bs_decrypt(csa->csa_key_even, csa->csa_tsbbatch_even, 184);
-    csa->csa_fill_even = 0;
+static void
+tvhcsa_csa_cbc_stats ( tvhcsa_t *csa )
+{
+  uint64_t packets, slots;
+  int64_t now = getmonoclock(), diff = now - csa->csa_stat_time;
+
+  if (diff < sec2mono(1))
+    return;
+  packets = atomic_get_u64(&csa->csa_stat_packets);
+  slots = atomic_get_u64(&csa->csa_stat_slots);
+  if (csa->csa_stat_time && packets > csa->csa_stat_packets0) {
+    csa->csa_stat_fill = ((slots - csa->csa_stat_slots0) * 100) /
+                         ((packets - csa->csa_stat_packets0) * csa->csa_cluster_size);
+    csa->csa_stat_rate = ((packets - csa->csa_stat_packets0) * 188 * 8 * 1000) /
+                         mono2ms(diff);
+  } else {
+    csa->csa_stat_fill = csa->csa_stat_rate = 0;
   }
-  if(csa->csa_fill_odd) {
-    csa->csa_tsbbatch_odd[csa->csa_fill_odd].data = NULL;
-    dvbcsa_bs_decrypt(csa->csa_key_odd, csa->csa_tsbbatch_odd, 184);
-    csa->csa_fill_odd = 0;
+  csa->csa_stat_packets0 = packets;
+  csa->csa_stat_slots0 = slots;
+  csa->csa_stat_time = now;
+}
+
+void
+tvhcsa_pool_start ( int threads )
+{
+  int i;
+
+  if (threads <= 0 || tvhcsa_pool_running)
+    return;
+  TAILQ_INIT(&tvhcsa_pool_jobs);
+  tvh_cond_init(&tvhcsa_pool_cond, 1);
+  tvh_cond_init(&tvhcsa_pool_done, 1);
+  tvhcsa_pool_running = 1;
+  tvhcsa_pool_threads = MIN(threads, 16);
+  tvhcsa_pool_tids = calloc(tvhcsa_pool_threads, sizeof(pthread_t));
+  for (i = 0; i < tvhcsa_pool_threads; i++)
+    tvh_thread_create(&tvhcsa_pool_tids[i], NULL, tvhcsa_pool_thread, NULL, "descrambler");
+  tvhinfo(LS_CSA, "started %d descrambler threads", tvhcsa_pool_threads);
+}
+
+void
+tvhcsa_pool_stop ( void )
+{
+  tvhcsa_job_t *cj;
+  int i;
+
+  if (!tvhcsa_pool_running)
+    return;
+  tvh_mutex_lock(&tvhcsa_pool_lock);
+  tvhcsa_pool_running = 0;
+  tvh_cond_signal(&tvhcsa_pool_cond, 1);
+  tvh_mutex_unlock(&tvhcsa_pool_lock);
+  for (i = 0; i < tvhcsa_pool_threads; i++)
+    pthread_join(tvhcsa_pool_tids[i], NULL);
+  /* finish the remaining jobs to release the waiters and engines */
+  while ((cj = TAILQ_FIRST(&tvhcsa_pool_jobs)) != NULL) {
+    TAILQ_REMOVE(&tvhcsa_pool_jobs, cj, cj_link);
+    tvhcsa_job_run(cj, cj->cj_engine->ce_key);
+    tvhcsa_engine_unref(cj->cj_engine);
+    free(cj);
   }
+  free(tvhcsa_pool_tids);
+  tvhcsa_pool_tids = NULL;
+  tvhcsa_pool_threads = 0;
+  tvh_cond_destroy(&tvhcsa_pool_done);
+  tvh_cond_destroy(&tvhcsa_pool_cond);
+}
+
+#endif
 
-  ts_recv_packet2(s, csa->csa_tsbcluster, csa->csa_fill * 188);
+static void
+tvhcsa_csa_cbc_flush
+  ( tvhcsa_t *csa, struct mpegts_service *s )
+{
+#if ENABLE_DVBCSA
+  tvhtrace(LS_CSA, "%p: CSA flush - descramble packets for service \"%s\" MAX=%d even=%d odd=%d fill=%d",
+           csa,((mpegts_service_t *)s)->s_dvb_svcname, csa->csa_cluster_size,
+           csa->csa_queued[0], csa->csa_queued[1], tvhcsa_cluster_current(csa)->csc_fill);
 
-  csa->csa_fill = 0;
+  if (tvhcsa_cluster_current(csa)->csc_fill)
+    tvhcsa_cluster_close(csa);
+  tvhcsa_cluster_deliver(csa, s, 0);
+  tvhcsa_csa_cbc_stats(csa);
 
 #else
 #error "Unknown CSA descrambler"
 #endif
 }
 
+/*
+ * Deliver the held packets when the oldest one is over the deadline,
+ * returns the time of the next deadline (0 - nothing is held)
+ */
+int64_t
+tvhcsa_expire ( tvhcsa_t *csa, struct mpegts_service *s )
+{
+#if ENABLE_DVBCSA
+  tvhcsa_cluster_t *csc;
+  int64_t deadline;
+
+  if (csa->csa_type != DESCRAMBLER_CSA_CBC)
+    return 0;
+  csc = tvhcsa_cluster_current(csa);
+  if (csa->csa_cluster_count)
+    deadline = csa->csa_cluster[csa->csa_cluster_head].csc_first;
+  else if (csc->csc_fill)
+    deadline = csc->csc_first;
+  else
+    return 0;
+  deadline += ms2mono(config.descrambler_deadline);
+  if (getmonoclock() < deadline)
+    return deadline;
+  if (csc->csc_fill)
+    tvhcsa_cluster_close(csa);
+  tvhcsa_cluster_deliver(csa, s, 0);
+  tvhcsa_csa_cbc_stats(csa);
+#endif
+  return 0;
+}
+
 static void
 tvhcsa_csa_cbc_descramble
   ( tvhcsa_t *csa, struct mpegts_service *s, const uint8_t *tsb, int tsb_len )
 {
   const uint8_t *tsb_end = tsb + tsb_len;
 
-  assert(csa->csa_fill >= 0 && csa->csa_fill < csa->csa_fill_size);
-
 #if ENABLE_DVBCSA
+  tvhcsa_engine_t *ce, *locked = NULL;
+  tvhcsa_cluster_t *csc;
+  tvhcsa_job_t *cj;
   uint8_t *pkt;
-  int_fast8_t ev_od;
+  int_fast8_t parity;
   int_fast16_t len;
   int_fast16_t offset;
 
+  /* deliver the clusters decrypted in the meantime */
+  if (csa->csa_cluster_count)
+    tvhcsa_cluster_deliver(csa, s, TVHCSA_CLUSTERS - 1);
+
+  csc = tvhcsa_cluster_current(csa);
+  assert(csc->csc_fill >= 0 && csc->csc_fill < csa->csa_fill_size);
+  if (csc->csc_data == NULL)
+    csc->csc_data = malloc(csa->csa_fill_size * 188);
+  if (csc->csc_fill == 0)
+    csc->csc_first = getmonoclock();
+
   for ( ; tsb < tsb_end; tsb += 188) {
 
-   pkt = csa->csa_tsbcluster + csa->csa_fill * 188;
+   pkt = csc->csc_data + csc->csc_fill * 188;
    memcpy(pkt, tsb, 188);
-   csa->csa_fill++;
+   csc->csc_fill++;
 
    do { 			// handle this packet
      if((pkt[3] & 0x80) == 0)	// clear or reserved (0x40)
        break;
-     ev_od = pkt[3] & 0x40;
+     parity = (pkt[3] & 0x40) >> 6;
      pkt[3] &= 0x3f; 		// consider it decrypted now
      if(pkt[3] & 0x20) {	// incomplete packet
        if(!(pkt[3] & 0x10))     // no payload - but why scrambled???
@@ -145,26 +533,51 @@ tvhcsa_csa_cbc_descramble
        len = 184;
        offset = 4;
      }
-     if(ev_od == 0) {
-       csa->csa_tsbbatch_even[csa->csa_fill_even].data = pkt + offset;
-       csa->csa_tsbbatch_even[csa->csa_fill_even].len = len;
-       csa->csa_fill_even++;
-       if(csa->csa_fill_even == csa->csa_cluster_size)
-         tvhcsa_csa_cbc_flush(csa, s);
-     } else {
-       csa->csa_tsbbatch_odd[csa->csa_fill_odd].data = pkt + offset;
-       csa->csa_tsbbatch_odd[csa->csa_fill_odd].len = len;
-       csa->csa_fill_odd++;
-       if(csa->csa_fill_odd == csa->csa_cluster_size)
-         tvhcsa_csa_cbc_flush(csa, s);
+     if ((ce = csa->csa_engine[parity]) == NULL)
+       break;			// no key yet
+     if (ce != locked) {
+       if (locked)
+         tvh_mutex_unlock(&locked->ce_lock);
+       tvh_mutex_lock(&ce->ce_lock);
+       locked = ce;
      }
+     cj = ce->ce_job;
+     cj->cj_batch[cj->cj_fill].data = pkt + offset;
+     cj->cj_batch[cj->cj_fill].len = len;
+     cj->cj_slot[cj->cj_fill].ces_csa = csa;
+     cj->cj_slot[cj->cj_fill].ces_cluster = csc;
+     cj->cj_slot[cj->cj_fill].ces_parity = parity;
+     atomic_add(&csc->csc_pending, 1);
+     csa->csa_queued[parity]++;
+     if(++cj->cj_fill == ce->ce_size)
+       tvhcsa_engine_submit(ce);
    } while(0);
 
-   if(csa->csa_fill == csa->csa_fill_size )
-     tvhcsa_csa_cbc_flush(csa, s);
+   if(csc->csc_fill == csa->csa_fill_size) {
+     if (locked) {
+       tvh_mutex_unlock(&locked->ce_lock);
+       locked = NULL;
+     }
+     tvhcsa_cluster_close(csa);
+     tvhcsa_cluster_deliver(csa, s, TVHCSA_CLUSTERS - 1);
+     csc = tvhcsa_cluster_current(csa);
+     if (csc->csc_data == NULL)
+       csc->csc_data = malloc(csa->csa_fill_size * 188);
+     csc->csc_first = getmonoclock();
+   }
 
   }
 
+  if (locked)
+    tvh_mutex_unlock(&locked->ce_lock);
+
+  if (csc->csc_fill &&
+      getmonoclock() - csc->csc_first >= ms2mono(config.descrambler_deadline)) {
+    tvhcsa_cluster_close(csa);
+    tvhcsa_cluster_deliver(csa, s, TVHCSA_CLUSTERS - 1);
+    tvhcsa_csa_cbc_stats(csa);
+  }
+
 #else
 #error "Unknown CSA descrambler"
 #endif
@@ -190,16 +603,6 @@ tvhcsa_set_type( tvhcsa_t *csa, struct mpegts_service *s, int type )
     csa->csa_fill_size  = 3 * csa->csa_cluster_size;
     tvhtrace(LS_CSA, "%p: service \"%s\" using CSA batch size = %d for decryption",
              csa, ((mpegts_service_t *)s)->s_dvb_svcname, csa->csa_cluster_size );
-
-    csa->csa_tsbcluster    = malloc(csa->csa_fill_size * 188);
-#if ENABLE_DVBCSA
-    csa->csa_tsbbatch_even = malloc((csa->csa_cluster_size + 1) *
-                                    sizeof(struct dvbcsa_bs_batch_s));
-    csa->csa_tsbbatch_odd  = malloc((csa->csa_cluster_size + 1) *
-                                    sizeof(struct dvbcsa_bs_batch_s));
-    csa->csa_key_even      = dvbcsa_bs_key_alloc();
-    csa->csa_key_odd       = dvbcsa_bs_key_alloc();
-#endif
     break;
   case DESCRAMBLER_DES_NCB:
     csa->csa_priv          = des_get_priv_struct();
@@ -232,7 +635,7 @@ void tvhcsa_set_key_even( tvhcsa_t *csa, const uint8_t *even )
   switch (csa->csa_type) {
   case DESCRAMBLER_CSA_CBC:
 #if ENABLE_DVBCSA
-    dvbcsa_bs_key_set_wrap(csa->csa_ecm, even, csa->csa_key_even);
+    tvhcsa_engine_set_key(csa, 0, even);
 #endif
     break;
   case DESCRAMBLER_DES_NCB:
@@ -254,7 +657,7 @@ void tvhcsa_set_key_odd( tvhcsa_t *csa, const uint8_t *odd )
   switch (csa->csa_type) {
   case DESCRAMBLER_CSA_CBC:
 #if ENABLE_DVBCSA
-    dvbcsa_bs_key_set_wrap(csa->csa_ecm, odd, csa->csa_key_odd);
+    tvhcsa_engine_set_key(csa, 1, odd);
 #endif
     break;
   case DESCRAMBLER_DES_NCB:
@@ -295,17 +698,15 @@ void
 tvhcsa_destroy ( tvhcsa_t *csa )
 {
 #if ENABLE_DVBCSA
-  if (csa->csa_key_odd)
-    dvbcsa_bs_key_free(csa->csa_key_odd);
-  if (csa->csa_key_even)
-    dvbcsa_bs_key_free(csa->csa_key_even);
-  if (csa->csa_tsbbatch_odd)
-    free(csa->csa_tsbbatch_odd);
-  if (csa->csa_tsbbatch_even)
-    free(csa->csa_tsbbatch_even);
+  int i;
+
+  tvhcsa_engine_put(csa, 0);
+  tvhcsa_engine_put(csa, 1);
+  for (i = 0; i < TVHCSA_CLUSTERS; i++) {
+    tvhcsa_cluster_wait(&csa->csa_cluster[i]);
+    free(csa->csa_cluster[i].csc_data);
+  }
 #endif
-  if (csa->csa_tsbcluster)
-    free(csa->csa_tsbcluster);
   if (csa->csa_priv) {
     switch (csa->csa_type) {
     case DESCRAMBLER_CSA_CBC:
@@ -326,6 +727,22 @@ tvhcsa_destroy ( tvhcsa_t *csa )
   memset(csa, 0, sizeof(*csa));
 }
 
+void
+tvhcsa_stats ( tvhcsa_t *csa, uint32_t *fill, uint32_t *rate,
+               uint32_t *latency )
+{
+#if ENABLE_DVBCSA
+  int i;
+
+  if (csa->csa_type == DESCRAMBLER_CSA_CBC) {
+    *fill = MAX(*fill, csa->csa_stat_fill);
+    *rate += csa->csa_stat_rate;
+    for (i = 0; i < TVHCSA_LATENCY_BUCKETS; i++)
+      latency[i] += csa->csa_stat_latency[i];
+  }
+#endif
+}
+
 #if ENABLE_DVBCSA
 void
 dvbcsa_bs_key_set_wrap(const unsigned char ecm, const dvbcsa_cw_t cw, struct dvbcsa_bs_key_s *key)
@@ -21,6 +21,7 @@
 
 struct mpegts_service;
 struct elementary_stream;
+struct tvhcsa_engine;
 
 #include <stdint.h>
 #include "build.h"
@@ -29,6 +30,19 @@ struct elementary_stream;
 #endif
 #include "tvhlog.h"
 
+#define TVHCSA_CLUSTERS        4
+#define TVHCSA_LATENCY_BUCKETS 10
+/* upper bounds of the latency histogram buckets in ms, 0 = unlimited */
+#define TVHCSA_LATENCY_BOUNDS  { 1, 2, 5, 10, 20, 50, 100, 200, 500, 0 }
+
+typedef struct tvhcsa_cluster
+{
+  uint8_t *csc_data;
+  int      csc_fill;
+  int      csc_pending;      /*< packets not decrypted yet (atomic) */
+  int64_t  csc_first;        /*< arrival time of the first packet */
+} tvhcsa_cluster_t;
+
 typedef struct tvhcsa
 {
 
@@ -44,19 +58,28 @@ typedef struct tvhcsa
               ( struct tvhcsa *csa, struct mpegts_service *s );
 
   int      csa_cluster_size;
-  uint8_t *csa_tsbcluster;
-  int      csa_fill;
   int      csa_fill_size;
   uint8_t  csa_ecm;
 
 #if ENABLE_DVBCSA
-  struct dvbcsa_bs_batch_s *csa_tsbbatch_even;
-  struct dvbcsa_bs_batch_s *csa_tsbbatch_odd;
-  int csa_fill_even;
-  int csa_fill_odd;
-
-  struct dvbcsa_bs_key_s *csa_key_even;
-  struct dvbcsa_bs_key_s *csa_key_odd;
+  /* shared engines for the even / odd control word */
+  struct tvhcsa_engine *csa_engine[2];
+  int      csa_queued[2];    /*< in the engine batch, protected by ce_lock */
+
+  /* cluster ring - the filled clusters wait for the decryption */
+  tvhcsa_cluster_t csa_cluster[TVHCSA_CLUSTERS];
+  int      csa_cluster_head;
+  int      csa_cluster_count;
+
+  /* statistics */
+  uint64_t csa_stat_packets; /*< decrypted packets */
+  uint64_t csa_stat_slots;   /*< sum of the batch fills for these packets */
+  uint64_t csa_stat_packets0;
+  uint64_t csa_stat_slots0;
+  int64_t  csa_stat_time;
+  uint32_t csa_stat_fill;    /*< batch fill in percent */
+  uint32_t csa_stat_rate;    /*< descrambled kbit/s */
+  uint32_t csa_stat_latency[TVHCSA_LATENCY_BUCKETS];
 #endif
   void *csa_priv;
   tvhlog_limit_t tvhcsa_loglimit;
@@ -73,6 +96,14 @@ void tvhcsa_set_key_odd ( tvhcsa_t *csa, const uint8_t *odd );
 void tvhcsa_init    ( tvhcsa_t *csa );
 void tvhcsa_destroy ( tvhcsa_t *csa );
 
+void tvhcsa_stats   ( tvhcsa_t *csa, uint32_t *fill, uint32_t *rate,
+                      uint32_t *latency );
+
+int64_t tvhcsa_expire ( tvhcsa_t *csa, struct mpegts_service *s );
+
+void tvhcsa_pool_start ( int threads );
+void tvhcsa_pool_stop  ( void );
+
 #else
 
 static inline int tvhcsa_set_type( tvhcsa_t *csa, struct mpegts_service *s, int type ) { return -1; }
@@ -83,6 +114,14 @@ static inline void tvhcsa_set_key_odd ( tvhcsa_t *csa, const uint8_t *odd ) { };
 static inline void tvhcsa_init ( tvhcsa_t *csa ) { };
 static inline void tvhcsa_destroy ( tvhcsa_t *csa ) { };
 
+static inline void tvhcsa_stats ( tvhcsa_t *csa, uint32_t *fill, uint32_t *rate,
+                                  uint32_t *latency ) { };
+
+static inline int64_t tvhcsa_expire ( tvhcsa_t *csa, struct mpegts_service *s ) { return 0; }
+
+static inline void tvhcsa_pool_start ( int threads ) { };
+static inline void tvhcsa_pool_stop ( void ) { };
+
 #endif
 
 #if ENABLE_DVBCSA
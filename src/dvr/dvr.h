@@ -289,6 +289,14 @@ typedef struct dvr_entry {
    */
   uint32_t de_data_errors;
 
+  /**
+   * Output rate measurement for the preallocation hint
+   * (only to be modified by the recording thread)
+   */
+  int64_t de_rate_start;
+  int64_t de_rate_bytes;
+  time_t  de_rate_stop;
+
   /**
    * Last error, see SM_CODE_ defines
    */
@@ -374,6 +382,8 @@ typedef struct dvr_autorec_entry {
   idnode_t dae_id;
 
   TAILQ_ENTRY(dvr_autorec_entry) dae_link;
+  uint32_t dae_seq;               /** Position in autorec_entries */
+  uint32_t dae_index_mark;        /** Candidate of the current event */
 
   char *dae_name;
   char *dae_directory;
@@ -613,6 +623,10 @@ void dvr_rec_unsubscribe(dvr_entry_t *de);
 
 void dvr_rec_migrate(dvr_entry_t *de_old, dvr_entry_t *de_new);
 
+void dvr_rec_init(void);
+
+void dvr_rec_done(void);
+
 void dvr_event_replaced(epg_broadcast_t *e, epg_broadcast_t *new_e);
 
 void dvr_event_removed(epg_broadcast_t *e);
@@ -185,19 +185,13 @@ dvr_autorec_completed(dvr_autorec_entry_t *dae, int error_code)
 }
 
 /**
- * return 1 if the event 'e' is matched by the autorec rule 'dae'
+ * return 1 if the rule 'dae' cannot match any event
  */
-int
-dvr_autorec_cmp(dvr_autorec_entry_t *dae, epg_broadcast_t *e)
+static int
+dvr_autorec_inactive(dvr_autorec_entry_t *dae)
 {
-  idnode_list_mapping_t *ilm;
-  dvr_config_t *cfg;
-  double duration;
-
-  if (!e) return 0;
-  if (!e->channel) return 0;
   if(dae->dae_enabled == 0 || dae->dae_weekdays == 0)
-    return 0;
+    return 1;
 
   if(dae->dae_channel == NULL &&
      dae->dae_channel_tag == NULL &&
@@ -214,7 +208,25 @@ dvr_autorec_cmp(dvr_autorec_entry_t *dae, epg_broadcast_t *e)
      dae->dae_minseason <= 0 &&
      dae->dae_maxseason <= 0 &&
      dae->dae_serieslink_uri == NULL)
-    return 0; // Avoid super wildcard match
+    return 1; // Avoid super wildcard match
+
+  return 0;
+}
+
+/**
+ * return 1 if the event 'e' is matched by the autorec rule 'dae'
+ */
+int
+dvr_autorec_cmp(dvr_autorec_entry_t *dae, epg_broadcast_t *e)
+{
+  idnode_list_mapping_t *ilm;
+  dvr_config_t *cfg;
+  double duration;
+
+  if (!e) return 0;
+  if (!e->channel) return 0;
+  if (dvr_autorec_inactive(dae))
+    return 0;
 
   if(dae->dae_serieslink_uri) {
     if (!e->serieslink ||
@@ -382,6 +394,463 @@ dvr_autorec_cmp(dvr_autorec_entry_t *dae, epg_broadcast_t *e)
   return 1;
 }
 
+/* **************************************************************************
+ * Rule index
+ *
+ * Only the candidate rules are compared with an updated event: the
+ * rules of the event channel (ch_autorecs) and of its tags (ct_autorecs)
+ * and the rules without channel and tag hashed by the series link, by
+ * a literal trigram of each title regex alternative or by the content
+ * type. The other rules are compared with every event. The candidates are
+ * compared in the autorec_entries order, like the full scan.
+ * **************************************************************************/
+
+#define AUTOREC_INDEX_HASH 1024
+#define AUTOREC_INDEX_ALTS 8    /* max. indexed alternatives of a title regex */
+
+typedef struct autorec_index_ent {
+  LIST_ENTRY(autorec_index_ent) link;
+  dvr_autorec_entry_t *dae;
+} autorec_index_ent_t;
+
+LIST_HEAD(autorec_index_list, autorec_index_ent);
+
+static int autorec_index_dirty = 1;
+static uint32_t autorec_index_seq;
+static uint32_t autorec_index_mark;
+static autorec_index_ent_t *autorec_index_ents;
+static struct autorec_index_list autorec_index_serieslink[AUTOREC_INDEX_HASH];
+static struct autorec_index_list autorec_index_title[AUTOREC_INDEX_HASH];
+static struct autorec_index_list autorec_index_genre[16];
+static struct autorec_index_list autorec_index_other;
+static dvr_autorec_entry_t **autorec_index_cand;
+static uint32_t autorec_index_cand_alloc;
+
+/*
+ * Self-check (TVHEADEND_AUTOREC_CHECK=1): every event is also compared
+ * with all rules and the differences are logged as errors
+ */
+static int autorec_index_check;
+static struct {
+  uint64_t events;
+  uint64_t candidates;
+  uint64_t mismatches;
+  int64_t  index_us;
+  int64_t  scan_us;
+} autorec_index_stats;
+
+/*
+ * Lowercase character usable in a title trigram, -1 otherwise. The
+ * caseless match of i, k and s may hit a non-ASCII character (dotted
+ * capital I, Kelvin sign, long s), so they are never part of a trigram.
+ */
+static inline int
+autorec_trigram_char(int c)
+{
+  if (c <= 0 || c >= 0x80)
+    return -1;
+  if (c >= 'A' && c <= 'Z')
+    c += 'a' - 'A';
+  if (c == 'i' || c == 'k' || c == 's')
+    return -1;
+  return c;
+}
+
+static inline uint32_t
+autorec_trigram_hash(int a, int b, int c)
+{
+  return ((((uint32_t)a << 16) | (b << 8) | c) * 2654435761U >> 22) &
+         (AUTOREC_INDEX_HASH - 1);
+}
+
+static inline uint32_t
+autorec_string_hash(const char *s)
+{
+  uint32_t h = 5381;
+  while (*s)
+    h = h * 33 + (uint8_t)*s++;
+  return h & (AUTOREC_INDEX_HASH - 1);
+}
+
+/*
+ * Skip a bracket expression, return the closing ']'
+ */
+static const char *
+autorec_regex_bracket(const char *p, const char *end)
+{
+  char t;
+
+  p++;
+  if (p < end && *p == '^') p++;
+  if (p < end && *p == ']') p++;
+  while (p < end && *p != ']') {
+    if (*p == '[' && p + 1 < end && (p[1] == ':' || p[1] == '.' || p[1] == '=')) {
+      t = p[1];
+      for (p += 2; p + 1 < end && (*p != t || p[1] != ']'); p++);
+      if (p + 1 >= end)
+        return NULL;
+      p++;
+    }
+    p++;
+  }
+  return p < end ? p : NULL;
+}
+
+/*
+ * Find a trigram which is present in every string matched by the regex
+ * range (extended syntax, caseless, no alternation): the first one of
+ * the longest literal run outside of the groups and brackets. Ranges
+ * with the escape sequences of letters or digits are not indexed.
+ */
+static int
+autorec_regex_trigram(const char *p, const char *end, uint32_t *key)
+{
+  int c, run = 0, best = 0, depth;
+  int t[3] = { 0 }, b[3] = { 0 };
+
+  for ( ; ; p++) {
+    switch (p < end ? *p : '\0') {
+    case '\0':
+      break;
+    case '*':
+    case '?':
+      if (run) run--;
+      break;
+    case '{':
+      if (run) run--;
+      if ((p = memchr(p, '}', end - p)) == NULL)
+        return -1;
+      break;
+    case '[':
+      if ((p = autorec_regex_bracket(p, end)) == NULL)
+        return -1;
+      break;
+    case '(':
+      for (depth = 1, p++; p < end && depth; p++) {
+        if (*p == '\\' && p + 1 < end) {
+          if (isalnum((uint8_t)p[1]))
+            return -1;
+          p++;
+        } else if (*p == '[') {
+          if ((p = autorec_regex_bracket(p, end)) == NULL)
+            return -1;
+        } else if (*p == '(')
+          depth++;
+        else if (*p == ')')
+          depth--;
+      }
+      if (depth)
+        return -1;
+      p--;
+      break;
+    case '\\':
+      /* \x41, \101, \cA, \d, \w, ... are not the literal characters */
+      if (p + 1 < end && isalnum((uint8_t)p[1]))
+        return -1;
+      if (p + 1 < end) p++;
+      break;
+    case '+':
+    case '.':
+    case '^':
+    case '$':
+    case ')':
+    case ']':
+    case '}':
+      break;
+    default:
+      if ((c = autorec_trigram_char((uint8_t)*p)) < 0)
+        break;
+      if (run < 3)
+        t[run] = c;
+      run++;
+      continue;
+    }
+    if (run >= 3 && run > best) {
+      best = run;
+      memcpy(b, t, sizeof(b));
+    }
+    run = 0;
+    if (p >= end)
+      break;
+  }
+  if (best == 0)
+    return -1;
+  *key = autorec_trigram_hash(b[0], b[1], b[2]);
+  return 0;
+}
+
+/*
+ * One trigram per top-level alternative of the title regex, return
+ * the count or -1 when an alternative has none
+ */
+static int
+autorec_regex_trigrams(const char *re, uint32_t *keys)
+{
+  const char *p, *s = re, *end = re + strlen(re);
+  int depth = 0, n = 0;
+
+  /* the inline options like (?x) change the meaning of the literals */
+  if (strstr(re, "(?"))
+    return -1;
+  for (p = re; ; p++) {
+    if (p == end || (*p == '|' && depth == 0)) {
+      if (n == AUTOREC_INDEX_ALTS || autorec_regex_trigram(s, p, &keys[n]))
+        return -1;
+      n++;
+      if (p == end)
+        return n;
+      s = p + 1;
+    } else if (*p == '\\') {
+      if (p + 1 < end) p++;
+    } else if (*p == '[') {
+      if ((p = autorec_regex_bracket(p, end)) == NULL)
+        return -1;
+    } else if (*p == '(') {
+      depth++;
+    } else if (*p == ')' && depth > 0) {
+      depth--;
+    }
+  }
+}
+
+static inline void
+dvr_autorec_index_insert
+  (struct autorec_index_list *l, dvr_autorec_entry_t *dae, uint32_t *n)
+{
+  autorec_index_ent_t *ent = &autorec_index_ents[(*n)++];
+  ent->dae = dae;
+  LIST_INSERT_HEAD(l, ent, link);
+}
+
+static void
+dvr_autorec_index_rebuild(void)
+{
+  dvr_autorec_entry_t *dae;
+  uint32_t keys[AUTOREC_INDEX_ALTS], n = 0;
+  int i, count = 0;
+
+  for (i = 0; i < AUTOREC_INDEX_HASH; i++) {
+    LIST_INIT(&autorec_index_serieslink[i]);
+    LIST_INIT(&autorec_index_title[i]);
+  }
+  for (i = 0; i < ARRAY_SIZE(autorec_index_genre); i++)
+    LIST_INIT(&autorec_index_genre[i]);
+  LIST_INIT(&autorec_index_other);
+
+  TAILQ_FOREACH(dae, &autorec_entries, dae_link)
+    count++;
+  free(autorec_index_ents);
+  autorec_index_ents = malloc(MAX(1, count * AUTOREC_INDEX_ALTS) *
+                              sizeof(autorec_index_ent_t));
+
+  TAILQ_FOREACH(dae, &autorec_entries, dae_link) {
+    /* found through the channel or tag lists */
+    if (dae->dae_channel || dae->dae_channel_tag)
+      continue;
+    if (dae->dae_serieslink_uri) {
+      dvr_autorec_index_insert(&autorec_index_serieslink[autorec_string_hash(dae->dae_serieslink_uri)], dae, &n);
+    } else if (dae->dae_title && dae->dae_title[0] && !dae->dae_fulltext &&
+               (count = autorec_regex_trigrams(dae->dae_title, keys)) > 0) {
+      for (i = 0; i < count; i++)
+        dvr_autorec_index_insert(&autorec_index_title[keys[i]], dae, &n);
+    } else if (dae->dae_content_type) {
+      dvr_autorec_index_insert(&autorec_index_genre[(dae->dae_content_type >> 4) & 0x0f], dae, &n);
+    } else {
+      dvr_autorec_index_insert(&autorec_index_other, dae, &n);
+    }
+  }
+  autorec_index_dirty = 0;
+}
+
+static int
+dvr_autorec_index_cmp(const void *a, const void *b)
+{
+  uint32_t s1 = (*(dvr_autorec_entry_t **)a)->dae_seq;
+  uint32_t s2 = (*(dvr_autorec_entry_t **)b)->dae_seq;
+  return s1 < s2 ? -1 : (s1 > s2);
+}
+
+typedef struct autorec_index_state {
+  epg_broadcast_t *e;
+  uint32_t count;
+  int wday;
+} autorec_index_state_t;
+
+static void
+dvr_autorec_index_add(autorec_index_state_t *st, dvr_autorec_entry_t *dae)
+{
+  struct tm tm;
+
+  if (dae->dae_index_mark == autorec_index_mark)
+    return;
+  dae->dae_index_mark = autorec_index_mark;
+  if (dvr_autorec_inactive(dae))
+    return;
+  if (dae->dae_weekdays != 0x7f) {
+    if (st->wday == 0) {
+      localtime_r(&st->e->start, &tm);
+      st->wday = 1 << ((tm.tm_wday ?: 7) - 1);
+    }
+    if (!(st->wday & dae->dae_weekdays))
+      return;
+  }
+  if (st->count >= autorec_index_cand_alloc) {
+    autorec_index_cand_alloc = MAX(64, autorec_index_cand_alloc * 2);
+    autorec_index_cand = realloc(autorec_index_cand,
+                                 autorec_index_cand_alloc * sizeof(dvr_autorec_entry_t *));
+  }
+  autorec_index_cand[st->count++] = dae;
+}
+
+static inline void
+dvr_autorec_index_add_list
+  (autorec_index_state_t *st, struct autorec_index_list *l)
+{
+  autorec_index_ent_t *ent;
+
+  LIST_FOREACH(ent, l, link)
+    dvr_autorec_index_add(st, ent->dae);
+}
+
+static void
+dvr_autorec_index_title(autorec_index_state_t *st, lang_str_t *ls)
+{
+  lang_str_ele_t *e;
+  const char *s;
+  int a, b, c;
+
+  RB_FOREACH(e, ls, link) {
+    for (a = b = -1, s = e->str; *s; s++, a = b, b = c) {
+      c = autorec_trigram_char((uint8_t)*s);
+      if (a >= 0 && b >= 0 && c >= 0)
+        dvr_autorec_index_add_list(st, &autorec_index_title[autorec_trigram_hash(a, b, c)]);
+    }
+  }
+}
+
+/*
+ * Collect the rules which may match the event, sorted like autorec_entries
+ */
+static uint32_t
+dvr_autorec_index_candidates(epg_broadcast_t *e)
+{
+  autorec_index_state_t st = { .e = e };
+  dvr_autorec_entry_t *dae;
+  idnode_list_mapping_t *ilm;
+  channel_tag_t *ct;
+  epg_genre_t *g;
+
+  lock_assert(&global_lock);
+
+  if (autorec_index_dirty)
+    dvr_autorec_index_rebuild();
+  if (++autorec_index_mark == 0) {
+    TAILQ_FOREACH(dae, &autorec_entries, dae_link)
+      dae->dae_index_mark = 0;
+    autorec_index_mark = 1;
+  }
+
+  LIST_FOREACH(dae, &e->channel->ch_autorecs, dae_channel_link)
+    dvr_autorec_index_add(&st, dae);
+  LIST_FOREACH(ilm, &e->channel->ch_ctms, ilm_in2_link) {
+    ct = (channel_tag_t *)ilm->ilm_in1;
+    LIST_FOREACH(dae, &ct->ct_autorecs, dae_channel_tag_link)
+      if (dae->dae_channel == NULL)
+        dvr_autorec_index_add(&st, dae);
+  }
+
+  if (e->serieslink)
+    dvr_autorec_index_add_list(&st, &autorec_index_serieslink[autorec_string_hash(e->serieslink->uri)]);
+  if (e->title)
+    dvr_autorec_index_title(&st, e->title);
+  LIST_FOREACH(g, &e->genre, link)
+    dvr_autorec_index_add_list(&st, &autorec_index_genre[(g->code >> 4) & 0x0f]);
+  dvr_autorec_index_add_list(&st, &autorec_index_other);
+
+  if (st.count > 1)
+    qsort(autorec_index_cand, st.count, sizeof(dvr_autorec_entry_t *),
+          dvr_autorec_index_cmp);
+  return st.count;
+}
+
+/**
+ * Index self-check
+ */
+static void
+dvr_autorec_index_mismatch
+  (dvr_autorec_entry_t *dae, epg_broadcast_t *e, const char *reason)
+{
+  char ubuf[UUID_HEX_SIZE];
+
+  autorec_index_stats.mismatches++;
+  tvherror(LS_DVR, "autorec index mismatch: rule %s \"%s\" event %u \"%s\" on \"%s\": %s",
+           idnode_uuid_as_str(&dae->dae_id, ubuf),
+           dae->dae_title ?: "", e->id,
+           epg_broadcast_get_title(e, NULL) ?: "",
+           channel_get_name(e->channel, ""), reason);
+}
+
+static void
+dvr_autorec_index_stats(void)
+{
+  uint64_t n = MAX(1, autorec_index_stats.events);
+
+  tvhinfo(LS_DVR, "autorec index check: %"PRIu64" events, %.1f candidates/event, "
+                  "index %.2f us/event, full scan %.2f us/event, %"PRIu64" mismatches",
+          autorec_index_stats.events,
+          (double)autorec_index_stats.candidates / n,
+          (double)autorec_index_stats.index_us / n,
+          (double)autorec_index_stats.scan_us / n,
+          autorec_index_stats.mismatches);
+}
+
+static void
+dvr_autorec_index_verify(epg_broadcast_t *e)
+{
+  dvr_autorec_entry_t *dae, **matched, **scan;
+  uint32_t i, j, count, n1 = 0, n2 = 0, total = 0;
+  int64_t t0, t1, t2;
+
+  TAILQ_FOREACH(dae, &autorec_entries, dae_link)
+    total++;
+  matched = malloc((total + 1) * 2 * sizeof(dvr_autorec_entry_t *));
+  scan = matched + total + 1;
+
+  t0 = getmonoclock();
+  count = dvr_autorec_index_candidates(e);
+  for (i = 0; i < count; i++)
+    if (dvr_autorec_cmp(autorec_index_cand[i], e))
+      matched[n1++] = autorec_index_cand[i];
+  t1 = getmonoclock();
+  TAILQ_FOREACH(dae, &autorec_entries, dae_link)
+    if (dvr_autorec_cmp(dae, e))
+      scan[n2++] = dae;
+  t2 = getmonoclock();
+
+  autorec_index_stats.candidates += count;
+  autorec_index_stats.index_us += t1 - t0;
+  autorec_index_stats.scan_us += t2 - t1;
+
+  /* both lists are in the autorec_entries order */
+  for (i = j = 0; i < n1 || j < n2; ) {
+    if (j >= n2 || (i < n1 && matched[i]->dae_seq < scan[j]->dae_seq)) {
+      dvr_autorec_index_mismatch(matched[i++], e, "matched by the index only");
+    } else if (i >= n1 || scan[j]->dae_seq < matched[i]->dae_seq) {
+      dvr_autorec_index_mismatch(scan[j++], e, "missed by the index");
+    } else {
+      i++;
+      j++;
+    }
+  }
+
+  for (j = 0; j < n2; j++)
+    dvr_entry_create_by_autorec(1, e, scan[j]);
+  free(matched);
+
+  if (++autorec_index_stats.events % 10000 == 0)
+    dvr_autorec_index_stats();
+}
+
 /**
  *
  */
@@ -411,8 +880,10 @@ dvr_autorec_create(const char *uuid, htsmsg_t *conf)
   LIST_INSERT_HEAD(&dae->dae_config->dvr_autorec_entries, dae, dae_config_link);
 
   TAILQ_INSERT_TAIL(&autorec_entries, dae, dae_link);
+  dae->dae_seq = ++autorec_index_seq;
 
   idnode_load(&dae->dae_id, conf);
+  autorec_index_dirty = 1;
 
   htsp_autorec_entry_add(dae);
 
@@ -506,6 +977,7 @@ autorec_entry_destroy(dvr_autorec_entry_t *dae, int delconf)
   htsp_autorec_entry_delete(dae);
 
   TAILQ_REMOVE(&autorec_entries, dae, dae_link);
+  autorec_index_dirty = 1;
   idnode_unlink(&dae->dae_id);
 
   if(dae->dae_config)
@@ -542,6 +1014,7 @@ dvr_autorec_entry_class_changed(idnode_t *self)
 
   if (dae->dae_error)
     dae->dae_enabled = 0;
+  autorec_index_dirty = 1;
   dvr_autorec_changed(dae, 1);
   dvr_autorec_completed(dae, 0);
   htsp_autorec_entry_update(dae);
@@ -1463,6 +1936,9 @@ dvr_autorec_init(void)
 
   TAILQ_INIT(&autorec_entries);
   idclass_register(&dvr_autorec_entry_class);
+  autorec_index_check = atoi(getenv("TVHEADEND_AUTOREC_CHECK") ?: "0") > 0;
+  if (autorec_index_check)
+    tvhwarn(LS_DVR, "autorec index check enabled (full scan for each event)");
   if((l = hts_settings_load("dvr/autorec")) != NULL) {
     HTSMSG_FOREACH(f, l) {
       if((c = htsmsg_get_map_by_field(f)) == NULL)
@@ -1479,8 +1955,15 @@ dvr_autorec_done(void)
   dvr_autorec_entry_t *dae;
 
   tvh_mutex_lock(&global_lock);
+  if (autorec_index_check)
+    dvr_autorec_index_stats();
   while ((dae = TAILQ_FIRST(&autorec_entries)) != NULL)
     autorec_entry_destroy(dae, 0);
+  free(autorec_index_ents);
+  autorec_index_ents = NULL;
+  free(autorec_index_cand);
+  autorec_index_cand = NULL;
+  autorec_index_cand_alloc = 0;
   tvh_mutex_unlock(&global_lock);
 }
 
@@ -1524,12 +2007,20 @@ void
 dvr_autorec_check_event(epg_broadcast_t *e)
 {
   dvr_autorec_entry_t *dae;
+  uint32_t i, count;
 
-  if (e->channel && !e->channel->ch_enabled)
+  if (!e->channel || !e->channel->ch_enabled)
     return;
-  TAILQ_FOREACH(dae, &autorec_entries, dae_link)
+  if (autorec_index_check) {
+    dvr_autorec_index_verify(e);
+    return;
+  }
+  count = dvr_autorec_index_candidates(e);
+  for (i = 0; i < count; i++) {
+    dae = autorec_index_cand[i];
     if(dvr_autorec_cmp(dae, e))
       dvr_entry_create_by_autorec(1, e, dae);
+  }
   // Note: no longer updating event here as it will be done from EPG
   //       anyway
 }
@@ -1542,15 +2033,32 @@ dvr_autorec_changed(dvr_autorec_entry_t *dae, int purge)
 {
   channel_t *ch;
   epg_broadcast_t *e, **disabled = NULL, **p;
-  int enabled;
+  idnode_list_mapping_t *ilm;
+  int enabled, skip;
 
   if (purge)
     disabled = dvr_autorec_purge_spawns(dae, 1, 1);
 
+  if (dae->dae_config == NULL || dvr_autorec_inactive(dae)) {
+    free(disabled);
+    return;
+  }
+
   CHANNEL_FOREACH(ch) {
     if (!ch->ch_enabled) continue;
+    /* skip the channels which cannot match (see dvr_autorec_cmp) */
+    skip = dae->dae_channel && dae->dae_channel != ch;
+    if (!skip && dae->dae_channel_tag) {
+      LIST_FOREACH(ilm, &ch->ch_ctms, ilm_in2_link)
+        if ((channel_tag_t *)ilm->ilm_in1 == dae->dae_channel_tag)
+          break;
+      skip = ilm == NULL;
+    }
+    if (skip && !autorec_index_check) continue;
     RB_FOREACH(e, &ch->ch_epg_schedule, sched_link) {
       if(dvr_autorec_cmp(dae, e)) {
+        if (skip)
+          dvr_autorec_index_mismatch(dae, e, "channel skipped");
         enabled = 1;
         if (disabled) {
           for (p = disabled; *p && *p != e; p++);
@@ -1588,6 +2096,7 @@ autorec_destroy_by_channel_tag(channel_tag_t *ct, int delconf)
   while((dae = LIST_FIRST(&ct->ct_autorecs)) != NULL) {
     LIST_REMOVE(dae, dae_channel_tag_link);
     dae->dae_channel_tag = NULL;
+    autorec_index_dirty = 1;
     idnode_notify_changed(&dae->dae_id);
     if (delconf)
       idnode_changed(&dae->dae_id);
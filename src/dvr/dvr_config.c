@@ -194,6 +194,7 @@ dvr_config_create(const char *name, const char *uuid, htsmsg_t *conf)
 
   /* Muxer config */
   cfg->dvr_muxcnf.m_cache  = MC_CACHE_SYSTEM;
+  cfg->dvr_muxcnf.m_io_block = 1024;
 
   /* Default recording file and directory permissions */
 
@@ -1247,6 +1248,35 @@ const idclass_t dvr_config_class = {
       .opts     = PO_EXPERT | PO_DOC_NLIST,
       .group    = 2,
     },
+    {
+      .type     = PT_INT,
+      .id       = "io-block",
+      .name     = N_("Write block size (KB)"),
+      .desc     = N_("Collect the recording data into blocks of this size "
+                     "and write them from a separate I/O thread. The cache "
+                     "scheme is applied once per block. Set to 0 to write "
+                     "each packet directly from the recording thread."),
+      .off      = offsetof(dvr_config_t, dvr_muxcnf.m_io_block),
+      .def.i    = 1024,
+      .opts     = PO_EXPERT,
+      .group    = 2,
+    },
+    {
+      .type     = PT_INT,
+      .id       = "prealloc",
+      .name     = N_("Preallocation step (MB)"),
+      .desc     = N_("Reserve the disk space for recordings in advance "
+                     "to reduce the file fragmentation. The first "
+                     "reservation is sized from the remaining recording "
+                     "time and the measured input rate, then the file "
+                     "is extended in steps of this size. The unused "
+                     "space is released when the recording ends. "
+                     "Set to 0 to disable (Linux only)."),
+      .off      = offsetof(dvr_config_t, dvr_muxcnf.m_prealloc),
+      .def.i    = 0,
+      .opts     = PO_EXPERT,
+      .group    = 2,
+    },
     {
       .type     = PT_BOOL,
       .id       = "day-dir",
@@ -1596,6 +1626,7 @@ dvr_init(void)
   dvr_inotify_init();
 #endif
   dvr_disk_space_boot();
+  dvr_rec_init();
   dvr_autorec_init();
   dvr_timerec_init();
   dvr_entry_init();
@@ -1626,6 +1657,9 @@ dvr_done(void)
 #endif
   tvh_mutex_lock(&global_lock);
   dvr_entry_done();
+  tvh_mutex_unlock(&global_lock);
+  dvr_rec_done();
+  tvh_mutex_lock(&global_lock);
   while ((cfg = LIST_FIRST(&dvrconfigs)) != NULL)
     dvr_config_destroy(cfg, 0);
   tvh_mutex_unlock(&global_lock);
@@ -31,6 +31,7 @@
 #include "notify.h"
 #include "compat.h"
 #include "string_list.h"
+#include "muxer/muxer_io.h"
 #include "epggrab.h" //Needed to get the epggrab_conf.epgdb_processparentallabels flag.
 
 struct dvr_entry_list dvrentries;
@@ -3117,6 +3118,8 @@ dvr_entry_class_save(idnode_t *self, char *filename, size_t fsize)
             htsmsg_add_s64(c, "stop", s64);
           if (!htsmsg_get_s64(e, "size", &s64))
             htsmsg_add_s64(c, "size", s64);
+          if (!htsmsg_get_s64(e, "extents", &s64))
+            htsmsg_add_s64(c, "extents", s64);
           htsmsg_add_msg(l, NULL, c);
         }
       }
@@ -3920,6 +3923,65 @@ dvr_entry_class_filesize_get(void *o)
   return &size;
 }
 
+static const void *
+dvr_entry_class_extents_get(void *o)
+{
+  static uint32_t u32;
+  dvr_entry_t *de = (dvr_entry_t *)o;
+  htsmsg_field_t *f;
+  htsmsg_t *m;
+
+  u32 = 0;
+  if (de->de_files)
+    HTSMSG_FOREACH(f, de->de_files)
+      if ((m = htsmsg_field_get_map(f)) != NULL)
+        u32 += htsmsg_get_u32_or_default(m, "extents", 0);
+  return &u32;
+}
+
+static int
+dvr_entry_io_stats(dvr_entry_t *de, muxer_io_stats_t *st)
+{
+  profile_chain_t *prch = de->de_chain;
+
+  memset(st, 0, sizeof(*st));
+  if (de->de_sched_state != DVR_RECORDING || prch == NULL ||
+      prch->prch_muxer == NULL || prch->prch_muxer->m_io == NULL)
+    return -1;
+  muxer_io_get_stats(prch->prch_muxer->m_io, st);
+  return 0;
+}
+
+static const void *
+dvr_entry_class_io_queue_get(void *o)
+{
+  static uint32_t u32;
+  muxer_io_stats_t st;
+  dvr_entry_io_stats((dvr_entry_t *)o, &st);
+  u32 = st.mis_queued;
+  return &u32;
+}
+
+static const void *
+dvr_entry_class_io_latency_get(void *o)
+{
+  static uint32_t u32;
+  muxer_io_stats_t st;
+  dvr_entry_io_stats((dvr_entry_t *)o, &st);
+  u32 = MIN(st.mis_latency_avg, UINT32_MAX);
+  return &u32;
+}
+
+static const void *
+dvr_entry_class_io_latency_max_get(void *o)
+{
+  static uint32_t u32;
+  muxer_io_stats_t st;
+  dvr_entry_io_stats((dvr_entry_t *)o, &st);
+  u32 = MIN(st.mis_latency_max, UINT32_MAX);
+  return &u32;
+}
+
 static const void *
 dvr_entry_class_start_real_get(void *o)
 {
@@ -4690,6 +4752,43 @@ const idclass_t dvr_entry_class = {
       .get      = dvr_entry_class_filesize_get,
       .opts     = PO_RDONLY | PO_NOSAVE,
     },
+    {
+      .type     = PT_U32,
+      .id       = "extents",
+      .name     = N_("File extents"),
+      .desc     = N_("Number of extents (fragments) the recording "
+                     "occupies on the disk, counted when the file "
+                     "was closed."),
+      .get      = dvr_entry_class_extents_get,
+      .opts     = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+    },
+    {
+      .type     = PT_U32,
+      .id       = "io_queue",
+      .name     = N_("Write queue"),
+      .desc     = N_("Number of data blocks waiting to be written "
+                     "to the recording file."),
+      .get      = dvr_entry_class_io_queue_get,
+      .opts     = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+    },
+    {
+      .type     = PT_U32,
+      .id       = "io_latency",
+      .name     = N_("Write latency (us)"),
+      .desc     = N_("Average time to write one data block to the "
+                     "recording file (microseconds)."),
+      .get      = dvr_entry_class_io_latency_get,
+      .opts     = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+    },
+    {
+      .type     = PT_U32,
+      .id       = "io_latency_max",
+      .name     = N_("Max. write latency (us)"),
+      .desc     = N_("Longest time to write one data block to the "
+                     "recording file (microseconds)."),
+      .get      = dvr_entry_class_io_latency_max_get,
+      .opts     = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+    },
     {
       .type     = PT_STR,
       .id       = "status",
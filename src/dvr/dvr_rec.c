@@ -31,6 +31,7 @@
 #include "intlconv.h"
 #include "notify.h"
 #include "string_list.h"
+#include "tvhvfs.h"
 
 #include "muxer.h"
 
@@ -1332,6 +1333,11 @@ dvr_rec_start(dvr_entry_t *de, const streaming_start_t *ss)
     return -1;
   }
 
+  /* The preallocation hint is set once the output rate is known */
+  de->de_rate_start = cfg->dvr_muxcnf.m_prealloc > 0 ? 0 : -1;
+  de->de_rate_bytes = 0;
+  de->de_rate_stop = dvr_entry_get_stop_time(de);
+
   dvr_vfs_refresh_entry(de);
 
   ss_copy = streaming_start_copy(ss);
@@ -1494,6 +1500,36 @@ dvr_streaming_restart(dvr_entry_t *de, int *run)
   }
 }
 
+/**
+ * Size the preallocation from the remaining time and the output rate
+ * measured over the first DVR_PREALLOC_RATE_TIME seconds
+ */
+#define DVR_PREALLOC_RATE_TIME 10
+
+static void
+dvr_thread_rate(dvr_entry_t *de, size_t len)
+{
+  int64_t mono, elapsed, remain;
+
+  if (de->de_rate_start < 0)
+    return;
+  mono = getmonoclock();
+  if (de->de_rate_start == 0)
+    de->de_rate_start = mono;
+  de->de_rate_bytes += len;
+  elapsed = mono - de->de_rate_start;
+  if (elapsed < sec2mono(DVR_PREALLOC_RATE_TIME))
+    return;
+  remain = de->de_rate_stop - gclk();
+  if (remain > 0) {
+    remain = de->de_rate_bytes + de->de_rate_bytes * sec2mono(remain) / elapsed;
+    tvhdebug(LS_DVR, "\"%s\": expected size %"PRId64" bytes",
+             lang_str_get(de->de_title, NULL), remain);
+    muxer_prealloc_hint(de->de_chain->prch_muxer, remain);
+  }
+  de->de_rate_start = -1;
+}
+
 /**
  *
  */
@@ -1508,8 +1544,10 @@ dvr_thread_pkt_stats(dvr_entry_t *de, th_pkt_t *pkt, int payload)
       de->de_data_errors += pkt->pkt_err;
       ret = 1;
     }
-    if (payload && pkt->pkt_payload)
+    if (payload && pkt->pkt_payload) {
       subscription_add_bytes_out(ts, pktbuf_len(pkt->pkt_payload));
+      dvr_thread_rate(de, pktbuf_len(pkt->pkt_payload));
+    }
   }
   return ret;
 }
@@ -1531,6 +1569,7 @@ dvr_thread_mpegts_stats(dvr_entry_t *de, void *sm_data)
         ret = 1;
       }
       subscription_add_bytes_out(ts, pktbuf_len(pb));
+      dvr_thread_rate(de, pktbuf_len(pb));
     }
   }
   return ret;
@@ -1679,7 +1718,7 @@ dvr_thread(void *aux)
   while(run) {
     sm = TAILQ_FIRST(&sq->sq_queue);
     if(sm == NULL) {
-      tvh_cond_wait(&sq->sq_cond, &sq->sq_mutex);
+      streaming_queue_wait(sq, 0);
       continue;
     }
     streaming_queue_remove(sq, sm);
@@ -1984,6 +2023,109 @@ dvr_spawn_cmd(dvr_entry_t *de, const char *cmd, const char *filename, int pre)
   htsstr_argsplit_free(args);
 }
 
+/*
+ * Closing the muxer writes the trailer and waits for the queued blocks
+ * of the asynchronous writer, which can take seconds on a slow disk or
+ * NAS. The muxer is detached from the entry under global_lock and closed
+ * by the close thread, the post-processing runs when the file is done.
+ */
+typedef struct dvr_rec_close {
+  TAILQ_ENTRY(dvr_rec_close) drc_link;
+  dvr_entry_t *drc_de;                /* referenced */
+  muxer_t     *drc_muxer;
+  char        *drc_filename;
+  char        *drc_postproc;
+  int          drc_extents;           /* FIEMAP result, -1 = unknown */
+} dvr_rec_close_t;
+
+static tvh_mutex_t                     dvr_rec_close_lock;
+static tvh_cond_t                      dvr_rec_close_cond;
+static TAILQ_HEAD(, dvr_rec_close)     dvr_rec_close_queue;
+static int                             dvr_rec_close_running;
+static pthread_t                       dvr_rec_close_tid;
+
+static void
+dvr_rec_close_finish(dvr_rec_close_t *drc)
+{
+  dvr_entry_t *de = drc->drc_de;
+  htsmsg_t *e;
+  htsmsg_field_t *f;
+  const char *filename;
+
+  lock_assert(&global_lock);
+
+  /* the entry list holds the other reference unless it was destroyed */
+  if (de->de_refcnt > 1) {
+    if (drc->drc_extents >= 0)
+      HTSMSG_FOREACH(f, de->de_files)
+        if ((e = htsmsg_field_get_map(f)) != NULL &&
+            (filename = htsmsg_get_str(e, "filename")) != NULL &&
+            strcmp(filename, drc->drc_filename) == 0)
+          htsmsg_set_s32(e, "extents", drc->drc_extents);
+    dvr_vfs_refresh_entry(de);
+    idnode_changed(&de->de_id);
+  }
+  if (drc->drc_postproc)
+    dvr_spawn_cmd(de, drc->drc_postproc, drc->drc_filename, 0);
+  dvr_entry_dec_ref(de);
+}
+
+static void *
+dvr_rec_close_thread(void *aux)
+{
+  dvr_rec_close_t *drc;
+
+  tvh_mutex_lock(&dvr_rec_close_lock);
+  while (1) {
+    drc = TAILQ_FIRST(&dvr_rec_close_queue);
+    if (drc == NULL) {
+      if (!dvr_rec_close_running)
+        break;
+      tvh_cond_wait(&dvr_rec_close_cond, &dvr_rec_close_lock);
+      continue;
+    }
+    TAILQ_REMOVE(&dvr_rec_close_queue, drc, drc_link);
+    tvh_mutex_unlock(&dvr_rec_close_lock);
+
+    muxer_close(drc->drc_muxer);
+    muxer_destroy(drc->drc_muxer);
+    /* the FIEMAP walk can be slow on large fragmented files */
+    drc->drc_extents = drc->drc_filename ? tvh_vfs_extents(drc->drc_filename) : -1;
+
+    tvh_mutex_lock(&global_lock);
+    dvr_rec_close_finish(drc);
+    tvh_mutex_unlock(&global_lock);
+
+    free(drc->drc_filename);
+    free(drc->drc_postproc);
+    free(drc);
+    tvh_mutex_lock(&dvr_rec_close_lock);
+  }
+  tvh_mutex_unlock(&dvr_rec_close_lock);
+  return NULL;
+}
+
+void
+dvr_rec_init(void)
+{
+  tvh_mutex_init(&dvr_rec_close_lock, NULL);
+  tvh_cond_init(&dvr_rec_close_cond, 1);
+  TAILQ_INIT(&dvr_rec_close_queue);
+  dvr_rec_close_running = 1;
+  tvh_thread_create(&dvr_rec_close_tid, NULL, dvr_rec_close_thread, NULL, "dvr-close");
+}
+
+/* Finish the closing recordings, global_lock must not be held */
+void
+dvr_rec_done(void)
+{
+  tvh_mutex_lock(&dvr_rec_close_lock);
+  dvr_rec_close_running = 0;
+  tvh_cond_signal(&dvr_rec_close_cond, 0);
+  tvh_mutex_unlock(&dvr_rec_close_lock);
+  pthread_join(dvr_rec_close_tid, NULL);
+}
+
 /**
  *
  */
@@ -1991,24 +2133,35 @@ static void
 dvr_thread_epilog(dvr_entry_t *de, const char *dvr_postproc)
 {
   profile_chain_t *prch = de->de_chain;
+  dvr_rec_close_t *drc;
   htsmsg_t *e;
   htsmsg_field_t *f;
+  const char *filename = NULL;
 
   lock_assert(&global_lock);
 
   if (prch == NULL)
     return;
 
-  muxer_close(prch->prch_muxer);
-  muxer_destroy(prch->prch_muxer);
-  prch->prch_muxer = NULL;
-
   if ((f = htsmsg_field_last(de->de_files)) != NULL &&
-      (e = htsmsg_field_get_map(f)) != NULL)
+      (e = htsmsg_field_get_map(f)) != NULL) {
     htsmsg_set_s64(e, "stop", gclk());
+    filename = htsmsg_get_str(e, "filename");
+  }
 
-  if(dvr_postproc && dvr_postproc[0])
-    dvr_spawn_cmd(de, dvr_postproc, NULL, 0);
+  drc = calloc(1, sizeof(*drc));
+  drc->drc_de = de;
+  de->de_refcnt++;
+  drc->drc_muxer = prch->prch_muxer;
+  prch->prch_muxer = NULL;
+  drc->drc_filename = filename ? strdup(filename) : NULL;
+  if (dvr_postproc && dvr_postproc[0])
+    drc->drc_postproc = strdup(dvr_postproc);
+
+  tvh_mutex_lock(&dvr_rec_close_lock);
+  TAILQ_INSERT_TAIL(&dvr_rec_close_queue, drc, drc_link);
+  tvh_cond_signal(&dvr_rec_close_cond, 0);
+  tvh_mutex_unlock(&dvr_rec_close_lock);
 
   idnode_changed(&de->de_id);
 }
@@ -41,9 +41,16 @@
 #define EPG_HASH_WIDTH 1024
 #define EPG_HASH_MASK  (EPG_HASH_WIDTH - 1)
 
+/* Broadcast channel/EID hashing */
+#define EPG_EID_HASH_WIDTH 65536
+#define EPG_EID_HASH_MASK  (EPG_EID_HASH_WIDTH - 1)
+
 /* Objects tree */
 epg_object_tree_t epg_objects[EPG_HASH_WIDTH];
 
+/* Broadcasts by channel and EID */
+static LIST_HEAD(, epg_broadcast) epg_eid_hash[EPG_EID_HASH_WIDTH];
+
 /* URI lists */
 epg_set_tree_t epg_serieslinks;
 epg_set_tree_t epg_episodelinks;
@@ -79,6 +86,12 @@ static int _ebc_start_cmp ( const void *a, const void *b )
   return ((epg_broadcast_t*)a)->start - ((epg_broadcast_t*)b)->start;
 }
 
+/* Comet notifications of the updated broadcasts, queued per epg_updated() */
+static htsmsg_t *epg_notify_create;
+static htsmsg_t *epg_notify_update;
+
+static epg_batch_stats_t epg_batch_stats;
+
 void epg_updated ( void )
 {
   epg_object_t *eo;
@@ -103,6 +116,92 @@ void epg_updated ( void )
     eo->_updated = 0;
     eo->_created = 1;
   }
+
+  /* Index the broadcasts queued during the load */
+  epg_fts_flush();
+
+  /* One notification per action for all updated broadcasts */
+  if (epg_notify_create) {
+    notify_delayed_list(epg_notify_create, "epg", "create");
+    epg_notify_create = NULL;
+  }
+  if (epg_notify_update) {
+    notify_delayed_list(epg_notify_update, "epg", "update");
+    epg_notify_update = NULL;
+  }
+}
+
+/* **************************************************************************
+ * Batched updates
+ * *************************************************************************/
+
+static void _epg_batch_hist
+  ( uint32_t *hist, const uint32_t *bounds, int64_t val )
+{
+  int i;
+
+  for (i = 0; i < EPG_BATCH_BUCKETS - 1; i++)
+    if (val <= bounds[i])
+      break;
+  hist[i]++;
+}
+
+static void _epg_batch_commit ( epg_batch_t *b )
+{
+  static const uint32_t size_bounds[] = EPG_BATCH_SIZE_BOUNDS;
+  static const uint32_t lock_bounds[] = EPG_BATCH_LOCK_BOUNDS;
+
+  epg_updated();
+  if (b->count) {
+    _epg_batch_hist(epg_batch_stats.size, size_bounds, b->count);
+    _epg_batch_hist(epg_batch_stats.lock, lock_bounds,
+                    getmonoclock() - b->start);
+  }
+}
+
+/*
+ * Take the global_lock for a batch of updates
+ */
+void epg_batch_begin ( epg_batch_t *b )
+{
+  tvh_mutex_lock(&global_lock);
+  b->start = getmonoclock();
+  b->count = 0;
+}
+
+/*
+ * One update applied, commit and let the other threads in when the
+ * batch is full
+ */
+void epg_batch_next ( epg_batch_t *b )
+{
+  lock_assert(&global_lock);
+
+  b->count++;
+  if (b->count < EPG_BATCH_MAX &&
+      getmonoclock() - b->start < EPG_BATCH_TIME)
+    return;
+  _epg_batch_commit(b);
+  tvh_mutex_unlock(&global_lock);
+  epg_batch_begin(b);
+}
+
+/*
+ * Commit the updates and release the global_lock
+ */
+void epg_batch_end ( epg_batch_t *b )
+{
+  lock_assert(&global_lock);
+
+  _epg_batch_commit(b);
+  tvh_mutex_unlock(&global_lock);
+}
+
+void epg_batch_get_stats ( epg_batch_stats_t *st )
+{
+  lock_assert(&global_lock);
+
+  *st = epg_batch_stats;
 }
 
 /* **************************************************************************
@@ -475,10 +574,92 @@ int epg_channel_ignore_broadcast(channel_t *ch, time_t start)
   return 0;
 }
 
+/*
+ * The schedule is also kept as an array sorted by start time, queries
+ * use it for the binary search of the time range. Start times are
+ * unique within the schedule (the tree is keyed by them).
+ */
+static uint32_t _epg_channel_index_lower ( channel_t *ch, int64_t start )
+{
+  uint32_t lo = 0, hi = ch->ch_epg_count, mid;
+
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    if ((int64_t)ch->ch_epg_index[mid]->start < start)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static int _epg_channel_index_find ( channel_t *ch, epg_broadcast_t *ebc )
+{
+  uint32_t i = _epg_channel_index_lower(ch, ebc->start);
+  if (i < ch->ch_epg_count && ch->ch_epg_index[i] == ebc)
+    return i;
+  return -1;
+}
+
+static void _epg_channel_index_add ( channel_t *ch, epg_broadcast_t *ebc )
+{
+  uint32_t i;
+
+  if (ch->ch_epg_count == ch->ch_epg_alloc) {
+    ch->ch_epg_alloc = MAX(64, ch->ch_epg_alloc * 2);
+    ch->ch_epg_index = realloc(ch->ch_epg_index,
+                               ch->ch_epg_alloc * sizeof(epg_broadcast_t *));
+  }
+  i = _epg_channel_index_lower(ch, ebc->start);
+  memmove(ch->ch_epg_index + i + 1, ch->ch_epg_index + i,
+          (ch->ch_epg_count - i) * sizeof(epg_broadcast_t *));
+  ch->ch_epg_index[i] = ebc;
+  ch->ch_epg_count++;
+}
+
+static void _epg_channel_index_rem ( channel_t *ch, epg_broadcast_t *ebc )
+{
+  int i = _epg_channel_index_find(ch, ebc);
+
+  assert(i >= 0);
+  ch->ch_epg_count--;
+  memmove(ch->ch_epg_index + i, ch->ch_epg_index + i + 1,
+          (ch->ch_epg_count - i) * sizeof(epg_broadcast_t *));
+  if (ch->ch_epg_alloc > 64 && ch->ch_epg_count < ch->ch_epg_alloc / 4) {
+    ch->ch_epg_alloc /= 2;
+    ch->ch_epg_index = realloc(ch->ch_epg_index,
+                               ch->ch_epg_alloc * sizeof(epg_broadcast_t *));
+  }
+}
+
+static inline uint32_t _epg_eid_hash ( channel_t *ch, uint16_t eid )
+{
+  return (((uint32_t)((uintptr_t)ch >> 4) * 2654435761U) ^ eid) & EPG_EID_HASH_MASK;
+}
+
+static void _epg_broadcast_eid_unhash ( epg_broadcast_t *ebc )
+{
+  LIST_SAFE_REMOVE(ebc, eid_link);
+}
+
+static void _epg_broadcast_eid_hash ( epg_broadcast_t *ebc )
+{
+  channel_t *ch = ebc->channel;
+
+  _epg_broadcast_eid_unhash(ebc);
+  if (ch == NULL || ebc->dvb_eid == 0) return;
+  if (_epg_channel_index_find(ch, ebc) < 0) return;
+  LIST_INSERT_HEAD(&epg_eid_hash[_epg_eid_hash(ch, ebc->dvb_eid)], ebc, eid_link);
+}
+
 static void _epg_channel_rem_broadcast
   ( channel_t *ch, epg_broadcast_t *ebc, epg_broadcast_t *ebc_new )
 {
   RB_REMOVE(&ch->ch_epg_schedule, ebc, sched_link);
+  _epg_channel_index_rem(ch, ebc);
+  _epg_broadcast_eid_unhash(ebc);
+  epg_fts_remove(ebc);
+  epg_journal_remove(ebc);
   if (ch->ch_epg_now  == ebc) ch->ch_epg_now  = NULL;
   if (ch->ch_epg_next == ebc) ch->ch_epg_next = NULL;
   if (ebc_new) {
@@ -591,6 +772,8 @@ static epg_broadcast_t *_epg_channel_add_broadcast
       *save  = 1;
       ret    = *bcast;
       *bcast = NULL;
+      _epg_channel_index_add(ch, ret);
+      _epg_broadcast_eid_hash(ret);
       _epg_object_create(ret);
       // Note: sets updated
       _epg_object_getref(ret);
@@ -704,6 +887,9 @@ void epg_channel_unlink ( channel_t *ch )
   epg_broadcast_t *ebc;
   while ((ebc = RB_FIRST(&ch->ch_epg_schedule)))
     _epg_channel_rem_broadcast(ch, ebc, NULL);
+  free(ch->ch_epg_index);
+  ch->ch_epg_index = NULL;
+  ch->ch_epg_alloc = 0;
   gtimer_disarm(&ch->ch_epg_timer);
 }
 
@@ -763,8 +949,10 @@ epg_broadcast_t *epg_match_now_next ( channel_t *ch, epg_broadcast_t *ebc )
   else
     return NULL;
   /* update eid for further lookups */
-  if (ret->dvb_eid != ebc->dvb_eid && ret->dvb_eid == 0 && ebc->dvb_eid)
+  if (ret->dvb_eid != ebc->dvb_eid && ret->dvb_eid == 0 && ebc->dvb_eid) {
     ret->dvb_eid = ebc->dvb_eid;
+    _epg_broadcast_eid_hash(ret);
+  }
   return ret;
 }
 
@@ -837,17 +1025,22 @@ void epg_set_broadcast_remove
  * Broadcast
  * *************************************************************************/
 
-static void _epg_broadcast_destroy ( void *eo )
+/* Only the broadcasts in the schedule are indexed and journaled */
+static inline int _epg_broadcast_in_schedule ( epg_broadcast_t *ebc )
+{
+  return ebc->channel && _epg_channel_index_find(ebc->channel, ebc) >= 0;
+}
+
+static void _epg_broadcast_fts_update ( epg_broadcast_t *ebc )
+{
+  if (_epg_broadcast_in_schedule(ebc))
+    epg_fts_update(ebc);
+}
+
+static void _epg_broadcast_free ( epg_broadcast_t *ebc )
 {
-  epg_broadcast_t *ebc = eo;
   epg_genre_t *eg;
-  char id[16];
 
-  if (ebc->_created) {
-    htsp_event_delete(ebc);
-    snprintf(id, sizeof(id), "%u", ebc->id);
-    notify_delayed(id, "epg", "delete");
-  }
   if (ebc->title)       lang_str_destroy(ebc->title);
   if (ebc->subtitle)    lang_str_destroy(ebc->subtitle);
   if (ebc->summary)     lang_str_destroy(ebc->summary);
@@ -863,8 +1056,22 @@ static void _epg_broadcast_destroy ( void *eo )
   if (ebc->category)    string_list_destroy(ebc->category);
   if (ebc->keyword)     string_list_destroy(ebc->keyword);
   if (ebc->keyword_cached) lang_str_destroy(ebc->keyword_cached);
+}
+
+static void _epg_broadcast_destroy ( void *eo )
+{
+  epg_broadcast_t *ebc = eo;
+  char id[16];
+
+  if (ebc->_created) {
+    htsp_event_delete(ebc);
+    snprintf(id, sizeof(id), "%u", ebc->id);
+    notify_delayed(id, "epg", "delete");
+  }
+  _epg_broadcast_free(ebc);
   epg_set_broadcast_remove(&epg_serieslinks, ebc->serieslink, ebc);
   epg_set_broadcast_remove(&epg_episodelinks, ebc->episodelink, ebc);
+  epg_fts_remove(ebc);
   _epg_object_destroy(eo, NULL);
   assert(LIST_EMPTY(&ebc->dvr_entries));
   free(ebc);
@@ -892,22 +1099,36 @@ static void _epg_broadcast_update_running ( epg_broadcast_t *broadcast )
   broadcast->update_running = EPG_RUNNING_NOTSET;
 }
 
+static void _epg_broadcast_notify
+  ( epg_broadcast_t *ebc, htsmsg_t **ids, const char *action )
+{
+  char id[16];
+
+  if (epg_in_load) {
+    notify_delayed("", "epg", action);
+    return;
+  }
+  snprintf(id, sizeof(id), "%u", ebc->id);
+  if (*ids == NULL)
+    *ids = htsmsg_create_list();
+  htsmsg_add_str(*ids, NULL, id);
+}
+
 static void _epg_broadcast_updated ( void *eo )
 {
   epg_broadcast_t *ebc = eo;
-  char id[16];
 
-  if (!epg_in_load)
-    snprintf(id, sizeof(id), "%u", ebc->id);
-  else
-    id[0] = '\0';
+  if (_epg_broadcast_in_schedule(ebc)) {
+    epg_fts_update(ebc);
+    epg_journal_update(ebc);
+  }
 
   if (ebc->_created) {
     htsp_event_update(eo);
-    notify_delayed(id, "epg", "update");
+    _epg_broadcast_notify(ebc, &epg_notify_update, "update");
   } else {
     htsp_event_add(eo);
-    notify_delayed(id, "epg", "create");
+    _epg_broadcast_notify(ebc, &epg_notify_create, "create");
   }
   if (ebc->channel) {
     dvr_event_updated(eo);
@@ -1081,13 +1302,29 @@ epg_broadcast_t *epg_broadcast_find_by_id ( uint32_t id )
   return (epg_broadcast_t*)epg_object_find_by_id(id, EPG_BROADCAST);
 }
 
+void epg_broadcast_remove ( epg_broadcast_t *ebc )
+{
+  if (_epg_broadcast_in_schedule(ebc))
+    _epg_channel_rem_broadcast(ebc->channel, ebc, NULL);
+}
+
 epg_broadcast_t *epg_broadcast_find_by_eid ( channel_t *ch, uint16_t eid )
 {
-  epg_broadcast_t *e;
-  RB_FOREACH(e, &ch->ch_epg_schedule, sched_link) {
-    if (e->dvb_eid == eid && e->stop > gclk()) return e;
+  epg_broadcast_t *e, *ret = NULL;
+  time_t now = gclk();
+
+  /* Broadcasts without EID are not hashed */
+  if (eid == 0) {
+    RB_FOREACH(e, &ch->ch_epg_schedule, sched_link)
+      if (e->dvb_eid == eid && e->stop > now) return e;
+    return NULL;
   }
-  return NULL;
+  /* The EID might be reused, return the earliest one */
+  LIST_FOREACH(e, &epg_eid_hash[_epg_eid_hash(ch, eid)], eid_link)
+    if (e->channel == ch && e->dvb_eid == eid && e->stop > now)
+      if (ret == NULL || e->start < ret->start)
+        ret = e;
+  return ret;
 }
 
 int epg_broadcast_set_running
@@ -1138,9 +1375,13 @@ int epg_broadcast_set_episodelink_uri
 int epg_broadcast_set_dvb_eid
   ( epg_broadcast_t *b, uint16_t dvb_eid, epg_changes_t *changed )
 {
+  int save;
   if (!b) return 0;
-  return _epg_object_set_u16(b, &b->dvb_eid, dvb_eid,
+  save = _epg_object_set_u16(b, &b->dvb_eid, dvb_eid,
                              changed, EPG_CHANGED_DVB_EID);
+  if (save)
+    _epg_broadcast_eid_hash(b);
+  return save;
 }
 
 int epg_broadcast_set_is_widescreen
@@ -1263,40 +1504,60 @@ int epg_broadcast_set_description
                                   changed, EPG_CHANGED_DESCRIPTION);
 }
 
+static void _epg_broadcast_credits_cache ( epg_broadcast_t *b )
+{
+  /* Copy in to cached csv for regex searching in autorec/GUI.
+   * We use just one string (rather than regex across each entry
+   * separately) so you could do a regex of "Douglas.*Stallone"
+   * to match the movies with the two actors.
+   */
+  if (!b->credits_cached) {
+      b->credits_cached = lang_str_create();
+  }
+  lang_str_set(&b->credits_cached, "", NULL);
+
+  if (b->credits) {
+    int add_sep = 0;
+    htsmsg_field_t *f;
+    HTSMSG_FOREACH(f, b->credits) {
+      if (add_sep) {
+        lang_str_append(b->credits_cached, ", ", NULL);
+      } else {
+        add_sep = 1;
+      }
+      lang_str_append(b->credits_cached, htsmsg_field_name(f), NULL);
+    }
+  } else {
+    if (b->credits_cached) {
+      lang_str_destroy(b->credits_cached);
+      b->credits_cached = NULL;
+    }
+  }
+}
+
+static void _epg_broadcast_keyword_cache ( epg_broadcast_t *b )
+{
+  /* Copy in to cached csv for regex searching in autorec/GUI. */
+  if (b->keyword) {
+    /* 1==>human readable */
+    char *str = string_list_2_csv(b->keyword, ',', 1);
+    lang_str_set(&b->keyword_cached, str, NULL);
+    free(str);
+  } else {
+    if (b->keyword_cached) {
+      lang_str_destroy(b->keyword_cached);
+      b->keyword_cached = NULL;
+    }
+  }
+}
+
 int epg_broadcast_set_credits
 ( epg_broadcast_t *b, const htsmsg_t *credits, epg_changes_t *changed )
 {
   if (!b) return 0;
   const int mod = _epg_object_set_htsmsg(b, &b->credits, credits, changed, EPG_CHANGED_CREDITS);
-  if (mod) {
-      /* Copy in to cached csv for regex searching in autorec/GUI.
-       * We use just one string (rather than regex across each entry
-       * separately) so you could do a regex of "Douglas.*Stallone"
-       * to match the movies with the two actors.
-       */
-      if (!b->credits_cached) {
-          b->credits_cached = lang_str_create();
-      }
-      lang_str_set(&b->credits_cached, "", NULL);
-
-      if (b->credits) {
-        int add_sep = 0;
-        htsmsg_field_t *f;
-        HTSMSG_FOREACH(f, b->credits) {
-          if (add_sep) {
-            lang_str_append(b->credits_cached, ", ", NULL);
-          } else {
-            add_sep = 1;
-          }
-          lang_str_append(b->credits_cached, htsmsg_field_name(f), NULL);
-        }
-      } else {
-        if (b->credits_cached) {
-          lang_str_destroy(b->credits_cached);
-          b->credits_cached = NULL;
-        }
-      }
-  }
+  if (mod)
+    _epg_broadcast_credits_cache(b);
   return mod;
 }
 
@@ -1312,20 +1573,8 @@ int epg_broadcast_set_keyword
 {
   if (!b) return 0;
   const int mod = _epg_object_set_string_list(b, &b->keyword, msg, changed, EPG_CHANGED_KEYWORD);
-  if (mod) {
-    /* Copy in to cached csv for regex searching in autorec/GUI. */
-    if (msg) {
-      /* 1==>human readable */
-      char *str = string_list_2_csv(msg, ',', 1);
-      lang_str_set(&b->keyword_cached, str, NULL);
-      free(str);
-    } else {
-      if (b->keyword_cached) {
-        lang_str_destroy(b->keyword_cached);
-        b->keyword_cached = NULL;
-      }
-    }
-  }
+  if (mod)
+    _epg_broadcast_keyword_cache(b);
   return mod;
 }
 
@@ -1759,6 +2008,63 @@ epg_broadcast_t *epg_broadcast_deserialize
   return ebc;
 }
 
+/*
+ * Database load - the broadcast is built without global_lock (only the
+ * own fields, texts, numbers and flags are set) and linked later
+ */
+epg_broadcast_t *epg_broadcast_restore_alloc ( void )
+{
+  epg_broadcast_t *ebc = calloc(1, sizeof(epg_broadcast_t));
+  if (ebc) {
+    ebc->type = EPG_BROADCAST;
+    ebc->ops  = &_epg_broadcast_ops;
+  }
+  return ebc;
+}
+
+void epg_broadcast_restore_free ( epg_broadcast_t *ebc )
+{
+  _epg_broadcast_free(ebc);
+  free(ebc);
+}
+
+epg_broadcast_t *epg_broadcast_restore
+  ( epg_broadcast_t *ebc, channel_t *ch, epggrab_module_t *grabber,
+    const char *rating_label, const char *serieslink,
+    const char *episodelink, int *save )
+{
+  epg_broadcast_t *ret;
+  time_t updated = ebc->updated;
+
+  lock_assert(&global_lock);
+
+  if (ch == NULL || ebc->stop <= gclk()) {
+    epg_broadcast_restore_free(ebc);
+    return NULL;
+  }
+  ret = _epg_channel_add_broadcast(ch, &ebc, grabber, 1, save, NULL);
+  /* not inserted - no grabber or the same start (duplicate) */
+  if (ebc) {
+    epg_broadcast_restore_free(ebc);
+    return NULL;
+  }
+  if (ret == NULL)
+    return NULL;
+  if (updated)
+    ret->updated = updated;
+  if (rating_label)
+    ret->rating_label = ratinglabel_find_from_uuid(rating_label);
+  _epg_broadcast_set_set(ret, serieslink, &epg_serieslinks, &ret->serieslink);
+  _epg_broadcast_set_set(ret, episodelink, &epg_episodelinks, &ret->episodelink);
+  if (ret->image)
+    imagecache_get_id(ret->image);
+  if (ret->credits)
+    _epg_broadcast_credits_cache(ret);
+  if (ret->keyword)
+    _epg_broadcast_keyword_cache(ret);
+  return ret;
+}
+
 /* **************************************************************************
  * Genre
  * *************************************************************************/
@@ -2274,11 +2580,81 @@ _eq_add ( epg_query_t *eq, epg_broadcast_t *e )
 }
 
 static void
-_eq_add_channel ( epg_query_t *eq, channel_t *ch )
+_eq_add_channel ( epg_query_t *eq, channel_t *ch,
+                  epg_broadcast_t **cand, uint32_t ccount )
+{
+  uint32_t i, lo = 0, hi = ch->ch_epg_count, mid;
+  int64_t limit = INT64_MAX;
+
+  /* Full-text index candidates (sorted by channel and start) */
+  if (cand) {
+    hi = ccount;
+    while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if ((uintptr_t)cand[mid]->channel < (uintptr_t)ch)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    for (i = lo; i < ccount && cand[i]->channel == ch; i++)
+      _eq_add(eq, cand[i]);
+    return;
+  }
+
+  /* Narrow the start time range, _eq_add() still checks all filters */
+  switch (eq->start.comp) {
+    case EC_EQ: limit = eq->start.val1; /* fall through */
+    case EC_GT: lo = _epg_channel_index_lower(ch, eq->start.val1); break;
+    case EC_LT: limit = eq->start.val1; break;
+    case EC_RG: lo = _epg_channel_index_lower(ch, eq->start.val1);
+                limit = eq->start.val2; break;
+    default: break;
+  }
+  /* A broadcast stopping before the limit also starts before it */
+  switch (eq->stop.comp) {
+    case EC_EQ:
+    case EC_LT: limit = MIN(limit, eq->stop.val1); break;
+    case EC_RG: limit = MIN(limit, eq->stop.val2); break;
+    default: break;
+  }
+  if (limit < INT64_MAX)
+    hi = _epg_channel_index_lower(ch, limit + 1);
+  for (i = lo; i < hi; i++)
+    _eq_add(eq, ch->ch_epg_index[i]);
+}
+
+static int
+_eq_cand_cmp ( const void *_a, const void *_b )
 {
-  epg_broadcast_t *ebc;
-  RB_FOREACH(ebc, &ch->ch_epg_schedule, sched_link)
-    _eq_add(eq, ebc);
+  const epg_broadcast_t *a = *(epg_broadcast_t **)_a;
+  const epg_broadcast_t *b = *(epg_broadcast_t **)_b;
+  if (a->channel != b->channel)
+    return (uintptr_t)a->channel < (uintptr_t)b->channel ? -1 : 1;
+  return a->start < b->start ? -1 : (a->start > b->start);
+}
+
+static epg_broadcast_t **
+_eq_fts_candidates ( epg_query_t *eq, uint32_t *count )
+{
+  epg_object_t *eo;
+  epg_broadcast_t *ebc, **cand;
+  uint32_t *ids, i, n, j = 0;
+
+  /* Not yet passed through epg_updated() */
+  LIST_FOREACH(eo, &epg_object_updated, up_link)
+    if (eo->type == EPG_BROADCAST)
+      _epg_broadcast_fts_update((epg_broadcast_t *)eo);
+
+  if (epg_fts_query(eq->stitle, eq->fulltext, &ids, &n))
+    return NULL;
+  cand = malloc(MAX(n, 1) * sizeof(epg_broadcast_t *));
+  for (i = 0; i < n; i++)
+    if ((ebc = epg_broadcast_find_by_id(ids[i])) != NULL)
+      cand[j++] = ebc;
+  free(ids);
+  qsort(cand, j, sizeof(epg_broadcast_t *), _eq_cand_cmp);
+  *count = j;
+  return cand;
 }
 
 static int
@@ -2495,6 +2871,8 @@ epg_query ( epg_query_t *eq, access_t *perm )
 {
   channel_t *channel;
   channel_tag_t *tag;
+  epg_broadcast_t **cand = NULL;
+  uint32_t ccount = 0;
   int (*fcn)(const void *, const void *, void *) = NULL;
 
   /* Setup exp */
@@ -2515,10 +2893,15 @@ epg_query ( epg_query_t *eq, access_t *perm )
   tag = channel_tag_find_by_uuid(eq->channel_tag) ?:
         channel_tag_find_by_name(eq->channel_tag, 0);
 
+  /* Narrow the title search using the full-text index (not worth it
+   * for a single channel) */
+  if (eq->stitle && (channel == NULL || tag))
+    cand = _eq_fts_candidates(eq, &ccount);
+
   /* Single channel */
   if (channel && tag == NULL) {
     if (channel_access(channel, perm, 0))
-      _eq_add_channel(eq, channel);
+      _eq_add_channel(eq, channel, cand, ccount);
 
   /* Tag based */
   } else if (tag) {
@@ -2528,14 +2911,14 @@ epg_query ( epg_query_t *eq, access_t *perm )
       ch2 = (channel_t *)ilm->ilm_in2;
       if(ch2 == channel || channel == NULL)
         if (channel_access(ch2, perm, 0))
-          _eq_add_channel(eq, ch2);
+          _eq_add_channel(eq, ch2, cand, ccount);
     }
 
   /* All channels */
   } else {
     CHANNEL_FOREACH(channel)
       if (channel_access(channel, perm, 0))
-        _eq_add_channel(eq, channel);
+        _eq_add_channel(eq, channel, cand, ccount);
   }
 
   switch (eq->sort_dir) {
@@ -2578,6 +2961,7 @@ epg_query ( epg_query_t *eq, access_t *perm )
   tvh_qsort_r(eq->result, eq->entries, sizeof(epg_broadcast_t *), fcn, eq);
 
 fin:
+  free(cand);
   _eq_done_str(&eq->title);
   _eq_done_str(&eq->subtitle);
   _eq_done_str(&eq->summary);
@@ -256,6 +256,8 @@ struct epg_broadcast
 
   struct channel            *channel;          ///< Channel being broadcast on
   RB_ENTRY(epg_broadcast)    sched_link;       ///< Schedule link
+  LIST_ENTRY(epg_broadcast)  eid_link;         ///< Channel/EID hash link
+  LIST_ENTRY(epg_broadcast)  journal_link;     ///< Not yet journaled changes
   LIST_HEAD(, dvr_entry)     dvr_entries;      ///< Associated DVR entries
 
   /* */
@@ -310,6 +312,11 @@ struct epg_broadcast
                                                ///< We'll call it copyright_year since words like "complete" and "finished"
                                                ///< sound too similar to dvr recorded functionality. We'll only store the
                                                ///< year since we only get year not month and day.
+
+  /* Full-text index */
+  uint32_t                  *fts_tokens;       ///< Indexed word ids
+  uint32_t                   fts_count;        ///< Count of indexed words
+  uint32_t                   fts_hash;         ///< Hash of the indexed words (0 = not indexed)
 };
 
 /* Lookup */
@@ -319,6 +326,17 @@ epg_broadcast_t *epg_broadcast_find_by_time
 epg_broadcast_t *epg_broadcast_find_by_eid ( struct channel *ch, uint16_t eid );
 epg_broadcast_t *epg_broadcast_find_by_id  ( uint32_t id );
 
+/* Remove from the channel schedule */
+void epg_broadcast_remove ( epg_broadcast_t *b );
+
+/* Database load (the allocated broadcast is filled outside of global_lock) */
+epg_broadcast_t *epg_broadcast_restore_alloc ( void );
+void epg_broadcast_restore_free ( epg_broadcast_t *b );
+epg_broadcast_t *epg_broadcast_restore
+  ( epg_broadcast_t *b, struct channel *ch, struct epggrab_module *grabber,
+    const char *rating_label, const char *serieslink,
+    const char *episodelink, int *save );
+
 /* Post-modify */
 int epg_broadcast_change_finish( epg_broadcast_t *b, epg_changes_t changed, int merge )
   __attribute__((warn_unused_result));
@@ -565,6 +583,20 @@ typedef struct epg_query {
 epg_broadcast_t  **epg_query(epg_query_t *eq, access_t *perm);
 void epg_query_free(epg_query_t *eq);
 
+/* ************************************************************************
+ * Full-text index
+ * ***********************************************************************/
+
+void epg_fts_init   (void);
+void epg_fts_done   (void);
+void epg_fts_update (epg_broadcast_t *ebc);
+void epg_fts_remove (epg_broadcast_t *ebc);
+void epg_fts_flush  (void);
+
+/* Candidate broadcast ids (sorted) for the title search, -1 if not usable */
+int  epg_fts_query
+  (const char *str, int fulltext, uint32_t **ids, uint32_t *count);
+
 /* ************************************************************************
  * Setup/Shutdown
  * ***********************************************************************/
@@ -576,4 +608,49 @@ void epg_save    (void);
 void epg_save_callback (void *p);
 void epg_updated (void);
 
+/* ************************************************************************
+ * Batched updates
+ *
+ * The grabbers apply the decoded events under one global_lock hold per
+ * batch; the update callbacks (HTSP, comet, DVR) run once per changed
+ * broadcast when the batch is committed (epg_updated). A batch is
+ * committed and the lock released when it grows too large or is held
+ * too long.
+ * ***********************************************************************/
+
+#define EPG_BATCH_MAX          256    ///< Max. updates per lock hold
+#define EPG_BATCH_TIME         20000  ///< Max. lock hold (us)
+#define EPG_BATCH_BUCKETS      10
+/* upper bounds of the histogram buckets, 0 = unlimited */
+#define EPG_BATCH_SIZE_BOUNDS  { 1, 2, 4, 8, 16, 32, 64, 128, 256, 0 }
+#define EPG_BATCH_LOCK_BOUNDS  { 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 0 }
+
+typedef struct epg_batch {
+  int64_t  start;         ///< global_lock acquisition (monoclock)
+  uint32_t count;         ///< updates in the current batch
+} epg_batch_t;
+
+typedef struct epg_batch_stats {
+  uint32_t size[EPG_BATCH_BUCKETS];  ///< updates per batch
+  uint32_t lock[EPG_BATCH_BUCKETS];  ///< global_lock hold per batch (us)
+} epg_batch_stats_t;
+
+void epg_batch_begin (epg_batch_t *b);
+void epg_batch_next  (epg_batch_t *b);
+void epg_batch_end   (epg_batch_t *b);
+void epg_batch_get_stats (epg_batch_stats_t *st);
+
+/* Database journal */
+typedef struct epg_save_stats {
+  int64_t  lock_last;     ///< global_lock hold of the last journal write (us)
+  int64_t  lock_max;      ///< longest global_lock hold (us)
+  int64_t  journal_size;  ///< bytes journaled since the last compaction
+  int      writes;        ///< journal writes
+  int      compactions;   ///< finished compactions
+} epg_save_stats_t;
+
+void epg_journal_update (epg_broadcast_t *ebc);
+void epg_journal_remove (epg_broadcast_t *ebc);
+void epg_save_get_stats (epg_save_stats_t *st);
+
 #endif /* EPG_H */
@@ -32,14 +32,914 @@
 #include "channels.h"
 #include "epg.h"
 #include "epggrab.h"
+#include "lang_codes.h"
 #include "config.h"
 #include "memoryinfo.h"
 
-#define EPG_DB_VERSION 3
+#define EPG_DB_VERSION 4
 #define EPG_DB_ALLOC_STEP (1024*1024)
 
+#define EPG_DB_V4_MAGIC      "TVHEPGDB"
+#define EPG_DB_V4_BYTEORDER  0x01020304
+#define EPG_DB_V4_DEFLATE    (1<<0)             /* gzip'ed chunks */
+#define EPG_DB_V4_RECORDS    4096               /* broadcasts per chunk */
+#define EPG_DB_V4_THREADS    8                  /* max. decoding threads */
+
+#define EPG_JOURNAL          ".journal"
+#define EPG_JOURNAL_OLD      ".journal.old"     /* under compaction */
+#define EPG_JOURNAL_INTERVAL 60                 /* seconds */
+#define EPG_JOURNAL_COMPACT  (16*1024*1024)     /* minimal size for compaction */
+
 extern epg_object_tree_t epg_episodes;
 
+typedef void (epgdb_msg_cb_t)
+  ( void *aux, const char *sect, htsmsg_t *m, const uint8_t *data, size_t len );
+
+/*
+ * v4 snapshot - fixed layout records in the host byte order
+ *
+ *   header | chunk table | config (binary2 message) | chunks
+ *
+ * The chunks are decoded independently (and in parallel). A chunk is
+ * the chunk header, the records, the lists (uint32 values, the first
+ * one is the count, the index 0 is not used) and the string table
+ * (the offset 0 is an empty string meaning "not set").
+ */
+typedef struct epgdb_v4_header {
+  char     magic[8];
+  uint32_t byteorder;
+  uint32_t flags;
+  uint32_t chunks;
+  uint32_t config;                /* config message size */
+} epgdb_v4_header_t;
+
+typedef struct epgdb_v4_chunk {
+  uint64_t offset;                /* 8-byte aligned */
+  uint32_t size;                  /* stored size */
+  uint32_t orig;                  /* decoded size */
+} epgdb_v4_chunk_t;
+
+typedef struct epgdb_v4_chunk_header {
+  uint32_t count;                 /* records */
+  uint32_t lists;                 /* list values */
+  uint32_t strings;               /* string table size */
+  uint32_t reserved;
+} epgdb_v4_chunk_header_t;
+
+#define EPGDB_V4_WIDESCREEN   (1<<0)
+#define EPGDB_V4_HD           (1<<1)
+#define EPGDB_V4_BW           (1<<2)
+#define EPGDB_V4_DEAFSIGNED   (1<<3)
+#define EPGDB_V4_SUBTITLED    (1<<4)
+#define EPGDB_V4_AUDIO_DESC   (1<<5)
+#define EPGDB_V4_NEW          (1<<6)
+#define EPGDB_V4_REPEAT       (1<<7)
+
+typedef struct epgdb_v4_rec {
+  int64_t  start;
+  int64_t  stop;
+  int64_t  updated;
+  int64_t  first_aired;
+  uint32_t id;
+  /* strings */
+  uint32_t channel;
+  uint32_t grabber;
+  uint32_t image;
+  uint32_t rating_label;
+  uint32_t serieslink;
+  uint32_t episodelink;
+  uint32_t eptext;
+  /* lists */
+  uint32_t title;                 /* language/text pairs */
+  uint32_t subtitle;
+  uint32_t summary;
+  uint32_t description;
+  uint32_t credits;               /* name/type pairs */
+  uint32_t category;              /* strings */
+  uint32_t keyword;
+  uint32_t genre;                 /* codes */
+  /* numbers */
+  uint16_t dvb_eid;
+  uint16_t lines;
+  uint16_t aspect;
+  uint16_t copyright_year;
+  uint16_t epnum[6];              /* s_num, s_cnt, e_num, e_cnt, p_num, p_cnt */
+  uint8_t  star_rating;
+  uint8_t  age_rating;
+  uint16_t flags;                 /* EPGDB_V4_* */
+} epgdb_v4_rec_t;
+
+static const struct {
+  const char *name;
+  uint16_t    flag;
+} epgdb_v4_flags[] = {
+  { "is_wd", EPGDB_V4_WIDESCREEN },
+  { "is_hd", EPGDB_V4_HD },
+  { "is_bw", EPGDB_V4_BW },
+  { "is_de", EPGDB_V4_DEAFSIGNED },
+  { "is_st", EPGDB_V4_SUBTITLED },
+  { "is_ad", EPGDB_V4_AUDIO_DESC },
+  { "is_n",  EPGDB_V4_NEW },
+  { "is_r",  EPGDB_V4_REPEAT },
+};
+
+/*
+ * Decoded chunk
+ */
+typedef struct epgdb_v4_view {
+  const epgdb_v4_rec_t *recs;
+  const uint32_t       *lists;
+  const char           *strings;
+  uint32_t              count;
+  uint32_t              lcount;
+  uint32_t              slen;
+} epgdb_v4_view_t;
+
+/*
+ * Chunk builder and the file data
+ */
+typedef struct epgdb_v4_writer {
+  epgdb_v4_rec_t   *recs;
+  uint32_t          count;
+  uint32_t         *lists;
+  uint32_t          lcount;
+  uint32_t          lalloc;
+  sbuf_t            strings;
+  uint32_t         *hash;         /* string offsets (0 - free slot) */
+  uint32_t          hmask;
+  uint32_t          hcount;
+  epgdb_v4_chunk_t *chunks;
+  uint32_t          ccount;
+  uint32_t          chunks_alloc;
+  sbuf_t            data;
+  int               deflate;
+  int               error;
+  int               broadcasts;
+} epgdb_v4_writer_t;
+
+/*
+ * Journal - the changed broadcasts (serialized at the next write) and
+ * the ids of the removed broadcasts
+ */
+static LIST_HEAD(, epg_broadcast) epg_journal_dirty;
+static uint32_t *epg_journal_deleted;
+static uint32_t epg_journal_deleted_count;
+static uint32_t epg_journal_deleted_alloc;
+static gtimer_t epg_journal_timer;
+static epg_save_stats_t epg_stats;
+static int64_t epg_snapshot_size;
+
+static void epg_journal_callback ( void *p );
+static void epg_compact ( void );
+
+/* **************************************************************************
+ * Files
+ * *************************************************************************/
+
+/*
+ * Database file path, the journals are stored next to the snapshot
+ */
+static void _epgdb_path ( char *path, size_t len, int ver, const char *suffix )
+{
+  char tmppath[PATH_MAX];
+
+  hts_settings_buildpath(tmppath, sizeof(tmppath), "epgdb.v%d", ver);
+  if (!realpath(tmppath, path))
+    strlcpy(path, tmppath, len);
+  strlcat(path, suffix, len);
+}
+
+static uint8_t *_epgdb_read ( const char *path, size_t *len )
+{
+  struct stat st;
+  uint8_t *buf = NULL;
+  size_t off = 0;
+  ssize_t r;
+  int fd;
+
+  if ((fd = tvh_open(path, O_RDONLY, 0)) < 0)
+    return NULL;
+  if (fstat(fd, &st) == 0 && st.st_size > 0 &&
+      (buf = malloc(st.st_size)) != NULL) {
+    while (off < st.st_size) {
+      r = read(fd, buf + off, st.st_size - off);
+      if (r <= 0) {
+        if (r < 0 && ERRNO_AGAIN(errno))
+          continue;
+        break;
+      }
+      off += r;
+    }
+    if (off != st.st_size) {
+      tvherror(LS_EPGDB, "unable to read file %s", path);
+      free(buf);
+      buf = NULL;
+    }
+  }
+  close(fd);
+  *len = off;
+  return buf;
+}
+
+static uint8_t *_epgdb_inflate ( uint8_t *rp, size_t *remain, uint8_t **zlib_mem )
+{
+#if ENABLE_ZLIB
+  if (*remain > 12 && memcmp(rp, "\xff\xffGZIP01", 8) == 0 &&
+      (rp[7] == '0' || rp[7] == '1')) {
+    uint32_t orig = (rp[8] << 24) | (rp[9] << 16) | (rp[10] << 8) | rp[11];
+    tvhinfo(LS_EPGDB, "gzip format detected, inflating (ratio %.1f%% deflated size %zd)",
+           (float)((*remain * 100.0) / orig), *remain);
+    rp = *zlib_mem = tvh_gzip_inflate(rp + 12, *remain - 12, orig);
+    *remain = rp ? orig : 0;
+  }
+#endif
+  return rp;
+}
+
+/*
+ * Walk the messages, returns -1 if the data are corrupted
+ */
+static int
+_epgdb_parse ( const uint8_t *rp, size_t remain, epgdb_msg_cb_t *cb, void *aux )
+{
+  char *sect = NULL;
+  const char *s;
+  size_t msglen;
+  htsmsg_t *m;
+  int r = 0;
+
+  while ( remain > 4 ) {
+
+    /* Get message length */
+    msglen = remain;
+    if (htsmsg_binary2_deserialize(&m, rp, &msglen, NULL)) {
+      r = -1;
+      break;
+    }
+
+    /* Process */
+    if (m) {
+      if ( (s = htsmsg_get_str(m, "__section__")) ) {
+        free(sect);
+        sect = strdup(s);
+      } else {
+        cb(aux, sect ?: "", m, rp, msglen);
+      }
+      htsmsg_destroy(m);
+    }
+
+    /* Next */
+    rp     += msglen;
+    remain -= msglen;
+  }
+
+  free(sect);
+  return r;
+}
+
+/* **************************************************************************
+ * v4 format
+ * *************************************************************************/
+
+static inline uint32_t _epgdb_v4_hash ( const char *s )
+{
+  uint32_t h = 2166136261U;
+  while (*s)
+    h = (h ^ (uint8_t)*s++) * 16777619U;
+  return h;
+}
+
+/*
+ * Returns the chunk table or NULL if the header is not valid
+ */
+static const epgdb_v4_chunk_t *
+_epgdb_v4_header ( const uint8_t *mem, size_t size, const epgdb_v4_header_t **hp )
+{
+  const epgdb_v4_header_t *h = (const epgdb_v4_header_t *)mem;
+
+  if (size < sizeof(*h) || memcmp(h->magic, EPG_DB_V4_MAGIC, sizeof(h->magic)))
+    return NULL;
+  if (h->byteorder != EPG_DB_V4_BYTEORDER) {
+    tvherror(LS_EPGDB, "database was created on a machine with another byte order");
+    return NULL;
+  }
+  size -= sizeof(*h);
+  if (size / sizeof(epgdb_v4_chunk_t) < h->chunks ||
+      size - h->chunks * sizeof(epgdb_v4_chunk_t) < h->config)
+    return NULL;
+  *hp = h;
+  return (const epgdb_v4_chunk_t *)(h + 1);
+}
+
+/*
+ * Chunk data (mapped or inflated to *zlib_mem)
+ */
+static const uint8_t *
+_epgdb_v4_chunk ( const uint8_t *mem, size_t size, uint32_t flags,
+                  const epgdb_v4_chunk_t *c, uint8_t **zlib_mem )
+{
+  if (c->offset > size || c->size > size - c->offset || c->orig == 0)
+    return NULL;
+  if (flags & EPG_DB_V4_DEFLATE) {
+#if ENABLE_ZLIB
+    return *zlib_mem = tvh_gzip_inflate(mem + c->offset, c->size, c->orig);
+#else
+    tvherror(LS_EPGDB, "compressed database is not supported");
+    return NULL;
+#endif
+  }
+  if (c->size != c->orig || (c->offset & 7) != 0)
+    return NULL;
+  return mem + c->offset;
+}
+
+static int
+_epgdb_v4_view ( epgdb_v4_view_t *v, const uint8_t *data, size_t len )
+{
+  const epgdb_v4_chunk_header_t *h = (const epgdb_v4_chunk_header_t *)data;
+
+  if (len < sizeof(*h))
+    return -1;
+  if ((uint64_t)h->count * sizeof(epgdb_v4_rec_t) +
+      (uint64_t)h->lists * sizeof(uint32_t) + h->strings != len - sizeof(*h))
+    return -1;
+  if (h->lists == 0 || h->strings == 0)
+    return -1;
+  v->recs    = (const epgdb_v4_rec_t *)(h + 1);
+  v->lists   = (const uint32_t *)(v->recs + h->count);
+  v->strings = (const char *)(v->lists + h->lists);
+  v->count   = h->count;
+  v->lcount  = h->lists;
+  v->slen    = h->strings;
+  return v->strings[v->slen - 1] != '\0' ? -1 : 0;
+}
+
+static inline const char *
+_epgdb_v4_str ( const epgdb_v4_view_t *v, uint32_t off )
+{
+  return off && off < v->slen ? v->strings + off : NULL;
+}
+
+static const uint32_t *
+_epgdb_v4_list ( const epgdb_v4_view_t *v, uint32_t idx, uint32_t *count )
+{
+  if (idx == 0 || idx >= v->lcount || v->lists[idx] > v->lcount - idx - 1)
+    return NULL;
+  *count = v->lists[idx];
+  return v->lists + idx + 1;
+}
+
+static lang_str_t *
+_epgdb_v4_lang_str ( const epgdb_v4_view_t *v, uint32_t idx )
+{
+  const uint32_t *l;
+  const char *s;
+  lang_str_t *ls;
+  uint32_t i, count;
+
+  if ((l = _epgdb_v4_list(v, idx, &count)) == NULL)
+    return NULL;
+  if ((ls = lang_str_create()) == NULL)
+    return NULL;
+  for (i = 0; i + 1 < count; i += 2)
+    if ((s = _epgdb_v4_str(v, l[i+1])))
+      lang_str_add(ls, s, _epgdb_v4_str(v, l[i]));
+  return ls;
+}
+
+static string_list_t *
+_epgdb_v4_string_list ( const epgdb_v4_view_t *v, uint32_t idx )
+{
+  const uint32_t *l;
+  const char *s;
+  string_list_t *sl = NULL;
+  uint32_t i, count;
+
+  if ((l = _epgdb_v4_list(v, idx, &count)) == NULL)
+    return NULL;
+  for (i = 0; i < count; i++)
+    if ((s = _epgdb_v4_str(v, l[i])) && *s) {
+      if (sl == NULL)
+        sl = string_list_create();
+      string_list_insert(sl, s);
+    }
+  return sl;
+}
+
+static htsmsg_t *
+_epgdb_v4_credits ( const epgdb_v4_view_t *v, uint32_t idx )
+{
+  const uint32_t *l;
+  const char *name, *type;
+  htsmsg_t *m;
+  uint32_t i, count;
+
+  if ((l = _epgdb_v4_list(v, idx, &count)) == NULL)
+    return NULL;
+  m = htsmsg_create_map();
+  for (i = 0; i + 1 < count; i += 2)
+    if ((name = _epgdb_v4_str(v, l[i])) && (type = _epgdb_v4_str(v, l[i+1])))
+      htsmsg_add_str(m, name, type);
+  return m;
+}
+
+/*
+ * Build the broadcast from the record (no global_lock, only the broadcast
+ * own data are filled, the links are created by epg_broadcast_restore())
+ */
+static epg_broadcast_t *
+_epgdb_v4_broadcast ( const epgdb_v4_view_t *v, const epgdb_v4_rec_t *r )
+{
+  epg_broadcast_t *ebc;
+  epg_genre_t genre;
+  const uint32_t *l;
+  const char *s;
+  uint32_t i, count;
+
+  if (!r->start || !r->stop || r->stop <= r->start || r->stop <= gclk())
+    return NULL;
+  if ((ebc = epg_broadcast_restore_alloc()) == NULL)
+    return NULL;
+
+  ebc->id             = r->id;
+  ebc->updated        = r->updated;
+  ebc->start          = r->start;
+  ebc->stop           = r->stop;
+  ebc->first_aired    = r->first_aired;
+  ebc->dvb_eid        = r->dvb_eid;
+  ebc->lines          = r->lines;
+  ebc->aspect         = r->aspect;
+  ebc->copyright_year = r->copyright_year;
+  ebc->star_rating    = r->star_rating;
+  ebc->age_rating     = r->age_rating;
+  ebc->is_widescreen  = !!(r->flags & EPGDB_V4_WIDESCREEN);
+  ebc->is_hd          = !!(r->flags & EPGDB_V4_HD);
+  ebc->is_bw          = !!(r->flags & EPGDB_V4_BW);
+  ebc->is_deafsigned  = !!(r->flags & EPGDB_V4_DEAFSIGNED);
+  ebc->is_subtitled   = !!(r->flags & EPGDB_V4_SUBTITLED);
+  ebc->is_audio_desc  = !!(r->flags & EPGDB_V4_AUDIO_DESC);
+  ebc->is_new         = !!(r->flags & EPGDB_V4_NEW);
+  ebc->is_repeat      = !!(r->flags & EPGDB_V4_REPEAT);
+
+  ebc->epnum.s_num    = r->epnum[0];
+  ebc->epnum.s_cnt    = r->epnum[1];
+  ebc->epnum.e_num    = r->epnum[2];
+  ebc->epnum.e_cnt    = r->epnum[3];
+  ebc->epnum.p_num    = r->epnum[4];
+  ebc->epnum.p_cnt    = r->epnum[5];
+  if ((s = _epgdb_v4_str(v, r->eptext)))
+    ebc->epnum.text = strdup(s);
+  if ((s = _epgdb_v4_str(v, r->image)))
+    ebc->image = strdup(s);
+
+  ebc->title       = _epgdb_v4_lang_str(v, r->title);
+  ebc->subtitle    = _epgdb_v4_lang_str(v, r->subtitle);
+  ebc->summary     = _epgdb_v4_lang_str(v, r->summary);
+  ebc->description = _epgdb_v4_lang_str(v, r->description);
+  ebc->credits     = _epgdb_v4_credits(v, r->credits);
+  ebc->category    = _epgdb_v4_string_list(v, r->category);
+  ebc->keyword     = _epgdb_v4_string_list(v, r->keyword);
+
+  if ((l = _epgdb_v4_list(v, r->genre, &count)))
+    for (i = 0; i < count; i++) {
+      genre.code = (uint8_t)l[i];
+      epg_genre_list_add(&ebc->genre, &genre);
+    }
+
+  return ebc;
+}
+
+/*
+ * Writer
+ */
+static void _epg_write_raw ( sbuf_t *sb, const void *data, size_t len )
+{
+  /* allocation helper - we fight with megabytes */
+  if (sb->sb_size - sb->sb_ptr < 32 * 1024)
+    sbuf_realloc(sb, (sb->sb_size - (sb->sb_size % EPG_DB_ALLOC_STEP)) + EPG_DB_ALLOC_STEP);
+  sbuf_append(sb, data, len);
+}
+
+static void _epgdb_v4_reset ( epgdb_v4_writer_t *w )
+{
+  w->count = 0;
+  w->lcount = 1;
+  w->lists[0] = 0;
+  w->strings.sb_ptr = 0;
+  sbuf_put_byte(&w->strings, 0);
+  memset(w->hash, 0, (w->hmask + 1) * sizeof(uint32_t));
+  w->hcount = 0;
+}
+
+static void _epgdb_v4_writer_init ( epgdb_v4_writer_t *w, size_t size )
+{
+  memset(w, 0, sizeof(*w));
+  w->recs = malloc(EPG_DB_V4_RECORDS * sizeof(epgdb_v4_rec_t));
+  w->lalloc = 64 * 1024;
+  w->lists = malloc(w->lalloc * sizeof(uint32_t));
+  w->hmask = 64 * 1024 - 1;
+  w->hash = malloc((w->hmask + 1) * sizeof(uint32_t));
+  sbuf_init_fixed(&w->strings, EPG_DB_ALLOC_STEP);
+  sbuf_init_fixed(&w->data, size + EPG_DB_ALLOC_STEP);
+#if ENABLE_ZLIB
+  w->deflate = config.epg_compress;
+#endif
+  _epgdb_v4_reset(w);
+}
+
+static void _epgdb_v4_writer_done ( epgdb_v4_writer_t *w )
+{
+  free(w->recs);
+  free(w->lists);
+  free(w->hash);
+  free(w->chunks);
+  sbuf_free(&w->strings);
+  sbuf_free(&w->data);
+}
+
+static void _epgdb_v4_hash_grow ( epgdb_v4_writer_t *w )
+{
+  uint32_t *hash, mask = w->hmask * 2 + 1, i, j;
+
+  hash = calloc(mask + 1, sizeof(uint32_t));
+  for (i = 0; i <= w->hmask; i++) {
+    if (w->hash[i] == 0) continue;
+    j = _epgdb_v4_hash((char *)w->strings.sb_data + w->hash[i]) & mask;
+    while (hash[j])
+      j = (j + 1) & mask;
+    hash[j] = w->hash[i];
+  }
+  free(w->hash);
+  w->hash = hash;
+  w->hmask = mask;
+}
+
+/*
+ * Add the string to the chunk string table (once)
+ */
+static uint32_t _epgdb_v4_intern ( epgdb_v4_writer_t *w, const char *s )
+{
+  uint32_t i, off;
+
+  if (s == NULL)
+    return 0;
+  for (i = _epgdb_v4_hash(s) & w->hmask; (off = w->hash[i]) != 0;
+       i = (i + 1) & w->hmask)
+    if (!strcmp((char *)w->strings.sb_data + off, s))
+      return off;
+  off = w->strings.sb_ptr;
+  _epg_write_raw(&w->strings, s, strlen(s) + 1);
+  w->hash[i] = off;
+  if (++w->hcount > w->hmask / 2)
+    _epgdb_v4_hash_grow(w);
+  return off;
+}
+
+static uint32_t _epgdb_v4_list_new ( epgdb_v4_writer_t *w, uint32_t count )
+{
+  uint32_t idx = w->lcount;
+
+  if (w->lcount + count + 1 > w->lalloc) {
+    w->lalloc = MAX(w->lalloc * 2, w->lcount + count + 1);
+    w->lists = realloc(w->lists, w->lalloc * sizeof(uint32_t));
+  }
+  w->lists[idx] = count;
+  w->lcount += count + 1;
+  return idx;
+}
+
+/*
+ * Write the chunk to the file data
+ */
+static void _epgdb_v4_flush ( epgdb_v4_writer_t *w )
+{
+  static const uint8_t pad[8];
+  epgdb_v4_chunk_header_t h;
+  epgdb_v4_chunk_t *c;
+  sbuf_t *sb, tmp;
+  uint8_t *z = NULL;
+  size_t zlen = 0;
+
+  if (w->count == 0)
+    return;
+  if (w->ccount == w->chunks_alloc) {
+    w->chunks_alloc = MAX(64, w->chunks_alloc * 2);
+    w->chunks = realloc(w->chunks, w->chunks_alloc * sizeof(*c));
+  }
+  h.count    = w->count;
+  h.lists    = w->lcount;
+  h.strings  = w->strings.sb_ptr;
+  h.reserved = 0;
+  c = &w->chunks[w->ccount++];
+  c->offset = w->data.sb_ptr;
+  c->orig   = sizeof(h) + h.count * sizeof(epgdb_v4_rec_t) +
+              h.lists * sizeof(uint32_t) + h.strings;
+  if (w->deflate) {
+    sbuf_init_fixed(sb = &tmp, c->orig);
+  } else {
+    sb = &w->data;
+  }
+  _epg_write_raw(sb, &h, sizeof(h));
+  _epg_write_raw(sb, w->recs, h.count * sizeof(epgdb_v4_rec_t));
+  _epg_write_raw(sb, w->lists, h.lists * sizeof(uint32_t));
+  _epg_write_raw(sb, w->strings.sb_data, h.strings);
+  if (w->deflate) {
+#if ENABLE_ZLIB
+    z = tvh_gzip_deflate_speed(tmp.sb_data, c->orig, &zlen, 3);
+#endif
+    if (z) {
+      _epg_write_raw(&w->data, z, zlen);
+      free(z);
+    } else {
+      w->error = 1;
+    }
+    sbuf_free(&tmp);
+  }
+  c->size = w->data.sb_ptr - c->offset;
+  _epg_write_raw(&w->data, pad, (8 - (w->data.sb_ptr & 7)) & 7);
+  _epgdb_v4_reset(w);
+}
+
+static epgdb_v4_rec_t *_epgdb_v4_rec_new ( epgdb_v4_writer_t *w )
+{
+  epgdb_v4_rec_t *r;
+
+  if (w->count == EPG_DB_V4_RECORDS)
+    _epgdb_v4_flush(w);
+  r = &w->recs[w->count++];
+  memset(r, 0, sizeof(*r));
+  w->broadcasts++;
+  return r;
+}
+
+static uint32_t
+_epgdb_v4_add_lang_str ( epgdb_v4_writer_t *w, htsmsg_t *m, const char *name )
+{
+  htsmsg_t *map;
+  htsmsg_field_t *f;
+  const char *s;
+  uint32_t idx, n = 0;
+
+  if ((map = htsmsg_get_map(m, name))) {
+    HTSMSG_FOREACH(f, map)
+      if (htsmsg_field_get_string(f)) n++;
+    if (n == 0)
+      return 0;
+    idx = _epgdb_v4_list_new(w, n * 2);
+    n = idx + 1;
+    HTSMSG_FOREACH(f, map)
+      if ((s = htsmsg_field_get_string(f))) {
+        w->lists[n++] = _epgdb_v4_intern(w, htsmsg_field_name(f));
+        w->lists[n++] = _epgdb_v4_intern(w, s);
+      }
+    return idx;
+  }
+  if ((s = htsmsg_get_str(m, name))) {
+    idx = _epgdb_v4_list_new(w, 2);
+    w->lists[idx+1] = 0;
+    w->lists[idx+2] = _epgdb_v4_intern(w, s);
+    return idx;
+  }
+  return 0;
+}
+
+static uint32_t
+_epgdb_v4_add_string_list ( epgdb_v4_writer_t *w, htsmsg_t *m, const char *name )
+{
+  htsmsg_t *list;
+  htsmsg_field_t *f;
+  uint32_t idx, n = 0;
+
+  if ((list = htsmsg_get_list(m, name)) == NULL)
+    return 0;
+  HTSMSG_FOREACH(f, list)
+    if (f->hmf_type == HMF_STR && f->hmf_str && *f->hmf_str) n++;
+  if (n == 0)
+    return 0;
+  idx = _epgdb_v4_list_new(w, n);
+  n = idx + 1;
+  HTSMSG_FOREACH(f, list)
+    if (f->hmf_type == HMF_STR && f->hmf_str && *f->hmf_str)
+      w->lists[n++] = _epgdb_v4_intern(w, f->hmf_str);
+  return idx;
+}
+
+static uint32_t
+_epgdb_v4_add_credits ( epgdb_v4_writer_t *w, htsmsg_t *m )
+{
+  htsmsg_t *map;
+  htsmsg_field_t *f;
+  const char *s;
+  uint32_t idx, n = 0;
+
+  if ((map = htsmsg_get_map(m, "cred")) == NULL)
+    return 0;
+  HTSMSG_FOREACH(f, map)
+    if (htsmsg_field_get_str(f)) n++;
+  idx = _epgdb_v4_list_new(w, n * 2);
+  n = idx + 1;
+  HTSMSG_FOREACH(f, map)
+    if ((s = htsmsg_field_get_str(f))) {
+      w->lists[n++] = _epgdb_v4_intern(w, htsmsg_field_name(f));
+      w->lists[n++] = _epgdb_v4_intern(w, s);
+    }
+  return idx;
+}
+
+static uint32_t
+_epgdb_v4_add_genre ( epgdb_v4_writer_t *w, htsmsg_t *m )
+{
+  htsmsg_t *list;
+  htsmsg_field_t *f;
+  uint32_t idx, n = 0;
+
+  if ((list = htsmsg_get_list(m, "genre")) == NULL)
+    return 0;
+  HTSMSG_FOREACH(f, list) n++;
+  idx = _epgdb_v4_list_new(w, n);
+  n = idx + 1;
+  HTSMSG_FOREACH(f, list)
+    w->lists[n++] = (uint8_t)f->hmf_s64;
+  return idx;
+}
+
+/*
+ * Add the broadcast in the serialized (htsmsg) form
+ */
+static void _epgdb_v4_add_msg ( epgdb_v4_writer_t *w, htsmsg_t *m )
+{
+  epgdb_v4_rec_t *r;
+  epg_episode_num_t num;
+  htsmsg_t *hm;
+  uint32_t id, u32;
+  int64_t start, stop;
+  int i;
+
+  if (htsmsg_get_u32(m, "id", &id) ||
+      htsmsg_get_s64(m, "start", &start) ||
+      htsmsg_get_s64(m, "stop", &stop))
+    return;
+  if (!htsmsg_get_u32(m, "tp", &u32) && u32 != EPG_BROADCAST)
+    return;
+
+  r = _epgdb_v4_rec_new(w);
+  r->id    = id;
+  r->start = start;
+  r->stop  = stop;
+  htsmsg_get_s64(m, "up", &r->updated);
+  htsmsg_get_s64(m, "fair", &r->first_aired);
+  r->channel      = _epgdb_v4_intern(w, htsmsg_get_str(m, "ch"));
+  r->grabber      = _epgdb_v4_intern(w, htsmsg_get_str(m, "gr"));
+  r->image        = _epgdb_v4_intern(w, htsmsg_get_str(m, "img"));
+  r->rating_label = _epgdb_v4_intern(w, htsmsg_get_str(m, "ratlab"));
+  r->serieslink   = _epgdb_v4_intern(w, htsmsg_get_str(m, "slink"));
+  r->episodelink  = _epgdb_v4_intern(w, htsmsg_get_str(m, "elink"));
+  r->title        = _epgdb_v4_add_lang_str(w, m, "tit");
+  r->subtitle     = _epgdb_v4_add_lang_str(w, m, "sti");
+  r->summary      = _epgdb_v4_add_lang_str(w, m, "sum");
+  r->description  = _epgdb_v4_add_lang_str(w, m, "des");
+  r->credits      = _epgdb_v4_add_credits(w, m);
+  r->category     = _epgdb_v4_add_string_list(w, m, "cat");
+  r->keyword      = _epgdb_v4_add_string_list(w, m, "key");
+  r->genre        = _epgdb_v4_add_genre(w, m);
+  r->dvb_eid        = htsmsg_get_u32_or_default(m, "eid", 0);
+  r->lines          = htsmsg_get_u32_or_default(m, "lines", 0);
+  r->aspect         = htsmsg_get_u32_or_default(m, "aspect", 0);
+  r->copyright_year = htsmsg_get_u32_or_default(m, "cyear", 0);
+  r->star_rating    = htsmsg_get_u32_or_default(m, "star", 0);
+  r->age_rating     = htsmsg_get_u32_or_default(m, "age", 0);
+  for (i = 0; i < ARRAY_SIZE(epgdb_v4_flags); i++)
+    if (htsmsg_get_u32_or_default(m, epgdb_v4_flags[i].name, 0))
+      r->flags |= epgdb_v4_flags[i].flag;
+  if ((hm = htsmsg_get_map(m, "epn"))) {
+    epg_episode_epnum_deserialize(hm, &num);
+    r->epnum[0] = num.s_num;
+    r->epnum[1] = num.s_cnt;
+    r->epnum[2] = num.e_num;
+    r->epnum[3] = num.e_cnt;
+    r->epnum[4] = num.p_num;
+    r->epnum[5] = num.p_cnt;
+    r->eptext = _epgdb_v4_intern(w, num.text);
+    free(num.text);
+  }
+}
+
+static inline uint32_t
+_epgdb_v4_copy_str
+  ( epgdb_v4_writer_t *w, const epgdb_v4_view_t *v, uint32_t off )
+{
+  return _epgdb_v4_intern(w, _epgdb_v4_str(v, off));
+}
+
+static uint32_t
+_epgdb_v4_copy_list
+  ( epgdb_v4_writer_t *w, const epgdb_v4_view_t *v, uint32_t idx, int strings )
+{
+  const uint32_t *l;
+  uint32_t i, count, ret;
+
+  if ((l = _epgdb_v4_list(v, idx, &count)) == NULL)
+    return 0;
+  ret = _epgdb_v4_list_new(w, count);
+  for (i = 0; i < count; i++)
+    w->lists[ret + 1 + i] = strings ? _epgdb_v4_copy_str(w, v, l[i]) : l[i];
+  return ret;
+}
+
+/*
+ * Add the record from another chunk
+ */
+static void
+_epgdb_v4_copy
+  ( epgdb_v4_writer_t *w, const epgdb_v4_view_t *v, const epgdb_v4_rec_t *src )
+{
+  epgdb_v4_rec_t *r = _epgdb_v4_rec_new(w);
+
+  *r = *src;
+  r->channel      = _epgdb_v4_copy_str(w, v, src->channel);
+  r->grabber      = _epgdb_v4_copy_str(w, v, src->grabber);
+  r->image        = _epgdb_v4_copy_str(w, v, src->image);
+  r->rating_label = _epgdb_v4_copy_str(w, v, src->rating_label);
+  r->serieslink   = _epgdb_v4_copy_str(w, v, src->serieslink);
+  r->episodelink  = _epgdb_v4_copy_str(w, v, src->episodelink);
+  r->eptext       = _epgdb_v4_copy_str(w, v, src->eptext);
+  r->title        = _epgdb_v4_copy_list(w, v, src->title, 1);
+  r->subtitle     = _epgdb_v4_copy_list(w, v, src->subtitle, 1);
+  r->summary      = _epgdb_v4_copy_list(w, v, src->summary, 1);
+  r->description  = _epgdb_v4_copy_list(w, v, src->description, 1);
+  r->credits      = _epgdb_v4_copy_list(w, v, src->credits, 1);
+  r->category     = _epgdb_v4_copy_list(w, v, src->category, 1);
+  r->keyword      = _epgdb_v4_copy_list(w, v, src->keyword, 1);
+  r->genre        = _epgdb_v4_copy_list(w, v, src->genre, 0);
+}
+
+/*
+ * Write the snapshot through a temporary file
+ */
+static int
+_epgdb_v4_store
+  ( const char *path, epgdb_v4_writer_t *w, const uint8_t *config, size_t config_len )
+{
+  static const uint8_t pad[8];
+  char tmppath[PATH_MAX + 20];
+  epgdb_v4_header_t h;
+  uint64_t base;
+  size_t padlen;
+  uint32_t i;
+  int fd, r;
+
+  _epgdb_v4_flush(w);
+  if (w->error) {
+    tvherror(LS_EPGDB, "unable to compress epgdb data");
+    return -1;
+  }
+
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, EPG_DB_V4_MAGIC, sizeof(h.magic));
+  h.byteorder = EPG_DB_V4_BYTEORDER;
+  h.flags     = w->deflate ? EPG_DB_V4_DEFLATE : 0;
+  h.chunks    = w->ccount;
+  h.config    = config_len;
+  base = sizeof(h) + w->ccount * sizeof(epgdb_v4_chunk_t) + config_len;
+  padlen = (8 - (base & 7)) & 7;
+  base += padlen;
+  for (i = 0; i < w->ccount; i++)
+    w->chunks[i].offset += base;
+
+  snprintf(tmppath, sizeof(tmppath), "%s.tmp", path);
+  if (hts_settings_makedirs(tmppath))
+    fd = -1;
+  else
+    fd = tvh_open(tmppath, O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    tvherror(LS_EPGDB, "unable to open epgdb file");
+    return -1;
+  }
+  r = tvh_write(fd, &h, sizeof(h));
+  if (!r && w->ccount)
+    r = tvh_write(fd, w->chunks, w->ccount * sizeof(epgdb_v4_chunk_t));
+  if (!r && config_len)
+    r = tvh_write(fd, config, config_len);
+  if (!r && padlen)
+    r = tvh_write(fd, pad, padlen);
+  if (!r && w->data.sb_ptr)
+    r = tvh_write(fd, w->data.sb_data, w->data.sb_ptr);
+  close(fd);
+  if (r) {
+    tvherror(LS_EPGDB, "write error (size %"PRId64")", base + w->data.sb_ptr);
+    if (remove(tmppath))
+      tvherror(LS_EPGDB, "unable to remove file %s", tmppath);
+    return -1;
+  }
+  tvhinfo(LS_EPGDB, "stored (size %"PRId64")", base + w->data.sb_ptr);
+  if (rename(tmppath, path)) {
+    tvherror(LS_EPGDB, "unable to rename file %s to %s", tmppath, path);
+    return -1;
+  }
+  atomic_set_s64(&epg_snapshot_size, base + w->data.sb_ptr);
+  return 0;
+}
+
 /* **************************************************************************
  * Load
  * *************************************************************************/
@@ -48,70 +948,387 @@ extern epg_object_tree_t epg_episodes;
  * Process v3 data
  */
 static void
-_epgdb_v3_process( char **sect, htsmsg_t *m, epggrab_stats_t *stats )
+_epgdb_v3_process( void *aux, const char *sect, htsmsg_t *m,
+                   const uint8_t *data, size_t len )
 {
+  epggrab_stats_t *stats = aux;
+  epg_broadcast_t *ebc;
+  uint32_t id;
   int save = 0;
-  const char *s;
 
-  /* New section */
-  if ( (s = htsmsg_get_str(m, "__section__")) ) {
-    if (*sect) free(*sect);
-    *sect = strdup(s);
-  
   /* Broadcasts */
-  } else if ( !strcmp(*sect, "broadcasts") ) {
+  if ( !strcmp(sect, "broadcasts") ) {
     if (epg_broadcast_deserialize(m, 1, &save)) stats->broadcasts.total++;
 
+  /* Removed broadcasts (journal) */
+  } else if ( !strcmp(sect, "deleted") ) {
+    if (!htsmsg_get_u32(m, "id", &id) && (ebc = epg_broadcast_find_by_id(id))) {
+      epg_broadcast_remove(ebc);
+      stats->broadcasts.modified++;
+    }
+
   /* Global config */
-  } else if ( !strcmp(*sect, "config") ) {
+  } else if ( !strcmp(sect, "config") ) {
     if (epg_config_deserialize(m)) stats->config.total++;
 
   /* Unknown */
   } else {
-    tvhdebug(LS_EPGDB, "malformed database section [%s]", *sect);
+    tvhdebug(LS_EPGDB, "malformed database section [%s]", sect);
     //htsmsg_print(m);
   }
-}
+}
+
+/*
+ * Memoryinfo
+ */
+
+static void epg_memoryinfo_broadcasts_update(memoryinfo_t *my)
+{
+  channel_t *ch;
+  epg_broadcast_t *ebc;
+  int64_t size = 0, count = 0;
+
+  CHANNEL_FOREACH(ch) {
+    if (ch->ch_epg_parent) continue;
+    RB_FOREACH(ebc, &ch->ch_epg_schedule, sched_link) {
+      size += sizeof(*ebc);
+      size += tvh_strlen(ebc->image);
+      size += tvh_strlen(ebc->epnum.text);
+      size += lang_str_size(ebc->title);
+      size += lang_str_size(ebc->subtitle);
+      size += lang_str_size(ebc->summary);
+      size += lang_str_size(ebc->description);
+      count++;
+    }
+  }
+  memoryinfo_update(my, size, count);
+}
+
+static memoryinfo_t epg_memoryinfo_broadcasts = {
+  .my_name = "EPG Broadcasts",
+  .my_update = epg_memoryinfo_broadcasts_update
+};
+
+/*
+ * Recovery (per thread, the v4 chunks are decoded in parallel)
+ */
+static __thread sigjmp_buf epg_mmap_env;
+
+static void epg_mmap_sigbus (int sig, siginfo_t *siginfo, void *ptr)
+{
+  siglongjmp(epg_mmap_env, 1);
+}
+
+/*
+ * v4 load - the chunks are decoded by the worker threads, the main
+ * thread (global_lock) links the broadcasts in the file order. The
+ * workers may run only a few chunks ahead to limit the memory usage.
+ */
+typedef struct epgdb_v4_part {
+  uint8_t          *zlib_mem;
+  epgdb_v4_view_t   view;
+  epg_broadcast_t **bcast;
+  uint32_t          decoded;
+  int               state;
+} epgdb_v4_part_t;
+
+#define EPGDB_V4_PART_WAIT   0
+#define EPGDB_V4_PART_DONE   1
+#define EPGDB_V4_PART_FAILED 2
+
+typedef struct epgdb_v4_load {
+  const uint8_t          *mem;
+  size_t                  size;
+  uint32_t                flags;
+  const epgdb_v4_chunk_t *chunks;
+  epgdb_v4_part_t        *parts;
+  uint32_t                count;
+  uint32_t                next;       /* next chunk to decode */
+  uint32_t                linked;     /* chunks linked to the schedules */
+  uint32_t                window;     /* max. decoded chunks ahead */
+  uint32_t                failed;
+  int                     abort;
+  tvh_mutex_t             lock;
+  tvh_cond_t              cond;
+} epgdb_v4_load_t;
+
+static int
+_epgdb_v4_decode ( epgdb_v4_load_t *l, epgdb_v4_part_t *p, uint32_t i )
+{
+  const uint8_t *data;
+  sigjmp_buf old;
+  uint32_t j;
+  int r = -1;
+
+  memcpy(old, epg_mmap_env, sizeof(old));
+  if (sigsetjmp(epg_mmap_env, 1)) {
+    tvherror(LS_EPGDB, "failed to read from mapped file");
+    goto done;
+  }
+  data = _epgdb_v4_chunk(l->mem, l->size, l->flags, &l->chunks[i], &p->zlib_mem);
+  if (data == NULL || _epgdb_v4_view(&p->view, data, l->chunks[i].orig))
+    goto done;
+  p->bcast = calloc(MAX(1, p->view.count), sizeof(epg_broadcast_t *));
+  for (j = 0; j < p->view.count; j++, p->decoded++)
+    p->bcast[j] = _epgdb_v4_broadcast(&p->view, &p->view.recs[j]);
+  r = 0;
+done:
+  memcpy(epg_mmap_env, old, sizeof(old));
+  return r;
+}
+
+static void _epgdb_v4_part_free ( epgdb_v4_part_t *p )
+{
+  uint32_t j;
+
+  for (j = 0; j < p->decoded; j++)
+    if (p->bcast[j])
+      epg_broadcast_restore_free(p->bcast[j]);
+  free(p->bcast);
+  free(p->zlib_mem);
+  p->bcast = NULL;
+  p->zlib_mem = NULL;
+  p->decoded = 0;
+}
+
+static void
+_epgdb_v4_link ( epgdb_v4_part_t *p, epggrab_stats_t *stats )
+{
+  const epgdb_v4_view_t *v = &p->view;
+  const epgdb_v4_rec_t *r;
+  const char *s;
+  channel_t *ch = NULL;
+  epggrab_module_t *grabber = NULL;
+  epg_broadcast_t *ebc;
+  uint32_t j, choff = 0, groff = 0;
+  int save = 0;
+
+  for (j = 0; j < p->decoded; j++) {
+    if ((ebc = p->bcast[j]) == NULL)
+      continue;
+    p->bcast[j] = NULL;
+    r = &v->recs[j];
+    /* the records are grouped by channel */
+    if (r->channel != choff) {
+      choff = r->channel;
+      ch = (s = _epgdb_v4_str(v, choff)) ? channel_find(s) : NULL;
+    }
+    if (r->grabber != groff) {
+      groff = r->grabber;
+      grabber = (s = _epgdb_v4_str(v, groff)) ? epggrab_module_find_by_id(s) : NULL;
+    }
+    if (epg_broadcast_restore(ebc, ch, grabber,
+                              _epgdb_v4_str(v, r->rating_label),
+                              _epgdb_v4_str(v, r->serieslink),
+                              _epgdb_v4_str(v, r->episodelink), &save))
+      stats->broadcasts.total++;
+  }
+  _epgdb_v4_part_free(p);
+}
+
+static void *_epgdb_v4_thread ( void *aux )
+{
+  epgdb_v4_load_t *l = aux;
+  uint32_t i;
+  int r;
+
+  tvh_mutex_lock(&l->lock);
+  while (1) {
+    while (!l->abort && l->next < l->count && l->next >= l->linked + l->window)
+      tvh_cond_wait(&l->cond, &l->lock);
+    if (l->abort || l->next >= l->count)
+      break;
+    i = l->next++;
+    tvh_mutex_unlock(&l->lock);
+    r = _epgdb_v4_decode(l, &l->parts[i], i);
+    tvh_mutex_lock(&l->lock);
+    l->parts[i].state = r ? EPGDB_V4_PART_FAILED : EPGDB_V4_PART_DONE;
+    tvh_cond_signal(&l->cond, 1);
+  }
+  tvh_mutex_unlock(&l->lock);
+  return NULL;
+}
+
+static size_t
+_epgdb_v4_load ( const uint8_t *mem, size_t size, epggrab_stats_t *stats )
+{
+  const epgdb_v4_header_t *h;
+  const epgdb_v4_chunk_t *chunks;
+  epgdb_v4_load_t *l;
+  epgdb_v4_part_t *p;
+  pthread_t tids[EPG_DB_V4_THREADS];
+  sigjmp_buf old;
+  htsmsg_t *m;
+  size_t len;
+  long cpus;
+  uint32_t i;
+  int threads;
+
+  if ((chunks = _epgdb_v4_header(mem, size, &h)) == NULL) {
+    tvherror(LS_EPGDB, "corruption detected, invalid header");
+    return 0;
+  }
+
+  /* Config */
+  len = h->config;
+  if (len && !htsmsg_binary2_deserialize(&m, chunks + h->chunks, &len, NULL) && m) {
+    if (epg_config_deserialize(m)) stats->config.total++;
+    htsmsg_destroy(m);
+  }
+  if (h->chunks == 0)
+    return size;
+
+  cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  threads = MIN(MAX(1, MIN(cpus, EPG_DB_V4_THREADS)), h->chunks);
+  tvhinfo(LS_EPGDB, "decoding %u chunks (%d threads)", h->chunks, threads);
+
+  /* builds the language lookup tables before the workers use them */
+  lang_code_preferred();
+
+  l = calloc(1, sizeof(*l));
+  l->mem    = mem;
+  l->size   = size;
+  l->flags  = h->flags;
+  l->chunks = chunks;
+  l->count  = h->chunks;
+  l->parts  = calloc(l->count, sizeof(epgdb_v4_part_t));
+  l->window = 2 * threads;
+  if (threads > 1) {
+    tvh_mutex_init(&l->lock, NULL);
+    tvh_cond_init(&l->cond, 1);
+    for (i = 0; i < threads; i++)
+      tvh_thread_create(&tids[i], NULL, _epgdb_v4_thread, l, "epgdb");
+  }
+
+  memcpy(old, epg_mmap_env, sizeof(old));
+  if (sigsetjmp(epg_mmap_env, 1)) {
+    tvherror(LS_EPGDB, "failed to read from mapped file");
+    l->failed = l->count - l->linked;
+    goto done;
+  }
+
+  while (l->linked < l->count) {
+    p = &l->parts[l->linked];
+    if (threads > 1) {
+      tvh_mutex_lock(&l->lock);
+      while (p->state == EPGDB_V4_PART_WAIT)
+        tvh_cond_wait(&l->cond, &l->lock);
+      tvh_mutex_unlock(&l->lock);
+    } else {
+      p->state = _epgdb_v4_decode(l, p, l->linked) ?
+                   EPGDB_V4_PART_FAILED : EPGDB_V4_PART_DONE;
+    }
+    if (p->state == EPGDB_V4_PART_DONE) {
+      _epgdb_v4_link(p, stats);
+    } else {
+      _epgdb_v4_part_free(p);
+      l->failed++;
+    }
+    if (threads > 1) {
+      tvh_mutex_lock(&l->lock);
+      l->linked++;
+      tvh_cond_signal(&l->cond, 1);
+      tvh_mutex_unlock(&l->lock);
+    } else {
+      l->linked++;
+    }
+  }
+
+done:
+  memcpy(epg_mmap_env, old, sizeof(old));
+  if (threads > 1) {
+    tvh_mutex_lock(&l->lock);
+    l->abort = 1;
+    tvh_cond_signal(&l->cond, 1);
+    tvh_mutex_unlock(&l->lock);
+    for (i = 0; i < threads; i++)
+      pthread_join(tids[i], NULL);
+    tvh_cond_destroy(&l->cond);
+    tvh_mutex_destroy(&l->lock);
+  }
+  for (i = l->linked; i < l->count; i++)
+    _epgdb_v4_part_free(&l->parts[i]);
+  if (l->failed)
+    tvherror(LS_EPGDB, "corruption detected, %u of %u chunks lost",
+             l->failed, l->count);
+  free(l->parts);
+  free(l);
+  return size;
+}
+
+/*
+ * Load one file (snapshot or journal), returns the data size
+ */
+static size_t _epgdb_load ( int fd, int ver, epggrab_stats_t *stats )
+{
+  struct stat st;
+  size_t remain;
+  uint8_t *mem, *rp, *zlib_mem = NULL;
+
+  /* Map file to memory */
+  if ( fstat(fd, &st) != 0 ) {
+    tvherror(LS_EPGDB, "failed to detect database size");
+    return 0;
+  }
+  if ( !st.st_size ) {
+    tvhdebug(LS_EPGDB, "database is empty");
+    return 0;
+  }
+  remain   = st.st_size;
+  rp = mem = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  if ( mem == MAP_FAILED ) {
+    tvherror(LS_EPGDB, "failed to mmap database");
+    return 0;
+  }
+
+  if (sigsetjmp(epg_mmap_env, 1)) {
+    tvherror(LS_EPGDB, "failed to read from mapped file");
+    if (mem)
+      munmap(mem, st.st_size);
+    return 0;
+  }
+
+  /* v4 snapshot is decoded directly from the mapped file */
+  if (ver == 4) {
+    madvise(mem, st.st_size, MADV_WILLNEED);
+    remain = _epgdb_v4_load(mem, remain, stats);
+    munmap(mem, st.st_size);
+    return remain;
+  }
 
-/*
- * Memoryinfo
- */
+  rp = _epgdb_inflate(rp, &remain, &zlib_mem);
 
-static void epg_memoryinfo_broadcasts_update(memoryinfo_t *my)
-{
-  channel_t *ch;
-  epg_broadcast_t *ebc;
-  int64_t size = 0, count = 0;
+  tvhinfo(LS_EPGDB, "parsing %zd bytes", remain);
 
-  CHANNEL_FOREACH(ch) {
-    if (ch->ch_epg_parent) continue;
-    RB_FOREACH(ebc, &ch->ch_epg_schedule, sched_link) {
-      size += sizeof(*ebc);
-      size += tvh_strlen(ebc->image);
-      size += tvh_strlen(ebc->epnum.text);
-      size += lang_str_size(ebc->title);
-      size += lang_str_size(ebc->subtitle);
-      size += lang_str_size(ebc->summary);
-      size += lang_str_size(ebc->description);
-      count++;
-    }
-  }
-  memoryinfo_update(my, size, count);
-}
+  /* Process */
+  if (ver == 3 && _epgdb_parse(rp, remain, _epgdb_v3_process, stats))
+    tvherror(LS_EPGDB, "corruption detected, some/all data lost");
 
-static memoryinfo_t epg_memoryinfo_broadcasts = {
-  .my_name = "EPG Broadcasts",
-  .my_update = epg_memoryinfo_broadcasts_update
-};
+  /* Close file */
+  munmap(mem, st.st_size);
+  free(zlib_mem);
+  return remain;
+}
 
 /*
- * Recovery
+ * Replay the journals of the given version (the old one is left by
+ * an interrupted compaction), the journal records use the v3 format
  */
-static sigjmp_buf epg_mmap_env;
-
-static void epg_mmap_sigbus (int sig, siginfo_t *siginfo, void *ptr)
+static int _epgdb_replay ( int ver, epggrab_stats_t *stats )
 {
-  siglongjmp(epg_mmap_env, 1);
+  char path[PATH_MAX + 16];
+  int fd, i, loaded = 0;
+
+  for (i = 0; i < 2; i++) {
+    _epgdb_path(path, sizeof(path), ver, i ? EPG_JOURNAL : EPG_JOURNAL_OLD);
+    if ((fd = tvh_open(path, O_RDONLY, 0)) < 0)
+      continue;
+    tvhinfo(LS_EPGDB, "replaying journal %s", path);
+    epg_stats.journal_size += _epgdb_load(fd, 3, stats);
+    close(fd);
+    loaded = 1;
+  }
+  return loaded;
 }
 
 /*
@@ -119,16 +1336,16 @@ static void epg_mmap_sigbus (int sig, siginfo_t *siginfo, void *ptr)
  */
 void epg_init ( void )
 {
-  int fd = -1, r;
-  struct stat st;
-  size_t remain;
-  uint8_t *mem, *rp, *zlib_mem = NULL;
+  int fd = -1, loaded = 0, upgrade = 0;
   epggrab_stats_t stats;
   int ver = EPG_DB_VERSION;
   struct sigaction act, oldact;
-  char *sect = NULL;
+  int64_t t0 = getmonoclock();
 
   memoryinfo_register(&epg_memoryinfo_broadcasts);
+  epg_fts_init();
+  gtimer_arm_rel(&epg_journal_timer, epg_journal_callback, NULL,
+                 EPG_JOURNAL_INTERVAL);
 
   /* Find the right file (and version) */
   while (fd < 0 && ver > 0) {
@@ -138,92 +1355,39 @@ void epg_init ( void )
   }
   if ( fd < 0 )
     fd = hts_settings_open_file(0, "epgdb");
-  if ( fd < 0 ) {
+  if ( fd < 0 )
     tvhdebug(LS_EPGDB, "database does not exist");
-    return;
-  }
 
   memset (&act, 0, sizeof(act));
   act.sa_sigaction = epg_mmap_sigbus;
   act.sa_flags = SA_SIGINFO;
   if (sigaction(SIGBUS, &act, &oldact)) {
     tvherror(LS_EPGDB, "failed to install SIGBUS handler");
-    close(fd);
+    if (fd >= 0)
+      close(fd);
     return;
   }
-  
-  /* Map file to memory */
-  if ( fstat(fd, &st) != 0 ) {
-    tvherror(LS_EPGDB, "failed to detect database size");
-    goto end;
-  }
-  if ( !st.st_size ) {
-    tvhdebug(LS_EPGDB, "database is empty");
-    goto end;
-  }
-  remain   = st.st_size;
-  rp = mem = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
-  if ( mem == MAP_FAILED ) {
-    tvherror(LS_EPGDB, "failed to mmap database");
-    goto end;
-  }
-
-  if (sigsetjmp(epg_mmap_env, 1)) {
-    tvherror(LS_EPGDB, "failed to read from mapped file");
-    if (mem)
-      munmap(mem, st.st_size);
-    goto end;
-  }
-
-#if ENABLE_ZLIB
-  if (remain > 12 && memcmp(rp, "\xff\xffGZIP01", 8) == 0 &&
-      (rp[7] == '0' || rp[7] == '1')) {
-    uint32_t orig = (rp[8] << 24) | (rp[9] << 16) | (rp[10] << 8) | rp[11];
-    tvhinfo(LS_EPGDB, "gzip format detected, inflating (ratio %.1f%% deflated size %zd)",
-           (float)((remain * 100.0) / orig), remain);
-    rp = zlib_mem = tvh_gzip_inflate(rp + 12, remain - 12, orig);
-    remain = rp ? orig : 0;
-  }
-#endif
-
-  tvhinfo(LS_EPGDB, "parsing %zd bytes", remain);
 
-  /* Process */
   memset(&stats, 0, sizeof(stats));
-  while ( remain > 4 ) {
-
-    /* Get message length */
-    size_t msglen = remain;
-    htsmsg_t *m;
-    r = htsmsg_binary2_deserialize(&m, rp, &msglen, NULL);
 
-    /* Safety check */
-    if (r) {
-      tvherror(LS_EPGDB, "corruption detected, some/all data lost");
-      break;
-    }
-
-    /* Next */
-    rp     += msglen;
-    remain -= msglen;
-
-    /* Skip */
-    if (!m) continue;
-
-    /* Process */
-    switch (ver) {
-      case 3:
-        _epgdb_v3_process(&sect, m, &stats);
-        break;
-      default:
-        break;
-    }
+  /* Snapshot */
+  if (fd >= 0) {
+    atomic_set_s64(&epg_snapshot_size, _epgdb_load(fd, ver, &stats));
+    close(fd);
+    loaded = 1;
+  }
 
-    /* Cleanup */
-    htsmsg_destroy(m);
+  /* Journals (v3 data are converted by the next compaction) */
+  if (ver != EPG_DB_VERSION) {
+    upgrade = _epgdb_replay(3, &stats) || ver == 3;
+    loaded |= upgrade;
   }
+  loaded |= _epgdb_replay(EPG_DB_VERSION, &stats);
 
-  free(sect);
+  sigaction(SIGBUS, &oldact, NULL);
+
+  if (!loaded)
+    return;
 
   if (!stats.config.total) {
     htsmsg_t *m = htsmsg_create_map();
@@ -235,16 +1399,16 @@ void epg_init ( void )
   }
 
   /* Stats */
-  tvhinfo(LS_EPGDB, "loaded v%d", ver);
+  tvhinfo(LS_EPGDB, "loaded v%d (%"PRId64" ms)", ver, (getmonoclock() - t0) / 1000);
   tvhinfo(LS_EPGDB, "  config     %d", stats.config.total);
   tvhinfo(LS_EPGDB, "  broadcasts %d", stats.broadcasts.total);
+  if (stats.broadcasts.modified)
+    tvhinfo(LS_EPGDB, "  removed    %d", stats.broadcasts.modified);
 
-  /* Close file */
-  munmap(mem, st.st_size);
-  free(zlib_mem);
-end:
-  sigaction(SIGBUS, &oldact, NULL);
-  close(fd);
+  if (upgrade) {
+    tvhinfo(LS_EPGDB, "converting database to v%d", EPG_DB_VERSION);
+    epg_compact();
+  }
 }
 
 void epg_done ( void )
@@ -252,9 +1416,14 @@ void epg_done ( void )
   channel_t *ch;
 
   tvh_mutex_lock(&global_lock);
+  gtimer_disarm(&epg_journal_timer);
   CHANNEL_FOREACH(ch)
     epg_channel_unlink(ch);
   epg_skel_done();
+  epg_fts_done();
+  free(epg_journal_deleted);
+  epg_journal_deleted = NULL;
+  epg_journal_deleted_count = epg_journal_deleted_alloc = 0;
   memoryinfo_unregister(&epg_memoryinfo_broadcasts);
   tvh_mutex_unlock(&global_lock);
 }
@@ -274,10 +1443,7 @@ static int _epg_write ( sbuf_t *sb, htsmsg_t *m )
     htsmsg_destroy(m);
     if (!r) {
       ret = 0;
-      /* allocation helper - we fight with megabytes */
-      if (sb->sb_size - sb->sb_ptr < 32 * 1024)
-        sbuf_realloc(sb, (sb->sb_size - (sb->sb_size % EPG_DB_ALLOC_STEP)) + EPG_DB_ALLOC_STEP);
-      sbuf_append(sb, msgdata, msglen);
+      _epg_write_raw(sb, msgdata, msglen);
       free(msgdata);
     }
   } else {
@@ -293,93 +1459,445 @@ static int _epg_write_sect ( sbuf_t *sb, const char *sect )
   return _epg_write(sb, m);
 }
 
-static void epg_save_tsk_callback ( void *p, int dearmed )
+/*
+ * Journal write (tasklet)
+ */
+static void epg_journal_tsk_callback ( void *p, int dearmed )
 {
-  char tmppath[PATH_MAX+4];
-  char path[PATH_MAX];
+  char path[PATH_MAX + 16];
   sbuf_t *sb = p;
-  size_t size = sb->sb_ptr, orig;
-  int fd, r;
+  off_t off = 0;
+  int fd, r = 1;
 
-  tvhinfo(LS_EPGDB, "save start");
-  hts_settings_buildpath(tmppath, sizeof(path), "epgdb.v%d", EPG_DB_VERSION);
-  if (!realpath(tmppath, path))
-    strlcpy(path, tmppath, sizeof(path));
-  snprintf(tmppath, sizeof(tmppath), "%s.tmp", path);
-  if (hts_settings_makedirs(tmppath))
+  _epgdb_path(path, sizeof(path), EPG_DB_VERSION, EPG_JOURNAL);
+  if (hts_settings_makedirs(path))
     fd = -1;
   else
-    fd = tvh_open(tmppath, O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR);
+    fd = tvh_open(path, O_CREAT | O_APPEND | O_WRONLY, S_IRUSR | S_IWUSR);
   if (fd >= 0) {
-#if ENABLE_ZLIB
-    if (config.epg_compress) {
-      r = tvh_gzip_deflate_fd_header(fd, sb->sb_data, size, &orig, 3, "01") < 0;
-   } else
-#endif
-      r = tvh_write(fd, sb->sb_data, orig = size);
+    off = lseek(fd, 0, SEEK_END);
+    r = tvh_write(fd, sb->sb_data, sb->sb_ptr);
+    /* do not leave a partial record, the records behind would be lost */
+    if (r && off >= 0 && ftruncate(fd, off))
+      tvherror(LS_EPGDB, "unable to truncate journal %s", path);
     close(fd);
-    if (r) {
-      tvherror(LS_EPGDB, "write error (size %zd)", orig);
-      if (remove(tmppath))
-        tvherror(LS_EPGDB, "unable to remove file %s", tmppath);
-    } else {
-      tvhinfo(LS_EPGDB, "stored (size %zd)", orig);
-      if (rename(tmppath, path))
-        tvherror(LS_EPGDB, "unable to rename file %s to %s", tmppath, path);
-    }
-  } else
-    tvherror(LS_EPGDB, "unable to open epgdb file");
+  }
+  if (r)
+    tvherror(LS_EPGDB, "journal write error (size %d)", sb->sb_ptr);
   sbuf_free(sb);
   free(sb);
 }
 
-void epg_save_callback ( void *p )
+/*
+ * Append the changes since the last write to the journal. Only the
+ * serialization runs under global_lock, the file is written by a tasklet.
+ * The removals go first: a broadcast created in place of a removed one
+ * (same start) must not be merged with it on replay.
+ */
+static void epg_journal_write ( void )
 {
-  epg_save();
+  sbuf_t *sb;
+  htsmsg_t *m;
+  epg_broadcast_t *ebc;
+  uint32_t i, count = 0, removed = epg_journal_deleted_count;
+  int64_t t0;
+  int size;
+
+  lock_assert(&global_lock);
+
+  if (LIST_EMPTY(&epg_journal_dirty) && epg_journal_deleted_count == 0)
+    return;
+  if ((sb = malloc(sizeof(*sb))) == NULL)
+    return;
+
+  t0 = getmonoclock();
+  sbuf_init_fixed(sb, 64 * 1024);
+  _epg_write_sect(sb, "config");
+  _epg_write(sb, epg_config_serialize());
+  if (epg_journal_deleted_count) {
+    _epg_write_sect(sb, "deleted");
+    for (i = 0; i < epg_journal_deleted_count; i++) {
+      m = htsmsg_create_map();
+      htsmsg_add_u32(m, "id", epg_journal_deleted[i]);
+      _epg_write(sb, m);
+    }
+    epg_journal_deleted_count = 0;
+  }
+  if (!LIST_EMPTY(&epg_journal_dirty)) {
+    _epg_write_sect(sb, "broadcasts");
+    while ((ebc = LIST_FIRST(&epg_journal_dirty)) != NULL) {
+      LIST_SAFE_REMOVE(ebc, journal_link);
+      if (_epg_write(sb, epg_broadcast_serialize(ebc)))
+        tvherror(LS_EPGDB, "failed to journal broadcast %u", ebc->id);
+      count++;
+    }
+  }
+  size = sb->sb_ptr;
+  epg_stats.journal_size += size;
+  epg_stats.writes++;
+  tasklet_arm_alloc(epg_journal_tsk_callback, sb);
+
+  epg_stats.lock_last = getmonoclock() - t0;
+  if (epg_stats.lock_last > epg_stats.lock_max)
+    epg_stats.lock_max = epg_stats.lock_last;
+  tvhdebug(LS_EPGDB, "journal %u broadcasts, %u removed (size %d, %"PRId64" us)",
+           count, removed, size, epg_stats.lock_last);
 }
 
-void epg_save ( void )
+void epg_journal_update ( epg_broadcast_t *ebc )
 {
-  sbuf_t *sb = malloc(sizeof(*sb));
-  epg_broadcast_t *ebc;
-  channel_t *ch;
-  epggrab_stats_t stats;
-  extern gtimer_t epggrab_save_timer;
+  if (epg_in_load || !tvheadend_is_running())
+    return;
+  if (LIST_SAFE_ENTRY(ebc, journal_link))
+    LIST_INSERT_HEAD(&epg_journal_dirty, ebc, journal_link);
+}
 
-  if (!sb)
+void epg_journal_remove ( epg_broadcast_t *ebc )
+{
+  LIST_SAFE_REMOVE(ebc, journal_link);
+  /* not stored yet or the whole EPG is going away */
+  if (epg_in_load || !ebc->_created || !tvheadend_is_running())
     return;
+  if (epg_journal_deleted_count == epg_journal_deleted_alloc) {
+    epg_journal_deleted_alloc = MAX(1024, epg_journal_deleted_alloc * 2);
+    epg_journal_deleted = realloc(epg_journal_deleted,
+                                  epg_journal_deleted_alloc * sizeof(uint32_t));
+  }
+  epg_journal_deleted[epg_journal_deleted_count++] = ebc->id;
+}
 
-  tvhinfo(LS_EPGDB, "snapshot start");
+/*
+ * Compaction - merge the snapshot with the journal (tasklet, it uses
+ * only the files, the in-memory EPG is not touched)
+ */
+typedef struct epgdb_jentry {
+  uint32_t       id;
+  uint32_t       seq;        /* journal order */
+  int64_t        stop;
+  const uint8_t *data;       /* NULL - removed */
+  size_t         len;
+  int            used;
+} epgdb_jentry_t;
 
-  sbuf_init_fixed(sb, EPG_DB_ALLOC_STEP);
+typedef struct epgdb_compact {
+  epgdb_jentry_t    *entries;
+  uint32_t           count;
+  uint32_t           alloc;
+  const uint8_t     *config;
+  size_t             config_len;
+  epgdb_v4_writer_t  w;
+  int64_t            now;
+} epgdb_compact_t;
 
-  if (epggrab_conf.epgdb_periodicsave)
-    gtimer_arm_rel(&epggrab_save_timer, epg_save_callback, NULL,
-                   epggrab_conf.epgdb_periodicsave * 3600);
+static int _epgdb_jentry_cmp ( const void *a, const void *b )
+{
+  const epgdb_jentry_t *x = a, *y = b;
+  if (x->id != y->id)
+    return x->id < y->id ? -1 : 1;
+  return x->seq < y->seq ? -1 : (x->seq > y->seq);
+}
 
-  memset(&stats, 0, sizeof(stats));
-  if ( _epg_write_sect(sb, "config") ) goto error;
-  if (_epg_write(sb, epg_config_serialize())) goto error;
-  if ( _epg_write_sect(sb, "broadcasts") ) goto error;
-  CHANNEL_FOREACH(ch) {
-    if (ch->ch_epg_parent) continue;
-    RB_FOREACH(ebc, &ch->ch_epg_schedule, sched_link) {
-      if (_epg_write(sb, epg_broadcast_serialize(ebc))) goto error;
-      stats.broadcasts.total++;
+static int _epgdb_jentry_id_cmp ( const void *a, const void *b )
+{
+  const epgdb_jentry_t *x = a, *y = b;
+  return x->id < y->id ? -1 : (x->id > y->id);
+}
+
+static epgdb_jentry_t *_epgdb_compact_find ( epgdb_compact_t *c, uint32_t id )
+{
+  epgdb_jentry_t skel, *e;
+
+  skel.id = id;
+  e = bsearch(&skel, c->entries, c->count, sizeof(*e), _epgdb_jentry_id_cmp);
+  if (e)
+    e->used = 1;
+  return e;
+}
+
+/*
+ * Add the last journaled state of the broadcast
+ */
+static void _epgdb_compact_entry ( epgdb_compact_t *c, epgdb_jentry_t *e )
+{
+  htsmsg_t *m;
+  size_t len = e->len;
+
+  if (e->data == NULL || e->stop <= c->now)
+    return;
+  if (!htsmsg_binary2_deserialize(&m, e->data, &len, NULL) && m) {
+    _epgdb_v4_add_msg(&c->w, m);
+    htsmsg_destroy(m);
+  }
+}
+
+static void
+_epgdb_compact_journal
+  ( void *aux, const char *sect, htsmsg_t *m, const uint8_t *data, size_t len )
+{
+  epgdb_compact_t *c = aux;
+  epgdb_jentry_t *e;
+  uint32_t id;
+  int del;
+
+  if (!strcmp(sect, "config")) {
+    c->config = data;
+    c->config_len = len;
+    return;
+  }
+  del = !strcmp(sect, "deleted");
+  if ((!del && strcmp(sect, "broadcasts")) || htsmsg_get_u32(m, "id", &id))
+    return;
+  if (c->count == c->alloc) {
+    c->alloc = MAX(1024, c->alloc * 2);
+    c->entries = realloc(c->entries, c->alloc * sizeof(*e));
+  }
+  e = &c->entries[c->count];
+  e->id = id;
+  e->seq = c->count++;
+  e->data = del ? NULL : data;
+  e->len = len;
+  e->used = 0;
+  if (del || htsmsg_get_s64(m, "stop", &e->stop))
+    e->stop = 0;
+}
+
+/*
+ * v3 snapshot (conversion)
+ */
+static void
+_epgdb_compact_v3
+  ( void *aux, const char *sect, htsmsg_t *m, const uint8_t *data, size_t len )
+{
+  epgdb_compact_t *c = aux;
+  epgdb_jentry_t *e;
+  uint32_t id;
+  int64_t stop;
+
+  if (!strcmp(sect, "config")) {
+    if (c->config == NULL) {
+      c->config = data;
+      c->config_len = len;
+    }
+    return;
+  }
+  if (strcmp(sect, "broadcasts") || htsmsg_get_u32(m, "id", &id))
+    return;
+  if ((e = _epgdb_compact_find(c, id)) != NULL)
+    _epgdb_compact_entry(c, e);
+  else if (!htsmsg_get_s64(m, "stop", &stop) && stop > c->now)
+    _epgdb_v4_add_msg(&c->w, m);
+}
+
+/*
+ * v4 snapshot - the unchanged records are copied without the htsmsg
+ */
+static int
+_epgdb_compact_v4 ( epgdb_compact_t *c, const uint8_t *mem, size_t size )
+{
+  const epgdb_v4_header_t *h;
+  const epgdb_v4_chunk_t *chunks;
+  const epgdb_v4_rec_t *r;
+  const uint8_t *data;
+  epgdb_v4_view_t v;
+  epgdb_jentry_t *e;
+  uint8_t *zlib_mem;
+  uint32_t i, j;
+  int ret = 0;
+
+  if ((chunks = _epgdb_v4_header(mem, size, &h)) == NULL)
+    return -1;
+  if (c->config == NULL && h->config) {
+    c->config = (const uint8_t *)(chunks + h->chunks);
+    c->config_len = h->config;
+  }
+  for (i = 0; i < h->chunks; i++) {
+    zlib_mem = NULL;
+    data = _epgdb_v4_chunk(mem, size, h->flags, &chunks[i], &zlib_mem);
+    if (data == NULL || _epgdb_v4_view(&v, data, chunks[i].orig)) {
+      free(zlib_mem);
+      ret = -1;
+      continue;
+    }
+    for (j = 0; j < v.count; j++) {
+      r = &v.recs[j];
+      if ((e = _epgdb_compact_find(c, r->id)) != NULL)
+        _epgdb_compact_entry(c, e);
+      else if (r->stop > c->now)
+        _epgdb_v4_copy(&c->w, &v, r);
     }
+    free(zlib_mem);
   }
+  return ret;
+}
 
-  tasklet_arm_alloc(epg_save_tsk_callback, sb);
+/*
+ * Move the journal aside, the next writes go to a fresh file. The journal
+ * of a failed compaction is kept and the new records are appended to it.
+ */
+static int _epgdb_rotate ( const char *jpath, const char *opath )
+{
+  uint8_t *buf;
+  size_t len;
+  int fd, r;
 
-  /* Stats */
-  tvhinfo(LS_EPGDB, "queued to save (size %d)", sb->sb_ptr);
-  tvhinfo(LS_EPGDB, "  broadcasts %d", stats.broadcasts.total);
+  if (access(opath, F_OK)) {
+    if (rename(jpath, opath) && errno != ENOENT) {
+      tvherror(LS_EPGDB, "unable to rename file %s to %s", jpath, opath);
+      return -1;
+    }
+    return 0;
+  }
+  if ((buf = _epgdb_read(jpath, &len)) == NULL)
+    return 0;
+  fd = tvh_open(opath, O_WRONLY | O_APPEND, 0);
+  r = fd < 0 || tvh_write(fd, buf, len);
+  if (fd >= 0)
+    close(fd);
+  free(buf);
+  if (r) {
+    tvherror(LS_EPGDB, "unable to append journal to %s", opath);
+    return -1;
+  }
+  unlink(jpath);
+  return 0;
+}
+
+static void epg_compact_tsk_callback ( void *p, int dearmed )
+{
+  char path[PATH_MAX + 16], jpath[PATH_MAX + 16], opath[PATH_MAX + 16];
+  char v3path[3][PATH_MAX + 16];
+  epgdb_compact_t c;
+  uint8_t *jbuf[3], *buf, *rp, *zlib_mem = NULL, *config = NULL;
+  size_t jlen, jsize = 0, len = 0;
+  uint32_t i, j;
+  int upgrade, r = 0;
+  int64_t t0 = getmonoclock();
 
-  return;
+  _epgdb_path(path, sizeof(path), EPG_DB_VERSION, "");
+  _epgdb_path(jpath, sizeof(jpath), EPG_DB_VERSION, EPG_JOURNAL);
+  _epgdb_path(opath, sizeof(opath), EPG_DB_VERSION, EPG_JOURNAL_OLD);
+  _epgdb_path(v3path[0], sizeof(v3path[0]), 3, EPG_JOURNAL_OLD);
+  _epgdb_path(v3path[1], sizeof(v3path[1]), 3, EPG_JOURNAL);
+  _epgdb_path(v3path[2], sizeof(v3path[2]), 3, "");
 
-error:
-  tvherror(LS_EPGDB, "failed to store epg to disk");
-  hts_settings_remove("epgdb.v%d", EPG_DB_VERSION);
-  sbuf_free(sb);
-  free(sb);
+  /* the v3 files are merged until the first v4 snapshot is stored */
+  upgrade = access(path, F_OK) != 0 &&
+            (!access(v3path[0], F_OK) || !access(v3path[1], F_OK) ||
+             !access(v3path[2], F_OK));
+
+  if (_epgdb_rotate(jpath, opath))
+    return;
+
+  /* Journals in the write order */
+  memset(&c, 0, sizeof(c));
+  c.now = gclk();
+  memset(jbuf, 0, sizeof(jbuf));
+  for (i = upgrade ? 0 : 2; i < 3; i++) {
+    if ((jbuf[i] = _epgdb_read(i < 2 ? v3path[i] : opath, &jlen)) == NULL)
+      continue;
+    jsize += jlen;
+    if (_epgdb_parse(jbuf[i], jlen, _epgdb_compact_journal, &c))
+      tvhwarn(LS_EPGDB, "journal corruption detected, some data lost");
+  }
+  if (!upgrade && jbuf[2] == NULL)
+    return;
+
+  tvhinfo(LS_EPGDB, "compaction start (journal size %zd%s)", jsize,
+          upgrade ? ", conversion to v4" : "");
+
+  /* Last state of each journaled broadcast */
+  qsort(c.entries, c.count, sizeof(*c.entries), _epgdb_jentry_cmp);
+  for (i = j = 0; i < c.count; i++) {
+    if (j > 0 && c.entries[j-1].id == c.entries[i].id)
+      c.entries[j-1] = c.entries[i];
+    else
+      c.entries[j++] = c.entries[i];
+  }
+  c.count = j;
+
+  /* Merge */
+  if (upgrade) {
+    rp = buf = _epgdb_read(v3path[2], &len);
+    if (buf)
+      rp = _epgdb_inflate(buf, &len, &zlib_mem);
+    _epgdb_v4_writer_init(&c.w, len / 2 + jsize);
+    if (rp && _epgdb_parse(rp, len, _epgdb_compact_v3, &c))
+      r = -1;
+  } else {
+    buf = _epgdb_read(path, &len);
+    _epgdb_v4_writer_init(&c.w, len + jsize);
+    if (buf && _epgdb_compact_v4(&c, buf, len))
+      r = -1;
+  }
+  if (r)
+    tvhwarn(LS_EPGDB, "snapshot corruption detected, some data lost");
+  for (i = 0; i < c.count; i++)
+    if (!c.entries[i].used)
+      _epgdb_compact_entry(&c, &c.entries[i]);
+
+  /* the config is pointing to the buffers */
+  if (c.config && (config = malloc(c.config_len)) != NULL)
+    memcpy(config, c.config, c.config_len);
+  free(zlib_mem);
+  free(buf);
+  for (i = 0; i < 3; i++)
+    free(jbuf[i]);
+
+  if (!_epgdb_v4_store(path, &c.w, config, config ? c.config_len : 0)) {
+    if (unlink(opath) && errno != ENOENT)
+      tvherror(LS_EPGDB, "unable to remove file %s", opath);
+    for (i = 0; upgrade && i < 3; i++)
+      if (unlink(v3path[i]) && errno != ENOENT)
+        tvherror(LS_EPGDB, "unable to remove file %s", v3path[i]);
+    atomic_add(&epg_stats.compactions, 1);
+    tvhinfo(LS_EPGDB, "compaction done (broadcasts %d, %"PRId64" ms)",
+            c.w.broadcasts, (getmonoclock() - t0) / 1000);
+  }
+  _epgdb_v4_writer_done(&c.w);
+  free(config);
+  free(c.entries);
+}
+
+static void epg_compact ( void )
+{
+  epg_stats.journal_size = 0;
+  tasklet_arm_alloc(epg_compact_tsk_callback, NULL);
+}
+
+static void epg_journal_callback ( void *p )
+{
+  epg_journal_write();
+  if (epg_stats.journal_size >
+        MAX(EPG_JOURNAL_COMPACT, atomic_get_s64(&epg_snapshot_size) / 2))
+    epg_compact();
+  gtimer_arm_rel(&epg_journal_timer, epg_journal_callback, NULL,
+                 EPG_JOURNAL_INTERVAL);
+}
+
+void epg_save_callback ( void *p )
+{
+  epg_save();
+}
+
+/*
+ * Write the pending changes and merge the journal into the snapshot
+ */
+void epg_save ( void )
+{
+  extern gtimer_t epggrab_save_timer;
+
+  if (epggrab_conf.epgdb_periodicsave)
+    gtimer_arm_rel(&epggrab_save_timer, epg_save_callback, NULL,
+                   epggrab_conf.epgdb_periodicsave * 3600);
+
+  epg_journal_write();
+  tvhinfo(LS_EPGDB, "save (journal size %"PRId64")", epg_stats.journal_size);
+  if (epg_stats.journal_size)
+    epg_compact();
+}
+
+void epg_save_get_stats ( epg_save_stats_t *st )
+{
+  *st = epg_stats;
+  st->compactions = atomic_get(&epg_stats.compactions);
 }
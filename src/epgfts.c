@@ -0,0 +1,723 @@
+/*
+ *  Electronic Program Guide - Full-text index
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Inverted index of the broadcast texts (title, subtitle, summary,
+ * description, credits and keywords, all languages). The texts are
+ * split to words made of ASCII letters, digits and UTF-8 sequences,
+ * ASCII letters are lowered. Each word has two sorted lists of the
+ * broadcast ids - the titles and all texts.
+ *
+ * The index only narrows the candidates for the literal (no regex
+ * operators) searches, epg_query() still matches each of them.
+ */
+
+#include <string.h>
+
+#include "tvheadend.h"
+#include "channels.h"
+#include "epg.h"
+#include "memoryinfo.h"
+
+#define EPG_FTS_TITLE    0x80000000U
+#define EPG_FTS_ID_MASK  0x7fffffffU
+#define EPG_FTS_BLOCK    512
+#define EPG_FTS_PENDING  1           /* fts_hash - waiting for the bulk indexing */
+
+typedef struct epg_fts_ids {
+  uint32_t *ids;
+  uint32_t  count;
+  uint32_t  alloc;
+} epg_fts_ids_t;
+
+/*
+ * Sorted broadcast ids split to blocks, so the updates move only
+ * a block (the common words have hundred thousands of broadcasts)
+ */
+typedef struct epg_fts_block {
+  uint32_t count;
+  uint32_t alloc;
+  uint32_t ids[0];
+} epg_fts_block_t;
+
+typedef struct epg_fts_list {
+  epg_fts_block_t **blocks;
+  uint32_t          nblocks;
+  uint32_t          count;
+} epg_fts_list_t;
+
+typedef struct epg_fts_token {
+  RB_ENTRY(epg_fts_token) link;
+  LIST_ENTRY(epg_fts_token) hash_link;
+  uint32_t       hash;
+  uint32_t       id;
+  epg_fts_list_t title;
+  epg_fts_list_t text;
+  char           str[0];
+} epg_fts_token_t;
+
+typedef struct epg_fts_word {
+  uint32_t off;
+  uint32_t flags;
+} epg_fts_word_t;
+
+static RB_HEAD(, epg_fts_token) epg_fts_tokens;       /* prefix scans */
+static LIST_HEAD(, epg_fts_token) *epg_fts_hash;       /* exact lookups */
+static uint32_t epg_fts_hash_mask;
+static epg_fts_token_t **epg_fts_table;
+static uint32_t epg_fts_table_count, epg_fts_table_alloc;
+static epg_fts_ids_t epg_fts_unused;
+static epg_fts_ids_t epg_fts_pending;
+static int64_t epg_fts_entries;
+
+/* Word scratch (global_lock) */
+static char *epg_fts_buf;
+static size_t epg_fts_buf_len, epg_fts_buf_alloc;
+static epg_fts_word_t *epg_fts_words;
+static uint32_t epg_fts_words_count, epg_fts_words_alloc;
+
+/* **************************************************************************
+ * Id arrays
+ * *************************************************************************/
+
+static void epg_fts_ids_grow ( epg_fts_ids_t *a, uint32_t count )
+{
+  if (count <= a->alloc) return;
+  a->alloc = MAX(count, MAX(16, a->alloc * 2));
+  a->ids = realloc(a->ids, a->alloc * sizeof(uint32_t));
+}
+
+static int epg_fts_id_cmp ( const void *a, const void *b )
+{
+  uint32_t x = *(uint32_t *)a, y = *(uint32_t *)b;
+  return x < y ? -1 : (x > y);
+}
+
+/* Sort and remove duplicates */
+static void epg_fts_ids_unique ( epg_fts_ids_t *a )
+{
+  uint32_t i, j;
+
+  if (a->count < 2) return;
+  qsort(a->ids, a->count, sizeof(uint32_t), epg_fts_id_cmp);
+  for (i = j = 1; i < a->count; i++)
+    if (a->ids[i] != a->ids[j - 1])
+      a->ids[j++] = a->ids[i];
+  a->count = j;
+}
+
+/* Keep only ids present in both (sorted) arrays */
+static void epg_fts_ids_intersect ( epg_fts_ids_t *a, epg_fts_ids_t *o )
+{
+  uint32_t i = 0, j = 0, k = 0;
+
+  while (i < a->count && j < o->count) {
+    if (a->ids[i] < o->ids[j]) {
+      i++;
+    } else if (a->ids[i] > o->ids[j]) {
+      j++;
+    } else {
+      a->ids[k++] = a->ids[i++];
+      j++;
+    }
+  }
+  a->count = k;
+}
+
+/* **************************************************************************
+ * Id lists
+ * *************************************************************************/
+
+static uint32_t epg_fts_block_lower ( epg_fts_block_t *b, uint32_t id )
+{
+  uint32_t lo = 0, hi = b->count, mid;
+
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    if (b->ids[mid] < id)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+/* The block which holds (or should hold) the id */
+static uint32_t epg_fts_list_block ( epg_fts_list_t *l, uint32_t id )
+{
+  uint32_t lo = 0, hi = l->nblocks, mid;
+  epg_fts_block_t *b;
+
+  if (hi <= 1) return 0;
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    b = l->blocks[mid];
+    if (b->ids[b->count - 1] < id)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo < l->nblocks ? lo : l->nblocks - 1;
+}
+
+static void epg_fts_list_insert_block
+  ( epg_fts_list_t *l, uint32_t bi, epg_fts_block_t *b )
+{
+  l->blocks = realloc(l->blocks, (l->nblocks + 1) * sizeof(epg_fts_block_t *));
+  memmove(l->blocks + bi + 1, l->blocks + bi,
+          (l->nblocks - bi) * sizeof(epg_fts_block_t *));
+  l->blocks[bi] = b;
+  l->nblocks++;
+}
+
+static void epg_fts_list_add ( epg_fts_list_t *l, uint32_t id )
+{
+  epg_fts_block_t *b, *b2;
+  uint32_t bi, i, half;
+
+  if (l->nblocks == 0) {
+    b = malloc(sizeof(*b) + 4 * sizeof(uint32_t));
+    b->count = 0;
+    b->alloc = 4;
+    epg_fts_list_insert_block(l, 0, b);
+  }
+  bi = l->nblocks - 1;
+  b = l->blocks[bi];
+  /* append (the bulk indexing goes in the ascending order) */
+  if (b->count > 0 && b->ids[b->count - 1] < id) {
+    i = b->count;
+    if (i == EPG_FTS_BLOCK) {
+      b = malloc(sizeof(*b) + EPG_FTS_BLOCK * sizeof(uint32_t));
+      b->count = i = 0;
+      b->alloc = EPG_FTS_BLOCK;
+      epg_fts_list_insert_block(l, ++bi, b);
+    }
+  } else {
+    bi = epg_fts_list_block(l, id);
+    b = l->blocks[bi];
+    i = epg_fts_block_lower(b, id);
+    if (i < b->count && b->ids[i] == id) return;
+  }
+  if (b->count == b->alloc) {
+    if (b->alloc < EPG_FTS_BLOCK) {
+      b->alloc = MIN(EPG_FTS_BLOCK, b->alloc * 2);
+      b = realloc(b, sizeof(*b) + b->alloc * sizeof(uint32_t));
+      l->blocks[bi] = b;
+    } else {
+      half = b->count / 2;
+      b2 = malloc(sizeof(*b2) + EPG_FTS_BLOCK * sizeof(uint32_t));
+      b2->alloc = EPG_FTS_BLOCK;
+      b2->count = b->count - half;
+      memcpy(b2->ids, b->ids + half, b2->count * sizeof(uint32_t));
+      b->count = half;
+      epg_fts_list_insert_block(l, bi + 1, b2);
+      if (i > half) {
+        b = b2;
+        i -= half;
+      }
+    }
+  }
+  memmove(b->ids + i + 1, b->ids + i, (b->count - i) * sizeof(uint32_t));
+  b->ids[i] = id;
+  b->count++;
+  l->count++;
+}
+
+static void epg_fts_list_rem ( epg_fts_list_t *l, uint32_t id )
+{
+  epg_fts_block_t *b;
+  uint32_t bi, i;
+
+  if (l->nblocks == 0) return;
+  bi = epg_fts_list_block(l, id);
+  b = l->blocks[bi];
+  i = epg_fts_block_lower(b, id);
+  if (i >= b->count || b->ids[i] != id) return;
+  b->count--;
+  l->count--;
+  memmove(b->ids + i, b->ids + i + 1, (b->count - i) * sizeof(uint32_t));
+  if (b->count == 0) {
+    free(b);
+    l->nblocks--;
+    memmove(l->blocks + bi, l->blocks + bi + 1,
+            (l->nblocks - bi) * sizeof(epg_fts_block_t *));
+    if (l->nblocks == 0) {
+      free(l->blocks);
+      l->blocks = NULL;
+    }
+  } else if (b->alloc > 16 && b->count < b->alloc / 4) {
+    b->alloc /= 2;
+    l->blocks[bi] = realloc(b, sizeof(*b) + b->alloc * sizeof(uint32_t));
+  }
+}
+
+static void epg_fts_list_free ( epg_fts_list_t *l )
+{
+  uint32_t i;
+
+  for (i = 0; i < l->nblocks; i++)
+    free(l->blocks[i]);
+  free(l->blocks);
+  memset(l, 0, sizeof(*l));
+}
+
+static int64_t epg_fts_list_size ( epg_fts_list_t *l )
+{
+  int64_t size = l->nblocks * sizeof(epg_fts_block_t *);
+  uint32_t i;
+
+  for (i = 0; i < l->nblocks; i++)
+    size += sizeof(epg_fts_block_t) + l->blocks[i]->alloc * sizeof(uint32_t);
+  return size;
+}
+
+static void epg_fts_list_append ( epg_fts_ids_t *a, epg_fts_list_t *l )
+{
+  epg_fts_block_t *b;
+  uint32_t i;
+
+  epg_fts_ids_grow(a, a->count + l->count);
+  for (i = 0; i < l->nblocks; i++) {
+    b = l->blocks[i];
+    memcpy(a->ids + a->count, b->ids, b->count * sizeof(uint32_t));
+    a->count += b->count;
+  }
+}
+
+/* **************************************************************************
+ * Tokens
+ * *************************************************************************/
+
+static int _token_cmp ( const void *a, const void *b )
+{
+  return strcmp(((epg_fts_token_t *)a)->str, ((epg_fts_token_t *)b)->str);
+}
+
+static inline uint32_t epg_fts_token_hash ( const char *str )
+{
+  uint32_t hash = 2166136261U;
+  for ( ; *str; str++)
+    hash = (hash ^ (uint8_t)*str) * 16777619U;
+  return hash;
+}
+
+static void epg_fts_hash_grow ( void )
+{
+  epg_fts_token_t *t;
+  uint32_t size = (epg_fts_hash_mask + 1) * 2;
+
+  free(epg_fts_hash);
+  epg_fts_hash = calloc(size, sizeof(*epg_fts_hash));
+  epg_fts_hash_mask = size - 1;
+  RB_FOREACH(t, &epg_fts_tokens, link)
+    LIST_INSERT_HEAD(&epg_fts_hash[t->hash & epg_fts_hash_mask], t, hash_link);
+}
+
+static epg_fts_token_t *epg_fts_token_find ( const char *str, int create )
+{
+  epg_fts_token_t *t;
+  uint32_t hash = epg_fts_token_hash(str);
+  size_t l;
+
+  LIST_FOREACH(t, &epg_fts_hash[hash & epg_fts_hash_mask], hash_link)
+    if (t->hash == hash && strcmp(t->str, str) == 0)
+      return t;
+  if (!create) return NULL;
+
+  l = strlen(str) + 1;
+  t = calloc(1, sizeof(*t) + l);
+  memcpy(t->str, str, l);
+  t->hash = hash;
+  if (epg_fts_unused.count) {
+    t->id = epg_fts_unused.ids[--epg_fts_unused.count];
+  } else {
+    if (epg_fts_table_count == epg_fts_table_alloc) {
+      epg_fts_table_alloc = MAX(1024, epg_fts_table_alloc * 2);
+      epg_fts_table = realloc(epg_fts_table,
+                              epg_fts_table_alloc * sizeof(epg_fts_token_t *));
+    }
+    t->id = epg_fts_table_count++;
+  }
+  epg_fts_table[t->id] = t;
+  RB_INSERT_SORTED(&epg_fts_tokens, t, link, _token_cmp);
+  LIST_INSERT_HEAD(&epg_fts_hash[hash & epg_fts_hash_mask], t, hash_link);
+  if (epg_fts_table_count > 2 * (epg_fts_hash_mask + 1))
+    epg_fts_hash_grow();
+  return t;
+}
+
+static void epg_fts_token_release ( epg_fts_token_t *t )
+{
+  if (t->text.count || t->title.count) return;
+  RB_REMOVE(&epg_fts_tokens, t, link);
+  LIST_REMOVE(t, hash_link);
+  epg_fts_table[t->id] = NULL;
+  epg_fts_ids_grow(&epg_fts_unused, epg_fts_unused.count + 1);
+  epg_fts_unused.ids[epg_fts_unused.count++] = t->id;
+  free(t);
+}
+
+/* **************************************************************************
+ * Words
+ * *************************************************************************/
+
+static inline int epg_fts_char ( uint8_t c )
+{
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+         (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+static inline const char *epg_fts_word_str ( epg_fts_word_t *w )
+{
+  return epg_fts_buf + w->off;
+}
+
+static void epg_fts_words_reset ( void )
+{
+  epg_fts_buf_len = 0;
+  epg_fts_words_count = 0;
+}
+
+static void epg_fts_words_add ( const char *s, uint32_t flags )
+{
+  size_t l = strlen(s);
+  uint8_t c;
+
+  if (epg_fts_buf_len + 2 * l + 1 > epg_fts_buf_alloc) {
+    epg_fts_buf_alloc = MAX(epg_fts_buf_alloc * 2, epg_fts_buf_len + 2 * l + 1);
+    epg_fts_buf = realloc(epg_fts_buf, epg_fts_buf_alloc);
+  }
+  if (epg_fts_words_count + l / 2 + 1 > epg_fts_words_alloc) {
+    epg_fts_words_alloc = MAX(epg_fts_words_alloc * 2, epg_fts_words_count + l / 2 + 1);
+    epg_fts_words = realloc(epg_fts_words, epg_fts_words_alloc * sizeof(epg_fts_word_t));
+  }
+  while (1) {
+    while (*s && !epg_fts_char(*s)) s++;
+    if (*s == '\0') break;
+    epg_fts_words[epg_fts_words_count].off = epg_fts_buf_len;
+    epg_fts_words[epg_fts_words_count].flags = flags;
+    epg_fts_words_count++;
+    while ((c = *s) != '\0' && epg_fts_char(c)) {
+      epg_fts_buf[epg_fts_buf_len++] = (c >= 'A' && c <= 'Z') ? c + 32 : c;
+      s++;
+    }
+    epg_fts_buf[epg_fts_buf_len++] = '\0';
+  }
+}
+
+static void epg_fts_words_add_lang ( lang_str_t *ls, uint32_t flags )
+{
+  lang_str_ele_t *e;
+
+  if (ls == NULL) return;
+  RB_FOREACH(e, ls, link)
+    epg_fts_words_add(e->str, flags);
+}
+
+static int epg_fts_word_cmp ( const void *a, const void *b )
+{
+  return strcmp(epg_fts_buf + ((epg_fts_word_t *)a)->off,
+                epg_fts_buf + ((epg_fts_word_t *)b)->off);
+}
+
+/* Sort, merge the duplicates and return the hash of the word set */
+static uint32_t epg_fts_words_unique ( void )
+{
+  epg_fts_word_t *w = epg_fts_words;
+  uint32_t i, j, hash = 2166136261U;
+  const char *s;
+
+  if (epg_fts_words_count > 1) {
+    qsort(w, epg_fts_words_count, sizeof(*w), epg_fts_word_cmp);
+    for (i = j = 1; i < epg_fts_words_count; i++) {
+      if (strcmp(epg_fts_word_str(&w[i]), epg_fts_word_str(&w[j - 1])))
+        w[j++] = w[i];
+      else
+        w[j - 1].flags |= w[i].flags;
+    }
+    epg_fts_words_count = j;
+  }
+  for (i = 0; i < epg_fts_words_count; i++) {
+    for (s = epg_fts_word_str(&w[i]); *s; s++)
+      hash = (hash ^ (uint8_t)*s) * 16777619U;
+    hash = (hash ^ (w[i].flags ? 2 : 1)) * 16777619U;
+  }
+  return hash > EPG_FTS_PENDING ? hash : EPG_FTS_PENDING + 1;
+}
+
+/* **************************************************************************
+ * Broadcasts
+ * *************************************************************************/
+
+void epg_fts_remove ( epg_broadcast_t *ebc )
+{
+  epg_fts_token_t *t;
+  uint32_t i, v;
+
+  /* the index is dropped as whole in epg_fts_done() */
+  for (i = 0; i < ebc->fts_count && tvheadend_is_running(); i++) {
+    v = ebc->fts_tokens[i];
+    t = epg_fts_table[v & EPG_FTS_ID_MASK];
+    if (v & EPG_FTS_TITLE)
+      epg_fts_list_rem(&t->title, ebc->id);
+    epg_fts_list_rem(&t->text, ebc->id);
+    epg_fts_token_release(t);
+  }
+  epg_fts_entries -= ebc->fts_count;
+  free(ebc->fts_tokens);
+  ebc->fts_tokens = NULL;
+  ebc->fts_count = 0;
+  ebc->fts_hash = 0;
+}
+
+static void epg_fts_index ( epg_broadcast_t *ebc )
+{
+  epg_fts_token_t *t;
+  epg_fts_word_t *w;
+  uint32_t i, hash;
+
+  epg_fts_words_reset();
+  epg_fts_words_add_lang(ebc->title, EPG_FTS_TITLE);
+  epg_fts_words_add_lang(ebc->subtitle, 0);
+  epg_fts_words_add_lang(ebc->summary, 0);
+  epg_fts_words_add_lang(ebc->description, 0);
+  epg_fts_words_add_lang(ebc->credits_cached, 0);
+  epg_fts_words_add_lang(ebc->keyword_cached, 0);
+  hash = epg_fts_words_unique();
+  if (hash == ebc->fts_hash) return;
+
+  epg_fts_remove(ebc);
+  if (epg_fts_words_count)
+    ebc->fts_tokens = malloc(epg_fts_words_count * sizeof(uint32_t));
+  for (i = 0; i < epg_fts_words_count; i++) {
+    w = &epg_fts_words[i];
+    t = epg_fts_token_find(epg_fts_word_str(w), 1);
+    if (w->flags & EPG_FTS_TITLE)
+      epg_fts_list_add(&t->title, ebc->id);
+    epg_fts_list_add(&t->text, ebc->id);
+    ebc->fts_tokens[i] = t->id | w->flags;
+  }
+  ebc->fts_count = epg_fts_words_count;
+  ebc->fts_hash = hash;
+  epg_fts_entries += ebc->fts_count;
+}
+
+/*
+ * The loaded broadcasts come in the reverse order of the ids, which is
+ * the worst case for the blocked lists. They are queued and indexed in
+ * the ascending order at the end of epg_updated(), the lists are only
+ * appended then.
+ */
+void epg_fts_update ( epg_broadcast_t *ebc )
+{
+  if (!tvheadend_is_running())
+    return;
+  if (epg_in_load && ebc->fts_count == 0) {
+    if (ebc->fts_hash != EPG_FTS_PENDING) {
+      ebc->fts_hash = EPG_FTS_PENDING;
+      epg_fts_ids_grow(&epg_fts_pending, epg_fts_pending.count + 1);
+      epg_fts_pending.ids[epg_fts_pending.count++] = ebc->id;
+    }
+    return;
+  }
+  epg_fts_index(ebc);
+}
+
+void epg_fts_flush ( void )
+{
+  epg_broadcast_t *ebc;
+  uint32_t i;
+
+  if (epg_fts_pending.count == 0)
+    return;
+  /* the removed broadcasts have fts_hash reset by epg_fts_remove() */
+  epg_fts_ids_unique(&epg_fts_pending);
+  for (i = 0; i < epg_fts_pending.count && tvheadend_is_running(); i++) {
+    ebc = epg_broadcast_find_by_id(epg_fts_pending.ids[i]);
+    if (ebc && ebc->fts_hash == EPG_FTS_PENDING) {
+      ebc->fts_hash = 0;
+      epg_fts_index(ebc);
+    }
+  }
+  free(epg_fts_pending.ids);
+  memset(&epg_fts_pending, 0, sizeof(epg_fts_pending));
+}
+
+/* **************************************************************************
+ * Query
+ * *************************************************************************/
+
+enum {
+  EPG_FTS_EXACT,
+  EPG_FTS_PREFIX,
+  EPG_FTS_SUFFIX,
+  EPG_FTS_SUBSTR
+};
+
+static inline epg_fts_list_t *
+epg_fts_token_list ( epg_fts_token_t *t, int fulltext )
+{
+  return fulltext ? &t->text : &t->title;
+}
+
+/* Collect ids of all tokens matching the word */
+static void epg_fts_query_word
+  ( epg_fts_ids_t *dst, const char *word, int mode, int fulltext )
+{
+  epg_fts_token_t *t, *skel;
+  size_t l = strlen(word), tl;
+  uint32_t i;
+
+  dst->count = 0;
+  switch (mode) {
+  case EPG_FTS_EXACT:
+    if ((t = epg_fts_token_find(word, 0)) != NULL)
+      epg_fts_list_append(dst, epg_fts_token_list(t, fulltext));
+    return;
+  case EPG_FTS_PREFIX:
+    skel = (epg_fts_token_t *)(word - offsetof(epg_fts_token_t, str));
+    t = RB_FIND_GE(&epg_fts_tokens, skel, link, _token_cmp);
+    for ( ; t && strncmp(t->str, word, l) == 0; t = RB_NEXT(t, link))
+      epg_fts_list_append(dst, epg_fts_token_list(t, fulltext));
+    break;
+  default:
+    for (i = 0; i < epg_fts_table_count; i++) {
+      if ((t = epg_fts_table[i]) == NULL) continue;
+      if (mode == EPG_FTS_SUFFIX) {
+        tl = strlen(t->str);
+        if (tl < l || strcmp(t->str + tl - l, word)) continue;
+      } else if (strstr(t->str, word) == NULL) {
+        continue;
+      }
+      epg_fts_list_append(dst, epg_fts_token_list(t, fulltext));
+    }
+    break;
+  }
+  epg_fts_ids_unique(dst);
+}
+
+/*
+ * A substring match of the words w1 .. wn (separated by other characters)
+ * means that w1 is a suffix of an indexed word, w2 .. wn-1 are indexed
+ * words and wn is a prefix of an indexed word.
+ */
+int epg_fts_query
+  ( const char *str, int fulltext, uint32_t **ids, uint32_t *count )
+{
+  epg_fts_ids_t res = { NULL, 0, 0 }, tmp = { NULL, 0, 0 };
+  const char *s;
+  size_t l;
+  uint32_t i, k;
+  int mode, lead, trail, first = 1;
+
+  if (!tvheadend_is_running() || str == NULL || (l = strlen(str)) == 0)
+    return -1;
+  for (s = str; *s; s++)
+    if ((uint8_t)*s >= 0x80 || strchr("\\^$.[]|()?*+{}", *s))
+      return -1;
+
+  epg_fts_words_reset();
+  epg_fts_words_add(str, 0);
+  if ((k = epg_fts_words_count) == 0)
+    return -1;
+
+  for (i = 0; i < k; i++) {
+    lead  = i > 0 || !epg_fts_char(str[0]);
+    trail = i + 1 < k || !epg_fts_char(str[l - 1]);
+    mode  = lead ? (trail ? EPG_FTS_EXACT : EPG_FTS_PREFIX) :
+                   (trail ? EPG_FTS_SUFFIX : EPG_FTS_SUBSTR);
+    /* Skip the dictionary scan for the suffix, the next words are enough */
+    if (mode == EPG_FTS_SUFFIX && k > 1)
+      continue;
+    epg_fts_query_word(first ? &res : &tmp,
+                       epg_fts_word_str(&epg_fts_words[i]), mode, fulltext);
+    if (!first)
+      epg_fts_ids_intersect(&res, &tmp);
+    first = 0;
+    if (res.count == 0)
+      break;
+  }
+  free(tmp.ids);
+  *ids = res.ids;
+  *count = res.count;
+  return 0;
+}
+
+/* **************************************************************************
+ * Setup / Shutdown
+ * *************************************************************************/
+
+static void epg_fts_memoryinfo_update ( memoryinfo_t *my )
+{
+  epg_fts_token_t *t;
+  int64_t size, count = 0;
+  uint32_t i;
+
+  size = epg_fts_table_alloc * sizeof(epg_fts_token_t *) +
+         (epg_fts_hash_mask + 1) * sizeof(*epg_fts_hash) +
+         epg_fts_unused.alloc * sizeof(uint32_t) +
+         epg_fts_entries * sizeof(uint32_t) +
+         epg_fts_buf_alloc + epg_fts_words_alloc * sizeof(epg_fts_word_t);
+  for (i = 0; i < epg_fts_table_count; i++) {
+    if ((t = epg_fts_table[i]) == NULL) continue;
+    size += sizeof(*t) + strlen(t->str) + 1;
+    size += epg_fts_list_size(&t->title) + epg_fts_list_size(&t->text);
+    count++;
+  }
+  memoryinfo_update(my, size, count);
+}
+
+static memoryinfo_t epg_fts_memoryinfo = {
+  .my_name = "EPG Full-text index",
+  .my_update = epg_fts_memoryinfo_update
+};
+
+void epg_fts_init ( void )
+{
+  RB_INIT(&epg_fts_tokens);
+  epg_fts_hash_mask = 1023;
+  epg_fts_hash = calloc(epg_fts_hash_mask + 1, sizeof(*epg_fts_hash));
+  memoryinfo_register(&epg_fts_memoryinfo);
+}
+
+void epg_fts_done ( void )
+{
+  epg_fts_token_t *t;
+
+  memoryinfo_unregister(&epg_fts_memoryinfo);
+  while ((t = RB_FIRST(&epg_fts_tokens)) != NULL) {
+    RB_REMOVE(&epg_fts_tokens, t, link);
+    epg_fts_list_free(&t->title);
+    epg_fts_list_free(&t->text);
+    free(t);
+  }
+  free(epg_fts_hash);
+  epg_fts_hash = NULL;
+  free(epg_fts_table);
+  epg_fts_table = NULL;
+  epg_fts_table_count = epg_fts_table_alloc = 0;
+  free(epg_fts_unused.ids);
+  memset(&epg_fts_unused, 0, sizeof(epg_fts_unused));
+  free(epg_fts_pending.ids);
+  memset(&epg_fts_pending, 0, sizeof(epg_fts_pending));
+  free(epg_fts_buf);
+  epg_fts_buf = NULL;
+  epg_fts_buf_alloc = 0;
+  free(epg_fts_words);
+  epg_fts_words = NULL;
+  epg_fts_words_alloc = 0;
+}
@@ -67,12 +67,22 @@ static cron_multi_t   *epggrab_cron_multi;
  */
 static void _epggrab_module_grab ( epggrab_module_int_t *mod )
 {
+  int fd;
   int64_t tm1, tm2;
   htsmsg_t *data;
 
   if (!mod->enabled)
     return;
 
+  /* Parse directly from the grabber output */
+  if (mod->stream && mod->grab == epggrab_module_grab_spawn) {
+    if ((fd = epggrab_module_spawn(mod)) >= 0) {
+      epggrab_module_stream(mod, fd);
+      close(fd);
+    }
+    return;
+  }
+
   /* Grab */
   tm1 = getfastmonoclock();
   data = mod->trans(mod, mod->grab(mod));
@@ -163,18 +173,22 @@ static void *_epggrab_data_thread( void *aux )
 {
   epggrab_module_t *mod;
   epggrab_queued_data_t *eq;
+  int drained;
 
   while (atomic_get(&epggrab_running)) {
     tvh_mutex_lock(&epggrab_data_mutex);
     do {
       eq = NULL;
+      drained = 0;
       mod = TAILQ_FIRST(&epggrab_data_modules);
       if (mod) {
         eq = TAILQ_FIRST(&mod->data_queue);
         if (eq) {
           TAILQ_REMOVE(&mod->data_queue, eq, eq_link);
-          if (TAILQ_EMPTY(&mod->data_queue))
+          if (TAILQ_EMPTY(&mod->data_queue)) {
             TAILQ_REMOVE(&epggrab_data_modules, mod, qlink);
+            drained = 1;
+          }
         }
       }
       if (eq == NULL)
@@ -185,6 +199,8 @@ static void *_epggrab_data_thread( void *aux )
       mod->process_data(mod, eq->eq_data, eq->eq_len);
       memoryinfo_free(&epggrab_data_memoryinfo, sizeof(*eq) + eq->eq_len);
       free(eq);
+      if (drained && mod->process_flush)
+        mod->process_flush(mod);
     }
   }
   tvh_mutex_lock(&epggrab_data_mutex);
@@ -334,6 +350,70 @@ epggrab_class_ota_genre_translation_notify(void *self, const char *lang)
   epggrab_ota_set_genre_translation();
 }
 
+static const void *
+epggrab_class_epgdb_lock_get(void *o)
+{
+  static uint32_t u32;
+  epg_save_stats_t st;
+  epg_save_get_stats(&st);
+  u32 = MIN(st.lock_last, UINT32_MAX);
+  return &u32;
+}
+
+static const void *
+epggrab_class_epgdb_lock_max_get(void *o)
+{
+  static uint32_t u32;
+  epg_save_stats_t st;
+  epg_save_get_stats(&st);
+  u32 = MIN(st.lock_max, UINT32_MAX);
+  return &u32;
+}
+
+static const void *
+epggrab_class_epgdb_journal_get(void *o)
+{
+  static uint32_t u32;
+  epg_save_stats_t st;
+  epg_save_get_stats(&st);
+  u32 = st.journal_size / 1024;
+  return &u32;
+}
+
+static const void *
+epggrab_class_epg_batch_hist
+  (const uint32_t *hist, const uint32_t *bounds)
+{
+  size_t l = 0;
+  int i;
+
+  prop_sbuf[0] = '\0';
+  for (i = 0; i < EPG_BATCH_BUCKETS - 1; i++)
+    tvh_strlcatf(prop_sbuf, PROP_SBUF_LEN, l, "%s<=%u: %u",
+                 i ? ", " : "", bounds[i], hist[i]);
+  tvh_strlcatf(prop_sbuf, PROP_SBUF_LEN, l, ", >%u: %u",
+               bounds[i - 1], hist[i]);
+  return &prop_sbuf_ptr;
+}
+
+static const void *
+epggrab_class_epg_batch_size_get(void *o)
+{
+  static const uint32_t bounds[] = EPG_BATCH_SIZE_BOUNDS;
+  epg_batch_stats_t st;
+  epg_batch_get_stats(&st);
+  return epggrab_class_epg_batch_hist(st.size, bounds);
+}
+
+static const void *
+epggrab_class_epg_batch_lock_get(void *o)
+{
+  static const uint32_t bounds[] = EPG_BATCH_LOCK_BOUNDS;
+  epg_batch_stats_t st;
+  epg_batch_get_stats(&st);
+  return epggrab_class_epg_batch_hist(st.lock, bounds);
+}
+
 CLASS_DOC(epgconf)
 PROP_DOC(cron)
 PROP_DOC(ota_genre_translation)
@@ -407,11 +487,11 @@ const idclass_t epggrab_class = {
       .type   = PT_INT,
       .id     = "epgdb_periodicsave",
       .name   = N_("Periodically save EPG to disk (hours)"),
-      .desc   = N_("Writes the current in-memory EPG database to disk "
-                   "every x hours, so should a crash/unexpected "
-                   "shutdown occur EPG data is saved "
-                   "periodically to the database (re-read on next "
-                   "startup). Set to 0 to disable."),
+      .desc   = N_("The EPG changes are written to a journal every "
+                   "minute. Merges the journal into the EPG database "
+                   "file every x hours, the journal is also merged "
+                   "when it grows large. Set to 0 to disable the "
+                   "periodic merge."),
       .off    = offsetof(epggrab_conf_t, epgdb_periodicsave),
       .group  = 1,
     },
@@ -435,6 +515,59 @@ const idclass_t epggrab_class = {
       .off    = offsetof(epggrab_conf_t, epgdb_processparentallabels),
       .group  = 1,
     },
+    {
+      .type   = PT_U32,
+      .id     = "epgdb_lock",
+      .name   = N_("EPG save lock time (us)"),
+      .desc   = N_("How long the last EPG database write blocked "
+                   "the other tasks (microseconds). Only the "
+                   "broadcasts changed since the previous write "
+                   "are written."),
+      .get    = epggrab_class_epgdb_lock_get,
+      .opts   = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+      .group  = 1,
+    },
+    {
+      .type   = PT_U32,
+      .id     = "epgdb_lock_max",
+      .name   = N_("Max. EPG save lock time (us)"),
+      .desc   = N_("The longest EPG database write since start-up "
+                   "(microseconds)."),
+      .get    = epggrab_class_epgdb_lock_max_get,
+      .opts   = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+      .group  = 1,
+    },
+    {
+      .type   = PT_U32,
+      .id     = "epgdb_journal",
+      .name   = N_("EPG journal size (KB)"),
+      .desc   = N_("Size of the EPG changes written since the last "
+                   "merge into the database file."),
+      .get    = epggrab_class_epgdb_journal_get,
+      .opts   = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+      .group  = 1,
+    },
+    {
+      .type   = PT_STR,
+      .id     = "epg_batch_size",
+      .name   = N_("EPG update batch sizes"),
+      .desc   = N_("Histogram of the grabber update batches "
+                   "(count of events applied per one global lock "
+                   "hold)."),
+      .get    = epggrab_class_epg_batch_size_get,
+      .opts   = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+      .group  = 1,
+    },
+    {
+      .type   = PT_STR,
+      .id     = "epg_batch_lock",
+      .name   = N_("EPG update lock times (us)"),
+      .desc   = N_("Histogram of the global lock hold times of "
+                   "the grabber update batches (microseconds)."),
+      .get    = epggrab_class_epg_batch_lock_get,
+      .opts   = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+      .group  = 1,
+    },
     {
       .type   = PT_STR,
       .id     = "cron",
@@ -61,6 +61,8 @@ typedef struct epggrab_stats
   epggrab_stats_part_t episodes;
   epggrab_stats_part_t broadcasts;
   epggrab_stats_part_t config;
+  int64_t              bytes;   ///< Input size
+  size_t               peak;    ///< Peak parser buffer (streaming)
 } epggrab_stats_t;
 
 /* **************************************************************************
@@ -182,6 +184,9 @@ struct epggrab_module
 
   /* Process queued data */
   void      (*process_data)( void *m, void *data, uint32_t len );
+
+  /* Queued data drained */
+  void      (*process_flush)( void *m );
 };
 
 /*
@@ -204,6 +209,7 @@ struct epggrab_module_int
   char*     (*grab)   ( void *mod );
   htsmsg_t* (*trans)  ( void *mod, char *data );
   int       (*parse)  ( void *mod, htsmsg_t *data, epggrab_stats_t *stat );
+  int       (*stream) ( void *mod, int fd, epggrab_stats_t *stat ); ///< Parse from descriptor (optional)
 };
 
 /*
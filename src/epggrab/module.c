@@ -19,6 +19,7 @@
 #include <signal.h>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <sys/resource.h>
 
 #include "tvheadend.h"
 #include "settings.h"
@@ -370,41 +371,10 @@ epggrab_module_t *epggrab_module_create
 }
 
 /*
- * Run the parse
+ * Schedule the EPG save after an import
  */
-void epggrab_module_parse( void *m, htsmsg_t *data )
+static void epggrab_module_save ( epggrab_module_int_t *mod, int save )
 {
-  int64_t tm1, tm2;
-  int save = 0;
-  epggrab_stats_t stats;
-  epggrab_module_int_t *mod = m;
-
-  /* Parse */
-  memset(&stats, 0, sizeof(stats));
-  tm1 = getfastmonoclock();
-  save |= mod->parse(mod, data, &stats);
-  tm2 = getfastmonoclock();
-  htsmsg_destroy(data);
-
-  /* Debug stats */
-  tvhinfo(mod->subsys, "%s: parse took %"PRId64" seconds", mod->id, mono2sec(tm2 - tm1));
-  tvhinfo(mod->subsys, "%s:  channels   tot=%5d new=%5d mod=%5d",
-          mod->id, stats.channels.total, stats.channels.created,
-          stats.channels.modified);
-  tvhinfo(mod->subsys, "%s:  brands     tot=%5d new=%5d mod=%5d",
-          mod->id, stats.brands.total, stats.brands.created,
-          stats.brands.modified);
-  tvhinfo(mod->subsys, "%s:  seasons    tot=%5d new=%5d mod=%5d",
-          mod->id, stats.seasons.total, stats.seasons.created,
-          stats.seasons.modified);
-  tvhinfo(mod->subsys, "%s:  episodes   tot=%5d new=%5d mod=%5d",
-          mod->id, stats.episodes.total, stats.episodes.created,
-          stats.episodes.modified);
-  tvhinfo(mod->subsys, "%s:  broadcasts tot=%5d new=%5d mod=%5d",
-          mod->id, stats.broadcasts.total, stats.broadcasts.created,
-          stats.broadcasts.modified);
-
-  /* Now we've parsed, do we need to save? */
   if (save && epggrab_conf.epgdb_saveafterimport) {
     tvhinfo(mod->subsys, "%s: scheduling save epg timer", mod->id);
     tvh_mutex_lock(&global_lock);
@@ -424,6 +394,82 @@ void epggrab_module_parse( void *m, htsmsg_t *data )
   }
 }
 
+/*
+ * Report the parse stats
+ */
+static void epggrab_module_parsed
+  ( epggrab_module_int_t *mod, epggrab_stats_t *stats, int64_t tm )
+{
+  struct rusage ru;
+
+  /* Debug stats */
+  tvhinfo(mod->subsys, "%s: parse took %"PRId64" seconds", mod->id, mono2sec(tm));
+  tvhinfo(mod->subsys, "%s:  channels   tot=%5d new=%5d mod=%5d",
+          mod->id, stats->channels.total, stats->channels.created,
+          stats->channels.modified);
+  tvhinfo(mod->subsys, "%s:  brands     tot=%5d new=%5d mod=%5d",
+          mod->id, stats->brands.total, stats->brands.created,
+          stats->brands.modified);
+  tvhinfo(mod->subsys, "%s:  seasons    tot=%5d new=%5d mod=%5d",
+          mod->id, stats->seasons.total, stats->seasons.created,
+          stats->seasons.modified);
+  tvhinfo(mod->subsys, "%s:  episodes   tot=%5d new=%5d mod=%5d",
+          mod->id, stats->episodes.total, stats->episodes.created,
+          stats->episodes.modified);
+  tvhinfo(mod->subsys, "%s:  broadcasts tot=%5d new=%5d mod=%5d",
+          mod->id, stats->broadcasts.total, stats->broadcasts.created,
+          stats->broadcasts.modified);
+  if (getrusage(RUSAGE_SELF, &ru))
+    ru.ru_maxrss = 0;
+  if (stats->bytes)
+    tvhinfo(mod->subsys, "%s:  input %"PRId64" kB, parser peak %zu kB",
+            mod->id, stats->bytes / 1024, stats->peak / 1024);
+  tvhinfo(mod->subsys, "%s:  %.0f events/s, max RSS %ld kB", mod->id,
+          stats->broadcasts.total * (double)MONOCLOCK_RESOLUTION / MAX(tm, 1),
+          ru.ru_maxrss);
+}
+
+/*
+ * Run the parse
+ */
+void epggrab_module_parse( void *m, htsmsg_t *data )
+{
+  int64_t tm1, tm2;
+  int save = 0;
+  epggrab_stats_t stats;
+  epggrab_module_int_t *mod = m;
+
+  /* Parse */
+  memset(&stats, 0, sizeof(stats));
+  tm1 = getmonoclock();
+  save |= mod->parse(mod, data, &stats);
+  tm2 = getmonoclock();
+  htsmsg_destroy(data);
+
+  epggrab_module_parsed(mod, &stats, tm2 - tm1);
+  epggrab_module_save(mod, save);
+}
+
+/*
+ * Run the parse directly from the descriptor
+ */
+void epggrab_module_stream( void *m, int fd )
+{
+  int64_t tm1, tm2;
+  int save = 0;
+  epggrab_stats_t stats;
+  epggrab_module_int_t *mod = m;
+
+  /* Parse */
+  memset(&stats, 0, sizeof(stats));
+  tm1 = getmonoclock();
+  save |= mod->stream(mod, fd, &stats);
+  tm2 = getmonoclock();
+
+  epggrab_module_parsed(mod, &stats, tm2 - tm1);
+  epggrab_module_save(mod, save);
+}
+
 /* **************************************************************************
  * Module channel routines
  * *************************************************************************/
@@ -471,6 +517,7 @@ epggrab_module_int_t *epggrab_module_int_create
     const char *path,
     char* (*grab) (void*m),
     int (*parse) (void *m, htsmsg_t *data, epggrab_stats_t *sta),
+    int (*stream) (void *m, int fd, epggrab_stats_t *sta),
     htsmsg_t* (*trans) (void *mod, char *data) )
 {
   /* Allocate data */
@@ -488,15 +535,15 @@ epggrab_module_int_t *epggrab_module_int_create
   skel->grab     = grab  ?: epggrab_module_grab_spawn;
   skel->trans    = trans ?: epggrab_module_trans_xml;
   skel->parse    = parse;
+  skel->stream   = stream;
   skel->done     = epggrab_module_int_done;
 
   return skel;
 }
 
-char *epggrab_module_grab_spawn ( void *m )
+int epggrab_module_spawn ( void *m )
 {
   int        rd = -1, outlen;
-  char       *outbuf;
   epggrab_module_int_t *mod = m;
   char      **argv = NULL;
   char       *path;
@@ -517,7 +564,7 @@ char *epggrab_module_grab_spawn ( void *m )
   /* Arguments */
   if (spawn_parse_args(&argv, 64, path, NULL)) {
     tvherror(mod->subsys, "%s: unable to parse arguments", mod->id);
-    return NULL;
+    return -1;
   }
 
   /* Grab */
@@ -525,22 +572,34 @@ char *epggrab_module_grab_spawn ( void *m )
 
   spawn_free_args(argv);
 
-  if (outlen < 0)
-    goto error;
+  if (outlen < 0) {
+    if (rd >= 0)
+      close(rd);
+    tvherror(mod->subsys, "%s: no output detected", mod->id);
+    return -1;
+  }
 
-  outlen = file_readall(rd, &outbuf);
-  if (outlen < 1)
-    goto error;
+  return rd;
+}
+
+char *epggrab_module_grab_spawn ( void *m )
+{
+  int        rd, outlen;
+  char       *outbuf;
+  epggrab_module_int_t *mod = m;
 
+  if ((rd = epggrab_module_spawn(mod)) < 0)
+    return NULL;
+
+  outlen = file_readall(rd, &outbuf);
   close(rd);
 
-  return outbuf;
+  if (outlen < 1) {
+    tvherror(mod->subsys, "%s: no output detected", mod->id);
+    return NULL;
+  }
 
-error:
-  if (rd >= 0)
-    close(rd);
-  tvherror(mod->subsys, "%s: no output detected", mod->id);
-  return NULL;
+  return outbuf;
 }
 
 
@@ -574,6 +633,12 @@ static void _epggrab_socket_handler ( epggrab_module_ext_t *mod, int s )
   time_t tm1, tm2;
   htsmsg_t *data = NULL;
 
+  /* Parse directly from the socket */
+  if (mod->stream) {
+    epggrab_module_stream(mod, s);
+    return;
+  }
+
   /* Grab/Translate */
   time(&tm1);
   outlen = file_readall(s, &outbuf);
@@ -699,6 +764,7 @@ epggrab_module_ext_t *epggrab_module_ext_create
     const char *id, int subsys, const char *saveid,
     const char *name, int priority, const char *sockid,
     int (*parse) (void *m, htsmsg_t *data, epggrab_stats_t *sta),
+    int (*stream) (void *m, int fd, epggrab_stats_t *sta),
     htsmsg_t* (*trans) (void *mod, char *data) )
 {
   char path[512];
@@ -712,7 +778,7 @@ epggrab_module_ext_t *epggrab_module_ext_create
   epggrab_module_int_create((epggrab_module_int_t*)skel,
                             cls ?: &epggrab_mod_ext_class,
                             id, subsys, saveid, name, priority, path,
-                            NULL, parse, trans);
+                            NULL, parse, stream, trans);
 
   /* Local */
   skel->type     = EPGGRAB_EXT;
@@ -748,6 +814,7 @@ epggrab_module_ota_t *epggrab_module_ota_create
   skel->done         = ops->done;
   skel->tune         = ops->tune;
   skel->process_data = ops->process_data;
+  skel->process_flush = ops->process_flush;
   skel->opaque       = ops->opaque;
 
   return skel;
@@ -67,6 +67,8 @@ typedef struct eit_private
   char slave[32];
   LIST_HEAD(, eit_nit) nit;
   LIST_HEAD(, eit_sdt) sdt;
+  TAILQ_HEAD(, eit_staged) staged;
+  int staged_count;
   epggrab_ota_module_ops_t *ops;
 } eit_private_t;
 
@@ -143,6 +145,20 @@ typedef struct eit_event
 
 } eit_event_t;
 
+/* Decoded event waiting for the global lock */
+#define EIT_STAGED_MAX EPG_BATCH_MAX
+
+typedef struct eit_staged
+{
+  TAILQ_ENTRY(eit_staged) link;
+  tvh_uuid_t  svc_uuid;
+  int         tableid;
+  int         sect;
+  int         local_time;
+  uint8_t     hdr[12];
+  eit_event_t ev;
+} eit_staged_t;
+
 
 /*
  * Forward declarations
@@ -828,24 +844,33 @@ running:
   return 0;
 }
 
-static int _eit_process_event
+static void _eit_event_free ( eit_event_t *ev )
+{
+#if TODO_ADD_EXTRA
+  if (ev->extra)    htsmsg_destroy(ev->extra);
+#endif
+  if (ev->genre)    epg_genre_list_destroy(ev->genre);
+  if (ev->title)    lang_str_destroy(ev->title);
+  if (ev->subtitle) lang_str_destroy(ev->subtitle);
+  if (ev->summary)  lang_str_destroy(ev->summary);
+  if (ev->desc)     lang_str_destroy(ev->desc);
+}
+
+/*
+ * Decode the descriptors and scrape the texts, no locks are required
+ */
+static int _eit_decode_event
   ( epggrab_module_t *mod, eit_data_t *ed,
-    const uint8_t *ptr0, int len0,
-    int *save, int lock )
+    const uint8_t *ptr0, int len0, eit_event_t *ev )
 {
   eit_module_t *eit_mod = (eit_module_t *)mod;
-  idnode_list_mapping_t *ilm = NULL;
-  mpegts_service_t *svc;
-  channel_t *ch;
-  eit_event_t ev;
-  const int tableid = ed->tableid;
-  const int sect = ed->sect;
-  const int local = ed->local_time;
   const uint8_t *ptr;
   int r, len;
   uint8_t dtag, dlen;
   int dllen;
 
+  memset(ev, 0, sizeof(*ev));
+
   if (len0 < 12) return -1;
 
   dllen = ((ptr0[10] & 0x0f) << 8) | ptr0[11];
@@ -854,9 +879,8 @@ static int _eit_process_event
 
   if (len < dllen) return -1;
 
-  memset(&ev, 0, sizeof(ev));
   if (ed->charset_len)
-    ev.default_charset = (char *)ed->data + ed->cridauth_len;
+    ev->default_charset = (char *)ed->data + ed->cridauth_len;
   while (dllen > 2) {
     dtag = ptr[0];
     dlen = ptr[1];
@@ -870,30 +894,30 @@ static int _eit_process_event
 
     switch (dtag) {
       case DVB_DESC_SHORT_EVENT:
-        r = _eit_desc_short_event(mod, ptr, dlen, &ev);
+        r = _eit_desc_short_event(mod, ptr, dlen, ev);
         break;
       case DVB_DESC_EXT_EVENT:
-        r = _eit_desc_ext_event(mod, ptr, dlen, &ev);
+        r = _eit_desc_ext_event(mod, ptr, dlen, ev);
         break;
       case DVB_DESC_CONTENT:
-        r = _eit_desc_content(mod, ptr, dlen, &ev);
+        r = _eit_desc_content(mod, ptr, dlen, ev);
         break;
       case DVB_DESC_COMPONENT:
-        r = _eit_desc_component(mod, ptr, dlen, &ev);
+        r = _eit_desc_component(mod, ptr, dlen, ev);
         break;
       case DVB_DESC_PARENTAL_RAT:
-        r = _eit_desc_parental(mod, ptr, dlen, &ev);
+        r = _eit_desc_parental(mod, ptr, dlen, ev);
         if(epggrab_conf.epgdb_processparentallabels){
-            if(ev.rating_label){
-              tvhtrace(mod->subsys, "RATINGLABEL '%d'  '%s'", ev.parental, ev.rating_label->rl_display_label);
+            if(ev->rating_label){
+              tvhtrace(mod->subsys, "RATINGLABEL '%d'  '%s'", ev->parental, ev->rating_label->rl_display_label);
             } else {
-              tvhtrace(mod->subsys, "RATINGLABEL '%d'  '<NONE>'", ev.parental);
+              tvhtrace(mod->subsys, "RATINGLABEL '%d'  '<NONE>'", ev->parental);
             }
         }
 
         break;
       case DVB_DESC_CRID:
-        r = _eit_desc_crid(mod, ptr, dlen, &ev, ed);
+        r = _eit_desc_crid(mod, ptr, dlen, ev, ed);
         break;
       default:
         r = 0;
@@ -914,51 +938,99 @@ static int _eit_process_event
    * then we use the one from the description.
    */
   if (eit_mod->scrape_episode) {
-    if (ev.title)
-      _eit_scrape_episode(ev.title, eit_mod, &ev);
-    if (ev.desc)
-      _eit_scrape_episode(ev.desc, eit_mod, &ev);
-    if (ev.summary)
-      _eit_scrape_episode(ev.summary, eit_mod, &ev);
+    if (ev->title)
+      _eit_scrape_episode(ev->title, eit_mod, ev);
+    if (ev->desc)
+      _eit_scrape_episode(ev->desc, eit_mod, ev);
+    if (ev->summary)
+      _eit_scrape_episode(ev->summary, eit_mod, ev);
   }
 
-  _eit_scrape_text(eit_mod, &ev);
+  _eit_scrape_text(eit_mod, ev);
+
+  return 12 + (((ptr0[10] & 0x0f) << 8) | ptr0[11]);
+}
+
+/*
+ * Update the broadcasts of the service channels (global_lock held)
+ */
+static void _eit_apply_event
+  ( epggrab_module_t *mod, tvh_uuid_t *svc_uuid,
+    int tableid, int sect, int local,
+    eit_event_t *ev, const uint8_t *hdr, int *save )
+{
+  idnode_list_mapping_t *ilm;
+  mpegts_service_t *svc;
+  channel_t *ch;
+
+  lock_assert(&global_lock);
 
-  if (lock)
-    tvh_mutex_lock(&global_lock);
-  svc = (mpegts_service_t *)service_find_by_uuid0(&ed->svc_uuid);
-  if (svc && eit_mod->opaque) {
+  svc = (mpegts_service_t *)service_find_by_uuid0(svc_uuid);
+  if (svc && ((eit_module_t *)mod)->opaque) {
     LIST_FOREACH(ilm, &svc->s_channels, ilm_in1_link) {
       ch = (channel_t *)ilm->ilm_in2;
       if (!ch->ch_enabled || ch->ch_epg_parent) continue;
       if (_eit_process_event_one(mod, tableid, sect, svc, ch,
-                                 &ev, ptr0, len0, local, save) < 0)
+                                 ev, hdr, 12, local, save) < 0)
         break;
     }
   }
-  if (lock)
-    tvh_mutex_unlock(&global_lock);
+}
 
-#if TODO_ADD_EXTRA
-  if (ev.extra)    htsmsg_destroy(ev.extra);
-#endif
-  if (ev.genre)    epg_genre_list_destroy(ev.genre);
-  if (ev.title)    lang_str_destroy(ev.title);
-  if (ev.subtitle) lang_str_destroy(ev.subtitle);
-  if (ev.summary)  lang_str_destroy(ev.summary);
-  if (ev.desc)     lang_str_destroy(ev.desc);
+static int _eit_process_event
+  ( epggrab_module_t *mod, eit_data_t *ed,
+    const uint8_t *ptr0, int len0, int *save )
+{
+  eit_event_t ev;
+  int r;
 
-  if (ilm)
-    return -1;
-  return 12 + (((ptr0[10] & 0x0f) << 8) | ptr0[11]);
+  if ((r = _eit_decode_event(mod, ed, ptr0, len0, &ev)) > 0)
+    _eit_apply_event(mod, &ed->svc_uuid, ed->tableid, ed->sect,
+                     ed->local_time, &ev, ptr0, save);
+  _eit_event_free(&ev);
+  return r;
 }
 
+/*
+ * Apply the staged events, one global_lock hold per batch
+ */
+static void
+_eit_process_flush(void *m)
+{
+  epggrab_module_t *mod = m;
+  eit_private_t *priv = ((eit_module_t *)mod)->opaque;
+  eit_staged_t *st;
+  epg_batch_t batch;
+  int save = 0;
+
+  if (priv == NULL || TAILQ_EMPTY(&priv->staged))
+    return;
+
+  epg_batch_begin(&batch);
+  while ((st = TAILQ_FIRST(&priv->staged)) != NULL) {
+    TAILQ_REMOVE(&priv->staged, st, link);
+    _eit_apply_event(mod, &st->svc_uuid, st->tableid, st->sect,
+                     st->local_time, &st->ev, st->hdr, &save);
+    _eit_event_free(&st->ev);
+    free(st);
+    epg_batch_next(&batch);
+  }
+  priv->staged_count = 0;
+  epg_batch_end(&batch);
+}
+
+/*
+ * Queued sections, the events are decoded here and applied
+ * in batches (EIT_STAGED_MAX or when the queue is drained)
+ */
 static void
 _eit_process_data(void *m, void *data, uint32_t len)
 {
-  int save = 0, r;
+  eit_private_t *priv = ((eit_module_t *)m)->opaque;
+  eit_staged_t *st;
   size_t hlen;
   eit_data_t *ed = data;
+  int r;
 
   assert(len >= sizeof(ed));
   hlen = sizeof(*ed) + ed->cridauth_len + ed->charset_len;
@@ -967,18 +1039,24 @@ _eit_process_data(void *m, void *data, uint32_t len)
   len -= hlen;
 
   while (len) {
-    if ((r = _eit_process_event(m, ed, data, len, &save, 1)) < 0)
+    st = malloc(sizeof(*st));
+    if ((r = _eit_decode_event(m, ed, data, len, &st->ev)) < 0) {
+      _eit_event_free(&st->ev);
+      free(st);
       break;
+    }
     assert(r > 0);
+    st->svc_uuid = ed->svc_uuid;
+    st->tableid = ed->tableid;
+    st->sect = ed->sect;
+    st->local_time = ed->local_time;
+    memcpy(st->hdr, data, sizeof(st->hdr));
+    TAILQ_INSERT_TAIL(&priv->staged, st, link);
+    if (++priv->staged_count >= EIT_STAGED_MAX)
+      _eit_process_flush(m);
     len -= r;
     data += r;
   }
-
-  if (save) {
-    tvh_mutex_lock(&global_lock);
-    epg_updated();
-    tvh_mutex_unlock(&global_lock);
-  }
 }
 
 static void
@@ -987,7 +1065,7 @@ _eit_process_immediate(void *m, const void *ptr, uint32_t len, eit_data_t *ed)
   int save = 0, r;
 
   while (len) {
-    if ((r = _eit_process_event(m, ed, ptr, len, &save, 0)) < 0)
+    if ((r = _eit_process_event(m, ed, ptr, len, &save)) < 0)
       break;
     assert(r > 0);
     len -= r;
@@ -1533,6 +1611,14 @@ static void _eit_module_load_config(eit_module_t *mod)
 static void _eit_done0( eit_private_t *priv )
 {
   eit_nit_t *nit;
+  eit_staged_t *st;
+
+  /* the staged events are not applied at the exit */
+  while ((st = TAILQ_FIRST(&priv->staged)) != NULL) {
+    TAILQ_REMOVE(&priv->staged, st, link);
+    _eit_event_free(&st->ev);
+    free(st);
+  }
   while ((nit = LIST_FIRST(&priv->nit)) != NULL) {
     LIST_REMOVE(nit, link);
     free(nit->name);
@@ -1651,9 +1737,11 @@ static void eit_init_one ( const char *id, htsmsg_t *conf )
   ops->done = _eit_done;
   ops->activate = _eit_activate;
   ops->process_data = _eit_process_data;
+  ops->process_flush = _eit_process_flush;
   ops->tune = _eit_tune;
   ops->opaque = priv;
   priv->ops = ops;
+  TAILQ_INIT(&priv->staged);
   priv->pid = htsmsg_get_s32_or_default(conf, "pid", 0);
   s = htsmsg_get_str(conf, "conv");
   if (s && strcmp(s, "huffman") == 0)
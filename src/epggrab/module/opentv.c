@@ -559,9 +559,7 @@ opentv_parse_event_section
                                            lang, buf, len);
   }
 
-  /* Update EPG */
-  if (save) epg_updated();
-  return 0;
+  return save;
 }
 
 static void
@@ -570,14 +568,16 @@ _opentv_process_data
 {
   opentv_module_t *mod = m;
   opentv_data_t od;
+  epg_batch_t batch;
 
   assert(len >= sizeof(od));
   memcpy(&od, data, sizeof(od));
   data += sizeof(od);
   len -= sizeof(od);
-  tvh_mutex_lock(&global_lock);
-  opentv_parse_event_section(mod, od.cid, od.mjd, data, len);
-  tvh_mutex_unlock(&global_lock);  
+  epg_batch_begin(&batch);
+  if (opentv_parse_event_section(mod, od.cid, od.mjd, data, len))
+    epg_batch_next(&batch);
+  epg_batch_end(&batch);
 }
 
 /* ************************************************************************
@@ -1027,15 +1027,40 @@ static int _xmltv_parse_channel
   return save;
 }
 
+/**
+ * Parse the children of the <tv> tag, one global_lock hold per batch
+ */
+static int _xmltv_parse_tags
+  (epggrab_module_t *mod, htsmsg_t *tags, epggrab_stats_t *stats)
+{
+  int save = 0;
+  const char *name;
+  htsmsg_field_t *f;
+  epg_batch_t batch;
+
+  epg_batch_begin(&batch);
+  HTSMSG_FOREACH(f, tags) {
+    name = htsmsg_field_name(f);
+    if(!strcmp(name, "channel"))
+      save |= _xmltv_parse_channel(mod, htsmsg_get_map_by_field(f), stats);
+    else if(!strcmp(name, "programme"))
+      save |= _xmltv_parse_programme(mod, htsmsg_get_map_by_field(f), stats);
+    else
+      continue;
+    epg_batch_next(&batch);
+  }
+  epg_batch_end(&batch);
+  return save;
+}
+
 /**
  *
  */
 static int _xmltv_parse_tv
   (epggrab_module_t *mod, htsmsg_t *body, epggrab_stats_t *stats)
 {
-  int gsave = 0, save;
+  int gsave;
   htsmsg_t *tags;
-  htsmsg_field_t *f;
 
   if((tags = htsmsg_get_map(body, "tags")) == NULL)
     return 0;
@@ -1044,20 +1069,7 @@ static int _xmltv_parse_tv
   epggrab_channel_begin_scan(mod);
   tvh_mutex_unlock(&global_lock);
 
-  HTSMSG_FOREACH(f, tags) {
-    save = 0;
-    if(!strcmp(htsmsg_field_name(f), "channel")) {
-      tvh_mutex_lock(&global_lock);
-      save = _xmltv_parse_channel(mod, htsmsg_get_map_by_field(f), stats);
-      tvh_mutex_unlock(&global_lock);
-    } else if(!strcmp(htsmsg_field_name(f), "programme")) {
-      tvh_mutex_lock(&global_lock);
-      save = _xmltv_parse_programme(mod, htsmsg_get_map_by_field(f), stats);
-      if (save) epg_updated();
-      tvh_mutex_unlock(&global_lock);
-    }
-    gsave |= save;
-  }
+  gsave = _xmltv_parse_tags(mod, tags, stats);
 
   tvh_mutex_lock(&global_lock);
   epggrab_channel_end_scan(mod);
@@ -1080,6 +1092,50 @@ static int _xmltv_parse
   return _xmltv_parse_tv(mod, tv, stats);
 }
 
+/**
+ * Streaming parse, the <tv> children are processed in batches
+ * while the document is read
+ */
+typedef struct xmltv_stream {
+  epggrab_module_t *mod;
+  epggrab_stats_t  *stats;
+  int               save;
+} xmltv_stream_t;
+
+static void _xmltv_stream_tags
+  ( void *opaque, htsmsg_t *tags )
+{
+  xmltv_stream_t *xs = opaque;
+
+  xs->save |= _xmltv_parse_tags(xs->mod, tags, xs->stats);
+}
+
+static int _xmltv_stream
+  ( void *m, int fd, epggrab_stats_t *stats )
+{
+  epggrab_module_t *mod = m;
+  xmltv_stream_t xs = { .mod = mod, .stats = stats };
+  htsmsg_xml_stream_stats_t xstats;
+  char errbuf[100];
+
+  tvh_mutex_lock(&global_lock);
+  epggrab_channel_begin_scan(mod);
+  tvh_mutex_unlock(&global_lock);
+
+  if (htsmsg_xml_deserialize_stream(fd, _xmltv_stream_tags, &xs,
+                                    &xstats, errbuf, sizeof(errbuf)))
+    tvherror(mod->subsys, "%s: htsmsg_xml_deserialize_stream error %s "
+             "(after %u elements)", mod->id, errbuf, xstats.elements);
+
+  tvh_mutex_lock(&global_lock);
+  epggrab_channel_end_scan(mod);
+  tvh_mutex_unlock(&global_lock);
+
+  stats->bytes = xstats.bytes;
+  stats->peak  = xstats.peak;
+  return xs.save;
+}
+
 /* ************************************************************************
  * Module Setup
  * ***********************************************************************/
@@ -1243,7 +1299,7 @@ static void _xmltv_load_grabbers ( void )
         epggrab_module_int_create(NULL, &epggrab_mod_int_xmltv_class,
                                   &outbuf[p], LS_XMLTV, "xmltv",
                                   name, 3, &outbuf[p],
-                                  NULL, _xmltv_parse, NULL);
+                                  NULL, _xmltv_parse, _xmltv_stream, NULL);
         p = n = i + 1;
       } else if ( outbuf[i] == '\\') {
         memmove(outbuf, outbuf + 1, strlen(outbuf));
@@ -1294,7 +1350,7 @@ static void _xmltv_load_grabbers ( void )
             } else {
               epggrab_module_int_create(NULL, &epggrab_mod_int_xmltv_class,
                                         bin, LS_XMLTV, "xmltv", name, 3, bin,
-                                        NULL, _xmltv_parse, NULL);
+                                        NULL, _xmltv_parse, _xmltv_stream, NULL);
             }
             free(outbuf);
           } else {
@@ -1315,7 +1371,7 @@ void xmltv_init ( void )
   /* External module */
   epggrab_module_ext_create(NULL, &epggrab_mod_ext_xmltv_class,
                             "xmltv", LS_XMLTV, "xmltv", "XMLTV", 3, "xmltv",
-                            _xmltv_parse, NULL);
+                            _xmltv_parse, _xmltv_stream, NULL);
 
   /* Standard modules */
   _xmltv_load_grabbers();
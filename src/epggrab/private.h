@@ -30,6 +30,7 @@ epggrab_module_t *epggrab_module_create
     const char *id, int subsys, const char *saveid,
     const char *name, int priority );
 
+int       epggrab_module_spawn      ( void *m );
 char     *epggrab_module_grab_spawn ( void *m );
 htsmsg_t *epggrab_module_trans_xml  ( void *m, char *data );
 
@@ -39,6 +40,7 @@ void      epggrab_module_ch_mod  ( void *m, struct channel *ch );
 void      epggrab_module_ch_save ( void *m, epggrab_channel_t *ec );
 
 void      epggrab_module_parse ( void *m, htsmsg_t *data );
+void      epggrab_module_stream ( void *m, int fd );
 
 void      epggrab_module_channels_load ( const char *modid );
 
@@ -80,6 +82,7 @@ epggrab_module_int_t *epggrab_module_int_create
     const char *path,
     char* (*grab) (void*m),
     int (*parse) (void *m, htsmsg_t *data, epggrab_stats_t *sta),
+    int (*stream) (void *m, int fd, epggrab_stats_t *sta),
     htsmsg_t* (*trans) (void *mod, char *data) );
 
 /* **************************************************************************
@@ -92,6 +95,7 @@ epggrab_module_ext_t *epggrab_module_ext_create
     const char *name, int priority,
     const char *sockid,
     int (*parse) (void *m, htsmsg_t *data, epggrab_stats_t *sta),
+    int (*stream) (void *m, int fd, epggrab_stats_t *sta),
     htsmsg_t* (*trans) (void *mod, char *data) );
 
 /* **************************************************************************
@@ -107,6 +111,7 @@ typedef struct epggrab_ota_module_ops {
     int  (*tune)     (epggrab_ota_map_t *map, epggrab_ota_mux_t *om,
                       struct mpegts_mux *mm);
     void (*process_data) (void *m, void *data, uint32_t len);
+    void (*process_flush) (void *m);
     void  *opaque;
 } epggrab_ota_module_ops_t;
 
@@ -22,10 +22,17 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/uio.h>
 
 #include "htsmsg_binary.h"
 #include "memoryinfo.h"
 
+typedef struct htsmsg_binary_iov {
+  uint8_t      *hbi_start;  /* start of the not yet added header data */
+  struct iovec *hbi_iov;
+  size_t        hbi_zcopy;
+} htsmsg_binary_iov_t;
+
 /*
  *
  */
@@ -257,11 +264,37 @@ htsmsg_binary_count(htsmsg_t *msg)
   return len;
 }
 
+/*
+ * Count the binary fields which are not copied in the vectored mode
+ */
+static size_t
+htsmsg_binary_count_zcopy(htsmsg_t *msg, size_t zcopy, int *count)
+{
+  htsmsg_field_t *f;
+  size_t len = 0;
+
+  TAILQ_FOREACH(f, &msg->hm_fields, hmf_link) {
+    switch(f->hmf_type) {
+    case HMF_MAP:
+    case HMF_LIST:
+      len += htsmsg_binary_count_zcopy(f->hmf_msg, zcopy, count);
+      break;
+    case HMF_BIN:
+      if (f->hmf_binsize >= zcopy) {
+        len += f->hmf_binsize;
+        (*count)++;
+      }
+      break;
+    }
+  }
+  return len;
+}
+
 /*
  *
  */
-static void
-htsmsg_binary_write(htsmsg_t *msg, uint8_t *ptr)
+static uint8_t *
+htsmsg_binary_write(htsmsg_t *msg, uint8_t *ptr, htsmsg_binary_iov_t *v)
 {
   htsmsg_field_t *f;
   uint64_t u64;
@@ -321,14 +354,27 @@ htsmsg_binary_write(htsmsg_t *msg, uint8_t *ptr)
     switch(f->hmf_type) {
     case HMF_MAP:
     case HMF_LIST:
-      htsmsg_binary_write(f->hmf_msg, ptr);
-      break;
+      ptr = htsmsg_binary_write(f->hmf_msg, ptr, v);
+      continue;
 
     case HMF_STR:
       memcpy(ptr, f->hmf_str, l);
       break;
 
     case HMF_BIN:
+      if (v && l >= v->hbi_zcopy) {
+        /* reference the data in place */
+        if (ptr != v->hbi_start) {
+          v->hbi_iov->iov_base = v->hbi_start;
+          v->hbi_iov->iov_len = ptr - v->hbi_start;
+          v->hbi_iov++;
+        }
+        v->hbi_iov->iov_base = (void *)f->hmf_bin;
+        v->hbi_iov->iov_len = l;
+        v->hbi_iov++;
+        v->hbi_start = ptr;
+        continue;
+      }
       memcpy(ptr, f->hmf_bin, l);
       break;
 
@@ -351,6 +397,7 @@ htsmsg_binary_write(htsmsg_t *msg, uint8_t *ptr)
     }
     ptr += l;
   }
+  return ptr;
 }
 
 /*
@@ -368,7 +415,7 @@ htsmsg_binary_serialize0(htsmsg_t *msg, void **datap, size_t *lenp, int maxlen)
 
   data = malloc(len);
 
-  htsmsg_binary_write(msg, data);
+  htsmsg_binary_write(msg, data, NULL);
   *datap = data;
   *lenp  = len;
   return 0;
@@ -394,8 +441,57 @@ htsmsg_binary_serialize(htsmsg_t *msg, void **datap, size_t *lenp, int maxlen)
   data[2] = len >> 8;
   data[3] = len;
 
-  htsmsg_binary_write(msg, data + 4);
+  htsmsg_binary_write(msg, data + 4, NULL);
   *datap = data;
   *lenp  = len + 4;
   return 0;
 }
+
+/*
+ *
+ */
+int
+htsmsg_binary_serialize_iov_size(htsmsg_t *msg, size_t zcopy, size_t *buflen,
+                                 int *iovcnt, int maxlen)
+{
+  size_t len, zlen;
+  int count = 0;
+
+  len = htsmsg_binary_count(msg);
+  if(len + 4 > maxlen)
+    return -1;
+  zlen = htsmsg_binary_count_zcopy(msg, zcopy, &count);
+  *buflen = len + 4 - zlen;
+  *iovcnt = 2 * count + 1;
+  return 0;
+}
+
+/*
+ *
+ */
+int
+htsmsg_binary_serialize_iov(htsmsg_t *msg, size_t zcopy,
+                            uint8_t *buf, struct iovec *iov)
+{
+  htsmsg_binary_iov_t v;
+  size_t len;
+  uint8_t *ptr;
+
+  len = htsmsg_binary_count(msg);
+
+  buf[0] = len >> 24;
+  buf[1] = len >> 16;
+  buf[2] = len >> 8;
+  buf[3] = len;
+
+  v.hbi_start = buf;
+  v.hbi_iov = iov;
+  v.hbi_zcopy = zcopy;
+  ptr = htsmsg_binary_write(msg, buf + 4, &v);
+  if (ptr != v.hbi_start) {
+    v.hbi_iov->iov_base = v.hbi_start;
+    v.hbi_iov->iov_len = ptr - v.hbi_start;
+    v.hbi_iov++;
+  }
+  return v.hbi_iov - iov;
+}
@@ -19,6 +19,7 @@
 #ifndef HTSMSG_BINARY_H_
 #define HTSMSG_BINARY_H_
 
+#include <sys/uio.h>
 #include "htsmsg.h"
 
 /**
@@ -36,4 +37,18 @@ int htsmsg_binary_serialize0(htsmsg_t *msg, void **datap, size_t *lenp,
 int htsmsg_binary_serialize(htsmsg_t *msg, void **datap, size_t *lenp,
 			    int maxlen);
 
+/**
+ * Vectored serialization
+ *
+ * The binary fields with 'zcopy' or more bytes are not copied, the iovec
+ * array points to the field data. The rest is written to 'buf'.
+ * The buffer and iovec sizes are returned by htsmsg_binary_serialize_iov_size().
+ * The message must not be destroyed until the data are sent.
+ */
+int htsmsg_binary_serialize_iov_size(htsmsg_t *msg, size_t zcopy,
+                                     size_t *buflen, int *iovcnt, int maxlen);
+
+int htsmsg_binary_serialize_iov(htsmsg_t *msg, size_t zcopy,
+                                uint8_t *buf, struct iovec *iov);
+
 #endif /* HTSMSG_BINARY_H_ */
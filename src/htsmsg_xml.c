@@ -858,6 +858,279 @@ htsmsg_xml_deserialize(char *src, char *errbuf, size_t errbufsize)
   return NULL;
 }
 
+/* **************************************************************************
+ * Streaming
+ *
+ * The document is read from a descriptor in blocks; only the children
+ * of the root element are parsed to htsmsg (the same layout as the
+ * "tags" map of htsmsg_xml_deserialize). The elements complete in the
+ * read buffer are passed to the callback together before the next
+ * block is read, so the memory use is bounded by the largest element.
+ * *************************************************************************/
+
+#define XML_STREAM_BLOCK (64*1024)
+
+enum {
+  XML_STREAM_TEXT,
+  XML_STREAM_SKIP,
+  XML_STREAM_START,
+  XML_STREAM_END,
+  XML_STREAM_EMPTY,
+};
+
+/**
+ *
+ */
+static char *
+xml_stream_find(char *s, char *end, const char *pat, int len)
+{
+  for (end -= len - 1; s < end; s++) {
+    if ((s = memchr(s, pat[0], end - s)) == NULL)
+      return NULL;
+    if (!memcmp(s, pat, len))
+      return s;
+  }
+  return NULL;
+}
+
+/**
+ * Find the end of the markup (or text) at s, NULL if it is not
+ * complete in the buffer yet
+ */
+static char *
+xml_stream_item(char *s, char *end, int *type)
+{
+  char *p, q = 0;
+  int brackets = 0;
+
+  if (*s != '<') {
+    *type = XML_STREAM_TEXT;
+    return memchr(s, '<', end - s) ?: end;
+  }
+  if (end - s < 2)
+    return NULL;
+
+  *type = XML_STREAM_SKIP;
+  if (s[1] == '?') {
+    p = xml_stream_find(s + 2, end, "?>", 2);
+    return p ? p + 2 : NULL;
+  }
+
+  if (s[1] == '!') {
+    if (end - s < 4)
+      return NULL;
+    if (s[2] == '-' && s[3] == '-') {
+      p = xml_stream_find(s + 4, end, "-->", 3);
+      return p ? p + 3 : NULL;
+    }
+    if (s[2] == '[') {
+      p = xml_stream_find(s + 3, end, "]]>", 3);
+      return p ? p + 3 : NULL;
+    }
+    /* <!DOCTYPE> with the optional internal subset */
+    for (p = s + 2; p < end; p++) {
+      if (*p == '[') brackets++;
+      else if (*p == ']') brackets--;
+      else if (*p == '>' && brackets <= 0) return p + 1;
+    }
+    return NULL;
+  }
+
+  if (s[1] == '/') {
+    *type = XML_STREAM_END;
+    p = memchr(s, '>', end - s);
+    return p ? p + 1 : NULL;
+  }
+
+  *type = XML_STREAM_START;
+  for (p = s + 1; p < end; p++) {
+    if (q) {
+      if (*p == q) q = 0;
+    } else if (*p == '"' || *p == '\'') {
+      q = *p;
+    } else if (*p == '>') {
+      if (p[-1] == '/')
+        *type = XML_STREAM_EMPTY;
+      return p + 1;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Parse one child element of the root (src points to '<', the element
+ * ends at the terminating NUL), the strings point to the read buffer
+ */
+static int
+xml_stream_element(xmlparser_t *xp, char *src, htsmsg_t **tags)
+{
+  htsmsg_field_t *last;
+
+  if (*tags == NULL)
+    *tags = htsmsg_create_map();
+  last = TAILQ_LAST(&(*tags)->hm_fields, htsmsg_field_queue);
+  if (htsmsg_xml_parse_tag(xp, *tags, src + 1))
+    return 0;
+  /* drop the incomplete element */
+  if (TAILQ_LAST(&(*tags)->hm_fields, htsmsg_field_queue) != last)
+    htsmsg_field_destroy(*tags, TAILQ_LAST(&(*tags)->hm_fields, htsmsg_field_queue));
+  return -1;
+}
+
+/**
+ * Pass the parsed elements to the callback
+ */
+static void
+xml_stream_flush(htsmsg_t **tags, htsmsg_xml_stream_cb_t cb, void *opaque)
+{
+  if (*tags == NULL)
+    return;
+  cb(opaque, *tags);
+  htsmsg_destroy(*tags);
+  *tags = NULL;
+}
+
+/**
+ *
+ */
+int
+htsmsg_xml_deserialize_stream(int fd, htsmsg_xml_stream_cb_t cb, void *opaque,
+                              htsmsg_xml_stream_stats_t *stats,
+                              char *errbuf, size_t errbufsize)
+{
+  xmlparser_t xp;
+  htsmsg_t *tags = NULL;
+  char *buf = NULL, *n, *p, c;
+  size_t size = 0, len = 0, pos = 0, scan = 0, elem = 0;
+  int level = 0, depth = 0, type, eof = 0, bom = 1, r, ret = -1;
+
+  memset(&xp, 0, sizeof(xp));
+  xp.xp_encoding = XML_ENCODING_UTF8;
+  LIST_INIT(&xp.xp_namespaces);
+  memset(stats, 0, sizeof(*stats));
+
+  while (1) {
+
+    /* check for UTF-8 BOM */
+    if (bom && (len >= 3 || eof)) {
+      if (len >= 3 && !memcmp(buf, "\xef\xbb\xbf", 3))
+        pos = scan = 3;
+      bom = 0;
+    }
+
+    while (!bom && scan < len) {
+      if ((p = xml_stream_item(buf + scan, buf + len, &type)) == NULL)
+        break;
+
+      if (level == 0) {
+        /* prolog, parse it when the root element starts */
+        if (type == XML_STREAM_START || type == XML_STREAM_EMPTY) {
+          c = buf[scan];
+          buf[scan] = '\0';
+          n = htsmsg_parse_prolog(&xp, buf + pos);
+          buf[scan] = c;
+          if (n == NULL)
+            goto err;
+          if (type == XML_STREAM_EMPTY)
+            goto done;
+          level = 1;
+          pos = p - buf;
+        }
+        scan = p - buf;
+        continue;
+      }
+
+      if (depth == 0) {
+        if (type == XML_STREAM_END)
+          goto done;
+        if (type != XML_STREAM_START && type != XML_STREAM_EMPTY) {
+          pos = scan = p - buf;
+          continue;
+        }
+        elem = scan;
+      }
+      scan = p - buf;
+      if (type == XML_STREAM_START)
+        depth++;
+      else if (type == XML_STREAM_END)
+        depth--;
+      if (depth > 0)
+        continue;
+
+      c = buf[scan];
+      buf[scan] = '\0';
+      r = xml_stream_element(&xp, buf + elem, &tags);
+      buf[scan] = c;
+      if (r)
+        goto err;
+      stats->elements++;
+      pos = scan;
+    }
+
+    if (eof)
+      break;
+
+    /* the elements point to the buffer */
+    xml_stream_flush(&tags, cb, opaque);
+
+    /* drop the consumed data, make room for the next block */
+    if (pos > 0) {
+      memmove(buf, buf + pos, len - pos);
+      len  -= pos;
+      scan -= pos;
+      elem -= MIN(elem, pos);
+      pos   = 0;
+    }
+    if (size - len < XML_STREAM_BLOCK) {
+      size = MAX(size * 2, len + XML_STREAM_BLOCK);
+      if ((n = realloc(buf, size + 1)) == NULL) {
+        xmlerr(&xp, "Out of memory (%zu bytes)", size);
+        goto err;
+      }
+      buf = n;
+      stats->peak = MAX(stats->peak, size + 1);
+    }
+
+    r = read(fd, buf + len, size - len);
+    if (r < 0) {
+      if (ERRNO_AGAIN(errno))
+        continue;
+      xmlerr(&xp, "Read error: %s", strerror(errno));
+      goto err;
+    }
+    if (r == 0)
+      eof = 1;
+    len += r;
+    stats->bytes += r;
+  }
+
+  if (level == 0) {
+    xmlerr(&xp, "No root element");
+    goto err;
+  }
+
+  /* unterminated element, parse the rest like htsmsg_xml_deserialize */
+  if (depth > 0) {
+    buf[len] = '\0';
+    if (xml_stream_element(&xp, buf + elem, &tags))
+      goto err;
+    stats->elements++;
+  }
+
+done:
+  ret = 0;
+err:
+  xml_stream_flush(&tags, cb, opaque);
+  free(buf);
+  if (ret) {
+    snprintf(errbuf, errbufsize, "%s", xp.xp_errmsg);
+    for ( ; *errbuf; errbuf++)
+      if (*errbuf < ' ')
+        *errbuf = ' ';
+  }
+  return ret;
+}
+
 /*
  * Get cdata string field
  */
@@ -22,7 +22,18 @@
 #include "htsmsg.h"
 #include "htsbuf.h"
 
+typedef struct htsmsg_xml_stream_stats {
+  int64_t  bytes;    ///< Bytes read
+  size_t   peak;     ///< Peak size of the read buffer
+  uint32_t elements; ///< Root child elements parsed
+} htsmsg_xml_stream_stats_t;
+
+typedef void (*htsmsg_xml_stream_cb_t)(void *opaque, htsmsg_t *tags);
+
 htsmsg_t *htsmsg_xml_deserialize(char *src, char *errbuf, size_t errbufsize);
+int htsmsg_xml_deserialize_stream(int fd, htsmsg_xml_stream_cb_t cb, void *opaque,
+                                  htsmsg_xml_stream_stats_t *stats,
+                                  char *errbuf, size_t errbufsize);
 const char *htsmsg_xml_get_cdata_str (htsmsg_t *tags, const char *tag);
 int htsmsg_xml_get_cdata_u32 (htsmsg_t *tags, const char *tag, uint32_t *u32);
 const char *htsmsg_xml_get_attr_str(htsmsg_t *tag, const char *attr);
@@ -18,6 +18,9 @@
 
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 
 #include "tvheadend.h"
 #include "atomic.h"
@@ -61,6 +64,10 @@ static void *htsp_server, *htsp_server_2;
 
 #define HTSP_PRIV_MASK (ACCESS_HTSP_STREAMING)
 
+#define HTSP_WRITE_MSGS  32   /* messages per writev() burst */
+#define HTSP_WRITE_IOV   64
+#define HTSP_WRITE_ZCOPY 1024 /* binary fields sent without a copy */
+
 extern char *dvr_storage;
 
 LIST_HEAD(htsp_connection_list, htsp_connection);
@@ -3450,56 +3457,159 @@ send_reply_with_unlock:
 }
 
 /**
- *
+ * Pop the next message using the queue priorities
  */
-static void *
-htsp_write_scheduler(void *aux)
+static htsp_msg_t *
+htsp_write_next(htsp_connection_t *htsp)
 {
-  htsp_connection_t *htsp = aux;
   htsp_msg_q_t *hmq;
   htsp_msg_t *hm;
+
+  if((hmq = TAILQ_FIRST(&htsp->htsp_active_output_queues)) == NULL)
+    return NULL;
+
+  hm = TAILQ_FIRST(&hmq->hmq_q);
+  TAILQ_REMOVE(&hmq->hmq_q, hm, hm_link);
+  hmq->hmq_length--;
+  hmq->hmq_payload -= hm->hm_payloadsize;
+
+  TAILQ_REMOVE(&htsp->htsp_active_output_queues, hmq, hmq_link);
+  if(hmq->hmq_length) {
+    /* Still messages to be sent, put back in active queues */
+    if(hmq->hmq_strict_prio) {
+      TAILQ_INSERT_HEAD(&htsp->htsp_active_output_queues, hmq, hmq_link);
+    } else {
+      TAILQ_INSERT_TAIL(&htsp->htsp_active_output_queues, hmq, hmq_link);
+    }
+  }
+  return hm;
+}
+
+/**
+ * Keep the partial frames in the kernel while more messages are queued
+ */
+static void
+htsp_write_cork(htsp_connection_t *htsp, int *corked, int on)
+{
+#ifdef TCP_CORK
+  if (*corked != on) {
+    setsockopt(htsp->htsp_fd, IPPROTO_TCP, TCP_CORK, &on, sizeof(on));
+    *corked = on;
+  }
+#endif
+}
+
+/**
+ * Serialize and send the messages using one writev() call per burst,
+ * the large binary fields (packet payload) are not copied
+ */
+static int
+htsp_write_burst(htsp_connection_t *htsp, htsp_msg_t **hms, int count,
+                 uint8_t **bufp, size_t *bufsizep)
+{
+  struct iovec iov[HTSP_WRITE_IOV];
+  size_t buflens[HTSP_WRITE_MSGS], total = 0;
+  int iovcnts[HTSP_WRITE_MSGS];
+  uint8_t *ptr;
   void *dptr;
   size_t dlen;
-  int r;
+  int i, iovcnt = 0, r = 0, n = count;
+
+  for (i = 0; i < count; i++) {
+    if (htsmsg_binary_serialize_iov_size(hms[i]->hm_msg, HTSP_WRITE_ZCOPY,
+                                         &buflens[i], &iovcnts[i],
+                                         INT32_MAX) != 0) {
+      tvhwarn(LS_HTSP, "%s: failed to serialize data", htsp->htsp_logname);
+      iovcnts[i] = 0;
+      continue;
+    }
+    total += buflens[i];
+  }
+
+  /* the header buffer is allocated for the whole burst, iov points to it */
+  if (total > *bufsizep) {
+    ptr = realloc(*bufp, total);
+    if (ptr == NULL) {
+      r = -1;
+      count = 0;
+    } else {
+      *bufp = ptr;
+      *bufsizep = total;
+    }
+  }
+
+  for (i = 0, ptr = *bufp; i < count && r == 0; i++) {
+    if (iovcnts[i] == 0)
+      continue;
+    if (iovcnts[i] > HTSP_WRITE_IOV) {
+      /* too many binary fields, copy everything */
+      if (iovcnt > 0) {
+        r = tvh_writev(htsp->htsp_fd, iov, iovcnt);
+        iovcnt = 0;
+        if (r)
+          break;
+      }
+      if (htsmsg_binary_serialize(hms[i]->hm_msg, &dptr, &dlen, INT32_MAX) == 0) {
+        r = tvh_write(htsp->htsp_fd, dptr, dlen);
+        free(dptr);
+      }
+      ptr += buflens[i];
+      continue;
+    }
+    if (iovcnt + iovcnts[i] > HTSP_WRITE_IOV) {
+      r = tvh_writev(htsp->htsp_fd, iov, iovcnt);
+      iovcnt = 0;
+      if (r)
+        break;
+    }
+    iovcnt += htsmsg_binary_serialize_iov(hms[i]->hm_msg, HTSP_WRITE_ZCOPY,
+                                          ptr, iov + iovcnt);
+    ptr += buflens[i];
+  }
+  if (r == 0 && iovcnt > 0)
+    r = tvh_writev(htsp->htsp_fd, iov, iovcnt);
+
+  for (i = 0; i < n; i++)
+    htsp_msg_destroy(hms[i]);
+  return r;
+}
+
+/**
+ *
+ */
+static void *
+htsp_write_scheduler(void *aux)
+{
+  htsp_connection_t *htsp = aux;
+  htsp_msg_t *hm, *hms[HTSP_WRITE_MSGS];
+  uint8_t *buf = NULL;
+  size_t bufsize = 0;
+  int r, count, corked = 0;
 
   tvh_mutex_lock(&htsp->htsp_out_mutex);
 
   while(htsp->htsp_writer_run) {
 
-    if((hmq = TAILQ_FIRST(&htsp->htsp_active_output_queues)) == NULL) {
+    if(TAILQ_FIRST(&htsp->htsp_active_output_queues) == NULL) {
       /* Nothing to be done, go to sleep */
+      htsp_write_cork(htsp, &corked, 0);
       tvh_cond_wait(&htsp->htsp_out_cond, &htsp->htsp_out_mutex);
       continue;
     }
 
-    hm = TAILQ_FIRST(&hmq->hmq_q);
-    TAILQ_REMOVE(&hmq->hmq_q, hm, hm_link);
-    hmq->hmq_length--;
-    hmq->hmq_payload -= hm->hm_payloadsize;
-
-    TAILQ_REMOVE(&htsp->htsp_active_output_queues, hmq, hmq_link);
-    if(hmq->hmq_length) {
-      /* Still messages to be sent, put back in active queues */
-      if(hmq->hmq_strict_prio) {
-        TAILQ_INSERT_HEAD(&htsp->htsp_active_output_queues, hmq, hmq_link);
-      } else {
-        TAILQ_INSERT_TAIL(&htsp->htsp_active_output_queues, hmq, hmq_link);
-      }
+    for (count = 0; count < HTSP_WRITE_MSGS; count++) {
+      if ((hm = htsp_write_next(htsp)) == NULL)
+        break;
+      hms[count] = hm;
     }
+    /* more data are waiting - do not send the partial segments */
+    r = TAILQ_FIRST(&htsp->htsp_active_output_queues) != NULL;
 
     tvh_mutex_unlock(&htsp->htsp_out_mutex);
 
-    if (htsmsg_binary_serialize(hm->hm_msg, &dptr, &dlen, INT32_MAX) != 0) {
-      tvhwarn(LS_HTSP, "%s: failed to serialize data", htsp->htsp_logname);
-      htsp_msg_destroy(hm);
-      tvh_mutex_lock(&htsp->htsp_out_mutex);
-      continue;
-    }
-
-    htsp_msg_destroy(hm);
+    htsp_write_cork(htsp, &corked, r);
+    r = htsp_write_burst(htsp, hms, count, &buf, &bufsize);
 
-    r = tvh_write(htsp->htsp_fd, dptr, dlen);
-    free(dptr);
     tvh_mutex_lock(&htsp->htsp_out_mutex);
 
     if (r) {
@@ -3512,6 +3622,7 @@ htsp_write_scheduler(void *aux)
 
   shutdown(htsp->htsp_fd, SHUT_RDWR);
   tvh_mutex_unlock(&htsp->htsp_out_mutex);
+  free(buf);
   return NULL;
 }
 
@@ -2077,11 +2077,13 @@ http_serve(int fd, void **opaque, struct sockaddr_storage *peer,
 
   http_serve_requests(&hc);
 
-  close(fd);
+  if (!hc.hc_detached)
+    close(fd);
 
   // Note: leave global_lock held for parent
   tvh_mutex_lock(&global_lock);
-  *opaque = NULL;
+  if (!hc.hc_detached)
+    *opaque = NULL;
 }
 
 void
@@ -192,6 +192,7 @@ typedef struct http_connection {
   uint8_t hc_keep_alive;
   uint8_t hc_no_output;
   uint8_t hc_shutdown;
+  uint8_t hc_detached;      /*< the socket is owned by the streaming engine */
   uint8_t hc_is_local_ip;   /*< a connection from the local network */
 
   /* Support for HTTP POST */
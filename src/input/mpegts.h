@@ -36,6 +36,7 @@
 #define MPEGTS_TSID_NONE        0x10000
 #define MPEGTS_FULLMUX_PID      0x2000
 #define MPEGTS_TABLES_PID       0x2001
+#define MPEGTS_PID_TABLE_SIZE   0x2000
 #define MPEGTS_PID_NONE         0xFFFF
 
 /* Types */
@@ -126,13 +127,76 @@ int mpegts_pid_dump ( mpegts_apids_t *pids, char *buf, int len, int wflag, int r
 
 struct mpegts_packet
 {
-  TAILQ_ENTRY(mpegts_packet)  mp_link;
   size_t                      mp_len;
+  size_t                      mp_slot;  /* ring slot size, 0 = wrap marker */
   mpegts_mux_t               *mp_mux;
   uint8_t                     mp_cc_restart;
-  uint8_t                     mp_data[0];
+  uint8_t                     mp_ready; /* filled by the producer */
+  uint8_t                     mp_data[0] __attribute__((aligned(16)));
 };
 
+/*
+ * Preallocated per-input ring of mpegts_packet_t slots. The producers
+ * (frontend threads) reserve a slot under mi_input_lock, fill it without
+ * the lock and mark it ready under the lock again. The input thread
+ * processes the ready head slot in place and releases it afterwards.
+ */
+#define MPEGTS_INPUT_RING_SIZE  (50*1024*1024)
+#define MPEGTS_INPUT_RING_ALIGN 64
+
+typedef struct mpegts_input_ring {
+  uint8_t  *mir_data;
+  size_t    mir_size;
+  size_t    mir_head;   /* consumer offset */
+  size_t    mir_tail;   /* producer offset */
+  size_t    mir_used;   /* occupied bytes including wrap padding */
+} mpegts_input_ring_t;
+
+/*
+ * Optional demux worker pool. The input thread classifies the PIDs
+ * and queues the per-service work (ts_recv_packet1) for one input
+ * chunk, each service is bound to one worker for the whole chunk
+ * (per-service ordering). The input thread waits until all workers
+ * are finished, so the chunk data and services stay valid.
+ */
+#define MPEGTS_DEMUX_MAX_THREADS 16
+
+typedef struct mpegts_demux_job {
+  mpegts_service_t           *dj_service;
+  uint64_t                    dj_tspos;
+  const uint8_t              *dj_tsb;
+  int                         dj_len;
+  uint16_t                    dj_pid;
+  uint8_t                     dj_table;
+} mpegts_demux_job_t;
+
+typedef struct mpegts_demux_worker {
+  struct mpegts_demux_pool   *dw_pool;
+  pthread_t                   dw_tid;
+  int                         dw_run;
+  mpegts_demux_job_t         *dw_jobs;
+  int                         dw_count;
+  int                         dw_alloc;
+  uint64_t                    dw_load;       /* bytes in the current chunk */
+  /* statistics */
+  uint64_t                    dw_stat_jobs;
+  uint64_t                    dw_stat_bytes;
+  int64_t                     dw_stat_busy;  /* in microseconds */
+} mpegts_demux_worker_t;
+
+typedef struct mpegts_demux_pool {
+  tvh_mutex_t                 dp_lock;
+  tvh_cond_t                  dp_cond;
+  tvh_cond_t                  dp_done;
+  int                         dp_running;
+  int                         dp_pending;
+  int                         dp_queued;
+  uint32_t                    dp_gen;
+  int64_t                     dp_start;
+  int                         dp_count;
+  mpegts_demux_worker_t      *dp_workers;
+} mpegts_demux_pool_t;
+
 struct mpegts_pcr {
   int64_t  pcr_first;
   int64_t  pcr_last;
@@ -497,8 +561,7 @@ struct mpegts_mux
   uint64_t                    mm_input_pos;
   RB_HEAD(, mpegts_pid)       mm_pids;
   LIST_HEAD(, mpegts_pid_sub) mm_all_subs;
-  int                         mm_last_pid;
-  mpegts_pid_t               *mm_last_mp;
+  mpegts_pid_t              **mm_pid_table; /* direct PID index, see mm_pids */
 
   int                         mm_num_tables;
   LIST_HEAD(, mpegts_table)   mm_tables;
@@ -616,6 +679,13 @@ struct mpegts_service
    */
   int64_t  s_pcr_drift;
 
+  /**
+   * Demux worker pool binding (see mpegts_demux_pool_t),
+   * protected by mi_output_lock
+   */
+  uint32_t s_demux_gen;
+  int      s_demux_worker;
+
   /**
    * PMT/CAT monitoring
    */
@@ -707,11 +777,14 @@ struct mpegts_input
   mtimer_t                        mi_input_thread_start;
   tvh_mutex_t                     mi_input_lock;
   tvh_cond_t                      mi_input_cond;
-  TAILQ_HEAD(,mpegts_packet)      mi_input_queue;
+  mpegts_input_ring_t             mi_input_ring;
   uint64_t                        mi_input_queue_size;
+  int                             mi_input_waiting;
+  int                             mi_input_filling;
   tvhlog_limit_t                  mi_input_queue_loglimit;
   qprofile_t                      mi_qprofile;
   int                             mi_remove_scrambled_bits;
+  int                             mi_demux_threads;
 
   /* Data processing/output */
   // Note: this lock (mi_output_lock) protects all the remaining
@@ -721,6 +794,9 @@ struct mpegts_input
   /* Active sources */
   LIST_HEAD(,mpegts_mux_instance) mi_mux_active;
 
+  /* Demux workers (owned by the input thread) */
+  mpegts_demux_pool_t            *mi_demux_pool;
+
   /* Table processing */
   pthread_t                       mi_table_tid;
   tvh_cond_t                      mi_table_cond;
@@ -976,12 +1052,13 @@ mpegts_pid_t *mpegts_mux_find_pid_(mpegts_mux_t *mm, int pid, int create);
 static inline mpegts_pid_t *
 mpegts_mux_find_pid(mpegts_mux_t *mm, int pid, int create)
 {
-  if (mm->mm_last_pid != pid)
-    return mpegts_mux_find_pid_(mm, pid, create);
-  else
-    return mm->mm_last_mp;
+  if ((unsigned int)pid < MPEGTS_PID_TABLE_SIZE && !create)
+    return mm->mm_pid_table ? mm->mm_pid_table[pid] : NULL;
+  return mpegts_mux_find_pid_(mm, pid, create);
 }
 
+void mpegts_mux_remove_pid(mpegts_mux_t *mm, mpegts_pid_t *mp);
+
 void mpegts_mux_update_pids ( mpegts_mux_t *mm );
 
 void mpegts_input_create_mux_instance ( mpegts_input_t *mi, mpegts_mux_t *mm );
@@ -995,6 +1072,14 @@ void mpegts_input_recv_packets
 void mpegts_input_postdemux
   ( mpegts_input_t *mi, mpegts_mux_t *mm, uint8_t *data, int len );
 
+mpegts_demux_pool_t *mpegts_demux_pool_create ( const char *name, int count );
+void mpegts_demux_pool_destroy ( mpegts_demux_pool_t *dp );
+void mpegts_demux_pool_queue
+  ( mpegts_demux_pool_t *dp, mpegts_service_t *s, uint64_t tspos,
+    uint16_t pid, const uint8_t *tsb, int len, int table );
+void mpegts_demux_pool_run ( mpegts_demux_pool_t *dp );
+void mpegts_demux_pool_load ( mpegts_demux_pool_t *dp, char *buf, size_t len );
+
 int mpegts_input_get_weight ( mpegts_input_t *mi, mpegts_mux_t *mm, int flags, int weight );
 int mpegts_input_get_priority ( mpegts_input_t *mi, mpegts_mux_t *mm, int flags );
 int mpegts_input_get_grace ( mpegts_input_t *mi, mpegts_mux_t *mm );
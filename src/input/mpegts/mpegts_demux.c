@@ -0,0 +1,198 @@
+/*
+ *  Tvheadend - MPEGTS demux worker pool
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input.h"
+#include "tsdemux.h"
+
+/*
+ * Worker
+ */
+static void *
+mpegts_demux_worker_thread ( void *aux )
+{
+  mpegts_demux_worker_t *dw = aux;
+  mpegts_demux_pool_t *dp = dw->dw_pool;
+  mpegts_demux_job_t *dj, *end;
+  uint64_t bytes;
+  int64_t start;
+
+  tvh_mutex_lock(&dp->dp_lock);
+  while (dp->dp_running) {
+    if (!dw->dw_run) {
+      tvh_cond_wait(&dp->dp_cond, &dp->dp_lock);
+      continue;
+    }
+    tvh_mutex_unlock(&dp->dp_lock);
+
+    start = getfastmonoclock();
+    bytes = 0;
+    for (dj = dw->dw_jobs, end = dj + dw->dw_count; dj != end; dj++) {
+      ts_recv_packet1(dj->dj_service, dj->dj_tspos, dj->dj_pid,
+                      dj->dj_tsb, dj->dj_len, dj->dj_table);
+      bytes += dj->dj_len;
+    }
+
+    tvh_mutex_lock(&dp->dp_lock);
+    dw->dw_stat_jobs += dw->dw_count;
+    dw->dw_stat_bytes += bytes;
+    dw->dw_stat_busy += getfastmonoclock() - start;
+    dw->dw_count = 0;
+    dw->dw_load = 0;
+    dw->dw_run = 0;
+    if (--dp->dp_pending == 0)
+      tvh_cond_signal(&dp->dp_done, 0);
+  }
+  tvh_mutex_unlock(&dp->dp_lock);
+  return NULL;
+}
+
+/*
+ * Pool
+ */
+mpegts_demux_pool_t *
+mpegts_demux_pool_create ( const char *name, int count )
+{
+  mpegts_demux_pool_t *dp;
+  mpegts_demux_worker_t *dw;
+  int i;
+
+  if (count <= 0)
+    return NULL;
+  count = MIN(count, MPEGTS_DEMUX_MAX_THREADS);
+
+  dp = calloc(1, sizeof(*dp));
+  tvh_mutex_init(&dp->dp_lock, NULL);
+  tvh_cond_init(&dp->dp_cond, 1);
+  tvh_cond_init(&dp->dp_done, 1);
+  dp->dp_running = 1;
+  dp->dp_gen     = 1;
+  dp->dp_start   = getfastmonoclock();
+  dp->dp_count   = count;
+  dp->dp_workers = calloc(count, sizeof(mpegts_demux_worker_t));
+  for (i = 0; i < count; i++) {
+    dw = &dp->dp_workers[i];
+    dw->dw_pool = dp;
+    tvh_thread_create(&dw->dw_tid, NULL, mpegts_demux_worker_thread, dw, "mi-demux");
+  }
+  tvhdebug(LS_MPEGTS, "%s: started %d demux threads", name, count);
+  return dp;
+}
+
+void
+mpegts_demux_pool_destroy ( mpegts_demux_pool_t *dp )
+{
+  int i;
+
+  if (dp == NULL)
+    return;
+  mpegts_demux_pool_run(dp);
+  tvh_mutex_lock(&dp->dp_lock);
+  dp->dp_running = 0;
+  tvh_cond_signal(&dp->dp_cond, 1);
+  tvh_mutex_unlock(&dp->dp_lock);
+  for (i = 0; i < dp->dp_count; i++) {
+    pthread_join(dp->dp_workers[i].dw_tid, NULL);
+    free(dp->dp_workers[i].dw_jobs);
+  }
+  tvh_cond_destroy(&dp->dp_done);
+  tvh_cond_destroy(&dp->dp_cond);
+  tvh_mutex_destroy(&dp->dp_lock);
+  free(dp->dp_workers);
+  free(dp);
+}
+
+void
+mpegts_demux_pool_queue
+  ( mpegts_demux_pool_t *dp, mpegts_service_t *s, uint64_t tspos,
+    uint16_t pid, const uint8_t *tsb, int len, int table )
+{
+  mpegts_demux_worker_t *dw;
+  mpegts_demux_job_t *dj;
+  int i;
+
+  /* Bind the service to the least loaded worker for this chunk */
+  if (s->s_demux_gen != dp->dp_gen || s->s_demux_worker >= dp->dp_count) {
+    s->s_demux_gen = dp->dp_gen;
+    s->s_demux_worker = 0;
+    for (i = 1; i < dp->dp_count; i++)
+      if (dp->dp_workers[i].dw_load < dp->dp_workers[s->s_demux_worker].dw_load)
+        s->s_demux_worker = i;
+  }
+  dw = &dp->dp_workers[s->s_demux_worker];
+
+  if (dw->dw_count >= dw->dw_alloc) {
+    dw->dw_alloc = MAX(64, dw->dw_alloc * 2);
+    dw->dw_jobs = realloc(dw->dw_jobs, dw->dw_alloc * sizeof(mpegts_demux_job_t));
+  }
+  dj = &dw->dw_jobs[dw->dw_count++];
+  dj->dj_service = s;
+  dj->dj_tspos   = tspos;
+  dj->dj_tsb     = tsb;
+  dj->dj_len     = len;
+  dj->dj_pid     = pid;
+  dj->dj_table   = table;
+  dw->dw_load   += len;
+  dp->dp_queued  = 1;
+}
+
+void
+mpegts_demux_pool_run ( mpegts_demux_pool_t *dp )
+{
+  mpegts_demux_worker_t *dw;
+  int i;
+
+  if (dp == NULL || !dp->dp_queued)
+    return;
+  tvh_mutex_lock(&dp->dp_lock);
+  for (i = 0; i < dp->dp_count; i++) {
+    dw = &dp->dp_workers[i];
+    if (dw->dw_count > 0) {
+      dw->dw_run = 1;
+      dp->dp_pending++;
+    }
+  }
+  tvh_cond_signal(&dp->dp_cond, 1);
+  while (dp->dp_pending > 0)
+    tvh_cond_wait(&dp->dp_done, &dp->dp_lock);
+  tvh_mutex_unlock(&dp->dp_lock);
+  /* new service to worker bindings for the next chunk */
+  dp->dp_gen++;
+  dp->dp_queued = 0;
+}
+
+void
+mpegts_demux_pool_load ( mpegts_demux_pool_t *dp, char *buf, size_t len )
+{
+  mpegts_demux_worker_t *dw;
+  int64_t elapsed;
+  size_t l = 0;
+  int i;
+
+  *buf = '\0';
+  if (dp == NULL)
+    return;
+  tvh_mutex_lock(&dp->dp_lock);
+  elapsed = MAX(1, getfastmonoclock() - dp->dp_start);
+  for (i = 0; i < dp->dp_count; i++) {
+    dw = &dp->dp_workers[i];
+    tvh_strlcatf(buf, len, l, "%s#%d: %d%% (%"PRIu64" jobs, %"PRIu64" KiB)",
+                 i ? ", " : "", i,
+                 (int)((dw->dw_stat_busy * 100) / elapsed),
+                 dw->dw_stat_jobs, dw->dw_stat_bytes / 1024);
+  }
+  tvh_mutex_unlock(&dp->dp_lock);
+}
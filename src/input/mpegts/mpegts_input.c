@@ -26,6 +26,7 @@
 
 memoryinfo_t mpegts_input_queue_memoryinfo = { .my_name = "MPEG-TS input queue" };
 memoryinfo_t mpegts_input_table_memoryinfo = { .my_name = "MPEG-TS table queue" };
+memoryinfo_t mpegts_input_ring_memoryinfo = { .my_name = "MPEG-TS input ring" };
 
 static void
 mpegts_input_del_network ( mpegts_network_link_t *mnl );
@@ -193,6 +194,17 @@ mpegts_input_class_linked_get ( void *self )
   return &prop_sbuf_ptr;
 }
 
+static const void *
+mpegts_input_class_demux_load_get ( void *self )
+{
+  mpegts_input_t *mi = self;
+
+  tvh_mutex_lock(&mi->mi_output_lock);
+  mpegts_demux_pool_load(mi->mi_demux_pool, prop_sbuf, PROP_SBUF_LEN);
+  tvh_mutex_unlock(&mi->mi_output_lock);
+  return &prop_sbuf_ptr;
+}
+
 static htsmsg_t *
 mpegts_input_class_linked_enum( void * self, const char *lang )
 {
@@ -331,6 +343,27 @@ const idclass_t mpegts_input_class =
       .def.i    = 1,
       .opts     = PO_EXPERT,
     },
+    {
+      .type     = PT_INT,
+      .id       = "demux_threads",
+      .name     = N_("Demux threads"),
+      .desc     = N_("Number of worker threads sharing the per-service "
+                     "processing (descrambling, parsing and delivery) of "
+                     "the received multiplex. Zero means that everything "
+                     "is processed in the input thread (default). Useful "
+                     "for busy multiplexes with many concurrently used "
+                     "services (maximum 16)."),
+      .off      = offsetof(mpegts_input_t, mi_demux_threads),
+      .opts     = PO_EXPERT,
+    },
+    {
+      .type     = PT_STR,
+      .id       = "demux_load",
+      .name     = N_("Demux thread load"),
+      .desc     = N_("Busy time, processed chunks and data per demux thread."),
+      .get      = mpegts_input_class_demux_load_get,
+      .opts     = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+    },
     {
       .type     = PT_STR,
       .id       = "networks",
@@ -592,10 +625,6 @@ mpegts_input_close_pid
     skel.mps_weight = -1;
     skel.mps_owner  = owner;
     mps = RB_FIND(&mp->mp_subs, &skel, mps_link, mpegts_mps_cmp);
-    if (pid == mm->mm_last_pid) {
-      mm->mm_last_pid = -1;
-      mm->mm_last_mp = NULL;
-    }
     if (mps) {
       tvhdebug(LS_MPEGTS, "%s - close PID %04X (%d) [%d/%p]",
                mm->mm_nicename, mp->mp_pid, mp->mp_pid, type, owner);
@@ -609,12 +638,7 @@ mpegts_input_close_pid
     }
   }
   if (!RB_FIRST(&mp->mp_subs)) {
-    if (mm->mm_last_pid == mp->mp_pid) {
-      mm->mm_last_pid = -1;
-      mm->mm_last_mp = NULL;
-    }
-    RB_REMOVE(&mm->mm_pids, mp, mp_link);
-    free(mp);
+    mpegts_mux_remove_pid(mm, mp);
     return 1;
   } else {
     type = 0;
@@ -1168,33 +1192,157 @@ ts_sync_count ( const uint8_t *tsb, int len )
   return tsb - start;
 }
 
+/*
+ * Input ring
+ */
+
+static mpegts_packet_t *
+mpegts_input_ring_alloc ( mpegts_input_ring_t *r, size_t len )
+{
+  size_t slot, pos;
+  mpegts_packet_t *mp;
+
+  slot = (sizeof(mpegts_packet_t) + len + MPEGTS_INPUT_RING_ALIGN - 1) &
+         ~((size_t)MPEGTS_INPUT_RING_ALIGN - 1);
+
+  if (r->mir_data == NULL) {
+    if (posix_memalign((void **)&r->mir_data, MPEGTS_INPUT_RING_ALIGN,
+                       MPEGTS_INPUT_RING_SIZE))
+      return NULL;
+    r->mir_size = MPEGTS_INPUT_RING_SIZE;
+    r->mir_head = r->mir_tail = r->mir_used = 0;
+    memoryinfo_alloc(&mpegts_input_ring_memoryinfo, r->mir_size);
+  }
+
+  /* Rewind when empty, so only the peak backlog touches the pages */
+  if (r->mir_used == 0)
+    r->mir_head = r->mir_tail = 0;
+
+  pos = r->mir_tail;
+  if (r->mir_tail > r->mir_head || r->mir_used == 0) {
+    if (r->mir_size - pos < slot) {
+      if (r->mir_head < slot)
+        return NULL;
+      /* not enough room at the end, continue from the start */
+      if (r->mir_size - pos >= sizeof(mpegts_packet_t))
+        ((mpegts_packet_t *)(r->mir_data + pos))->mp_slot = 0;
+      r->mir_used += r->mir_size - pos;
+      pos = 0;
+    }
+  } else if (r->mir_head - pos < slot) {
+    return NULL;
+  }
+
+  mp = (mpegts_packet_t *)(r->mir_data + pos);
+  mp->mp_slot = slot;
+  r->mir_tail = pos + slot;
+  r->mir_used += slot;
+  return mp;
+}
+
+static mpegts_packet_t *
+mpegts_input_ring_next ( mpegts_input_ring_t *r, size_t *pos, size_t *left )
+{
+  mpegts_packet_t *mp;
+  size_t pad;
+
+  if (*left == 0)
+    return NULL;
+  pad = r->mir_size - *pos;
+  if (pad < sizeof(mpegts_packet_t) ||
+      ((mpegts_packet_t *)(r->mir_data + *pos))->mp_slot == 0) {
+    *left -= pad;
+    *pos = 0;
+  }
+  mp = (mpegts_packet_t *)(r->mir_data + *pos);
+  *pos += mp->mp_slot;
+  *left -= mp->mp_slot;
+  return mp;
+}
+
+static mpegts_packet_t *
+mpegts_input_ring_head ( mpegts_input_ring_t *r )
+{
+  size_t pad;
+
+  if (r->mir_used == 0)
+    return NULL;
+  pad = r->mir_size - r->mir_head;
+  if (pad < sizeof(mpegts_packet_t) ||
+      ((mpegts_packet_t *)(r->mir_data + r->mir_head))->mp_slot == 0) {
+    r->mir_used -= pad;
+    r->mir_head = 0;
+  }
+  return (mpegts_packet_t *)(r->mir_data + r->mir_head);
+}
+
+static void
+mpegts_input_ring_release ( mpegts_input_ring_t *r, mpegts_packet_t *mp )
+{
+  assert((uint8_t *)mp == r->mir_data + r->mir_head);
+  r->mir_head += mp->mp_slot;
+  r->mir_used -= mp->mp_slot;
+  if (r->mir_used == 0)
+    r->mir_head = r->mir_tail = 0;
+}
+
+static void
+mpegts_input_ring_free ( mpegts_input_ring_t *r )
+{
+  if (r->mir_data) {
+    memoryinfo_free(&mpegts_input_ring_memoryinfo, r->mir_size);
+    free(r->mir_data);
+  }
+  memset(r, 0, sizeof(*r));
+}
+
 static void
 mpegts_input_queue_packets
-  ( mpegts_mux_instance_t *mmi, mpegts_packet_t *mp )
+  ( mpegts_mux_instance_t *mmi, const uint8_t *tsb, int len, int flags )
 {
   mpegts_input_t *mi = mmi->mmi_input;
   const char *id = SRCLINEID();
-  int len = mp->mp_len;
+  mpegts_packet_t *mp;
+  uint8_t *tmp, *end;
 
   tvh_mutex_lock(&mi->mi_input_lock);
-  if (mmi->mmi_mux->mm_active == mmi) {
-    if (mi->mi_input_queue_size < 50*1024*1024) {
-      mi->mi_input_queue_size += len;
-      memoryinfo_alloc(&mpegts_input_queue_memoryinfo, sizeof(mpegts_packet_t) + len);
-      mpegts_mux_grab(mp->mp_mux);
-      TAILQ_INSERT_TAIL(&mi->mi_input_queue, mp, mp_link);
-      tprofile_queue_add(&mi->mi_qprofile, id, len);
-      tprofile_queue_set(&mi->mi_qprofile, id, mi->mi_input_queue_size);
-      tvh_cond_signal(&mi->mi_input_cond, 0);
-    } else {
-      if (tvhlog_limit(&mi->mi_input_queue_loglimit, 10))
-        tvhwarn(LS_MPEGTS, "too much queued input data (over 50MB) for %s, discarding new", mi->mi_name);
-      tprofile_queue_drop(&mi->mi_qprofile, id, len);
-      free(mp);
-    }
-  } else {
-    free(mp);
+  if (mmi->mmi_mux->mm_active != mmi) {
+    tvh_mutex_unlock(&mi->mi_input_lock);
+    return;
   }
+  if ((mp = mpegts_input_ring_alloc(&mi->mi_input_ring, len)) == NULL) {
+    if (tvhlog_limit(&mi->mi_input_queue_loglimit, 10))
+      tvhwarn(LS_MPEGTS, "input ring full (%zu bytes queued) for %s, discarding new",
+              mi->mi_input_ring.mir_used, mi->mi_name);
+    tprofile_queue_drop(&mi->mi_qprofile, id, len);
+    tvh_mutex_unlock(&mi->mi_input_lock);
+    return;
+  }
+  mp->mp_mux        = mmi->mmi_mux;
+  mp->mp_len        = len;
+  mp->mp_cc_restart = (flags & MPEGTS_DATA_CC_RESTART) ? 1 : 0;
+  mp->mp_ready      = 0;
+  mi->mi_input_queue_size += mp->mp_slot;
+  mi->mi_input_filling++;
+  memoryinfo_alloc(&mpegts_input_queue_memoryinfo, mp->mp_slot);
+  mpegts_mux_grab(mp->mp_mux);
+  tprofile_queue_add(&mi->mi_qprofile, id, len);
+  tprofile_queue_set(&mi->mi_qprofile, id, mi->mi_input_queue_size);
+  tvh_mutex_unlock(&mi->mi_input_lock);
+
+  /* The reserved slot is owned by this producer until it's ready */
+  memcpy(mp->mp_data, tsb, len);
+  if (mi->mi_remove_scrambled_bits || (flags & MPEGTS_DATA_REMOVE_SCRAMBLED) != 0)
+    for (tmp = mp->mp_data, end = mp->mp_data + len; tmp < end; tmp += 188)
+      tmp[3] &= ~0xc0;
+  if ((flags & MPEGTS_DATA_CC_RESTART) == 0 && data_noise(mp))
+    mp->mp_len = 0;
+
+  tvh_mutex_lock(&mi->mi_input_lock);
+  mp->mp_ready = 1;
+  mi->mi_input_filling--;
+  if (mi->mi_input_waiting)
+    tvh_cond_signal(&mi->mi_input_cond, 0);
   tvh_mutex_unlock(&mi->mi_input_lock);
 }
 
@@ -1205,7 +1353,6 @@ mpegts_input_recv_packets
 {
   mpegts_input_t *mi = mmi->mmi_input;
   int len, len2, off;
-  mpegts_packet_t *mp;
   uint8_t *tsb;
 #define MIN_TS_PKT 100
 #define MIN_TS_SYN (5*188)
@@ -1266,31 +1413,12 @@ retry:
 
   /* Pass */
   if (len2 >= MIN_TS_SYN || (flags & MPEGTS_DATA_CC_RESTART)) {
-    mp = malloc(sizeof(mpegts_packet_t) + len2);
-    mp->mp_mux        = mmi->mmi_mux;
-    mp->mp_len        = len2;
-    mp->mp_cc_restart = (flags & MPEGTS_DATA_CC_RESTART) ? 1 : 0;
-
-    memcpy(mp->mp_data, tsb, len2);
-    if (mi->mi_remove_scrambled_bits || (flags & MPEGTS_DATA_REMOVE_SCRAMBLED) != 0) {
-      uint8_t *tmp, *end;
-      for (tmp = mp->mp_data, end = mp->mp_data + len2; tmp < end; tmp += 188)
-        tmp[3] &= ~0xc0;
-    }
-
+    mpegts_input_queue_packets(mmi, tsb, len2, flags);
     len -= len2;
     off += len2;
-
-    if ((flags & MPEGTS_DATA_CC_RESTART) == 0 && data_noise(mp)) {
-      free(mp);
-      goto end;
-    }
-
-    mpegts_input_queue_packets(mmi, mp);
   }
 
   /* Adjust buffer */
-end:
   if (len && (flags & MPEGTS_DATA_CC_RESTART) == 0) {
     sbuf_cut(sb, off); // cut off the bottom
     if (sb->sb_ptr >= MIN_TS_PKT * 188)
@@ -1415,21 +1543,35 @@ mpegts_input_table_waiting ( mpegts_input_t *mi, mpegts_mux_t *mm )
   tvh_mutex_unlock(&mm->mm_tables_lock);
 }
 
+static inline void
+mpegts_input_recv_packet1
+  ( mpegts_input_t *mi, mpegts_service_t *s, uint64_t tspos,
+    uint16_t pid, const uint8_t *tsb, int len, int table )
+{
+  /* slaves feed their masters, keep them on the input thread */
+  if (mi->mi_demux_pool && s->s_masters.is_count == 0)
+    mpegts_demux_pool_queue(mi->mi_demux_pool, s, tspos, pid, tsb, len, table);
+  else
+    ts_recv_packet1(s, tspos, pid, tsb, len, table);
+}
+
 static int
 mpegts_input_process
-  ( mpegts_input_t *mi, mpegts_packet_t *mpkt )
+  ( mpegts_input_t *mi, mpegts_mux_t *mm, mpegts_packet_t *mpkt )
 {
   uint16_t pid, pid2;
   uint8_t cc, cc2;
-  uint8_t *tsb = mpkt->mp_data, *tsb2, *tsb2_end;
-  int len = mpkt->mp_len, llen;
+  uint8_t *tsb = mpkt->mp_data;
+  int len = mpkt->mp_len, llen, i, npkt;
+  int hidx = 0, hcount = 0;
+  uint16_t hpid[TS_HDR_BATCH];
+  uint8_t hflags[TS_HDR_BATCH];
   int type = 0, f;
   mpegts_pid_t *mp;
   mpegts_pid_sub_t *mps;
   service_t *s;
   elementary_stream_t *st;
   int table_wakeup = 0;
-  mpegts_mux_t *mm = mpkt->mp_mux;
   mpegts_mux_instance_t *mmi;
   mpegts_table_feed_t *mtf;
   uint64_t tspos;
@@ -1459,26 +1601,30 @@ mpegts_input_process
   assert((len % 188) == 0);
   while (len > 0) {
 
+    /* Decode the next batch of headers */
+    if (hidx >= hcount) {
+      hcount = MIN(len / 188, TS_HDR_BATCH);
+      mpegts_hdr_decode(tsb, hcount, hpid, hflags);
+      hidx = 0;
+    }
+
     /*
-     * mask
-     *  0 - 0xFF - sync word 0x47
-     *  1 - 0x80 - transport error
-     *  1 - 0x1F - pid high
-     *  2 - 0xFF - pid low
-     *  3 - 0xC0 - scrambled
-     *  3 - 0x10 - CC check
+     * run of packets with the same
+     *  - sync word 0x47, transport error, pid
+     *  - scrambled (0xC0) and CC check (0x10) bits
      */
-    llen = mpegts_word_count(tsb, len, 0xFF9FFFD0);
+    npkt = mpegts_hdr_run(hpid + hidx, hflags + hidx, hcount - hidx, 0xFFFF, 0xD0);
+    llen = npkt * 188;
 
-    pid = (tsb[1] << 8) | tsb[2];
+    pid = hpid[hidx];
 
     /* Transport error */
-    if (pid & 0x8000) {
-      if ((pid & 0x1FFF) != 0x1FFF)
+    if (pid & TS_HDR_TEI) {
+      if ((pid & TS_HDR_PID) != 0x1FFF)
         atomic_add(&mmi->tii_stats.te, 1);
     }
 
-    pid &= 0x1FFF;
+    pid &= TS_HDR_PID;
 
     /* Ignore NULL packets */
     if (pid == 0x1FFF) {
@@ -1491,10 +1637,9 @@ mpegts_input_process
     if ((mp = mpegts_mux_find_pid(mm, pid, 0))) {
 
       /* Low level CC check */
-      if (tsb[3] & 0x10) {
-        for (tsb2 = tsb, tsb2_end = tsb + llen, cc2 = mp->mp_cc;
-             tsb2 < tsb2_end; tsb2 += 188) {
-          cc = tsb2[3] & 0x0f;
+      if (hflags[hidx] & 0x10) {
+        for (i = hidx, cc2 = mp->mp_cc; i < hidx + npkt; i++) {
+          cc = hflags[i] & 0x0f;
           if (cc2 != 0xff && cc2 != cc) {
             tvhtrace(LS_MPEGTS, "%s: pid %04X cc err %2d != %2d", mm->mm_nicename, pid, cc, cc2);
             atomic_add(&mmi->tii_stats.cc, 1);
@@ -1524,7 +1669,7 @@ mpegts_input_process
           f = (type & (MPS_TABLE|MPS_FTABLE)) ||
               (pid == s->s_components.set_pmt_pid) ||
               (pid == s->s_components.set_pcr_pid);
-          ts_recv_packet1((mpegts_service_t*)s, tspos, pid, tsb, llen, f);
+          mpegts_input_recv_packet1(mi, (mpegts_service_t*)s, tspos, pid, tsb, llen, f);
         }
       } else
       /* Stream table data */
@@ -1534,15 +1679,18 @@ mpegts_input_process
           f = (type & (MPS_TABLE|MPS_FTABLE)) ||
               (pid == s->s_components.set_pmt_pid) ||
               (pid == s->s_components.set_pcr_pid);
-          ts_recv_packet1((mpegts_service_t*)s, tspos, pid, tsb, llen, f);
+          mpegts_input_recv_packet1(mi, (mpegts_service_t*)s, tspos, pid, tsb, llen, f);
         }
       }
 
       /* Table data */
       if (type & (MPS_TABLE | MPS_FTABLE)) {
         if (!(tsb[1] & 0x80)) {
-          if (type & MPS_FTABLE)
+          if (type & MPS_FTABLE) {
+            /* services must see the table changes in the stream order */
+            mpegts_demux_pool_run(mi->mi_demux_pool);
             mpegts_input_table_dispatch(mm, mm->mm_nicename, tsb, llen, 1);
+          }
           if (type & MPS_TABLE) {
             if (mi->mi_table_queue_size >= 2*1024*1024) {
               if (tvhlog_limit(&mi->mi_input_queue_loglimit, 10)) {
@@ -1585,11 +1733,15 @@ mpegts_input_process
     }
 
 done:
+    hidx += npkt;
     tsb += llen;
     len -= llen;
     tspos += llen;
   }
 
+  /* Wait for the demux workers */
+  mpegts_demux_pool_run(mi->mi_demux_pool);
+
   /* Raw stream */
   if (tsb != mpkt->mp_data &&
       LIST_FIRST(&mmi->mmi_streaming_pad.sp_targets) != NULL) {
@@ -1702,7 +1854,8 @@ mpegts_input_thread ( void * p )
 {
   mpegts_packet_t *mp;
   mpegts_input_t *mi = p;
-  size_t bytes = 0;
+  mpegts_mux_t *mm;
+  size_t bytes = 0, pos, left;
   int update_pids;
   tprofile_t tprofile;
   char buf[256];
@@ -1716,45 +1869,52 @@ mpegts_input_thread ( void * p )
   tvh_mutex_lock(&mi->mi_input_lock);
   while (atomic_get(&mi->mi_running)) {
 
-    /* Wait for a packet */
-    if (!(mp = TAILQ_FIRST(&mi->mi_input_queue))) {
+    /* Wait for a packet (slots are filled in the reservation order) */
+    if (!(mp = mpegts_input_ring_head(&mi->mi_input_ring)) || !mp->mp_ready) {
       if (bytes) {
         tvhtrace(LS_MPEGTS, "input %s got %zu bytes", buf, bytes);
         bytes = 0;
       }
+      mi->mi_input_waiting = 1;
       tvh_cond_wait(&mi->mi_input_cond, &mi->mi_input_lock);
+      mi->mi_input_waiting = 0;
       continue;
     }
-    mi->mi_input_queue_size -= mp->mp_len;
-    memoryinfo_free(&mpegts_input_queue_memoryinfo, sizeof(mpegts_packet_t) + mp->mp_len);
-    TAILQ_REMOVE(&mi->mi_input_queue, mp, mp_link);
+    /* Take over the mux reference, the slot stays in the ring */
+    /* until it's processed (see mpegts_input_flush_mux) */
+    mm = mp->mp_mux;
+    mp->mp_mux = NULL;
     tvh_mutex_unlock(&mi->mi_input_lock);
-      
+
     /* Process */
     tvh_mutex_lock(&mi->mi_output_lock);
-    mpegts_input_table_waiting(mi, mp->mp_mux);
-    if (mp->mp_mux && mp->mp_mux->mm_update_pids_flag) {
+    if ((mi->mi_demux_pool ? mi->mi_demux_pool->dp_count : 0) !=
+        MINMAX(mi->mi_demux_threads, 0, MPEGTS_DEMUX_MAX_THREADS)) {
+      mpegts_demux_pool_destroy(mi->mi_demux_pool);
+      mi->mi_demux_pool = mpegts_demux_pool_create(buf, mi->mi_demux_threads);
+    }
+    mpegts_input_table_waiting(mi, mm);
+    if (mm && mm->mm_update_pids_flag) {
       tvh_mutex_unlock(&mi->mi_output_lock);
       tvh_mutex_lock(&global_lock);
-      mpegts_mux_update_pids(mp->mp_mux);
+      mpegts_mux_update_pids(mm);
       tvh_mutex_unlock(&global_lock);
       tvh_mutex_lock(&mi->mi_output_lock);
     }
     tprofile_start(&tprofile, "input");
-    bytes += mpegts_input_process(mi, mp);
+    bytes += mpegts_input_process(mi, mm, mp);
     tprofile_finish(&tprofile);
-    update_pids = mp->mp_mux && mp->mp_mux->mm_update_pids_flag;
+    update_pids = mm && mm->mm_update_pids_flag;
     tvh_mutex_unlock(&mi->mi_output_lock);
     if (update_pids) {
       tvh_mutex_lock(&global_lock);
-      mpegts_mux_update_pids(mp->mp_mux);
+      mpegts_mux_update_pids(mm);
       tvh_mutex_unlock(&global_lock);
     }
 
     /* Cleanup */
-    if (mp->mp_mux)
-      mpegts_mux_release(mp->mp_mux);
-    free(mp);
+    if (mm)
+      mpegts_mux_release(mm);
 
 #if ENABLE_TSDEBUG
     {
@@ -1764,18 +1924,33 @@ mpegts_input_thread ( void * p )
 #endif
 
     tvh_mutex_lock(&mi->mi_input_lock);
+    mi->mi_input_queue_size -= mp->mp_slot;
+    memoryinfo_free(&mpegts_input_queue_memoryinfo, mp->mp_slot);
+    mpegts_input_ring_release(&mi->mi_input_ring, mp);
   }
 
   tvhtrace(LS_MPEGTS, "input %s got %zu bytes (finish)", buf, bytes);
 
-  /* Flush */
-  while ((mp = TAILQ_FIRST(&mi->mi_input_queue))) {
-    memoryinfo_free(&mpegts_input_queue_memoryinfo, sizeof(mpegts_packet_t) + mp->mp_len);
-    TAILQ_REMOVE(&mi->mi_input_queue, mp, mp_link);
+  tvh_mutex_lock(&mi->mi_output_lock);
+  mpegts_demux_pool_destroy(mi->mi_demux_pool);
+  mi->mi_demux_pool = NULL;
+  tvh_mutex_unlock(&mi->mi_output_lock);
+
+  /* Flush (wait for the producers still filling a reserved slot) */
+  while (mi->mi_input_filling > 0) {
+    mi->mi_input_waiting = 1;
+    tvh_cond_wait(&mi->mi_input_cond, &mi->mi_input_lock);
+  }
+  mi->mi_input_waiting = 0;
+  pos = mi->mi_input_ring.mir_head;
+  left = mi->mi_input_ring.mir_used;
+  while ((mp = mpegts_input_ring_next(&mi->mi_input_ring, &pos, &left))) {
+    memoryinfo_free(&mpegts_input_queue_memoryinfo, mp->mp_slot);
     if (mp->mp_mux)
       mpegts_mux_release(mp->mp_mux);
-    free(mp);
   }
+  mi->mi_input_ring.mir_head = mi->mi_input_ring.mir_tail = 0;
+  mi->mi_input_ring.mir_used = 0;
   mi->mi_input_queue_size = 0;
   tvh_mutex_unlock(&mi->mi_input_lock);
 
@@ -1839,6 +2014,7 @@ mpegts_input_flush_mux
 {
   mpegts_table_feed_t *mtf;
   mpegts_packet_t *mp;
+  size_t pos, left;
 
   lock_assert(&global_lock);
 
@@ -1848,7 +2024,9 @@ mpegts_input_flush_mux
 
   /* Flush input Q */
   tvh_mutex_lock(&mi->mi_input_lock);
-  TAILQ_FOREACH(mp, &mi->mi_input_queue, mp_link) {
+  pos = mi->mi_input_ring.mir_head;
+  left = mi->mi_input_ring.mir_used;
+  while ((mp = mpegts_input_ring_next(&mi->mi_input_ring, &pos, &left))) {
     if (mp->mp_mux == mm) {
       mpegts_mux_release(mm);
       mp->mp_mux = NULL;
@@ -2024,6 +2202,11 @@ mpegts_input_thread_stop ( mpegts_input_t *mi )
   if (mi->mi_table_tid)
     pthread_join(mi->mi_table_tid, NULL);
   tvh_mutex_lock(&global_lock);
+
+  /* Release the input ring */
+  tvh_mutex_lock(&mi->mi_input_lock);
+  mpegts_input_ring_free(&mi->mi_input_ring);
+  tvh_mutex_unlock(&mi->mi_input_lock);
 }
 
 /* **************************************************************************
@@ -2104,7 +2287,6 @@ mpegts_input_create0
   /* Init input/output structures */
   tvh_mutex_init(&mi->mi_input_lock, NULL);
   tvh_cond_init(&mi->mi_input_cond, 1);
-  TAILQ_INIT(&mi->mi_input_queue);
 
   tvh_mutex_init(&mi->mi_output_lock, NULL);
   tvh_cond_init(&mi->mi_table_cond, 1);
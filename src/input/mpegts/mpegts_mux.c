@@ -770,6 +770,7 @@ mpegts_mux_free ( mpegts_mux_t *mm )
   free(mm->mm_charset);
   free(mm->mm_epg_module_id);
   free(mm->mm_nicename);
+  free(mm->mm_pid_table);
   free(mm);
 }
 
@@ -895,8 +896,6 @@ mpegts_mux_stop ( mpegts_mux_t *mm, int force, int reason )
 
   /* Ensure PIDs are cleared */
   tvh_mutex_lock(&mi->mi_output_lock);
-  mm->mm_last_pid = -1;
-  mm->mm_last_mp = NULL;
   while ((mp = RB_FIRST(&mm->mm_pids))) {
     assert(mi);
     if (mp->mp_pid == MPEGTS_FULLMUX_PID ||
@@ -922,9 +921,10 @@ mpegts_mux_stop ( mpegts_mux_t *mm, int force, int reason )
         free(mps);
       }
     }
-    RB_REMOVE(&mm->mm_pids, mp, mp_link);
-    free(mp);
+    mpegts_mux_remove_pid(mm, mp);
   }
+  free(mm->mm_pid_table);
+  mm->mm_pid_table = NULL;
   tvh_mutex_unlock(&mi->mi_output_lock);
 
   /* Scanning */
@@ -1255,7 +1255,6 @@ mpegts_mux_create0
   TAILQ_INIT(&mm->mm_descrambler_emms);
   tvh_mutex_init(&mm->mm_descrambler_lock, NULL);
 
-  mm->mm_last_pid            = -1;
   mm->mm_created             = gclk();
 
   /* Configuration */
@@ -1508,39 +1507,6 @@ mpegts_mux_find_service ( mpegts_mux_t *mm, uint16_t sid )
   return ms;
 }
 
-static int mp_cmp ( mpegts_pid_t *a, mpegts_pid_t *b )
-{
-  return a->mp_pid - b->mp_pid;
-}
-
-mpegts_pid_t *
-mpegts_mux_find_pid_ ( mpegts_mux_t *mm, int pid, int create )
-{
-  mpegts_pid_t skel, *mp;
-
-  if (pid < 0 || pid > MPEGTS_TABLES_PID) return NULL;
-
-  skel.mp_pid = pid;
-  mp = RB_FIND(&mm->mm_pids, &skel, mp_link, mp_cmp);
-  if (mp == NULL) {
-    if (create) {
-      mp = calloc(1, sizeof(*mp));
-      mp->mp_pid = pid;
-      if (!RB_INSERT_SORTED(&mm->mm_pids, mp, mp_link, mp_cmp)) {
-        mp->mp_cc = -1;
-      } else {
-        free(mp);
-        mp = NULL;
-      }
-    }
-  }
-  if (mp) {
-    mm->mm_last_pid = pid;
-    mm->mm_last_mp = mp;
-  }
-  return mp;
-}
-
 /* **************************************************************************
  * Misc
  * *************************************************************************/
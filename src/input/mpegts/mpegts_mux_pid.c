@@ -0,0 +1,72 @@
+/*
+ *  Tvheadend - MPEGTS multiplex PID lookup
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The PIDs below MPEGTS_PID_TABLE_SIZE are indexed by mm_pid_table
+ * for the per-packet lookup in mpegts_input_process(), mm_pids keeps
+ * all PIDs (including the pseudo PIDs) sorted.
+ */
+
+#include "input.h"
+
+static int mp_cmp ( mpegts_pid_t *a, mpegts_pid_t *b )
+{
+  return a->mp_pid - b->mp_pid;
+}
+
+mpegts_pid_t *
+mpegts_mux_find_pid_ ( mpegts_mux_t *mm, int pid, int create )
+{
+  mpegts_pid_t skel, *mp;
+
+  if (pid < 0 || pid > MPEGTS_TABLES_PID) return NULL;
+
+  if (pid < MPEGTS_PID_TABLE_SIZE && mm->mm_pid_table) {
+    if ((mp = mm->mm_pid_table[pid]) != NULL || !create)
+      return mp;
+  } else {
+    skel.mp_pid = pid;
+    mp = RB_FIND(&mm->mm_pids, &skel, mp_link, mp_cmp);
+  }
+  if (mp == NULL) {
+    if (create) {
+      mp = calloc(1, sizeof(*mp));
+      mp->mp_pid = pid;
+      if (!RB_INSERT_SORTED(&mm->mm_pids, mp, mp_link, mp_cmp)) {
+        mp->mp_cc = -1;
+        if (pid < MPEGTS_PID_TABLE_SIZE) {
+          if (mm->mm_pid_table == NULL)
+            mm->mm_pid_table = calloc(MPEGTS_PID_TABLE_SIZE, sizeof(mpegts_pid_t *));
+          mm->mm_pid_table[pid] = mp;
+        }
+      } else {
+        free(mp);
+        mp = NULL;
+      }
+    }
+  }
+  return mp;
+}
+
+void
+mpegts_mux_remove_pid ( mpegts_mux_t *mm, mpegts_pid_t *mp )
+{
+  if (mp->mp_pid < MPEGTS_PID_TABLE_SIZE && mm->mm_pid_table)
+    mm->mm_pid_table[mp->mp_pid] = NULL;
+  RB_REMOVE(&mm->mm_pids, mp, mp_link);
+  free(mp);
+}
@@ -70,12 +70,14 @@
 #include "libav.h"
 #include "transcoding/codec.h"
 #include "profile.h"
+#include "muxer/muxer_io.h"
 #include "bouquet.h"
 #include "ratinglabels.h"
 #include "tvhtime.h"
 #include "packet.h"
 #include "streaming.h"
 #include "memoryinfo.h"
+#include "slab.h"
 #include "watchdog.h"
 #include "tprofile.h"
 #if CONFIG_LINUXDVB_CA
@@ -856,6 +858,7 @@ main(int argc, char **argv)
               opt_nobat        = 0,
               opt_subsystems   = 0,
               opt_tprofile     = 0,
+              opt_noslab       = 0,
               opt_thread_debug = 0;
   const char *opt_config       = NULL,
              *opt_user         = NULL,
@@ -968,6 +971,7 @@ main(int argc, char **argv)
 #endif
 
     { 0, "tprofile", N_("Gather timing statistics for the code"), OPT_BOOL, &opt_tprofile },
+    { 0, "noslab", N_("Use malloc() for the packet pools (valgrind)"), OPT_BOOL, &opt_noslab },
 #if ENABLE_TRACE
     { 0, "thrdebug", N_("Thread debugging"), OPT_INT, &opt_thread_debug },
 #endif
@@ -1156,6 +1160,7 @@ main(int argc, char **argv)
   }
 
   tprofile_module_init(opt_tprofile);
+  slab_module_init(!opt_noslab);
   tprofile_init(&gtimer_profile, "gtimer");
   tprofile_init(&mtimer_profile, "mtimer");
   uuid_init();
@@ -1267,9 +1272,7 @@ main(int argc, char **argv)
   memoryinfo_register(&htsmsg_memoryinfo);
   memoryinfo_register(&htsmsg_field_memoryinfo);
 #endif
-  memoryinfo_register(&pkt_memoryinfo);
-  memoryinfo_register(&pktbuf_memoryinfo);
-  memoryinfo_register(&pktref_memoryinfo);
+  pkt_init();
 
   /**
    * Initialize subsystems
@@ -1295,6 +1298,7 @@ main(int argc, char **argv)
   tvhftrace(LS_MAIN, tvhtime_init);
   tvhftrace(LS_MAIN, codec_init);
   tvhftrace(LS_MAIN, profile_init);
+  tvhftrace(LS_MAIN, muxer_io_init);
   tvhftrace(LS_MAIN, imagecache_init);
   tvhftrace(LS_MAIN, http_client_init);
   tvhftrace(LS_MAIN, esfilter_init);
@@ -1403,6 +1407,7 @@ main(int argc, char **argv)
   tvhftrace(LS_MAIN, mpegts_done);
 #endif
   tvhftrace(LS_MAIN, dvr_done);
+  tvhftrace(LS_MAIN, muxer_io_done);
   tvhftrace(LS_MAIN, descrambler_done);
   tvhftrace(LS_MAIN, service_mapper_done);
   tvhftrace(LS_MAIN, service_done);
@@ -80,6 +80,23 @@ const idclass_t memoryinfo_class = {
       .off      = offsetof(memoryinfo_t, my_peak_count),
       .opts     = PO_RDONLY | PO_NOSAVE,
     },
+    {
+      .type     = PT_S64_ATOMIC,
+      .id       = "pool_hits",
+      .name     = N_("Pool hits"),
+      .desc     = N_("Allocations served from the object pool."),
+      .off      = offsetof(memoryinfo_t, my_pool_hits),
+      .opts     = PO_RDONLY | PO_NOSAVE,
+    },
+    {
+      .type     = PT_S64_ATOMIC,
+      .id       = "pool_misses",
+      .name     = N_("Pool misses"),
+      .desc     = N_("Pooled allocations which required a new "
+                     "memory block from the system."),
+      .off      = offsetof(memoryinfo_t, my_pool_misses),
+      .opts     = PO_RDONLY | PO_NOSAVE,
+    },
     {}
   }
 };
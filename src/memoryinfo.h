@@ -35,6 +35,8 @@ typedef struct memoryinfo {
   int64_t                my_peak_size;
   int64_t                my_count;
   int64_t                my_peak_count;
+  int64_t                my_pool_hits;
+  int64_t                my_pool_misses;
 } memoryinfo_t;
 
 LIST_HEAD(memoryinfo_list, memoryinfo);
@@ -16,8 +16,10 @@
  *  along with this program.  If not, see <htmlui://www.gnu.org/licenses/>.
  */
 
+#define _GNU_SOURCE
 #include <string.h>
 #include <fcntl.h>
+#include <sys/stat.h>
 
 #include "tvheadend.h"
 #include "service.h"
@@ -401,9 +403,9 @@ muxer_cache_txt2type(const char *str)
  * cache scheme
  */
 void
-muxer_cache_update(muxer_t *m, int fd, off_t pos, size_t size)
+muxer_cache_apply(int cache, int fd, off_t pos, size_t size)
 {
-  switch (m->m_config.m_cache) {
+  switch (cache) {
   case MC_CACHE_UNKNOWN:
   case MC_CACHE_SYSTEM:
     break;
@@ -425,6 +427,54 @@ muxer_cache_update(muxer_t *m, int fd, off_t pos, size_t size)
   }
 }
 
+void
+muxer_cache_update(muxer_t *m, int fd, off_t pos, size_t size)
+{
+  muxer_cache_apply(m->m_config.m_cache, fd, pos, size);
+}
+
+/**
+ * Reserve the disk space ahead of the write position, so the file is
+ * laid out in a few large extents instead of growing block by block.
+ * The first reservation covers the expected size, then the area is
+ * extended in m_prealloc steps. FALLOC_FL_KEEP_SIZE keeps the file
+ * size equal to the written data for readers.
+ */
+void
+muxer_prealloc(muxer_t *m, int fd, off_t pos)
+{
+#if defined(PLATFORM_LINUX) && defined(FALLOC_FL_KEEP_SIZE)
+  int64_t step = (int64_t)m->m_config.m_prealloc * 1024 * 1024;
+  off_t end;
+
+  if (step <= 0 || m->m_alloc_end < 0 || pos + step / 2 < m->m_alloc_end)
+    return;
+  end = MAX(pos + step, m->m_alloc_hint);
+  if (fallocate(fd, FALLOC_FL_KEEP_SIZE, m->m_alloc_end, end - m->m_alloc_end)) {
+    tvhdebug(LS_MUXER, "preallocation not available -- %s", strerror(errno));
+    m->m_alloc_end = -1;
+    return;
+  }
+  m->m_alloc_end = end;
+#endif
+}
+
+/**
+ * Release the reserved blocks behind the end of file
+ */
+void
+muxer_prealloc_trim(muxer_t *m, int fd)
+{
+  struct stat st;
+
+  if (m->m_alloc_end > 0 && fstat(fd, &st) == 0 && st.st_size < m->m_alloc_end)
+    /* truncate to the same size frees the blocks beyond EOF */
+    if (ftruncate(fd, st.st_size))
+      tvhwarn(LS_MUXER, "unable to trim the preallocated area -- %s",
+              strerror(errno));
+  m->m_alloc_end = 0;
+}
+
 /**
  * Get a list of supported cache schemes
  */
@@ -21,10 +21,12 @@
 
 #include "streaming.h"
 #include "htsmsg.h"
+#include "htsbuf.h"
 
 #define MC_IS_EOS_ERROR(e) ((e) == EPIPE || (e) == ECONNRESET)
 
 #define MC_CAP_ANOTHER_SERVICE (1<<0)	/* I can stream another service (SID must match!) */
+#define MC_CAP_OUTPUT_QUEUE    (1<<1)	/* I can write the stream to m_output */
 
 typedef enum {
   MC_UNKNOWN     = 0,
@@ -66,6 +68,8 @@ typedef struct muxer_config {
   int                  m_file_permissions;
   int                  m_directory_permissions; 
   int                  m_output_chunk; /* > 0 if muxer output needs writing in chunks */   
+  int                  m_io_block;     /* > 0 asynchronous file writes in blocks of kB */
+  int                  m_prealloc;     /* > 0 preallocate the file in steps of MB */
 
   /*
    * type specific section
@@ -98,6 +102,7 @@ typedef struct muxer_hints {
 } muxer_hints_t;
 
 struct muxer;
+struct muxer_io;
 struct streaming_start;
 struct th_pkt;
 struct epg_broadcast;
@@ -127,6 +132,10 @@ typedef struct muxer {
   int                    m_caps;       /* Capabilities */
   muxer_config_t         m_config;     /* general configuration */
   muxer_hints_t         *m_hints;      /* other hints */
+  htsbuf_queue_t        *m_output;     /* Stream output queue (instead of fd) */
+  struct muxer_io       *m_io;         /* Asynchronous file writer (or NULL) */
+  int64_t                m_alloc_hint; /* Expected file size */
+  off_t                  m_alloc_end;  /* End of the preallocated area, -1 = off */
 } muxer_t;
 
 
@@ -187,7 +196,14 @@ const char* muxer_suffix      (muxer_t *m, const struct streaming_start *ss);
 /* Cache */
 const char *       muxer_cache_type2txt(muxer_cache_type_t t);
 muxer_cache_type_t muxer_cache_txt2type(const char *str);
+void               muxer_cache_apply(int cache, int fd, off_t off, size_t size);
 void               muxer_cache_update(muxer_t *m, int fd, off_t off, size_t size);
 int                muxer_cache_list(htsmsg_t *array);
 
+/* Preallocation */
+static inline void muxer_prealloc_hint(muxer_t *m, int64_t size)
+  { if (m) m->m_alloc_hint = size; }
+void               muxer_prealloc(muxer_t *m, int fd, off_t pos);
+void               muxer_prealloc_trim(muxer_t *m, int fd);
+
 #endif
@@ -27,6 +27,7 @@
 #include "epg.h"
 #include "channels.h"
 #include "muxer_audioes.h"
+#include "muxer_io.h"
 
 typedef struct audioes_muxer {
   muxer_t;
@@ -156,6 +157,7 @@ audioes_muxer_open_stream(muxer_t *m, int fd)
   am->am_seekable = 0;
   am->am_off      = 0;
   am->am_filename = strdup("Live stream");
+  am->m_caps     |= MC_CAP_OUTPUT_QUEUE;
 
   return 0;
 }
@@ -191,6 +193,7 @@ audioes_muxer_open_file(muxer_t *m, const char *filename)
   am->am_off      = 0;
   am->am_fd       = fd;
   am->am_filename = strdup(filename);
+  am->m_io        = muxer_io_create(fd, &am->m_config, filename);
   return 0;
 }
 
@@ -219,7 +222,10 @@ audioes_muxer_write_pkt(muxer_t *m, streaming_message_type_t smt, void *data)
 
   if (am->am_error) {
     am->m_errors++;
-  } else if (tvh_write(am->am_fd, pktbuf_ptr(pkt->pkt_payload), size)) {
+  } else if (m->m_output) {
+    htsbuf_append(m->m_output, pktbuf_ptr(pkt->pkt_payload), size);
+  } else if (m->m_io ? muxer_io_write(m->m_io, pktbuf_ptr(pkt->pkt_payload), size) :
+                       tvh_write(am->am_fd, pktbuf_ptr(pkt->pkt_payload), size)) {
     am->am_error = errno;
     if (!MC_IS_EOS_ERROR(errno)) {
       tvherror(LS_AUDIOES, "%s: Write failed -- %s", am->am_filename,
@@ -228,14 +234,18 @@ audioes_muxer_write_pkt(muxer_t *m, streaming_message_type_t smt, void *data)
       am->m_eos = 1;
     }
     am->m_errors++;
-    if (am->am_seekable) {
+    if (m->m_io) {
+      am->am_off = muxer_io_tell(m->m_io);
+    } else if (am->am_seekable) {
       muxer_cache_update(m, am->am_fd, am->am_off, 0);
       am->am_off = lseek(am->am_fd, 0, SEEK_CUR);
     }
   } else {
-    if (am->am_seekable)
+    if (am->am_seekable && !m->m_io)
       muxer_cache_update(m, am->am_fd, am->am_off, 0);
     am->am_off += size;
+    if (am->am_seekable)
+      muxer_prealloc(m, am->am_fd, am->am_off);
   }
 
   pkt_ref_dec(pkt);
@@ -261,7 +271,20 @@ static int
 audioes_muxer_close(muxer_t *m)
 {
   audioes_muxer_t *am = (audioes_muxer_t*)m;
+  int err;
+
+  if (m->m_io) {
+    err = muxer_io_destroy(m->m_io);
+    m->m_io = NULL;
+    if (err && !am->am_error) {
+      am->am_error = err;
+      tvherror(LS_AUDIOES, "%s: Write failed -- %s", am->am_filename, strerror(err));
+      am->m_errors++;
+    }
+  }
 
+  if (am->am_seekable)
+    muxer_prealloc_trim(m, am->am_fd);
   if ((am->am_seekable) && (close(am->am_fd))) {
     am->am_error = errno;
     tvherror(LS_AUDIOES, "%s: Unable to close file -- %s",
@@ -282,6 +305,7 @@ audioes_muxer_destroy(muxer_t *m)
 {
   audioes_muxer_t *am = (audioes_muxer_t*)m;
 
+  muxer_io_destroy(m->m_io);
   if (am->am_filename)
     free(am->am_filename);
   muxer_config_free(&am->m_config);
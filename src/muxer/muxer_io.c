@@ -0,0 +1,402 @@
+/*
+ *  tvheadend, asynchronous block writer for recordings
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <htmlui://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The recording muxers produce a stream of small writes (one per TS
+ * packet batch or mkv cluster element). With the engine enabled the
+ * data is copied into page aligned blocks which are handed over to a
+ * small pool of I/O threads once full. A file is serviced by at most
+ * one thread at a time, so the blocks hit the disk in submission order
+ * and the mkv header rewrites stay behind the data they patch. The
+ * cache policy is applied per written block.
+ */
+
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "tvheadend.h"
+#include "memoryinfo.h"
+#include "muxer_io.h"
+
+typedef struct muxer_io_block {
+  TAILQ_ENTRY(muxer_io_block) mib_link;
+  off_t    mib_off;
+  size_t   mib_size;
+  size_t   mib_alloc;
+  uint8_t *mib_data;
+} muxer_io_block_t;
+
+TAILQ_HEAD(muxer_io_block_queue, muxer_io_block);
+
+struct muxer_io {
+  TAILQ_ENTRY(muxer_io) mio_link;     /* muxer_io_ready */
+
+  int     mio_fd;
+  int     mio_cache;
+  char   *mio_filename;
+  size_t  mio_block_size;
+  off_t   mio_off;                    /* append position */
+
+  /* Owned by the writer, no locking */
+  muxer_io_block_t *mio_fill;
+
+  /* Protected by muxer_io_lock */
+  struct muxer_io_block_queue mio_queue;
+  int        mio_queued;
+  int        mio_busy;
+  int        mio_error;
+  tvh_cond_t mio_cond;
+
+  uint64_t mio_bytes;
+  uint64_t mio_writes;
+  int      mio_queued_max;
+  int64_t  mio_latency_sum;
+  int64_t  mio_latency_max;
+};
+
+static tvh_mutex_t                 muxer_io_lock;
+static tvh_cond_t                  muxer_io_cond;
+static TAILQ_HEAD(, muxer_io)      muxer_io_ready;
+static struct muxer_io_block_queue muxer_io_pool;
+static int                         muxer_io_pool_count;
+static int                         muxer_io_running;
+static pthread_t                   muxer_io_tid[MUXER_IO_THREADS];
+
+static memoryinfo_t muxer_io_memoryinfo = { .my_name = "Recording I/O buffers" };
+
+/* **************************************************************************
+ * Blocks
+ * *************************************************************************/
+
+static muxer_io_block_t *
+muxer_io_block_get(muxer_io_t *mio)
+{
+  muxer_io_block_t *b;
+  void *data;
+
+  tvh_mutex_lock(&muxer_io_lock);
+  TAILQ_FOREACH(b, &muxer_io_pool, mib_link)
+    if (b->mib_alloc == mio->mio_block_size) {
+      TAILQ_REMOVE(&muxer_io_pool, b, mib_link);
+      muxer_io_pool_count--;
+      break;
+    }
+  tvh_mutex_unlock(&muxer_io_lock);
+
+  if (b == NULL) {
+    if (posix_memalign(&data, 4096, mio->mio_block_size))
+      return NULL;
+    b = malloc(sizeof(*b));
+    b->mib_data = data;
+    b->mib_alloc = mio->mio_block_size;
+    memoryinfo_alloc(&muxer_io_memoryinfo, sizeof(*b) + b->mib_alloc);
+  }
+  b->mib_off = mio->mio_off;
+  b->mib_size = 0;
+  return b;
+}
+
+/* muxer_io_lock must be held */
+static void
+muxer_io_block_put(muxer_io_block_t *b)
+{
+  if (muxer_io_pool_count < MUXER_IO_QUEUE_MAX * MUXER_IO_THREADS) {
+    TAILQ_INSERT_HEAD(&muxer_io_pool, b, mib_link);
+    muxer_io_pool_count++;
+    return;
+  }
+  memoryinfo_free(&muxer_io_memoryinfo, sizeof(*b) + b->mib_alloc);
+  free(b->mib_data);
+  free(b);
+}
+
+/* **************************************************************************
+ * I/O threads
+ * *************************************************************************/
+
+static int
+muxer_io_pwrite(int fd, const uint8_t *data, size_t size, off_t off)
+{
+  ssize_t r;
+
+  while (size > 0) {
+    r = pwrite(fd, data, size, off);
+    if (r < 0) {
+      if (ERRNO_AGAIN(errno))
+        continue;
+      return -1;
+    }
+    data += r;
+    size -= r;
+    off  += r;
+  }
+  return 0;
+}
+
+static void *
+muxer_io_thread(void *aux)
+{
+  muxer_io_t *mio;
+  muxer_io_block_t *b;
+  int64_t t;
+  int err;
+
+  tvh_mutex_lock(&muxer_io_lock);
+  while (muxer_io_running) {
+    mio = TAILQ_FIRST(&muxer_io_ready);
+    if (mio == NULL) {
+      tvh_cond_wait(&muxer_io_cond, &muxer_io_lock);
+      continue;
+    }
+    TAILQ_REMOVE(&muxer_io_ready, mio, mio_link);
+    b = TAILQ_FIRST(&mio->mio_queue);
+    TAILQ_REMOVE(&mio->mio_queue, b, mib_link);
+    mio->mio_busy = 1;
+    err = mio->mio_error;
+    tvh_mutex_unlock(&muxer_io_lock);
+
+    t = getmonoclock();
+    if (err == 0) {
+      if (muxer_io_pwrite(mio->mio_fd, b->mib_data, b->mib_size, b->mib_off))
+        err = errno;
+      else
+        muxer_cache_apply(mio->mio_cache, mio->mio_fd, b->mib_off, b->mib_size);
+    }
+    t = getmonoclock() - t;
+
+    tvh_mutex_lock(&muxer_io_lock);
+    if (err) {
+      if (mio->mio_error == 0)
+        tvherror(LS_MUXER, "%s: Write failed -- %s",
+                 mio->mio_filename, strerror(err));
+      mio->mio_error = err;
+    } else {
+      mio->mio_bytes += b->mib_size;
+      mio->mio_writes++;
+      mio->mio_latency_sum += t;
+      if (t > mio->mio_latency_max)
+        mio->mio_latency_max = t;
+    }
+    muxer_io_block_put(b);
+    mio->mio_queued--;
+    mio->mio_busy = 0;
+    if (!TAILQ_EMPTY(&mio->mio_queue))
+      TAILQ_INSERT_TAIL(&muxer_io_ready, mio, mio_link);
+    tvh_cond_signal(&mio->mio_cond, 0);
+  }
+  tvh_mutex_unlock(&muxer_io_lock);
+  return NULL;
+}
+
+/*
+ * Hand the fill block over to the I/O threads
+ */
+static int
+muxer_io_submit(muxer_io_t *mio)
+{
+  muxer_io_block_t *b = mio->mio_fill;
+  int err;
+
+  mio->mio_fill = NULL;
+  tvh_mutex_lock(&muxer_io_lock);
+  if ((err = mio->mio_error) != 0) {
+    muxer_io_block_put(b);
+  } else {
+    if (TAILQ_EMPTY(&mio->mio_queue) && !mio->mio_busy) {
+      TAILQ_INSERT_TAIL(&muxer_io_ready, mio, mio_link);
+      tvh_cond_signal(&muxer_io_cond, 0);
+    }
+    TAILQ_INSERT_TAIL(&mio->mio_queue, b, mib_link);
+    mio->mio_queued++;
+    if (mio->mio_queued > mio->mio_queued_max)
+      mio->mio_queued_max = mio->mio_queued;
+    /* Backpressure, the disk can't keep up */
+    while (mio->mio_queued >= MUXER_IO_QUEUE_MAX && mio->mio_error == 0)
+      tvh_cond_wait(&mio->mio_cond, &muxer_io_lock);
+    err = mio->mio_error;
+  }
+  tvh_mutex_unlock(&muxer_io_lock);
+  if (err) {
+    errno = err;
+    return -1;
+  }
+  return 0;
+}
+
+/* **************************************************************************
+ * Writer API
+ * *************************************************************************/
+
+int
+muxer_io_write(muxer_io_t *mio, const void *_data, size_t size)
+{
+  const uint8_t *data = _data;
+  muxer_io_block_t *b;
+  size_t l;
+
+  while (size > 0) {
+    if ((b = mio->mio_fill) == NULL) {
+      b = mio->mio_fill = muxer_io_block_get(mio);
+      if (b == NULL) {
+        errno = ENOMEM;
+        return -1;
+      }
+    }
+    l = MIN(size, b->mib_alloc - b->mib_size);
+    memcpy(b->mib_data + b->mib_size, data, l);
+    b->mib_size += l;
+    mio->mio_off += l;
+    data += l;
+    size -= l;
+    if (b->mib_size == b->mib_alloc && muxer_io_submit(mio))
+      return -1;
+  }
+  return 0;
+}
+
+int
+muxer_io_seek(muxer_io_t *mio, off_t off)
+{
+  if (mio->mio_fill && mio->mio_fill->mib_size > 0)
+    if (muxer_io_submit(mio))
+      return -1;
+  if (mio->mio_fill) {
+    tvh_mutex_lock(&muxer_io_lock);
+    muxer_io_block_put(mio->mio_fill);
+    tvh_mutex_unlock(&muxer_io_lock);
+    mio->mio_fill = NULL;
+  }
+  mio->mio_off = off;
+  return 0;
+}
+
+off_t
+muxer_io_tell(muxer_io_t *mio)
+{
+  return mio->mio_off;
+}
+
+void
+muxer_io_get_stats(muxer_io_t *mio, muxer_io_stats_t *st)
+{
+  tvh_mutex_lock(&muxer_io_lock);
+  st->mis_bytes = mio->mio_bytes;
+  st->mis_writes = mio->mio_writes;
+  st->mis_queued = mio->mio_queued;
+  st->mis_queued_max = mio->mio_queued_max;
+  st->mis_latency_avg = mio->mio_writes ?
+                          mio->mio_latency_sum / (int64_t)mio->mio_writes : 0;
+  st->mis_latency_max = mio->mio_latency_max;
+  tvh_mutex_unlock(&muxer_io_lock);
+}
+
+muxer_io_t *
+muxer_io_create(int fd, const muxer_config_t *m_cfg, const char *filename)
+{
+  muxer_io_t *mio;
+  int kb = m_cfg->m_io_block;
+
+  if (kb <= 0 || !muxer_io_running)
+    return NULL;
+
+  mio = calloc(1, sizeof(*mio));
+  mio->mio_fd = fd;
+  mio->mio_cache = m_cfg->m_cache;
+  mio->mio_filename = strdup(filename);
+  mio->mio_block_size = (size_t)MINMAX(kb, MUXER_IO_BLOCK_MIN, MUXER_IO_BLOCK_MAX) * 1024;
+  mio->mio_off = lseek(fd, 0, SEEK_CUR);
+  if (mio->mio_off < 0)
+    mio->mio_off = 0;
+  TAILQ_INIT(&mio->mio_queue);
+  tvh_cond_init(&mio->mio_cond, 1);
+  memoryinfo_alloc(&muxer_io_memoryinfo, sizeof(*mio));
+  return mio;
+}
+
+int
+muxer_io_destroy(muxer_io_t *mio)
+{
+  muxer_io_stats_t st;
+  int err;
+
+  if (mio == NULL)
+    return 0;
+
+  muxer_io_seek(mio, mio->mio_off);
+
+  tvh_mutex_lock(&muxer_io_lock);
+  while (mio->mio_queued > 0)
+    tvh_cond_wait(&mio->mio_cond, &muxer_io_lock);
+  err = mio->mio_error;
+  tvh_mutex_unlock(&muxer_io_lock);
+
+  muxer_io_get_stats(mio, &st);
+  tvhdebug(LS_MUXER, "%s: %"PRIu64" bytes in %"PRIu64" writes, "
+                     "latency avg %"PRId64"us max %"PRId64"us, queue max %d",
+           mio->mio_filename, st.mis_bytes, st.mis_writes,
+           st.mis_latency_avg, st.mis_latency_max, st.mis_queued_max);
+
+  tvh_cond_destroy(&mio->mio_cond);
+  memoryinfo_free(&muxer_io_memoryinfo, sizeof(*mio));
+  free(mio->mio_filename);
+  free(mio);
+  return err;
+}
+
+/* **************************************************************************
+ * Setup / Teardown
+ * *************************************************************************/
+
+void
+muxer_io_init(void)
+{
+  int i;
+
+  memoryinfo_register(&muxer_io_memoryinfo);
+  tvh_mutex_init(&muxer_io_lock, NULL);
+  tvh_cond_init(&muxer_io_cond, 1);
+  TAILQ_INIT(&muxer_io_ready);
+  TAILQ_INIT(&muxer_io_pool);
+  muxer_io_running = 1;
+  for (i = 0; i < MUXER_IO_THREADS; i++)
+    tvh_thread_create(&muxer_io_tid[i], NULL, muxer_io_thread, NULL, "muxer-io");
+}
+
+void
+muxer_io_done(void)
+{
+  muxer_io_block_t *b;
+  int i;
+
+  tvh_mutex_lock(&muxer_io_lock);
+  muxer_io_running = 0;
+  tvh_cond_signal(&muxer_io_cond, 1);
+  tvh_mutex_unlock(&muxer_io_lock);
+  for (i = 0; i < MUXER_IO_THREADS; i++)
+    pthread_join(muxer_io_tid[i], NULL);
+
+  while ((b = TAILQ_FIRST(&muxer_io_pool)) != NULL) {
+    TAILQ_REMOVE(&muxer_io_pool, b, mib_link);
+    memoryinfo_free(&muxer_io_memoryinfo, sizeof(*b) + b->mib_alloc);
+    free(b->mib_data);
+    free(b);
+  }
+  muxer_io_pool_count = 0;
+  tvh_mutex_lock(&global_lock);
+  memoryinfo_unregister(&muxer_io_memoryinfo);
+  tvh_mutex_unlock(&global_lock);
+}
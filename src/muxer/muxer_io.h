@@ -0,0 +1,62 @@
+/*
+ *  tvheadend, asynchronous block writer for recordings
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <htmlui://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUXER_IO_H_
+#define MUXER_IO_H_
+
+#include "muxer.h"
+
+#define MUXER_IO_THREADS      4
+#define MUXER_IO_QUEUE_MAX    8         /* blocks per file before the writer waits */
+#define MUXER_IO_BLOCK_MIN    64        /* kB */
+#define MUXER_IO_BLOCK_MAX    16384     /* kB */
+
+typedef struct muxer_io muxer_io_t;
+
+typedef struct muxer_io_stats {
+  uint64_t mis_bytes;        /* bytes written to the file */
+  uint64_t mis_writes;       /* number of block writes */
+  int      mis_queued;       /* blocks waiting or in flight */
+  int      mis_queued_max;   /* peak queue depth */
+  int64_t  mis_latency_avg;  /* average block write time (us) */
+  int64_t  mis_latency_max;  /* worst block write time (us) */
+} muxer_io_stats_t;
+
+void muxer_io_init(void);
+void muxer_io_done(void);
+
+/*
+ * Returns NULL when asynchronous writing is disabled in the config,
+ * the caller then keeps writing to fd directly.
+ */
+muxer_io_t *muxer_io_create(int fd, const muxer_config_t *m_cfg,
+                            const char *filename);
+
+/* Flush the pending data, wait for the queue and free; returns errno or 0 */
+int muxer_io_destroy(muxer_io_t *mio);
+
+/* Append data; returns -1 and sets errno if a previous block failed */
+int muxer_io_write(muxer_io_t *mio, const void *data, size_t size);
+
+/* Submit the partial block and move the append position */
+int muxer_io_seek(muxer_io_t *mio, off_t off);
+
+off_t muxer_io_tell(muxer_io_t *mio);
+
+void muxer_io_get_stats(muxer_io_t *mio, muxer_io_stats_t *st);
+
+#endif
@@ -66,6 +66,11 @@ lav_muxer_write(void *opaque, uint8_t *buf, int buf_size)
     return buf_size;
   }
 
+  if (lm->m_output) {
+    htsbuf_append(lm->m_output, buf, buf_size);
+    return buf_size;
+  }
+
   r = write(lm->lm_fd, buf, buf_size);
   if (r != buf_size)
     lm->m_errors++;
@@ -484,6 +489,7 @@ lav_muxer_open_stream(muxer_t *m, int fd)
   pb->seekable = 0;
   lm->lm_oc->pb = pb;
   lm->lm_fd = fd;
+  lm->m_caps |= MC_CAP_OUTPUT_QUEUE;
 
   return 0;
 }
@@ -42,6 +42,7 @@
 #include "parsers/parser_avc.h"
 #include "parsers/parser_hevc.h"
 #include "muxer_mkv.h"
+#include "muxer_io.h"
 
 
 extern int dvr_iov_max;
@@ -517,6 +518,26 @@ mk_write_to_fd(mk_muxer_t *mk, htsbuf_queue_t *hq)
   int i = 0;
   off_t oldpos = mk->fdpos;
 
+  if (mk->m_output) {
+    mk->fdpos += hq->hq_size;
+    htsbuf_appendq(mk->m_output, hq);
+    return 0;
+  }
+
+  if (mk->m_io) {
+    TAILQ_FOREACH(hd, &hq->hq_q, hd_link) {
+      i = hd->hd_data_len - hd->hd_data_off;
+      if (muxer_io_write(mk->m_io, hd->hd_data + hd->hd_data_off, i)) {
+        mk->error = errno;
+        return -1;
+      }
+      mk->fdpos += i;
+    }
+    if (mk->seekable)
+      muxer_prealloc((muxer_t *)mk, mk->fd, mk->fdpos);
+    return 0;
+  }
+
   TAILQ_FOREACH(hd, &hq->hq_q, hd_link)
     i++;
 
@@ -542,13 +563,27 @@ mk_write_to_fd(mk_muxer_t *mk, htsbuf_queue_t *hq)
     iov += iovcnt;
   } while(i);
 
-  if (mk->seekable)
+  if (mk->seekable) {
     muxer_cache_update((muxer_t *)mk, mk->fd, oldpos, 0);
+    muxer_prealloc((muxer_t *)mk, mk->fd, mk->fdpos);
+  }
 
   return 0;
 }
 
 
+/**
+ *
+ */
+static off_t
+mk_seek(mk_muxer_t *mk, off_t pos)
+{
+  if (mk->m_io)
+    return muxer_io_seek(mk->m_io, pos) ? (off_t)-1 : pos;
+  return lseek(mk->fd, pos, SEEK_SET);
+}
+
+
 /**
  *
  */
@@ -908,12 +943,12 @@ mk_write_metaseek(mk_muxer_t *mk, int first)
   } else if(mk->seekable) {
     off_t prev = mk->fdpos;
     mk->fdpos = mk->segment_pos;
-    if(lseek(mk->fd, mk->segment_pos, SEEK_SET) == (off_t) -1)
+    if(mk_seek(mk, mk->segment_pos) == (off_t) -1)
       mk->error = errno;
 
     mk_write_queue(mk, &q);
     mk->fdpos = prev;
-    if(lseek(mk->fd, mk->fdpos, SEEK_SET) == (off_t) -1)
+    if(mk_seek(mk, mk->fdpos) == (off_t) -1)
       mk->error = errno;
   }
   htsbuf_queue_flush(&q);
@@ -1259,6 +1294,7 @@ static int
 mk_mux_close(mk_muxer_t *mk)
 {
   int64_t totsize;
+  int err;
   mk_close_cluster(mk);
   mk_write_cues(mk);
   mk_write_chapters(mk);
@@ -1268,7 +1304,7 @@ mk_mux_close(mk_muxer_t *mk)
 
   if(mk->seekable) {
     // Rewrite segment info to update duration
-    if(lseek(mk->fd, mk->segmentinfo_pos, SEEK_SET) == mk->segmentinfo_pos)
+    if(mk_seek(mk, mk->segmentinfo_pos) == mk->segmentinfo_pos)
       mk_write_master(mk, 0x1549a966, mk_build_segment_info(mk));
     else {
       mk->error = errno;
@@ -1277,7 +1313,7 @@ mk_mux_close(mk_muxer_t *mk)
     }
 
     // Rewrite segment header to update total size
-    if(lseek(mk->fd, mk->segment_header_pos, SEEK_SET) == mk->segment_header_pos) {
+    if(mk_seek(mk, mk->segment_header_pos) == mk->segment_header_pos) {
       mk_write_segment_header(mk, totsize - mk->segment_header_pos - 12);
     } else {
       mk->error = errno;
@@ -1285,6 +1321,17 @@ mk_mux_close(mk_muxer_t *mk)
 	       mk->filename, strerror(errno));
     }
 
+    if (mk->m_io) {
+      err = muxer_io_destroy(mk->m_io);
+      mk->m_io = NULL;
+      if (err && !mk->error) {
+        mk->error = err;
+        tvherror(LS_MKV, "%s: Write failed -- %s", mk->filename, strerror(err));
+      }
+    }
+
+    muxer_prealloc_trim((muxer_t *)mk, mk->fd);
+
     if(close(mk->fd)) {
       mk->error = errno;
       tvherror(LS_MKV, "%s: Unable to close the file descriptor, close failed -- %s",
@@ -1412,6 +1459,7 @@ mkv_muxer_open_stream(muxer_t *m, int fd)
   mk->fd = fd;
   mk->cluster_maxsize = 0;
   mk->totduration = 0;
+  mk->m_caps |= MC_CAP_OUTPUT_QUEUE;
 
   return 0;
 }
@@ -1449,6 +1497,7 @@ mkv_muxer_open_file(muxer_t *m, const char *filename)
   mk->cluster_maxsize = 2000000;
   mk->seekable = 1;
   mk->totduration = 0;
+  mk->m_io = muxer_io_create(fd, &mk->m_config, filename);
 
   return 0;
 }
@@ -1531,6 +1580,7 @@ mkv_muxer_destroy(muxer_t *m)
   mk_muxer_t *mk = (mk_muxer_t*)m;
   mk_chapter_t *ch;
 
+  muxer_io_destroy(m->m_io);
   pktref_clear_queue(&mk->holdq);
 
   while((ch = TAILQ_FIRST(&mk->chapters)) != NULL) {
@@ -28,6 +28,7 @@
 #include "service.h"
 #include "input/mpegts/dvb.h"
 #include "muxer_pass.h"
+#include "muxer_io.h"
 #include "spawn.h"
 
 typedef struct pass_muxer {
@@ -537,7 +538,11 @@ pass_muxer_open_stream(muxer_t *m, int fd)
   pm->pm_seekable = 0;
   pm->pm_filename = strdup("Live stream");
 
-  return pass_muxer_open2(pm);
+  if (pass_muxer_open2(pm))
+    return -1;
+  if (pm->pm_spawn_pid <= 0)
+    pm->m_caps |= MC_CAP_OUTPUT_QUEUE;
+  return 0;
 }
 
 
@@ -572,7 +577,11 @@ pass_muxer_open_file(muxer_t *m, const char *filename)
   pm->pm_ofd      = fd;
   pm->pm_filename = strdup(filename);
 
-  return pass_muxer_open2(pm);
+  if (pass_muxer_open2(pm))
+    return -1;
+  if (pm->pm_spawn_pid <= 0)
+    pm->m_io = muxer_io_create(fd, &pm->m_config, filename);
+  return 0;
 }
 
 
@@ -590,7 +599,12 @@ pass_muxer_write(muxer_t *m, const void *data, size_t size)
     return;
   } 
   
-  if (pm->m_config.m_output_chunk > 0) {
+  if (m->m_output) {
+    htsbuf_append(m->m_output, data, size);
+    ret = 0;
+  } else if (m->m_io) {
+    ret = muxer_io_write(m->m_io, data, size);
+  } else if (pm->m_config.m_output_chunk > 0) {
     ret = tvh_write_in_chunks(pm->pm_fd, data, size, pm->m_config.m_output_chunk);
   } else {
     ret = tvh_write(pm->pm_fd, data, size);
@@ -605,14 +619,18 @@ pass_muxer_write(muxer_t *m, const void *data, size_t size)
       /* this is an end-of-streaming notification */
       m->m_eos = 1;
     m->m_errors++;
-    if (pm->pm_seekable) {
+    if (m->m_io) {
+      pm->pm_off = muxer_io_tell(m->m_io);
+    } else if (pm->pm_seekable) {
       muxer_cache_update(m, pm->pm_fd, pm->pm_off, 0);
       pm->pm_off = lseek(pm->pm_fd, 0, SEEK_CUR);
     }
   } else {
-    if (pm->pm_seekable)
+    if (pm->pm_seekable && !m->m_io)
       muxer_cache_update(m, pm->pm_fd, pm->pm_off, 0);
     pm->pm_off += size;
+    if (pm->pm_seekable && pm->pm_fd == pm->pm_ofd)
+      muxer_prealloc(m, pm->pm_ofd, pm->pm_off);
   }
 }
 
@@ -624,19 +642,27 @@ static void
 pass_muxer_write_ts(muxer_t *m, pktbuf_t *pb)
 {
   pass_muxer_t *pm = (pass_muxer_t*)m;
-  int l, pid;
+  int l, n, pid, hidx = 0, hcount = 0;
   uint8_t *tsb, *pkt = pktbuf_ptr(pb);
   size_t  len = pktbuf_len(pb), len2;
+  uint16_t hpid[TS_HDR_BATCH];
+  uint8_t hflags[TS_HDR_BATCH];
   
   /* Rewrite PAT/PMT in operation */
   if (pm->m_config.u.pass.m_rewrite_pat || pm->m_config.u.pass.m_rewrite_pmt ||
       pm->pm_rewrite_sdt || pm->pm_rewrite_nit || pm->pm_rewrite_eit) {
 
     for (tsb = pktbuf_ptr(pb), len2 = pktbuf_len(pb), len = 0;
-         len2 > 0; tsb += l, len2 -= l) {
+         len2 >= 188; tsb += l, len2 -= l, hidx += n) {
 
-      pid = (tsb[1] & 0x1f) << 8 | tsb[2];
-      l = mpegts_word_count(tsb, len2, 0x001FFF00);
+      if (hidx >= hcount) {
+        hcount = MIN(len2 / 188, TS_HDR_BATCH);
+        mpegts_hdr_decode(tsb, hcount, hpid, hflags);
+        hidx = 0;
+      }
+      pid = hpid[hidx] & TS_HDR_PID;
+      n = mpegts_hdr_run(hpid + hidx, hflags + hidx, hcount - hidx, TS_HDR_PID, 0);
+      l = n * 188;
 
       /* Process */
       if ( (pm->m_config.u.pass.m_rewrite_pat && pid == DVB_PAT_PID) ||
@@ -736,7 +762,19 @@ static int
 pass_muxer_close(muxer_t *m)
 {
   pass_muxer_t *pm = (pass_muxer_t*)m;
-
+  int err;
+
+  if (m->m_io) {
+    err = muxer_io_destroy(m->m_io);
+    m->m_io = NULL;
+    if (err && !pm->pm_error) {
+      pm->pm_error = err;
+      tvherror(LS_PASS, "%s: Write failed -- %s", pm->pm_filename, strerror(err));
+      m->m_errors++;
+    }
+  }
+  if (pm->pm_seekable)
+    muxer_prealloc_trim(m, pm->pm_ofd);
   if(pm->pm_spawn_pid > 0)
     spawn_kill(pm->pm_spawn_pid, tvh_kill_to_sig(pm->m_config.u.pass.m_killsig),
                pm->m_config.u.pass.m_killtimeout);
@@ -760,6 +798,7 @@ pass_muxer_destroy(muxer_t *m)
 {
   pass_muxer_t *pm = (pass_muxer_t*)m;
 
+  muxer_io_destroy(m->m_io);
   if(pm->pm_filename)
     free(pm->pm_filename);
 
@@ -80,6 +80,45 @@ skip:
   tvh_mutex_unlock(&notify_mutex);
 }
 
+/*
+ * Queue a list of ids (the list is consumed). The ids are not checked
+ * against the queued ones, the caller sends each id once per list.
+ */
+void
+notify_delayed_list(htsmsg_t *ids, const char *event, const char *action)
+{
+  htsmsg_t *m = NULL, *e = NULL;
+  htsmsg_field_t *f;
+
+  if (!tvheadend_is_running()) {
+    htsmsg_destroy(ids);
+    return;
+  }
+
+  tvh_mutex_lock(&notify_mutex);
+  if (notify_queue == NULL) {
+    notify_queue = htsmsg_create_map();
+  } else {
+    m = htsmsg_get_map(notify_queue, event);
+  }
+  if (m == NULL) {
+    m = htsmsg_add_msg(notify_queue, event, htsmsg_create_map());
+  } else {
+    e = htsmsg_get_list(m, action);
+  }
+  if (e == NULL) {
+    htsmsg_add_msg(m, action, ids);
+  } else {
+    while ((f = TAILQ_FIRST(&ids->hm_fields)) != NULL) {
+      TAILQ_REMOVE(&ids->hm_fields, f, hmf_link);
+      TAILQ_INSERT_TAIL(&e->hm_fields, f, hmf_link);
+    }
+    htsmsg_destroy(ids);
+  }
+  tvh_cond_signal(&notify_cond, 0);
+  tvh_mutex_unlock(&notify_mutex);
+}
+
 void *
 notify_thread ( void *p )
 {
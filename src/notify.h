@@ -29,6 +29,7 @@ void notify_by_msg(const char *class, htsmsg_t *m, int isrestricted, int rewrite
 void notify_reload(const char *class);
 
 void notify_delayed(const char *id, const char *event, const char *action);
+void notify_delayed_list(htsmsg_t *ids, const char *event, const char *action);
 
 void notify_init(void);
 void notify_done(void);
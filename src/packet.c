@@ -23,6 +23,7 @@
 #include "string.h"
 #include "atomic.h"
 #include "memoryinfo.h"
+#include "slab.h"
 
 #ifndef PKTBUF_DATA_ALIGN
 #define PKTBUF_DATA_ALIGN 64
@@ -32,6 +33,35 @@ memoryinfo_t pkt_memoryinfo = { .my_name = "Packets" };
 memoryinfo_t pktbuf_memoryinfo = { .my_name = "Packet buffers" };
 memoryinfo_t pktref_memoryinfo = { .my_name = "Packet references" };
 
+/*
+ * Pools - the packet buffers are allocated with the data in one block
+ * using the size classes PKTBUF_SLAB_MIN << (class - 1), class 0 is
+ * used for the header only buffers (no data or foreign data)
+ */
+#define PKTBUF_SLAB_MIN     256
+#define PKTBUF_SLAB_CLASSES 10
+#define PKTBUF_SLAB_MAX     (PKTBUF_SLAB_MIN << (PKTBUF_SLAB_CLASSES - 2))
+
+static slab_t pkt_slab;
+static slab_t pktref_slab;
+static slab_t pktbuf_slab[PKTBUF_SLAB_CLASSES];
+
+static inline int
+pktbuf_slab_class(size_t size)
+{
+  if (size == 0)
+    return 0;
+  if (size <= PKTBUF_SLAB_MIN)
+    return 1;
+  return 1 + (32 - __builtin_clz((size - 1) / PKTBUF_SLAB_MIN));
+}
+
+static inline int
+pktbuf_inline(pktbuf_t *pb)
+{
+  return pb->pb_data == (uint8_t *)(pb + 1);
+}
+
 /*
  *
  */
@@ -42,7 +72,7 @@ pkt_destroy(th_pkt_t *pkt)
     pktbuf_ref_dec(pkt->pkt_payload);
     pktbuf_ref_dec(pkt->pkt_meta);
 
-    free(pkt);
+    slab_free(&pkt_slab, pkt);
     memoryinfo_free(&pkt_memoryinfo, sizeof(*pkt));
   }
 }
@@ -67,8 +97,9 @@ pkt_alloc(streaming_component_type_t type, const uint8_t *data, size_t datalen,
     payload = NULL;
   }
 
-  pkt = calloc(1, sizeof(th_pkt_t));
+  pkt = slab_alloc(&pkt_slab);
   if (pkt) {
+    memset(pkt, 0, sizeof(*pkt));
     pkt->pkt_type = type;
     pkt->pkt_payload = payload;
     pkt->pkt_dts = dts;
@@ -90,7 +121,7 @@ pkt_alloc(streaming_component_type_t type, const uint8_t *data, size_t datalen,
 th_pkt_t *
 pkt_copy_shallow(th_pkt_t *pkt)
 {
-  th_pkt_t *n = malloc(sizeof(th_pkt_t));
+  th_pkt_t *n = slab_alloc(&pkt_slab);
 
   if (n) {
     blacklisted_memcpy(n, pkt, sizeof(*pkt));
@@ -113,7 +144,7 @@ pkt_copy_shallow(th_pkt_t *pkt)
 th_pkt_t *
 pkt_copy_nodata(th_pkt_t *pkt)
 {
-  th_pkt_t *n = malloc(sizeof(th_pkt_t));
+  th_pkt_t *n = slab_alloc(&pkt_slab);
 
   if (n) {
     blacklisted_memcpy(n, pkt, sizeof(*pkt));
@@ -212,7 +243,7 @@ pktref_clear_queue(struct th_pktref_queue *q)
     while((pr = TAILQ_FIRST(q)) != NULL) {
       TAILQ_REMOVE(q, pr, pr_link);
       pkt_ref_dec(pr->pr_pkt);
-      free(pr);
+      slab_free(&pktref_slab, pr);
       memoryinfo_free(&pktref_memoryinfo, sizeof(*pr));
     }
   }
@@ -225,7 +256,7 @@ pktref_clear_queue(struct th_pktref_queue *q)
 void
 pktref_enqueue(struct th_pktref_queue *q, th_pkt_t *pkt)
 {
-  th_pktref_t *pr = malloc(sizeof(th_pktref_t));
+  th_pktref_t *pr = slab_alloc(&pktref_slab);
   if (pr) {
     pr->pr_pkt = pkt;
     TAILQ_INSERT_TAIL(q, pr, pr_link);
@@ -241,7 +272,7 @@ void
 pktref_enqueue_sorted(struct th_pktref_queue *q, th_pkt_t *pkt,
                       int (*cmp)(const void *, const void *))
 {
-  th_pktref_t *pr = malloc(sizeof(th_pktref_t));
+  th_pktref_t *pr = slab_alloc(&pktref_slab);
   if (pr) {
     pr->pr_pkt = pkt;
     TAILQ_INSERT_SORTED(q, pr, pr_link, cmp);
@@ -260,7 +291,7 @@ pktref_remove(struct th_pktref_queue *q, th_pktref_t *pr)
     if (q)
       TAILQ_REMOVE(q, pr, pr_link);
     pkt_ref_dec(pr->pr_pkt);
-    free(pr);
+    slab_free(&pktref_slab, pr);
     memoryinfo_free(&pktref_memoryinfo, sizeof(*pr));
   }
 }
@@ -292,7 +323,7 @@ pktref_get_first(struct th_pktref_queue *q)
   if (pr) {
     pkt = pr->pr_pkt;
     TAILQ_REMOVE(q, pr, pr_link);
-    free(pr);
+    slab_free(&pktref_slab, pr);
     memoryinfo_free(&pktref_memoryinfo, sizeof(*pr));
     return pkt;
   }
@@ -317,7 +348,7 @@ pktref_insert_head(struct th_pktref_queue *q, th_pkt_t *pkt)
 th_pktref_t *
 pktref_create(th_pkt_t *pkt)
 {
-  th_pktref_t *pr = malloc(sizeof(th_pktref_t));
+  th_pktref_t *pr = slab_alloc(&pktref_slab);
   if (pr) {
     pr->pr_pkt = pkt;
     memoryinfo_alloc(&pktref_memoryinfo, sizeof(*pr));
@@ -329,25 +360,28 @@ pktref_create(th_pkt_t *pkt)
  *
  */
 
+static void
+pktbuf_free(pktbuf_t *pb)
+{
+  memoryinfo_free(&pktbuf_memoryinfo, sizeof(*pb) + pb->pb_size);
+  if (!pktbuf_inline(pb))
+    free(pb->pb_data);
+  slab_free(&pktbuf_slab[pb->pb_slab], pb);
+}
+
 void
 pktbuf_destroy(pktbuf_t *pb)
 {
-  if (pb) {
-    memoryinfo_free(&pktbuf_memoryinfo, sizeof(*pb) + pb->pb_size);
-    free(pb->pb_data);
-    free(pb);
-  }
+  if (pb)
+    pktbuf_free(pb);
 }
 
 void
 pktbuf_ref_dec(pktbuf_t *pb)
 {
   if (pb) {
-    if((atomic_add(&pb->pb_refcount, -1)) == 1) {
-      memoryinfo_free(&pktbuf_memoryinfo, sizeof(*pb) + pb->pb_size);
-      free(pb->pb_data);
-      free(pb);
-    }
+    if((atomic_add(&pb->pb_refcount, -1)) == 1)
+      pktbuf_free(pb);
   }
 }
 
@@ -366,23 +400,32 @@ pktbuf_alloc(const uint8_t *data, size_t size)
 {
   pktbuf_t *pb;
   uint8_t *buffer;
+  int cls;
 
-  buffer = size > 0 ? malloc(size) : NULL;
-  if (buffer) {\
-    if (data != NULL)
-      memcpy(buffer, data, size);
-  } else if (size > 0) {
-    return NULL;
-  }
-  pb = malloc(sizeof(pktbuf_t));
-  if (pb == NULL) {
-    free(buffer);
-    return NULL;
+  if (size <= PKTBUF_SLAB_MAX) {
+    cls = pktbuf_slab_class(size);
+    pb = slab_alloc(&pktbuf_slab[cls]);
+    if (pb == NULL)
+      return NULL;
+    buffer = size > 0 ? (uint8_t *)(pb + 1) : NULL;
+  } else {
+    cls = 0;
+    buffer = malloc(size);
+    if (buffer == NULL)
+      return NULL;
+    pb = slab_alloc(&pktbuf_slab[0]);
+    if (pb == NULL) {
+      free(buffer);
+      return NULL;
+    }
   }
+  if (buffer && data != NULL)
+    memcpy(buffer, data, size);
   pb->pb_refcount = 1;
   pb->pb_data = buffer;
   pb->pb_size = size;
   pb->pb_err = 0;
+  pb->pb_slab = cls;
   memoryinfo_alloc(&pktbuf_memoryinfo, sizeof(*pb) + size);
   return pb;
 }
@@ -390,11 +433,13 @@ pktbuf_alloc(const uint8_t *data, size_t size)
 pktbuf_t *
 pktbuf_make(void *data, size_t size)
 {
-  pktbuf_t *pb = malloc(sizeof(pktbuf_t));
+  pktbuf_t *pb = slab_alloc(&pktbuf_slab[0]);
   if (pb) {
     pb->pb_refcount = 1;
     pb->pb_size = size;
     pb->pb_data = data;
+    pb->pb_err = 0;
+    pb->pb_slab = 0;
     memoryinfo_alloc(&pktbuf_memoryinfo, sizeof(*pb) + pb->pb_size);
   }
   return pb;
@@ -406,7 +451,14 @@ pktbuf_append(pktbuf_t *pb, const void *data, size_t size)
   void *ndata;
   if (pb == NULL)
     return pktbuf_alloc(data, size);
-  ndata = realloc(pb->pb_data, pb->pb_size + size);
+  if (pktbuf_inline(pb)) {
+    /* the pooled block cannot grow, move the data out */
+    ndata = malloc(pb->pb_size + size);
+    if (ndata)
+      memcpy(ndata, pb->pb_data, pb->pb_size);
+  } else {
+    ndata = realloc(pb->pb_data, pb->pb_size + size);
+  }
   if (ndata) {
     pb->pb_data = ndata;
     memcpy(ndata + pb->pb_size, data, size);
@@ -416,6 +468,29 @@ pktbuf_append(pktbuf_t *pb, const void *data, size_t size)
   return pb;
 }
 
+/*
+ *
+ */
+void
+pkt_init(void)
+{
+  static char names[PKTBUF_SLAB_CLASSES][24];
+  int i;
+
+  slab_init(&pkt_slab, "packet", sizeof(th_pkt_t), &pkt_memoryinfo);
+  slab_init(&pktref_slab, "packet reference", sizeof(th_pktref_t),
+            &pktref_memoryinfo);
+  for (i = 0; i < PKTBUF_SLAB_CLASSES; i++) {
+    snprintf(names[i], sizeof(names[i]), "packet buffer %d",
+             i ? PKTBUF_SLAB_MIN << (i - 1) : 0);
+    slab_init(&pktbuf_slab[i], names[i], sizeof(pktbuf_t) +
+              (i ? PKTBUF_SLAB_MIN << (i - 1) : 0), &pktbuf_memoryinfo);
+  }
+  memoryinfo_register(&pkt_memoryinfo);
+  memoryinfo_register(&pktbuf_memoryinfo);
+  memoryinfo_register(&pktref_memoryinfo);
+}
+
 /*
  *
  */
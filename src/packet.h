@@ -29,6 +29,7 @@ struct memoryinfo;
 typedef struct pktbuf {
   int pb_refcount;
   int pb_err;
+  int pb_slab;        /* pool size class */
   uint8_t *pb_data;
   size_t pb_size;
 } pktbuf_t;
@@ -163,6 +164,8 @@ pktbuf_t *pktbuf_make(void *data, size_t size);
 
 pktbuf_t *pktbuf_append(pktbuf_t *pb, const void *data, size_t size);
 
+void pkt_init(void);
+
 static inline size_t   pktbuf_len(pktbuf_t *pb) { return pb ? pb->pb_size : 0; }
 static inline uint8_t *pktbuf_ptr(pktbuf_t *pb) { return pb->pb_data; }
 
@@ -33,6 +33,9 @@
 
 #define RTP_PACKETS 128
 #define RTP_PAYLOAD (7*188+12)
+#define RTP_TS_PAYLOAD (7*188)
+#define RTP_GSO_SEGS 48                     /* < 64kB and UDP_MAX_SEGMENTS */
+#define RTP_GSO_IOV ((RTP_GSO_SEGS+1)*8)    /* header + 7 TS runs per segment */
 #define RTP_TCP_MIN_PAYLOAD (7*188+12+4)   /* fit ethernet packet */
 #define RTP_TCP_MAX_PAYLOAD (348*188+12+4) /* cca 64kB */
 #define RTCP_PAYLOAD (1420)
@@ -47,6 +50,19 @@ typedef struct satip_rtp_table {
   int remove_mark;
 } satip_rtp_table_t;
 
+typedef struct satip_rtp_gso {
+  struct iovec *iov;
+  int niov;
+  int first;            /* first iovec of the current segment */
+  int segs;             /* complete segments */
+  int len;              /* TS bytes in the current segment, -1 = none */
+  pktbuf_t **pbs;       /* referenced input buffers */
+  int npbs;
+  uint8_t *hdr;         /* RTP headers */
+  uint8_t *copy;        /* copied data (tables, previous segment) */
+  int copy_len;
+} satip_rtp_gso_t;
+
 typedef struct satip_rtp_session {
   TAILQ_ENTRY(satip_rtp_session) link;
   pthread_t tid;
@@ -66,6 +82,8 @@ typedef struct satip_rtp_session {
   TAILQ_HEAD(, satip_rtp_table) pmt_tables;
   udp_multisend_t um;
   struct iovec *um_iovec;
+  int gso;
+  satip_rtp_gso_t gso_data;
   struct iovec tcp_data;
   uint32_t tcp_payload;
   uint32_t tcp_buffer_size;
@@ -234,18 +252,219 @@ satip_rtp_append_data(satip_rtp_session_t *rtp, struct iovec **_v, uint8_t *data
   return 0;
 }
 
+/*
+ * UDP segmentation offload - the RTP headers and the TS data from
+ * the input buffers are sent without copying in one system call
+ */
+static void
+satip_rtp_gso_init(satip_rtp_session_t *rtp)
+{
+  satip_rtp_gso_t *g = &rtp->gso_data;
+
+  g->iov  = malloc(RTP_GSO_IOV * sizeof(struct iovec));
+  g->pbs  = malloc(RTP_GSO_IOV * sizeof(pktbuf_t *));
+  g->hdr  = malloc((RTP_GSO_SEGS + 1) * 12);
+  g->copy = malloc((RTP_GSO_SEGS + 1) * RTP_TS_PAYLOAD);
+  g->len  = -1;
+}
+
+static void
+satip_rtp_gso_release(satip_rtp_session_t *rtp)
+{
+  satip_rtp_gso_t *g = &rtp->gso_data;
+
+  while (g->npbs > 0)
+    pktbuf_ref_dec(g->pbs[--g->npbs]);
+}
+
+static void
+satip_rtp_gso_free(satip_rtp_session_t *rtp)
+{
+  satip_rtp_gso_t *g = &rtp->gso_data;
+
+  satip_rtp_gso_release(rtp);
+  free(g->iov);
+  free(g->pbs);
+  free(g->hdr);
+  free(g->copy);
+  memset(g, 0, sizeof(*g));
+}
+
+/*
+ * Keep the incomplete segment (copy), forget the rest
+ */
+static void
+satip_rtp_gso_reset(satip_rtp_session_t *rtp)
+{
+  satip_rtp_gso_t *g = &rtp->gso_data;
+  uint8_t tmp[12 + RTP_TS_PAYLOAD];
+  int i, l = 0;
+
+  if (g->len >= 0)
+    for (i = g->first; i < g->niov; i++) {
+      memcpy(tmp + l, g->iov[i].iov_base, g->iov[i].iov_len);
+      l += g->iov[i].iov_len;
+    }
+  satip_rtp_gso_release(rtp);
+  g->niov = g->first = g->segs = g->copy_len = 0;
+  if (g->len < 0)
+    return;
+  memcpy(g->hdr, tmp, 12);
+  g->iov[g->niov].iov_base = g->hdr;
+  g->iov[g->niov++].iov_len = 12;
+  if (l > 12) {
+    memcpy(g->copy, tmp + 12, l - 12);
+    g->copy_len = l - 12;
+    g->iov[g->niov].iov_base = g->copy;
+    g->iov[g->niov++].iov_len = l - 12;
+  }
+}
+
+/*
+ * The kernel cannot segment for this socket, use the copy path
+ */
 static int
-satip_rtp_loop(satip_rtp_session_t *rtp, uint8_t *data, int len)
+satip_rtp_gso_fallback(satip_rtp_session_t *rtp, int err)
 {
-  int i, j, pid, last_pid = -1, r;
+  satip_rtp_gso_t *g = &rtp->gso_data;
+  struct iovec *v;
+  uint8_t *p;
+  size_t l;
+  int i, r = 0;
+
+  tvhinfo(LS_SATIPS, "rtp udp segmentation offload failed (%s), "
+                     "using the multisend path", strerror(err));
+  rtp->gso = 0;
+  /* the headers were not sent, reuse the sequence numbers */
+  rtp->seq -= g->segs + (g->len >= 0 ? 1 : 0);
+  satip_rtp_header(rtp, rtp->um_iovec, 0);
+  v = rtp->um_iovec;
+  for (i = 0; i < g->niov && !r; i++) {
+    p = g->iov[i].iov_base;
+    if (p >= g->hdr && p < g->hdr + (RTP_GSO_SEGS + 1) * 12)
+      continue;
+    for (l = g->iov[i].iov_len; l >= 188 && !r; p += 188, l -= 188)
+      r = satip_rtp_append_data(rtp, &v, p);
+  }
+  g->len = -1;
+  satip_rtp_gso_reset(rtp);
+  return r;
+}
+
+/*
+ * Send the complete segments
+ */
+static int
+satip_rtp_gso_send(satip_rtp_session_t *rtp)
+{
+  satip_rtp_gso_t *g = &rtp->gso_data;
+  int niov, r;
+
+  if (g->segs == 0)
+    return 0;
+  niov = g->len < 0 ? g->niov : g->first;
+  while (1) {
+    r = udp_segment_send(rtp->fd_rtp, g->iov, niov, RTP_PAYLOAD);
+    if (r < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        tvh_usleep(100);
+        continue;
+      }
+      if (errno == EIO || errno == EINVAL || errno == EOPNOTSUPP)
+        return satip_rtp_gso_fallback(rtp, errno);
+      tvhtrace(LS_SATIPS, "rtp udp segment send failed (errno %d)", errno);
+      return r;
+    }
+    break;
+  }
+  satip_rtp_gso_reset(rtp);
+  return 0;
+}
+
+/*
+ * Append the TS packets, pb == NULL means that the data must be copied
+ */
+static int
+satip_rtp_gso_append(satip_rtp_session_t *rtp, pktbuf_t *pb,
+                     uint8_t *data, int len)
+{
+  satip_rtp_gso_t *g = &rtp->gso_data;
+  struct iovec *v, hv;
+  uint8_t *src;
+  int take, r;
+
+  while (len > 0 && rtp->gso) {
+    if (g->len < 0) {
+      hv.iov_base = g->hdr + g->segs * 12;
+      satip_rtp_header(rtp, &hv, 0);
+      g->first = g->niov;
+      g->iov[g->niov++] = hv;
+      g->len = 0;
+    }
+    if (pb == NULL) {
+      take = 188;
+      src = g->copy + g->copy_len;
+      memcpy(src, data, take);
+      g->copy_len += take;
+    } else {
+      take = MIN(len, RTP_TS_PAYLOAD - g->len);
+      src = data;
+      if (g->npbs == 0 || g->pbs[g->npbs - 1] != pb)
+        g->pbs[g->npbs++] = pktbuf_ref_inc(pb);
+    }
+    v = &g->iov[g->niov - 1];
+    if (g->len > 0 && (uint8_t *)v->iov_base + v->iov_len == src) {
+      v->iov_len += take;
+    } else {
+      v = &g->iov[g->niov++];
+      v->iov_base = src;
+      v->iov_len = take;
+    }
+    g->len += take;
+    data += take;
+    len -= take;
+    if (g->len == RTP_TS_PAYLOAD) {
+      g->segs++;
+      g->len = -1;
+      if (g->segs == RTP_GSO_SEGS) {
+        r = satip_rtp_gso_send(rtp);
+        if (r < 0)
+          return r;
+      }
+    }
+  }
+  /* fallback to the copy path */
+  v = rtp->um_iovec + rtp->um_packet;
+  for ( ; len >= 188; data += 188, len -= 188) {
+    r = satip_rtp_append_data(rtp, &v, data);
+    if (r < 0)
+      return r;
+  }
+  return 0;
+}
+
+static int
+satip_rtp_loop(satip_rtp_session_t *rtp, pktbuf_t *pb, uint8_t *data, int len)
+{
+  int i, j, k, n, pid, r, hidx = 0, hcount = 0;
   mpegts_apid_t *pids = rtp->pids.pids;
   struct iovec *v = rtp->um_iovec + rtp->um_packet;
   satip_rtp_table_t *tbl;
+  uint16_t hpid[TS_HDR_BATCH];
+  uint8_t hflags[TS_HDR_BATCH];
 
   assert((len % 188) == 0);
-  for ( ; len >= 188 ; data += 188, len -= 188) {
-    pid = ((data[1] & 0x1f) << 8) | data[2];
-    if (pid != last_pid && !rtp->pids.all) {
+  for ( ; len >= 188 ; data += n * 188, len -= n * 188, hidx += n) {
+    if (hidx >= hcount) {
+      hcount = MIN(len / 188, TS_HDR_BATCH);
+      mpegts_hdr_decode(data, hcount, hpid, hflags);
+      hidx = 0;
+    }
+    pid = hpid[hidx] & TS_HDR_PID;
+    n = mpegts_hdr_run(hpid + hidx, hflags + hidx, hcount - hidx, TS_HDR_PID, 0);
+    if (!rtp->pids.all) {
       for (i = 0; i < rtp->pids.count; i++) {
         j = pids[i].pid;
         if (pid < j) break;
@@ -255,26 +474,42 @@ satip_rtp_loop(satip_rtp_session_t *rtp, uint8_t *data, int len)
 found:
       TAILQ_FOREACH(tbl, &rtp->pmt_tables, link)
         if (tbl->pid == pid) {
-          dvb_table_parse(&tbl->tbl, "-", data, 188, 1, 0, satip_rtp_pmt_cb);
-          if (rtp->table_data.sb_ptr > 0) {
-            for (i = r = 0; i < rtp->table_data.sb_ptr; i += 188) {
-              r = satip_rtp_append_data(rtp, &v, rtp->table_data.sb_data + i);
+          for (k = 0; k < n; k++) {
+            dvb_table_parse(&tbl->tbl, "-", data + k * 188, 188, 1, 0, satip_rtp_pmt_cb);
+            if (rtp->table_data.sb_ptr > 0) {
+              if (rtp->gso) {
+                r = satip_rtp_gso_append(rtp, NULL, rtp->table_data.sb_data,
+                                         rtp->table_data.sb_ptr);
+                v = rtp->um_iovec + rtp->um_packet;
+              } else {
+                for (i = r = 0; i < rtp->table_data.sb_ptr; i += 188) {
+                  r = satip_rtp_append_data(rtp, &v, rtp->table_data.sb_data + i);
+                  if (r)
+                    break;
+                }
+              }
+              sbuf_reset(&rtp->table_data, 10*188);
               if (r)
-                break;
+                return r;
             }
-            sbuf_reset(&rtp->table_data, 10*188);
-            if (r)
-              return r;
           }
           break;
         }
       if (tbl)
         continue;
-      last_pid = pid;
     }
-    r = satip_rtp_append_data(rtp, &v, data);
-    if (r < 0)
-      return r;
+    if (rtp->gso) {
+      r = satip_rtp_gso_append(rtp, pb, data, n * 188);
+      if (r < 0)
+        return r;
+      v = rtp->um_iovec + rtp->um_packet;
+      continue;
+    }
+    for (k = 0; k < n; k++) {
+      r = satip_rtp_append_data(rtp, &v, data + k * 188);
+      if (r < 0)
+        return r;
+    }
   }
   return 0;
 }
@@ -385,8 +620,9 @@ satip_rtp_thread(void *aux)
   int tcp = rtp->port == RTSP_TCP_DATA;
 
   tcp_get_str_from_ip(&rtp->peer, peername, sizeof(peername));
-  tvhdebug(LS_SATIPS, "RTP streaming to %s:%d open", peername,
-           tcp ? ntohs(IP_PORT(rtp->peer)) : rtp->port);
+  tvhdebug(LS_SATIPS, "RTP streaming to %s:%d open%s", peername,
+           tcp ? ntohs(IP_PORT(rtp->peer)) : rtp->port,
+           rtp->gso ? " (segmentation offload)" : "");
 
   tvh_mutex_lock(&sq->sq_mutex);
   while (rtp->sq && !fatal) {
@@ -394,6 +630,8 @@ satip_rtp_thread(void *aux)
     if (sm == NULL) {
       if (tcp) {
         r = satip_rtp_flush_tcp_data(rtp);
+      } else if (rtp->gso) {
+        r = satip_rtp_gso_send(rtp);
       } else {
         r = satip_rtp_send(rtp);
       }
@@ -401,7 +639,7 @@ satip_rtp_thread(void *aux)
         fatal = 1;
         continue;
       }
-      tvh_cond_wait(&sq->sq_cond, &sq->sq_mutex);
+      streaming_queue_wait(sq, 0);
       continue;
     }
     streaming_queue_remove(sq, sm);
@@ -419,7 +657,7 @@ satip_rtp_thread(void *aux)
         if (tcp)
           r = satip_rtp_tcp_loop(rtp, pktbuf_ptr(pb), r);
         else
-          r = satip_rtp_loop(rtp, pktbuf_ptr(pb), r);
+          r = satip_rtp_loop(rtp, pb, pktbuf_ptr(pb), r);
         tvh_mutex_unlock(&rtp->lock);
         if (r) fatal = 1;
       }
@@ -503,7 +741,12 @@ void *satip_rtp_queue(th_subscription_t *subs,
   TAILQ_INIT(&rtp->pmt_tables);
   if (port != RTSP_TCP_DATA) {
     udp_multisend_init(&rtp->um, RTP_PACKETS, RTP_PAYLOAD, &rtp->um_iovec);
-    satip_rtp_header(rtp, rtp->um_iovec, 0);
+    if (!satip_server_conf.satip_nogso && udp_segment_probe(fd_rtp)) {
+      rtp->gso = 1;
+      satip_rtp_gso_init(rtp);
+    } else {
+      satip_rtp_header(rtp, rtp->um_iovec, 0);
+    }
   } else {
     socklen = sizeof(len);
     if (getsockopt(fd_rtp, SOL_SOCKET, SO_SNDBUF, &len, &socklen) == 0 &&
@@ -631,6 +874,7 @@ void satip_rtp_close(void *_rtp)
     http_extra_destroy(rtp->hc);
     free(rtp->tcp_data.iov_base);
   } else {
+    satip_rtp_gso_free(rtp);
     udp_multisend_free(&rtp->um);
   }
   mpegts_pid_done(&rtp->pids);
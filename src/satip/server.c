@@ -950,6 +950,18 @@ const idclass_t satip_server_class = {
       .opts   = PO_EXPERT,
       .group  = 5,
     },
+    {
+      .type   = PT_BOOL,
+      .id     = "satip_nogso",
+      .name   = N_("Disable UDP segmentation offload"),
+      .desc   = N_("Do not use the UDP segmentation offload (GSO) for "
+                   "the RTP/UDP transfers. The RTP packets are copied "
+                   "and sent using one datagram per packet like on "
+                   "the systems without GSO support."),
+      .off    = offsetof(struct satip_server_conf, satip_nogso),
+      .opts   = PO_EXPERT,
+      .group  = 5,
+    },
     {
       .type   = PT_BOOL,
       .id     = "satip_restrict_pids_all",
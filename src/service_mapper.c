@@ -440,7 +440,7 @@ service_mapper_thread ( void *aux )
       /* Wait for message */
       tvh_mutex_lock(&sq->sq_mutex);
       while((sm = TAILQ_FIRST(&sq->sq_queue)) == NULL) {
-        tvh_cond_wait(&sq->sq_cond, &sq->sq_mutex);
+        streaming_queue_wait(sq, 0);
         if (!tvheadend_is_running())
           break;
       }
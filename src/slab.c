@@ -0,0 +1,197 @@
+/*
+ *  Tvheadend - object pools for the fixed size objects
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tvheadend.h"
+#include "memoryinfo.h"
+#include "slab.h"
+
+typedef struct slab_cache {
+  void    *sc_head;
+  int      sc_count;
+  uint32_t sc_hits;
+  uint32_t sc_misses;
+} slab_cache_t;
+
+static int slab_enabled;
+static int slab_count;
+static slab_t *slab_list[SLAB_MAX];
+static pthread_key_t slab_key;
+
+static __thread slab_cache_t slab_caches[SLAB_MAX];
+static __thread int slab_thread_registered;
+
+/*
+ * Move the statistics to the memoryinfo counters
+ */
+static inline void
+slab_stats(slab_t *sl, slab_cache_t *sc)
+{
+  memoryinfo_t *my = sl->sl_memoryinfo;
+
+  if (my) {
+    if (sc->sc_hits)
+      atomic_add_s64(&my->my_pool_hits, sc->sc_hits);
+    if (sc->sc_misses)
+      atomic_add_s64(&my->my_pool_misses, sc->sc_misses);
+  }
+  sc->sc_hits = sc->sc_misses = 0;
+}
+
+/*
+ * Move 'count' objects from the thread cache to the depot
+ */
+static void
+slab_drain(slab_t *sl, slab_cache_t *sc, int count)
+{
+  void *p, *rest = NULL;
+
+  slab_stats(sl, sc);
+  tvh_mutex_lock(&sl->sl_lock);
+  while (count-- > 0 && (p = sc->sc_head) != NULL) {
+    sc->sc_head = *(void **)p;
+    sc->sc_count--;
+    if (sl->sl_depot_count < sl->sl_depot_max) {
+      *(void **)p = sl->sl_depot;
+      sl->sl_depot = p;
+      sl->sl_depot_count++;
+    } else {
+      *(void **)p = rest;
+      rest = p;
+    }
+  }
+  tvh_mutex_unlock(&sl->sl_lock);
+  while ((p = rest) != NULL) {
+    rest = *(void **)p;
+    free(p);
+  }
+}
+
+static void
+slab_thread_exit(void *aux)
+{
+  int i;
+
+  for (i = 0; i < slab_count; i++)
+    slab_drain(slab_list[i], &slab_caches[i], INT_MAX);
+}
+
+/*
+ * The thread caches are returned to the depots when the thread exits
+ */
+static inline void
+slab_thread_register(void)
+{
+  if (!slab_thread_registered) {
+    pthread_setspecific(slab_key, slab_caches);
+    slab_thread_registered = 1;
+  }
+}
+
+/*
+ * Take a half of the thread cache size from the depot
+ *
+ * Note: the depot is checked under the lock, the refill is done once
+ * per sl_cache_max / 2 allocations only
+ */
+static void
+slab_refill(slab_t *sl, slab_cache_t *sc)
+{
+  void *p;
+  int count;
+
+  slab_thread_register();
+  slab_stats(sl, sc);
+  tvh_mutex_lock(&sl->sl_lock);
+  for (count = sl->sl_cache_max / 2; count > 0; count--) {
+    if ((p = sl->sl_depot) == NULL)
+      break;
+    sl->sl_depot = *(void **)p;
+    sl->sl_depot_count--;
+    *(void **)p = sc->sc_head;
+    sc->sc_head = p;
+    sc->sc_count++;
+  }
+  tvh_mutex_unlock(&sl->sl_lock);
+}
+
+void *
+slab_alloc(slab_t *sl)
+{
+  slab_cache_t *sc;
+  void *p;
+
+  if (!slab_enabled)
+    return malloc(sl->sl_size);
+  sc = &slab_caches[sl->sl_index];
+  if (sc->sc_head == NULL) {
+    slab_refill(sl, sc);
+    if (sc->sc_head == NULL) {
+      sc->sc_misses++;
+      return malloc(sl->sl_size);
+    }
+  }
+  p = sc->sc_head;
+  sc->sc_head = *(void **)p;
+  sc->sc_count--;
+  sc->sc_hits++;
+  return p;
+}
+
+void
+slab_free(slab_t *sl, void *ptr)
+{
+  slab_cache_t *sc;
+
+  if (ptr == NULL)
+    return;
+  if (!slab_enabled) {
+    free(ptr);
+    return;
+  }
+  slab_thread_register();
+  sc = &slab_caches[sl->sl_index];
+  *(void **)ptr = sc->sc_head;
+  sc->sc_head = ptr;
+  if (++sc->sc_count > sl->sl_cache_max)
+    slab_drain(sl, sc, sl->sl_cache_max / 2);
+}
+
+/*
+ *
+ */
+void
+slab_init(slab_t *sl, const char *name, size_t size, memoryinfo_t *my)
+{
+  assert(slab_count < SLAB_MAX);
+  memset(sl, 0, sizeof(*sl));
+  sl->sl_name = name;
+  sl->sl_size = MAX(size, sizeof(void *));
+  sl->sl_index = slab_count;
+  sl->sl_cache_max = MINMAX((256 * 1024) / sl->sl_size, 4, 64);
+  sl->sl_depot_max = MINMAX((4 * 1024 * 1024) / sl->sl_size, 16, 1024);
+  sl->sl_memoryinfo = my;
+  tvh_mutex_init(&sl->sl_lock, NULL);
+  slab_list[slab_count++] = sl;
+}
+
+void
+slab_module_init(int enabled)
+{
+  slab_enabled = enabled;
+  if (enabled)
+    pthread_key_create(&slab_key, slab_thread_exit);
+}
@@ -0,0 +1,52 @@
+/*
+ *  Tvheadend - object pools for the fixed size objects
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TVHEADEND_SLAB_H
+#define TVHEADEND_SLAB_H
+
+#include "tvh_thread.h"
+
+struct memoryinfo;
+
+#define SLAB_MAX 16
+
+/*
+ * Each thread keeps a small freelist per pool, the overflow goes
+ * to the shared depot. The objects are returned to the system only
+ * when the depot is full.
+ */
+typedef struct slab {
+  const char  *sl_name;
+  size_t       sl_size;
+  int          sl_index;       /* thread cache index */
+  int          sl_cache_max;   /* objects per thread */
+  int          sl_depot_max;   /* objects in the depot */
+  tvh_mutex_t  sl_lock;        /* protects the depot */
+  void        *sl_depot;
+  int          sl_depot_count;
+  struct memoryinfo *sl_memoryinfo;
+} slab_t;
+
+void slab_init(slab_t *sl, const char *name, size_t size,
+               struct memoryinfo *my);
+
+void *slab_alloc(slab_t *sl);
+void slab_free(slab_t *sl, void *ptr);
+
+void slab_module_init(int enabled);
+
+#endif /* TVHEADEND_SLAB_H */
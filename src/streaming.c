@@ -25,8 +25,10 @@
 #include "atomic.h"
 #include "service.h"
 #include "timeshift.h"
+#include "slab.h"
 
 static memoryinfo_t streaming_msg_memoryinfo = { .my_name = "Streaming message" };
+static slab_t streaming_msg_slab;
 
 void
 streaming_pad_init(streaming_pad_t *sp)
@@ -84,7 +86,15 @@ streaming_queue_deliver(void *opauqe, streaming_message_t *sm)
     sq->sq_size += streaming_message_data_size(sm);
   }
 
-  tvh_cond_signal(&sq->sq_cond, 0);
+  /* the running consumer takes the message with the next batch, */
+  /* a sleeping one is woken only once */
+  if (sq->sq_waiting) {
+    sq->sq_waiting = 0;
+    if (sq->sq_notify)
+      sq->sq_notify(sq->sq_notify_aux);
+    else
+      tvh_cond_signal(&sq->sq_cond, 0);
+  }
   tvh_mutex_unlock(&sq->sq_mutex);
 }
 
@@ -115,6 +125,44 @@ streaming_queue_remove(streaming_queue_t *sq, streaming_message_t *sm)
   TAILQ_REMOVE(&sq->sq_queue, sm, sm_link);
 }
 
+/**
+ * Move all queued messages to the consumer queue
+ *
+ * The bytes of the previous batch are released here, so the queue
+ * size still accounts the messages being processed by the consumer.
+ */
+void
+streaming_queue_take(streaming_queue_t *sq, struct streaming_message_queue *q)
+{
+  lock_assert(&sq->sq_mutex);
+
+  sq->sq_size -= sq->sq_taken;
+  TAILQ_CONCAT(q, &sq->sq_queue, sm_link);
+  sq->sq_taken = sq->sq_size;
+}
+
+/**
+ * Wait for new messages (mono == 0 - no timeout)
+ *
+ * There is one consumer per queue, the producer clears sq_waiting
+ * when it signals.
+ */
+int
+streaming_queue_wait(streaming_queue_t *sq, int64_t mono)
+{
+  int r;
+
+  lock_assert(&sq->sq_mutex);
+
+  sq->sq_waiting = 1;
+  if (mono)
+    r = tvh_cond_timedwait(&sq->sq_cond, &sq->sq_mutex, mono);
+  else
+    r = tvh_cond_wait(&sq->sq_cond, &sq->sq_mutex);
+  sq->sq_waiting = 0;
+  return r;
+}
+
 /**
  *
  */
@@ -134,6 +182,10 @@ streaming_queue_init(streaming_queue_t *sq, int reject_filter, size_t maxsize)
 
   sq->sq_maxsize = maxsize;
   sq->sq_size = 0;
+  sq->sq_taken = 0;
+  sq->sq_waiting = 0;
+  sq->sq_notify = NULL;
+  sq->sq_notify_aux = NULL;
 }
 
 /**
@@ -143,6 +195,7 @@ void
 streaming_queue_deinit(streaming_queue_t *sq)
 {
   sq->sq_size = 0;
+  sq->sq_taken = 0;
   streaming_queue_clear(&sq->sq_queue);
   tvh_mutex_destroy(&sq->sq_mutex);
   tvh_cond_destroy(&sq->sq_cond);
@@ -201,7 +254,7 @@ streaming_target_disconnect(streaming_pad_t *sp, streaming_target_t *st)
 streaming_message_t *
 streaming_msg_create(streaming_message_type_t type)
 {
-  streaming_message_t *sm = malloc(sizeof(streaming_message_t));
+  streaming_message_t *sm = slab_alloc(&streaming_msg_slab);
   memoryinfo_alloc(&streaming_msg_memoryinfo, sizeof(*sm));
   sm->sm_type = type;
 #if ENABLE_TIMESHIFT
@@ -256,7 +309,7 @@ streaming_msg_create_code(streaming_message_type_t type, int code)
 streaming_message_t *
 streaming_msg_clone(streaming_message_t *src)
 {
-  streaming_message_t *dst = malloc(sizeof(streaming_message_t));
+  streaming_message_t *dst = slab_alloc(&streaming_msg_slab);
   streaming_start_t *ss;
 
   memoryinfo_alloc(&streaming_msg_memoryinfo, sizeof(*dst));
@@ -388,7 +441,7 @@ streaming_msg_free(streaming_message_t *sm)
     abort();
   }
   memoryinfo_free(&streaming_msg_memoryinfo, sizeof(*sm));
-  free(sm);
+  slab_free(&streaming_msg_slab, sm);
 }
 
 /**
@@ -640,6 +693,8 @@ const char *signal2str(signal_state_t st)
  */
 void streaming_init(void)
 {
+  slab_init(&streaming_msg_slab, "streaming message",
+            sizeof(streaming_message_t), &streaming_msg_memoryinfo);
   memoryinfo_register(&streaming_msg_memoryinfo);
 }
 
@@ -360,6 +360,11 @@ struct streaming_queue {
 
   size_t      sq_maxsize;  /* Max queue size (bytes) */
   size_t      sq_size;     /* Actual queue size (bytes) - only data */
+  size_t      sq_taken;    /* Bytes in the batch owned by the consumer */
+  int         sq_waiting;  /* Consumer waits, cleared on the wakeup */
+
+  void      (*sq_notify)(void *aux); /* Wakeup for the event driven consumer */
+  void       *sq_notify_aux;         /* (called once per sq_waiting set) */
 
   struct streaming_message_queue sq_queue;
 
@@ -435,6 +440,10 @@ void streaming_queue_deinit(streaming_queue_t *sq);
 
 void streaming_queue_remove(streaming_queue_t *sq, streaming_message_t *sm);
 
+void streaming_queue_take(streaming_queue_t *sq, struct streaming_message_queue *q);
+
+int streaming_queue_wait(streaming_queue_t *sq, int64_t mono);
+
 void streaming_target_connect(streaming_pad_t *sp, streaming_target_t *st);
 
 void streaming_target_disconnect(streaming_pad_t *sp, streaming_target_t *st);
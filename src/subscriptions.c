@@ -1060,6 +1060,7 @@ subscription_create_msg(th_subscription_t *s, const char *lang)
                  di->reader[0] ? "/" : "", di->reader);
       }
       htsmsg_add_str(m, "descramble", buf);
+      descrambler_status(t, m);
     }
     tvh_mutex_unlock(&t->s_stream_mutex);
 
@@ -1095,6 +1096,8 @@ subscription_create_msg(th_subscription_t *s, const char *lang)
   htsmsg_add_u32(m, "out", atomic_get(&s->ths_bytes_out_avg));
   htsmsg_add_s64(m, "total_in", atomic_get_u64(&s->ths_total_bytes_in));
   htsmsg_add_s64(m, "total_out", atomic_get_u64(&s->ths_total_bytes_out));
+  if (atomic_get(&s->ths_clients) > 0)
+    htsmsg_add_u32(m, "clients", atomic_get(&s->ths_clients));
 
   return m;
 }
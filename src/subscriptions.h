@@ -105,6 +105,7 @@ typedef struct th_subscription {
   uint64_t ths_total_bytes_out_prev; /* total bytes since the subscription started, minus 1 second */
   int ths_bytes_in_avg; /* Average bytes in per second */
   int ths_bytes_out_avg; /* Average bytes out per second */
+  int ths_clients; /* Number of HTTP clients sharing the output */
 
   streaming_target_t ths_input;
 
@@ -522,6 +522,8 @@ typedef struct tcp_server_launch {
   uint32_t id;
   int fd;
   int streaming;
+  int detached;         /* 1 = owned by another thread, 2 = finished */
+  int joined;
   tcp_server_ops_t ops;
   void *opaque;
   char *representative;
@@ -647,6 +649,62 @@ tcp_connection_land(void *tcp_id)
   tsl->representative = NULL;
 }
 
+/**
+ * Pass the connection to another owner, the start thread finishes
+ * without closing the socket. The status and cancel callbacks are
+ * called with the new opaque pointer from now.
+ */
+void
+tcp_connection_detach(void *tcp_id, void *opaque,
+                      void (*status) (void *opaque, htsmsg_t *m),
+                      void (*cancel) (void *opaque))
+{
+  tcp_server_launch_t *tsl = tcp_id;
+
+  lock_assert(&global_lock);
+
+  tsl->detached = 1;
+  tsl->opaque = opaque;
+  tsl->status = status;
+  tsl->ops.cancel = cancel;
+  tsl->ops.stop = NULL;
+}
+
+/**
+ * Finish the detached connection (land and close the socket)
+ */
+void
+tcp_connection_detach_done(void *tcp_id)
+{
+  tcp_server_launch_t *tsl = tcp_id;
+
+  lock_assert(&global_lock);
+
+  assert(tsl->detached == 1);
+  tcp_connection_land(tsl);
+  LIST_REMOVE(tsl, alink);
+  close(tsl->fd);
+  tsl->fd = -1;
+  tsl->detached = 2;
+  if (tsl->joined)
+    free(tsl);
+}
+
+/*
+ * Join the finished start thread
+ */
+static void
+tcp_server_join_thread(tcp_server_launch_t *tsl)
+{
+  pthread_join(tsl->tid, NULL);
+  tvh_mutex_lock(&global_lock);
+  if (tsl->detached == 1)
+    tsl->joined = 1;
+  else
+    free(tsl);
+  tvh_mutex_unlock(&global_lock);
+}
+
 /**
  *
  */
@@ -725,7 +783,8 @@ tcp_server_start(void *aux)
 
   /* Stop */
   if (tsl->ops.stop) tsl->ops.stop(tsl->opaque);
-  LIST_REMOVE(tsl, alink);
+  if (!tsl->detached)
+    LIST_REMOVE(tsl, alink);
   LIST_INSERT_HEAD(&tcp_server_join, tsl, jlink);
   tvh_mutex_unlock(&global_lock);
   if (atomic_get(&tcp_server_running))
@@ -766,8 +825,7 @@ next:
         while ((tsl = LIST_FIRST(&tcp_server_join)) != NULL) {
           LIST_REMOVE(tsl, jlink);
           tvh_mutex_unlock(&global_lock);
-          pthread_join(tsl->tid, NULL);
-          free(tsl);
+          tcp_server_join_thread(tsl);
           goto next;
         }
         while ((ts = LIST_FIRST(&tcp_server_delete_list)) != NULL) {
@@ -793,6 +851,8 @@ next:
       tsl->opaque         = ts->opaque;
       tsl->status         = NULL;
       tsl->representative = NULL;
+      tsl->detached       = 0;
+      tsl->joined         = 0;
       slen = sizeof(struct sockaddr_storage);
 
       tsl->fd = accept(ts->serverfd, 
@@ -1197,7 +1257,8 @@ tcp_server_done(void)
       tsl->ops.cancel(tsl->opaque);
     if (tsl->fd >= 0)
       shutdown(tsl->fd, SHUT_RDWR);
-    tvh_thread_kill(tsl->tid, SIGTERM);
+    if (!tsl->detached)
+      tvh_thread_kill(tsl->tid, SIGTERM);
   }
   tvh_mutex_unlock(&global_lock);
 
@@ -1217,8 +1278,7 @@ tcp_server_done(void)
   while ((tsl = LIST_FIRST(&tcp_server_join)) != NULL) {
     LIST_REMOVE(tsl, jlink);
     tvh_mutex_unlock(&global_lock);
-    pthread_join(tsl->tid, NULL);
-    free(tsl);
+    tcp_server_join_thread(tsl);
     tvh_mutex_lock(&global_lock);
   }
   while ((ts = LIST_FIRST(&tcp_server_delete_list)) != NULL) {
@@ -160,6 +160,10 @@ void *tcp_connection_launch(int fd, int streaming,
                             void (*status) (void *opaque, htsmsg_t *m),
                             struct access *aa);
 void tcp_connection_land(void *tcp_id);
+void tcp_connection_detach(void *tcp_id, void *opaque,
+                           void (*status) (void *opaque, htsmsg_t *m),
+                           void (*cancel) (void *opaque));
+void tcp_connection_detach_done(void *tcp_id);
 void tcp_connection_cancel(uint32_t id);
 void tcp_connection_cancel_all(void);
 
@@ -88,6 +88,7 @@ void timeshift_init ( void )
   timeshift_conf.idnode.in_class = &timeshift_conf_class;
   timeshift_conf.max_period       = 60;                      // Hr (60mins)
   timeshift_conf.max_size         = 10000 * (size_t)1048576; // 10G
+  timeshift_conf.shared           = 1;
 
   idclass_register(&timeshift_conf_class);
 
@@ -176,6 +177,14 @@ timeshift_conf_class_ram_size_set ( void *o, const void *v )
   return 0;
 }
 
+static const void *
+timeshift_conf_class_saved_size_get ( void *o )
+{
+  static uint64_t r;
+  r = atomic_get_u64(&timeshift_total_saved_size) / 1048576LL;
+  return &r;
+}
+
 CLASS_DOC(timeshift)
 
 const idclass_t timeshift_conf_class = {
@@ -289,6 +298,26 @@ const idclass_t timeshift_conf_class = {
       .off    = offsetof(timeshift_conf_t, ram_fit),
       .opts   = PO_EXPERT,
     },
+    {
+      .type   = PT_BOOL,
+      .id     = "shared",
+      .name   = N_("Share buffers"),
+      .desc   = N_("Use one buffer for all clients watching the same "
+                   "channel with the same stream profile. The data are "
+                   "stored only once, each client keeps its own "
+                   "position and play speed."),
+      .off    = offsetof(timeshift_conf_t, shared),
+      .opts   = PO_EXPERT,
+    },
+    {
+      .type   = PT_S64,
+      .id     = "saved_size",
+      .name   = N_("Saved by sharing (MB)"),
+      .desc   = N_("The amount of data which did not have to be stored "
+                   "thanks to the shared buffers (since start)."),
+      .get    = timeshift_conf_class_saved_size_get,
+      .opts   = PO_RDONLY | PO_NOSAVE | PO_EXPERT,
+    },
     {
       .type   = PT_BOOL,
       .id     = "teletext",
@@ -434,14 +463,8 @@ timeshift_destroy(streaming_target_t *pad)
   close(ts->rd_pipe.rd);
   close(ts->rd_pipe.wr);
 
-  /* Flush files */
-  timeshift_filemgr_flush(ts, NULL);
-
-  if (ts->smt_start)
-    streaming_start_unref(ts->smt_start);
-
-  if (ts->path)
-    free(ts->path);
+  /* Release buffer */
+  timeshift_buffer_detach(ts);
 
   free(ts);
   memoryinfo_free(&timeshift_memoryinfo, sizeof(timeshift_t));
@@ -452,9 +475,11 @@ timeshift_destroy(streaming_target_t *pad)
  *
  * max_period of buffer in seconds (0 = unlimited)
  * max_size   of buffer in bytes   (0 = unlimited)
+ * key_id and key_pro identify the source for the shared buffer (may be NULL)
  */
 streaming_target_t *timeshift_create
-  (streaming_target_t *out, time_t max_time)
+  (streaming_target_t *out, time_t max_time,
+   const void *key_id, const void *key_pro)
 {
   timeshift_t *ts = calloc(1, sizeof(timeshift_t));
 
@@ -464,14 +489,10 @@ streaming_target_t *timeshift_create
   lock_assert(&global_lock);
 
   /* Setup structure */
-  TAILQ_INIT(&ts->files);
   ts->output     = out;
-  ts->path       = NULL;
   ts->max_time   = max_time;
   ts->state      = TS_LIVE;
   ts->exit       = 0;
-  ts->full       = 0;
-  ts->vididx     = -1;
   ts->id         = timeshift_index;
   ts->ondemand   = timeshift_conf.ondemand;
   ts->dobuf      = ts->ondemand ? 0 : 1;
@@ -482,10 +503,12 @@ streaming_target_t *timeshift_create
   ts->ref_time   = 0;
   ts->seek.file  = NULL;
   ts->seek.frame = NULL;
-  ts->ram_segments = 0;
-  ts->file_segments = 0;
+  TAILQ_INIT(&ts->pending);
   tvh_mutex_init(&ts->state_mutex, NULL);
 
+  /* Shared buffer */
+  timeshift_buffer_attach(ts, key_id, key_pro);
+
   /* Initialise output */
   tvh_pipe(O_NONBLOCK, &ts->rd_pipe);
 
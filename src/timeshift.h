@@ -39,6 +39,7 @@ typedef struct timeshift_conf {
   int       ram_only;
   int       ram_fit;
   int       teletext;
+  int       shared;
 } timeshift_conf_t;
 
 extern struct timeshift_conf timeshift_conf;
@@ -51,7 +52,8 @@ void timeshift_init ( void );
 void timeshift_term ( void );
 
 streaming_target_t *timeshift_create
-  (streaming_target_t *out, time_t max_period);
+  (streaming_target_t *out, time_t max_period,
+   const void *key_id, const void *key_pro);
 
 void timeshift_destroy(streaming_target_t *pad);
 
@@ -22,19 +22,55 @@
 #define TIMESHIFT_PLAY_BUF         1000000 //< us to buffer in TX
 #define TIMESHIFT_FILE_PERIOD      60      //< number of secs in each buffer file
 #define TIMESHIFT_BACKLOG_MAX      16      //< maximum elementary streams
+#define TIMESHIFT_SYNC_RING        64      //< packets remembered for the shared buffer sync
+#define TIMESHIFT_SYNC_RUN         4       //< consecutive equal packets to accept the sync
+#define TIMESHIFT_SYNC_TIMEOUT     5       //< secs to find the shared buffer time offset
+#define TIMESHIFT_PENDING_MAX      4096    //< packets kept for the writer handover
+#define TIMESHIFT_SEGMENT_SIZE     (64*1024*1024) //< mapped size of the disk segment
+#define TIMESHIFT_SEGMENT_GROW     (1024*1024)    //< disk space reserved at once
+#define TIMESHIFT_RECORD_MAX       (2*1024*1024)  //< maximal record size
+#define TIMESHIFT_RECORD_ALIGN     8
 
 /**
- * Indexes of import data in the stream
+ * Segment layout
+ *
+ * Each segment (RAM or file) is a fixed size memory mapping. The records
+ * are appended from the start of the segment, the i-frame index grows
+ * from the end of the segment down. Only the writer appends, the readers
+ * access the data directly (both with the buffer lock held).
+ */
+typedef struct timeshift_record
+{
+  uint32_t                            len;    ///< Record size (with header, aligned)
+  uint8_t                             type;   ///< Message type
+  uint8_t                             spare[3];
+  int64_t                             time;   ///< Message time
+} timeshift_record_t;
+
+typedef struct timeshift_record_pkt
+{
+  int64_t                             pts;
+  int64_t                             dts;
+  int64_t                             pcr;
+  int32_t                             duration;
+  uint32_t                            meta_len;
+  uint32_t                            payload_len;
+  uint8_t                             type;
+  uint8_t                             err;
+  uint8_t                             componentindex;
+  uint8_t                             commercial;
+  uint8_t                             av[8];  ///< Audio/video specific fields
+} timeshift_record_pkt_t;
+
+/**
+ * Indexes of import data in the stream (stored at the end of the segment)
  */
 typedef struct timeshift_index_iframe
 {
-  off_t                               pos;    ///< Position in the file
+  int64_t                             pos;    ///< Position in the segment
   int64_t                             time;   ///< Packet time
-  TAILQ_ENTRY(timeshift_index_iframe) link;   ///< List entry
 } timeshift_index_iframe_t;
 
-typedef TAILQ_HEAD(timeshift_index_iframe_list,timeshift_index_iframe) timeshift_index_iframe_list_t;
-
 /**
  * Indexes of import data in the stream
  */
@@ -52,41 +88,151 @@ typedef TAILQ_HEAD(timeshift_index_data_list,timeshift_index_data) timeshift_ind
  */
 typedef struct timeshift_file
 {
-  int                           wfd;      ///< Write descriptor
-  int                           rfd;      ///< Read descriptor
+  int                           wfd;      ///< Write descriptor (file segment)
   char                          *path;    ///< Full path to file
 
   int64_t                       time;     ///< Files coarse timestamp
+  int64_t                       boff;     ///< Offset of file in the buffer
   size_t                        size;     ///< Current file size;
   int64_t                       last;     ///< Latest timestamp
   off_t                         woff;     ///< Write offset
-  off_t                         roff;     ///< Read offset
 
-  uint8_t                      *ram;      ///< RAM area
-  int64_t                       ram_size; ///< RAM area size in bytes
+  uint8_t                      *data;     ///< Mapped segment
+  size_t                        data_size;///< Mapped size
+  off_t                         rsv_lo;   ///< Disk space reserved for records
+  off_t                         rsv_hi;   ///< Disk space reserved for index
+  int64_t                       ram_size; ///< Accounted RAM size in bytes
 
+  uint8_t                       ram;      ///< RAM segment
   uint8_t                       bad;      ///< File is broken
 
   int                           refcount; ///< Reader ref count
 
-  timeshift_index_iframe_list_t iframes;  ///< I-frame indexing
+  int                           iframes;  ///< I-frame index entries
   timeshift_index_data_list_t   sstart;   ///< Stream start messages
 
   TAILQ_ENTRY(timeshift_file) link;     ///< List entry
-
-  tvh_mutex_t               ram_lock; ///< Mutex for the ram array access
 } timeshift_file_t;
 
 typedef TAILQ_HEAD(timeshift_file_list,timeshift_file) timeshift_file_list_t;
 
 /**
- *
+ * Time index of the whole buffer (append only, trimmed from the head)
+ */
+typedef struct timeshift_index_entry {
+  int64_t                       time;     ///< Frame time
+  int64_t                       boff;     ///< Offset of frame in the buffer
+  timeshift_file_t             *file;     ///< Segment
+  int                           idx;      ///< Entry of the segment index
+} timeshift_index_entry_t;
+
+typedef struct timeshift_index {
+  timeshift_index_entry_t      *entries;
+  int                           first;    ///< First valid entry
+  int                           count;    ///< Used entries (with trimmed)
+  int                           alloc;    ///< Allocated entries
+} timeshift_index_t;
+
+static inline timeshift_index_iframe_t *
+timeshift_file_iframe ( timeshift_file_t *tsf, int idx )
+{
+  if (idx < 0 || idx >= tsf->iframes)
+    return NULL;
+  return (timeshift_index_iframe_t *)
+    (tsf->data + tsf->data_size) - (idx + 1);
+}
+
+static inline int
+timeshift_file_iframe_idx ( timeshift_file_t *tsf, timeshift_index_iframe_t *ti )
+{
+  return ((timeshift_index_iframe_t *)(tsf->data + tsf->data_size) - ti) - 1;
+}
+
+static inline size_t timeshift_file_free ( timeshift_file_t *tsf )
+{
+  size_t used = tsf->woff + (tsf->iframes + 1) * sizeof(timeshift_index_iframe_t);
+  return used < tsf->data_size ? tsf->data_size - used : 0;
+}
+
+/**
+ * Reader position (each reader has own cursor to the shared files)
  */
 typedef struct timeshift_seek {
   timeshift_file_t           *file;
   timeshift_index_iframe_t   *frame;
+  off_t                       roff;       ///< Read offset
+  uint8_t                     moved;      ///< Moved forward by the writer (buffer full)
 } timeshift_seek_t;
 
+/**
+ * Recently seen packets (to find the time offset between the clients)
+ */
+typedef struct timeshift_sync {
+  pktbuf_t                   *pb;         ///< Payload (referenced)
+  int64_t                     pts;        ///< Packet PTS
+  int64_t                     seq;        ///< Packet sequence number
+  uint32_t                    hash;       ///< Payload hash (start of the payload)
+  int                         comp;       ///< Component index
+} timeshift_sync_t;
+
+typedef struct timeshift_sync_ring {
+  timeshift_sync_t            ring[TIMESHIFT_SYNC_RING];
+  int                         next;
+} timeshift_sync_ring_t;
+
+/**
+ * Packets seen by a reader but not passed by the writer yet (handover)
+ */
+typedef struct timeshift_pending {
+  streaming_message_t        *sm;
+  int64_t                     seq;        ///< Packet sequence number (buffer)
+  TAILQ_ENTRY(timeshift_pending) link;
+} timeshift_pending_t;
+
+typedef TAILQ_HEAD(timeshift_pending_list,timeshift_pending) timeshift_pending_list_t;
+
+struct timeshift;
+
+/**
+ * Buffer shared by all timeshift instances of one channel/profile
+ */
+typedef struct timeshift_buffer {
+  LIST_ENTRY(timeshift_buffer) link;      ///< Global list entry
+  const void                 *key_id;     ///< Source (channel/service)
+  const void                 *key_pro;    ///< Stream profile
+
+  int                         id;         ///< Reference number
+  char                       *path;       ///< Directory used for files
+  time_t                      max_time;   ///< Maximum period to shift
+  int                         dobuf;      ///< Buffer packets (store)
+  uint8_t                     full;       ///< Buffer is full
+
+  tvh_mutex_t                 lock;       ///< Protect files and readers
+  int                         refcount;   ///< Attached instances
+  LIST_HEAD(, timeshift)      instances;  ///< Attached instances
+  struct timeshift           *writer;     ///< Instance storing the data
+  timeshift_sync_ring_t       sync;       ///< Packets stored by the writer
+  int64_t                     seq;        ///< Last packet passed by the writer
+
+  timeshift_file_list_t       files;      ///< List of files
+  timeshift_index_t           index;      ///< I-frame index for all files
+  int64_t                     boff;       ///< Bytes stored since start
+
+  int                         ram_segments;  ///< Count of segments in RAM
+  int                         file_segments; ///< Count of segments in files
+
+  int                         vididx;     ///< Index of (current) video stream
+  int                         audidx;     ///< Index of (current) audio stream
+
+  uint8_t                     audio_packet_counter; ///< Counter for audio packets in audio-only streams
+
+  streaming_start_t          *smt_start;  ///< Streaming start info
+
+  int                         max_clients;///< Max. attached instances
+  uint64_t                    written;    ///< Stored bytes
+  uint64_t                    saved;      ///< Bytes not stored thanks to sharing
+} timeshift_buffer_t;
+
 /**
  *
  */
@@ -96,7 +242,6 @@ typedef struct timeshift {
   streaming_target_t          *output;    ///< Output dest
 
   int                         id;         ///< Reference number
-  char                        *path;      ///< Directory containing buffer
   time_t                      max_time;   ///< Maximum period to shift
   int                         ondemand;   ///< Whether this is an on-demand timeshift
   int                         packet_mode;///< Packet mode (otherwise MPEG-TS data mode)
@@ -115,7 +260,18 @@ typedef struct timeshift {
   }                           state;       ///< Play state
   tvh_mutex_t             state_mutex; ///< Protect state changes
   uint8_t                     exit;        ///< Exit from the main input thread
-  uint8_t                     full;        ///< Buffer is full
+
+  timeshift_buffer_t         *tsb;        ///< Buffer (changed with state_mutex)
+  LIST_ENTRY(timeshift)       tsb_link;   ///< Buffer instances
+  uint8_t                     synced;     ///< Time offset to the buffer is known
+  uint8_t                     handover;   ///< Writer was changed, continue after tsb->seq
+  int64_t                     delta;      ///< Time offset to the buffer (us)
+  int64_t                     delta_pts;  ///< Time offset to the buffer (PTS)
+  int64_t                     sync_start; ///< Sync start (monoclock)
+  timeshift_sync_ring_t       sync;       ///< Packets seen (not synced yet)
+  int64_t                     seq;        ///< Last packet (buffer numbering when synced)
+  timeshift_pending_list_t    pending;    ///< Packets not passed by the writer yet
+  int                         pending_count;
 
   timeshift_seek_t            seek;       ///< Seek into buffered data
   
@@ -125,18 +281,6 @@ typedef struct timeshift {
   pthread_t                   rd_thread;  ///< Reader thread
   th_pipe_t                   rd_pipe;    ///< Message passing to reader
 
-  timeshift_file_list_t       files;      ///< List of files
-
-  int                         ram_segments;  ///< Count of segments in RAM
-  int                         file_segments; ///< Count of segments in files
-
-  int                         vididx;     ///< Index of (current) video stream
-  int                         audidx;     ///< Index of (current) audio stream
-  
-  uint8_t                         audio_packet_counter; ///< Counter for audio packets in audio-only streams
-
-  streaming_start_t          *smt_start;  ///< Streaming start info
-
 } timeshift_t;
 
 /*
@@ -144,6 +288,7 @@ typedef struct timeshift {
  */
 extern uint64_t timeshift_total_size;
 extern uint64_t timeshift_total_ram_size;
+extern uint64_t timeshift_total_saved_size;
 
 void timeshift_packet_log0
   ( const char *prefix, timeshift_t *ts, streaming_message_t *sm );
@@ -158,7 +303,6 @@ static inline void timeshift_packet_log
 /*
  * Write functions
  */
-ssize_t timeshift_write_start   ( timeshift_file_t *tsf, int64_t time, streaming_start_t *ss );
 ssize_t timeshift_write_sigstat ( timeshift_file_t *tsf, int64_t time, signal_status_t *ss );
 ssize_t timeshift_write_packet  ( timeshift_file_t *tsf, int64_t time, th_pkt_t *pkt );
 ssize_t timeshift_write_mpegts  ( timeshift_file_t *tsf, int64_t time, void *data );
@@ -166,7 +310,6 @@ ssize_t timeshift_write_skip    ( int fd, streaming_skip_t *skip );
 ssize_t timeshift_write_speed   ( int fd, int speed );
 ssize_t timeshift_write_stop    ( int fd, int code );
 ssize_t timeshift_write_exit    ( int fd );
-ssize_t timeshift_write_eof     ( timeshift_file_t *tsf );
 
 /*
  * Threads
@@ -210,26 +353,66 @@ static inline void timeshift_file_put0 ( timeshift_file_t *tsf )
 })
 
 timeshift_file_t *timeshift_filemgr_get
-  ( timeshift_t *ts, int64_t start_time );
+  ( timeshift_buffer_t *tsb, int64_t start_time );
 timeshift_file_t *timeshift_filemgr_oldest
-  ( timeshift_t *ts );
+  ( timeshift_buffer_t *tsb );
 timeshift_file_t *timeshift_filemgr_newest
-  ( timeshift_t *ts );
+  ( timeshift_buffer_t *tsb );
 timeshift_file_t *timeshift_filemgr_prev
   ( timeshift_file_t *ts, int *end, int keep );
 timeshift_file_t *timeshift_filemgr_next
   ( timeshift_file_t *ts, int *end, int keep );
 void timeshift_filemgr_remove
-  ( timeshift_t *ts, timeshift_file_t *tsf, int force );
-void timeshift_filemgr_flush ( timeshift_t *ts, timeshift_file_t *end );
+  ( timeshift_buffer_t *tsb, timeshift_file_t *tsf, int force );
+void timeshift_filemgr_flush ( timeshift_buffer_t *tsb, timeshift_file_t *end );
+void timeshift_filemgr_trim ( timeshift_buffer_t *tsb );
 void timeshift_filemgr_close ( timeshift_file_t *tsf );
 
-void timeshift_filemgr_dump0 ( timeshift_t *ts );
+void timeshift_filemgr_dump0 ( timeshift_buffer_t *tsb );
+
+void timeshift_index_add
+  ( timeshift_buffer_t *tsb, timeshift_file_t *tsf, int idx );
+void timeshift_index_remove
+  ( timeshift_buffer_t *tsb, timeshift_file_t *tsf );
+void timeshift_index_free ( timeshift_buffer_t *tsb );
+timeshift_index_entry_t *timeshift_index_find_time
+  ( timeshift_buffer_t *tsb, int64_t time, int back );
+timeshift_index_entry_t *timeshift_index_find_boff
+  ( timeshift_buffer_t *tsb, int64_t boff );
 
-static inline void timeshift_filemgr_dump ( timeshift_t *ts )
+static inline timeshift_index_entry_t *
+timeshift_index_first ( timeshift_buffer_t *tsb )
+{
+  timeshift_index_t *ti = &tsb->index;
+  return ti->first < ti->count ? &ti->entries[ti->first] : NULL;
+}
+
+static inline timeshift_index_entry_t *
+timeshift_index_last ( timeshift_buffer_t *tsb )
+{
+  timeshift_index_t *ti = &tsb->index;
+  return ti->first < ti->count ? &ti->entries[ti->count - 1] : NULL;
+}
+
+static inline void timeshift_filemgr_dump ( timeshift_buffer_t *tsb )
 {
   if (tvhtrace_enabled())
-    timeshift_filemgr_dump0(ts);
+    timeshift_filemgr_dump0(tsb);
 }
 
+/*
+ * Shared buffer
+ */
+void timeshift_buffer_attach
+  ( timeshift_t *ts, const void *key_id, const void *key_pro );
+void timeshift_buffer_detach ( timeshift_t *ts );
+void timeshift_buffer_sync ( timeshift_t *ts, th_pkt_t *pkt );
+void timeshift_buffer_record ( timeshift_buffer_t *tsb, th_pkt_t *pkt );
+void timeshift_buffer_follow ( timeshift_t *ts, streaming_message_t *sm );
+streaming_message_t *timeshift_buffer_pending_next ( timeshift_t *ts );
+void timeshift_buffer_pending_clear ( timeshift_t *ts );
+int  timeshift_buffer_release ( timeshift_buffer_t *tsb, timeshift_file_t *tsf );
+void timeshift_buffer_dobuf ( timeshift_t *ts );
+int  timeshift_buffer_sharers ( timeshift_buffer_t *tsb );
+
 #endif /* __TVH_TIMESHIFT_PRIVATE_H__ */
@@ -0,0 +1,527 @@
+/*
+ *  TV headend - Timeshift Shared Buffer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The timeshift instances of the same channel and stream profile use
+ * one buffer. Only one instance (the writer) stores the data, the other
+ * instances only read them with their own position and speed.
+ *
+ * The timestamps are rebased for each client (tsfix), so each instance
+ * has its own time offset to the buffer. The offset is found by matching
+ * a run of packet payloads with the packets recently stored by the writer.
+ * The instances which cannot find the offset use their own buffer.
+ *
+ * The packets are numbered in the buffer order. The synced instances keep
+ * the packets which the writer did not pass yet, so the new writer can
+ * continue exactly after the last stored packet when the writer leaves.
+ */
+
+#include "tvheadend.h"
+#include "streaming.h"
+#include "timeshift.h"
+#include "timeshift/private.h"
+#include "atomic.h"
+
+static tvh_mutex_t timeshift_buffers_lock = TVH_THREAD_MUTEX_INITIALIZER;
+static LIST_HEAD(, timeshift_buffer) timeshift_buffers;
+
+/* **************************************************************************
+ * Payload ring
+ * *************************************************************************/
+
+static uint32_t
+timeshift_sync_hash ( pktbuf_t *pb )
+{
+  const uint8_t *p = pktbuf_ptr(pb);
+  size_t i, len = MIN(pktbuf_len(pb), 256);
+  uint32_t h = 2166136261u;
+
+  for (i = 0; i < len; i++)
+    h = (h ^ p[i]) * 16777619u;
+  return h;
+}
+
+static void
+timeshift_sync_add
+  ( timeshift_sync_ring_t *r, th_pkt_t *pkt, int64_t pts, int64_t seq )
+{
+  timeshift_sync_t *s = &r->ring[r->next];
+
+  if (s->pb)
+    pktbuf_ref_dec(s->pb);
+  s->pb   = pktbuf_ref_inc(pkt->pkt_payload);
+  s->pts  = pts;
+  s->seq  = seq;
+  s->hash = timeshift_sync_hash(pkt->pkt_payload);
+  s->comp = pkt->pkt_componentindex;
+  r->next = (r->next + 1) % TIMESHIFT_SYNC_RING;
+}
+
+/*
+ * Each subscription parses the stream itself, so the payloads of two
+ * instances are equal by content (the same buffer only for the shared
+ * profile chains)
+ */
+static int
+timeshift_sync_equal ( timeshift_sync_t *a, timeshift_sync_t *b )
+{
+  size_t len;
+
+  if (a->pb == NULL || b->pb == NULL)
+    return 0;
+  if (a->pb == b->pb)
+    return 1;
+  len = pktbuf_len(a->pb);
+  return a->comp == b->comp && a->hash == b->hash &&
+         len == pktbuf_len(b->pb) &&
+         memcmp(pktbuf_ptr(a->pb), pktbuf_ptr(b->pb), len) == 0;
+}
+
+/*
+ * Find the entry in r for the newest packet in r2, the previous packets
+ * must match, too, and the match must be unique (some payloads repeat,
+ * like the silent audio frames)
+ */
+static timeshift_sync_t *
+timeshift_sync_find ( timeshift_sync_ring_t *r, timeshift_sync_ring_t *r2 )
+{
+  const int n = TIMESHIFT_SYNC_RING;
+  int i, k, last = (r2->next + n - 1) % n;
+  timeshift_sync_t *res = NULL;
+
+  for (i = 0; i < n; i++) {
+    if ((i - r->next + n) % n < TIMESHIFT_SYNC_RUN - 1)
+      continue;
+    for (k = 0; k < TIMESHIFT_SYNC_RUN; k++)
+      if (!timeshift_sync_equal(&r->ring[(i + n - k) % n],
+                                &r2->ring[(last + n - k) % n]))
+        break;
+    if (k == TIMESHIFT_SYNC_RUN) {
+      if (res)
+        return NULL;
+      res = &r->ring[i];
+    }
+  }
+  return res;
+}
+
+static void
+timeshift_sync_clear ( timeshift_sync_ring_t *r )
+{
+  int i;
+
+  for (i = 0; i < TIMESHIFT_SYNC_RING; i++)
+    if (r->ring[i].pb)
+      pktbuf_ref_dec(r->ring[i].pb);
+  memset(r, 0, sizeof(*r));
+}
+
+/* **************************************************************************
+ * Pending packets (writer handover)
+ * *************************************************************************/
+
+static void
+timeshift_pending_remove ( timeshift_t *ts, timeshift_pending_t *tp )
+{
+  TAILQ_REMOVE(&ts->pending, tp, link);
+  ts->pending_count--;
+  if (tp->sm)
+    streaming_msg_free(tp->sm);
+  memoryinfo_free(&timeshift_memoryinfo, sizeof(*tp));
+  free(tp);
+}
+
+void
+timeshift_buffer_pending_clear ( timeshift_t *ts )
+{
+  timeshift_pending_t *tp;
+
+  while ((tp = TAILQ_FIRST(&ts->pending)) != NULL)
+    timeshift_pending_remove(ts, tp);
+}
+
+/*
+ * Remember the packet until the writer passes it (synced readers,
+ * must hold tsb->lock, ts->seq is already increased)
+ */
+void
+timeshift_buffer_follow ( timeshift_t *ts, streaming_message_t *sm )
+{
+  timeshift_buffer_t *tsb = ts->tsb;
+  timeshift_pending_t *tp;
+
+  while ((tp = TAILQ_FIRST(&ts->pending)) != NULL &&
+         (tp->seq <= tsb->seq || ts->pending_count >= TIMESHIFT_PENDING_MAX))
+    timeshift_pending_remove(ts, tp);
+
+  if (!tsb->dobuf || ts->seq <= tsb->seq)
+    return;
+  tp = malloc(sizeof(*tp));
+  memoryinfo_alloc(&timeshift_memoryinfo, sizeof(*tp));
+  tp->sm  = streaming_msg_clone(sm);
+  tp->seq = ts->seq;
+  TAILQ_INSERT_TAIL(&ts->pending, tp, link);
+  ts->pending_count++;
+}
+
+/*
+ * Next packet which the previous writer did not pass (new writer,
+ * must hold tsb->lock), the caller owns the returned message
+ */
+streaming_message_t *
+timeshift_buffer_pending_next ( timeshift_t *ts )
+{
+  timeshift_buffer_t *tsb = ts->tsb;
+  timeshift_pending_t *tp;
+  streaming_message_t *sm;
+
+  while ((tp = TAILQ_FIRST(&ts->pending)) != NULL) {
+    if (tp->seq > tsb->seq) {
+      sm = tp->sm;
+      tp->sm = NULL;
+      tsb->seq = tp->seq;
+      timeshift_pending_remove(ts, tp);
+      return sm;
+    }
+    timeshift_pending_remove(ts, tp);
+  }
+  return NULL;
+}
+
+/* **************************************************************************
+ * Buffer management
+ * *************************************************************************/
+
+/*
+ * Instance time = buffer time + delta
+ */
+static void
+timeshift_buffer_synced ( timeshift_t *ts, int64_t pts, int64_t buf_pts )
+{
+  ts->delta_pts = pts - buf_pts;
+  ts->delta     = ts_rescale(pts, 1000000) - ts_rescale(buf_pts, 1000000);
+  ts->synced    = 1;
+  timeshift_sync_clear(&ts->sync);
+  tvhdebug(LS_TIMESHIFT, "ts %d joined shared buffer %d (offset %"PRId64" us)",
+           ts->id, ts->tsb->id, ts->delta);
+}
+
+static void
+timeshift_buffer_max_time ( timeshift_buffer_t *tsb )
+{
+  timeshift_t *ts;
+  time_t t = 0;
+
+  LIST_FOREACH(ts, &tsb->instances, tsb_link) {
+    if (ts->max_time == 0) {
+      t = 0;
+      break;
+    }
+    t = MAX(t, ts->max_time);
+  }
+  tsb->max_time = t;
+}
+
+static timeshift_buffer_t *
+timeshift_buffer_create
+  ( timeshift_t *ts, const void *key_id, const void *key_pro )
+{
+  timeshift_buffer_t *tsb = calloc(1, sizeof(*tsb));
+
+  memoryinfo_alloc(&timeshift_memoryinfo, sizeof(*tsb));
+  tsb->key_id  = key_id;
+  tsb->key_pro = key_pro;
+  tsb->id      = ts->id;
+  tsb->vididx  = -1;
+  tvh_mutex_init(&tsb->lock, NULL);
+  TAILQ_INIT(&tsb->files);
+  LIST_INIT(&tsb->instances);
+  LIST_INSERT_HEAD(&timeshift_buffers, tsb, link);
+  return tsb;
+}
+
+static void
+timeshift_buffer_destroy ( timeshift_buffer_t *tsb )
+{
+  tvhdebug(LS_TIMESHIFT, "ts %d buffer close (clients %d, stored %"PRIu64
+                         " bytes, saved %"PRIu64" bytes)",
+           tsb->id, tsb->max_clients, tsb->written, tsb->saved);
+  timeshift_filemgr_flush(tsb, NULL);
+  timeshift_index_free(tsb);
+  timeshift_sync_clear(&tsb->sync);
+  if (tsb->smt_start)
+    streaming_start_unref(tsb->smt_start);
+  free(tsb->path);
+  tvh_mutex_destroy(&tsb->lock);
+  memoryinfo_free(&timeshift_memoryinfo, sizeof(*tsb));
+  free(tsb);
+}
+
+/*
+ * Must hold timeshift_buffers_lock and tsb->lock
+ */
+static void
+timeshift_buffer_insert ( timeshift_buffer_t *tsb, timeshift_t *ts )
+{
+  LIST_INSERT_HEAD(&tsb->instances, ts, tsb_link);
+  tsb->refcount++;
+  tsb->max_clients = MAX(tsb->max_clients, tsb->refcount);
+  ts->tsb        = tsb;
+  ts->handover   = 0;
+  ts->sync_start = 0;
+  if (tsb->writer == NULL) {
+    tsb->writer   = ts;
+    tsb->seq      = ts->seq;
+    ts->synced    = 1;
+    ts->delta     = 0;
+    ts->delta_pts = 0;
+  } else {
+    ts->synced    = 0;
+    tvhdebug(LS_TIMESHIFT, "ts %d attach to shared buffer %d", ts->id, tsb->id);
+  }
+  if (ts->dobuf)
+    tsb->dobuf = 1;
+  timeshift_buffer_max_time(tsb);
+}
+
+/*
+ * Must hold timeshift_buffers_lock and tsb->lock
+ */
+static int
+timeshift_buffer_remove ( timeshift_buffer_t *tsb, timeshift_t *ts )
+{
+  timeshift_t *ts2;
+
+  LIST_REMOVE(ts, tsb_link);
+  tsb->refcount--;
+  timeshift_sync_clear(&ts->sync);
+  timeshift_buffer_pending_clear(ts);
+  ts->tsb = NULL;
+
+  /* Elect new writer */
+  if (tsb->writer == ts) {
+    tsb->writer = NULL;
+    LIST_FOREACH(ts2, &tsb->instances, tsb_link)
+      if (ts2->synced) {
+        tsb->writer = ts2;
+        ts2->handover = 1;
+        break;
+      }
+    if (tsb->writer == NULL && (ts2 = LIST_FIRST(&tsb->instances)) != NULL) {
+      /* nobody knows the time offset, start from scratch */
+      timeshift_filemgr_flush(tsb, NULL);
+      timeshift_sync_clear(&tsb->sync);
+      tsb->full     = 0;
+      tsb->writer   = ts2;
+      tsb->seq      = ts2->seq;
+      ts2->synced   = 1;
+      ts2->delta    = 0;
+      ts2->delta_pts = 0;
+      timeshift_sync_clear(&ts2->sync);
+      timeshift_buffer_pending_clear(ts2);
+    }
+    if (tsb->writer)
+      tvhdebug(LS_TIMESHIFT, "ts %d new writer for shared buffer %d",
+               tsb->writer->id, tsb->id);
+  }
+
+  timeshift_buffer_max_time(tsb);
+  return tsb->refcount;
+}
+
+/*
+ * Attach the instance to the buffer for the given channel and profile
+ */
+void
+timeshift_buffer_attach
+  ( timeshift_t *ts, const void *key_id, const void *key_pro )
+{
+  timeshift_buffer_t *tsb = NULL;
+
+  if (!timeshift_conf.shared)
+    key_id = key_pro = NULL;
+
+  tvh_mutex_lock(&timeshift_buffers_lock);
+  if (key_id)
+    LIST_FOREACH(tsb, &timeshift_buffers, link)
+      if (tsb->key_id == key_id && tsb->key_pro == key_pro)
+        break;
+  if (tsb == NULL)
+    tsb = timeshift_buffer_create(ts, key_id, key_pro);
+  tvh_mutex_lock(&tsb->lock);
+  timeshift_buffer_insert(tsb, ts);
+  tvh_mutex_unlock(&tsb->lock);
+  tvh_mutex_unlock(&timeshift_buffers_lock);
+}
+
+/*
+ * Detach the instance (the threads must be finished)
+ */
+void
+timeshift_buffer_detach ( timeshift_t *ts )
+{
+  timeshift_buffer_t *tsb = ts->tsb;
+  int r;
+
+  if (tsb == NULL)
+    return;
+  tvh_mutex_lock(&timeshift_buffers_lock);
+  tvh_mutex_lock(&tsb->lock);
+  r = timeshift_buffer_remove(tsb, ts);
+  if (r == 0)
+    LIST_REMOVE(tsb, link);
+  tvh_mutex_unlock(&tsb->lock);
+  tvh_mutex_unlock(&timeshift_buffers_lock);
+  if (r == 0)
+    timeshift_buffer_destroy(tsb);
+}
+
+/*
+ * Find the time offset to the shared buffer (writer thread, state_mutex)
+ */
+void
+timeshift_buffer_sync ( timeshift_t *ts, th_pkt_t *pkt )
+{
+  timeshift_buffer_t *tsb = ts->tsb, *tsb2;
+  timeshift_sync_t *s;
+  int64_t now;
+  int r = 1, own = 0;
+
+  if (ts->synced)
+    return;
+
+  now = getfastmonoclock();
+  tvh_mutex_lock(&tsb->lock);
+  if (!ts->synced) {
+    if (ts->sync_start == 0)
+      ts->sync_start = now;
+    if (pkt && pkt->pkt_payload && pkt->pkt_pts != PTS_UNSET) {
+      /* this packet gets ts->seq + 1 in _process_msg */
+      timeshift_sync_add(&ts->sync, pkt, pkt->pkt_pts, ts->seq + 1);
+      if ((s = timeshift_sync_find(&tsb->sync, &ts->sync)) != NULL) {
+        ts->seq = s->seq - 1;
+        timeshift_buffer_synced(ts, pkt->pkt_pts, s->pts);
+      }
+    }
+    own = !ts->synced &&
+          now - ts->sync_start > sec2mono(TIMESHIFT_SYNC_TIMEOUT);
+  }
+  tvh_mutex_unlock(&tsb->lock);
+
+  if (!own)
+    return;
+
+  /* Different data (other service or profile settings), use own buffer */
+  tvh_mutex_lock(&timeshift_buffers_lock);
+  tvh_mutex_lock(&tsb->lock);
+  if (ts->synced) {
+    own = 0;
+  } else {
+    tvhdebug(LS_TIMESHIFT, "ts %d no match with shared buffer %d, using own buffer",
+             ts->id, tsb->id);
+    r = timeshift_buffer_remove(tsb, ts);
+    if (r == 0)
+      LIST_REMOVE(tsb, link);
+  }
+  tvh_mutex_unlock(&tsb->lock);
+  if (own) {
+    tsb2 = timeshift_buffer_create(ts, NULL, NULL);
+    tvh_mutex_lock(&tsb2->lock);
+    timeshift_buffer_insert(tsb2, ts);
+    tvh_mutex_unlock(&tsb2->lock);
+  }
+  tvh_mutex_unlock(&timeshift_buffers_lock);
+  if (own && r == 0)
+    timeshift_buffer_destroy(tsb);
+}
+
+/*
+ * Remember the packet passed by the writer (must hold tsb->lock)
+ */
+void
+timeshift_buffer_record ( timeshift_buffer_t *tsb, th_pkt_t *pkt )
+{
+  timeshift_t *ts;
+  timeshift_sync_t *s;
+  int64_t pts;
+
+  if (pkt->pkt_payload == NULL)
+    return;
+  tsb->seq = tsb->writer->seq;
+  if (pkt->pkt_pts == PTS_UNSET)
+    return;
+  pts = pkt->pkt_pts - tsb->writer->delta_pts;
+  timeshift_sync_add(&tsb->sync, pkt, pts, tsb->seq);
+  LIST_FOREACH(ts, &tsb->instances, tsb_link)
+    if (!ts->synced && (s = timeshift_sync_find(&ts->sync, &tsb->sync))) {
+      ts->seq += tsb->seq - s->seq;
+      timeshift_buffer_synced(ts, s->pts, pts);
+    }
+}
+
+/*
+ * Move the readers of the oldest segment to the next one, one paused
+ * client must not stop the writing for the others (must hold tsb->lock)
+ */
+int
+timeshift_buffer_release ( timeshift_buffer_t *tsb, timeshift_file_t *tsf )
+{
+  timeshift_file_t *next = TAILQ_NEXT(tsf, link);
+  timeshift_index_iframe_t *fi;
+  timeshift_t *ts;
+
+  if (tsb->refcount < 2 || next == NULL)
+    return 0;
+  fi = timeshift_file_iframe(next, 0);
+  LIST_FOREACH(ts, &tsb->instances, tsb_link) {
+    if (ts->seek.file != tsf)
+      continue;
+    timeshift_file_put(tsf);
+    ts->seek.file  = timeshift_file_get(next);
+    ts->seek.frame = fi;
+    ts->seek.roff  = fi ? fi->pos : 0;
+    ts->seek.moved = 1;
+    tvhdebug(LS_TIMESHIFT, "ts %d buffer %d full, reader moved forward",
+             ts->id, tsb->id);
+  }
+  return tsf->refcount == 0;
+}
+
+/*
+ * Start buffering (must hold tsb->lock)
+ */
+void
+timeshift_buffer_dobuf ( timeshift_t *ts )
+{
+  ts->dobuf = 1;
+  ts->tsb->dobuf = 1;
+}
+
+/*
+ * Number of instances which use the stored data (must hold tsb->lock)
+ */
+int
+timeshift_buffer_sharers ( timeshift_buffer_t *tsb )
+{
+  timeshift_t *ts;
+  int r = 0;
+
+  LIST_FOREACH(ts, &tsb->instances, tsb_link)
+    if (ts->synced && ts->dobuf)
+      r++;
+  return r;
+}
@@ -17,6 +17,7 @@
  */
 
 #include <fcntl.h>
+#include <sys/mman.h>
 
 #include "tvheadend.h"
 #include "streaming.h"
@@ -34,6 +35,7 @@ static tvh_cond_t            timeshift_reaper_cond;
 
 uint64_t                     timeshift_total_size;
 uint64_t                     timeshift_total_ram_size;
+uint64_t                     timeshift_total_saved_size;
 
 /* **************************************************************************
  * File reaper thread
@@ -43,7 +45,6 @@ static void* timeshift_reaper_callback ( void *p )
 {
   char *dpath;
   timeshift_file_t *tsf;
-  timeshift_index_iframe_t *ti;
   timeshift_index_data_t *tid;
   streaming_message_t *sm;
   tvh_mutex_lock(&timeshift_reaper_lock);
@@ -73,11 +74,6 @@ static void* timeshift_reaper_callback ( void *p )
     }
 
     /* Free memory */
-    while ((ti = TAILQ_FIRST(&tsf->iframes))) {
-      TAILQ_REMOVE(&tsf->iframes, ti, link);
-      memoryinfo_free(&timeshift_memoryinfo, sizeof(*ti));
-      free(ti);
-    }
     while ((tid = TAILQ_FIRST(&tsf->sstart))) {
       TAILQ_REMOVE(&tsf->sstart, tid, link);
       sm = tid->data;
@@ -86,8 +82,10 @@ static void* timeshift_reaper_callback ( void *p )
       free(tid);
     }
     free(tsf->path);
-    memoryinfo_free(&timeshift_memoryinfo_ram, tsf->ram_size);
-    free(tsf->ram);
+    if (tsf->ram)
+      memoryinfo_free(&timeshift_memoryinfo_ram, tsf->ram_size);
+    if (tsf->data)
+      munmap(tsf->data, tsf->data_size);
     memoryinfo_free(&timeshift_memoryinfo, sizeof(*tsf));
     free(tsf);
 
@@ -112,22 +110,135 @@ static void timeshift_reaper_remove ( timeshift_file_t *tsf )
   tvh_mutex_unlock(&timeshift_reaper_lock);
 }
 
+/* **************************************************************************
+ * Buffer index
+ * *************************************************************************/
+
+/*
+ * Append the frame (the times and offsets are increasing)
+ */
+void timeshift_index_add
+  ( timeshift_buffer_t *tsb, timeshift_file_t *tsf, int idx )
+{
+  timeshift_index_t *ti = &tsb->index;
+  timeshift_index_entry_t *e;
+  timeshift_index_iframe_t *fi = timeshift_file_iframe(tsf, idx);
+  int alloc;
+
+  if (ti->count == ti->alloc) {
+    /* reuse the trimmed entries */
+    if (ti->first > 0) {
+      memmove(ti->entries, ti->entries + ti->first,
+              (ti->count - ti->first) * sizeof(*e));
+      ti->count -= ti->first;
+      ti->first = 0;
+    }
+    if (ti->count >= ti->alloc / 2) {
+      alloc = MAX(256, ti->alloc * 2);
+      ti->entries = realloc(ti->entries, alloc * sizeof(*e));
+      memoryinfo_append(&timeshift_memoryinfo, (alloc - ti->alloc) * sizeof(*e));
+      ti->alloc = alloc;
+    }
+  }
+  e = &ti->entries[ti->count++];
+  e->time = fi->time;
+  e->boff = tsf->boff + fi->pos;
+  e->file = tsf;
+  e->idx  = idx;
+}
+
+/*
+ * Remove the entries for the removed file
+ */
+void timeshift_index_remove
+  ( timeshift_buffer_t *tsb, timeshift_file_t *tsf )
+{
+  timeshift_index_t *ti = &tsb->index;
+  int i, j;
+
+  /* the oldest file (the usual case) */
+  while (ti->first < ti->count && ti->entries[ti->first].file == tsf)
+    ti->first++;
+  if (ti->first == ti->count) {
+    ti->first = ti->count = 0;
+    return;
+  }
+  for (i = j = ti->first; i < ti->count; i++)
+    if (ti->entries[i].file != tsf)
+      ti->entries[j++] = ti->entries[i];
+  ti->count = j;
+}
+
+void timeshift_index_free ( timeshift_buffer_t *tsb )
+{
+  timeshift_index_t *ti = &tsb->index;
+
+  if (ti->alloc)
+    memoryinfo_remove(&timeshift_memoryinfo, ti->alloc * sizeof(*ti->entries));
+  free(ti->entries);
+  memset(ti, 0, sizeof(*ti));
+}
+
+/*
+ * Binary search by time
+ *   back    - the last frame with time <= time
+ *   forward - the first frame with time >= time
+ */
+timeshift_index_entry_t *timeshift_index_find_time
+  ( timeshift_buffer_t *tsb, int64_t time, int back )
+{
+  timeshift_index_t *ti = &tsb->index;
+  int lo = ti->first, hi = ti->count, mid;
+  int64_t t;
+
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    t = ti->entries[mid].time;
+    if (back ? t <= time : t < time)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (back)
+    return lo > ti->first ? &ti->entries[lo - 1] : NULL;
+  return lo < ti->count ? &ti->entries[lo] : NULL;
+}
+
+/*
+ * Binary search by buffer offset (the last frame at or before boff)
+ */
+timeshift_index_entry_t *timeshift_index_find_boff
+  ( timeshift_buffer_t *tsb, int64_t boff )
+{
+  timeshift_index_t *ti = &tsb->index;
+  int lo = ti->first, hi = ti->count, mid;
+
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    if (ti->entries[mid].boff <= boff)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo > ti->first ? &ti->entries[lo - 1] : NULL;
+}
+
 /* **************************************************************************
  * File Handling
  * *************************************************************************/
 
 void
-timeshift_filemgr_dump0 ( timeshift_t *ts )
+timeshift_filemgr_dump0 ( timeshift_buffer_t *tsb )
 {
   timeshift_file_t *tsf;
 
-  if (TAILQ_EMPTY(&ts->files)) {
-    tvhtrace(LS_TIMESHIFT, "ts %d file dump - EMPTY", ts->id);
+  if (TAILQ_EMPTY(&tsb->files)) {
+    tvhtrace(LS_TIMESHIFT, "ts %d file dump - EMPTY", tsb->id);
     return;
   }
-  TAILQ_FOREACH(tsf, &ts->files, link) {
+  TAILQ_FOREACH(tsf, &tsb->files, link) {
     tvhtrace(LS_TIMESHIFT, "ts %d (full=%d) file dump tsf %p time %4"PRId64" last %10"PRId64" bad %d refcnt %d",
-             ts->id, ts->full, tsf, tsf->time, tsf->last, tsf->bad, tsf->refcount);
+             tsb->id, tsb->full, tsf, tsf->time, tsf->last, tsf->bad, tsf->refcount);
   }
 }
 
@@ -159,26 +270,36 @@ int timeshift_filemgr_makedirs ( int index, char *buf, size_t len )
   return makedirs(LS_TIMESHIFT, buf, 0700, 0, -1, -1);
 }
 
+/*
+ * Map the segment (anonymous memory for RAM segments)
+ */
+static uint8_t *timeshift_filemgr_map ( int fd, size_t size )
+{
+  void *p;
+
+  if (fd < 0)
+    p = mmap(NULL, size, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  else
+    p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  return p == MAP_FAILED ? NULL : p;
+}
+
 /*
  * Close file
  */
 void timeshift_filemgr_close ( timeshift_file_t *tsf )
 {
-  uint8_t *ram;
-  ssize_t r = timeshift_write_eof(tsf);
-  if (r > 0) {
-    tsf->size += r;
-    atomic_add_u64(&timeshift_total_size, r);
-    if (tsf->ram)
-      atomic_add_u64(&timeshift_total_ram_size, r);
-  }
-  if (tsf->ram) {
-    /* maintain unused memory block */
-    ram = realloc(tsf->ram, tsf->woff);
-    if (ram) {
-      memoryinfo_append(&timeshift_memoryinfo_ram, tsf->ram_size - tsf->woff);
-      tsf->ram = ram;
-      tsf->ram_size = tsf->woff;
+  size_t pg, start, end;
+
+  if (tsf->ram && tsf->data) {
+    /* release the unused part of the RAM segment */
+    pg    = sysconf(_SC_PAGESIZE);
+    start = (tsf->woff + pg - 1) & ~(pg - 1);
+    end   = (tsf->data_size - tsf->iframes * sizeof(timeshift_index_iframe_t)) & ~(pg - 1);
+    if (end > start && madvise(tsf->data + start, end - start, MADV_DONTNEED) == 0) {
+      memoryinfo_remove(&timeshift_memoryinfo_ram, end - start);
+      tsf->ram_size -= end - start;
     }
   }
   if (tsf->wfd >= 0)
@@ -190,25 +311,26 @@ void timeshift_filemgr_close ( timeshift_file_t *tsf )
  * Remove file
  */
 void timeshift_filemgr_remove
-  ( timeshift_t *ts, timeshift_file_t *tsf, int force )
+  ( timeshift_buffer_t *tsb, timeshift_file_t *tsf, int force )
 {
   if (tsf->wfd >= 0)
     close(tsf->wfd);
-  assert(tsf->rfd < 0);
+  tsf->wfd = -1;
   if (tvhtrace_enabled()) {
     if (tsf->path)
-      tvhdebug(LS_TIMESHIFT, "ts %d remove %s (size %"PRId64")", ts->id, tsf->path, (int64_t)tsf->size);
+      tvhdebug(LS_TIMESHIFT, "ts %d remove %s (size %"PRId64")", tsb->id, tsf->path, (int64_t)tsf->size);
     else
       tvhdebug(LS_TIMESHIFT, "ts %d RAM segment remove time %"PRId64" (size %"PRId64", alloc size %"PRId64")",
-               ts->id, tsf->time, (int64_t)tsf->size, (int64_t)tsf->ram_size);
+               tsb->id, tsf->time, (int64_t)tsf->size, (int64_t)tsf->data_size);
   }
-  TAILQ_REMOVE(&ts->files, tsf, link);
+  TAILQ_REMOVE(&tsb->files, tsf, link);
+  timeshift_index_remove(tsb, tsf);
   if (tsf->path) {
-    assert(ts->file_segments > 0);
-    ts->file_segments--;
+    assert(tsb->file_segments > 0);
+    tsb->file_segments--;
   } else {
-    assert(ts->ram_segments > 0);
-    ts->ram_segments--;
+    assert(tsb->ram_segments > 0);
+    tsb->ram_segments--;
   }
   atomic_dec_u64(&timeshift_total_size, tsf->size);
   if (tsf->ram)
@@ -219,12 +341,24 @@ void timeshift_filemgr_remove
 /*
  * Flush all files
  */
-void timeshift_filemgr_flush ( timeshift_t *ts, timeshift_file_t *end )
+void timeshift_filemgr_flush ( timeshift_buffer_t *tsb, timeshift_file_t *end )
 {
   timeshift_file_t *tsf;
-  while ((tsf = TAILQ_FIRST(&ts->files))) {
+  while ((tsf = TAILQ_FIRST(&tsb->files))) {
     if (tsf == end) break;
-    timeshift_filemgr_remove(ts, tsf, 1);
+    timeshift_filemgr_remove(tsb, tsf, 1);
+  }
+}
+
+/*
+ * Remove the old files which are not used by any reader
+ */
+void timeshift_filemgr_trim ( timeshift_buffer_t *tsb )
+{
+  timeshift_file_t *tsf;
+  while ((tsf = TAILQ_FIRST(&tsb->files))) {
+    if (tsf->refcount || !TAILQ_NEXT(tsf, link)) break;
+    timeshift_filemgr_remove(tsb, tsf, 0);
   }
 }
 
@@ -232,27 +366,27 @@ void timeshift_filemgr_flush ( timeshift_t *ts, timeshift_file_t *end )
  *
  */
 static timeshift_file_t * timeshift_filemgr_file_init
-  ( timeshift_t *ts, int64_t start_time )
+  ( timeshift_buffer_t *tsb, int64_t start_time, uint8_t *data, size_t size )
 {
   timeshift_file_t *tsf;
 
   tsf = calloc(1, sizeof(timeshift_file_t));
   memoryinfo_alloc(&timeshift_memoryinfo, sizeof(*tsf));
-  tsf->time     = mono2sec(start_time) / TIMESHIFT_FILE_PERIOD;
-  tsf->last     = start_time;
-  tsf->wfd      = -1;
-  tsf->rfd      = -1;
-  TAILQ_INIT(&tsf->iframes);
+  tsf->time      = mono2sec(start_time) / TIMESHIFT_FILE_PERIOD;
+  tsf->boff      = tsb->boff;
+  tsf->last      = start_time;
+  tsf->wfd       = -1;
+  tsf->data      = data;
+  tsf->data_size = size;
   TAILQ_INIT(&tsf->sstart);
-  TAILQ_INSERT_TAIL(&ts->files, tsf, link);
-  tvh_mutex_init(&tsf->ram_lock, NULL);
+  TAILQ_INSERT_TAIL(&tsb->files, tsf, link);
   return tsf;
 }
 
 /*
  * Get current / new file
  */
-timeshift_file_t *timeshift_filemgr_get ( timeshift_t *ts, int64_t start_time )
+timeshift_file_t *timeshift_filemgr_get ( timeshift_buffer_t *tsb, int64_t start_time )
 {
   int fd;
   timeshift_file_t *tsf_tl, *tsf_hd, *tsf_tmp;
@@ -260,21 +394,23 @@ timeshift_file_t *timeshift_filemgr_get ( timeshift_t *ts, int64_t start_time )
   streaming_message_t *sm;
   char path[PATH_MAX];
   int64_t time;
+  uint8_t *data;
+  size_t size;
 
   /* Return last file */
   if (start_time < 0)
-    return timeshift_filemgr_newest(ts);
+    return timeshift_filemgr_newest(tsb);
 
   /* No space */
-  if (ts->full)
+  if (tsb->full)
     return NULL;
 
   /* Store to file */
-  tsf_tl = TAILQ_LAST(&ts->files, timeshift_file_list);
+  tsf_tl = TAILQ_LAST(&tsb->files, timeshift_file_list);
   time = mono2sec(start_time) / TIMESHIFT_FILE_PERIOD;
   if (!tsf_tl || tsf_tl->time < time ||
-      (tsf_tl->ram && tsf_tl->woff >= timeshift_conf.ram_segment_size)) {
-    tsf_hd = TAILQ_FIRST(&ts->files);
+      timeshift_file_free(tsf_tl) < TIMESHIFT_RECORD_MAX) {
+    tsf_hd = TAILQ_FIRST(&tsb->files);
 
     /* Close existing */
     if (tsf_tl)
@@ -282,15 +418,15 @@ timeshift_file_t *timeshift_filemgr_get ( timeshift_t *ts, int64_t start_time )
 
     /* Check period */
     if (!timeshift_conf.unlimited_period &&
-        ts->max_time && tsf_hd && tsf_tl) {
+        tsb->max_time && tsf_hd && tsf_tl) {
       time_t d = (tsf_tl->time - tsf_hd->time) * TIMESHIFT_FILE_PERIOD;
-      if (d > (ts->max_time+5)) {
-        if (!tsf_hd->refcount) {
-          timeshift_filemgr_remove(ts, tsf_hd, 0);
+      if (d > (tsb->max_time+5)) {
+        if (!tsf_hd->refcount || timeshift_buffer_release(tsb, tsf_hd)) {
+          timeshift_filemgr_remove(tsb, tsf_hd, 0);
           tsf_hd = NULL;
         } else {
-          tvhdebug(LS_TIMESHIFT, "ts %d buffer full", ts->id);
-          ts->full = 1;
+          tvhdebug(LS_TIMESHIFT, "ts %d buffer full", tsb->id);
+          tsb->full = 1;
         }
       }
     }
@@ -300,46 +436,46 @@ timeshift_file_t *timeshift_filemgr_get ( timeshift_t *ts, int64_t start_time )
         atomic_pre_add_u64(&timeshift_conf.total_size, 0) >= timeshift_conf.max_size) {
 
       /* Remove the last file (if we can) */
-      if (tsf_hd && !tsf_hd->refcount) {
-        timeshift_filemgr_remove(ts, tsf_hd, 0);
+      if (tsf_hd && (!tsf_hd->refcount || timeshift_buffer_release(tsb, tsf_hd))) {
+        timeshift_filemgr_remove(tsb, tsf_hd, 0);
 
       /* Full */
       } else {
-        tvhdebug(LS_TIMESHIFT, "ts %d buffer full", ts->id);
-        ts->full = 1;
+        tvhdebug(LS_TIMESHIFT, "ts %d buffer full", tsb->id);
+        tsb->full = 1;
       }
     }
 
     /* Create new file */
     tsf_tmp = NULL;
-    if (!ts->full) {
+    if (!tsb->full) {
 
       tvhtrace(LS_TIMESHIFT, "ts %d RAM total %"PRId64" requested %"PRId64" segment %"PRId64,
-                   ts->id, atomic_pre_add_u64(&timeshift_total_ram_size, 0),
+                   tsb->id, atomic_pre_add_u64(&timeshift_total_ram_size, 0),
                    timeshift_conf.ram_size, timeshift_conf.ram_segment_size);
       while (1) {
         if (timeshift_conf.ram_size >= 8*1024*1024 &&
             atomic_pre_add_u64(&timeshift_total_ram_size, 0) <
               timeshift_conf.ram_size + (timeshift_conf.ram_segment_size / 2)) {
-          tsf_tmp = timeshift_filemgr_file_init(ts, start_time);
-          tsf_tmp->ram_size = MIN(16*1024*1024, timeshift_conf.ram_segment_size);
-          tsf_tmp->ram = malloc(tsf_tmp->ram_size);
-          if (!tsf_tmp->ram) {
-            free(tsf_tmp);
-            tsf_tmp = NULL;
-          } else {
-            tvhtrace(LS_TIMESHIFT, "ts %d create RAM segment with %"PRId64" bytes (time %"PRId64")",
-                     ts->id, tsf_tmp->ram_size, start_time);
-            ts->ram_segments++;
-            memoryinfo_alloc(&timeshift_memoryinfo_ram, tsf_tmp->ram_size);
+          size = MAX(timeshift_conf.ram_segment_size, 4 * TIMESHIFT_RECORD_MAX);
+          size = (size + 65535) & ~(size_t)65535;
+          if ((data = timeshift_filemgr_map(-1, size)) != NULL) {
+            tsf_tmp = timeshift_filemgr_file_init(tsb, start_time, data, size);
+            tsf_tmp->ram      = 1;
+            tsf_tmp->ram_size = size;
+            tsf_tmp->rsv_lo   = size;
+            tvhtrace(LS_TIMESHIFT, "ts %d create RAM segment with %zd bytes (time %"PRId64")",
+                     tsb->id, size, start_time);
+            tsb->ram_segments++;
+            memoryinfo_alloc(&timeshift_memoryinfo_ram, size);
           }
           break;
         } else {
-          tsf_hd = TAILQ_FIRST(&ts->files);
+          tsf_hd = TAILQ_FIRST(&tsb->files);
           if (timeshift_conf.ram_fit && tsf_hd && !tsf_hd->refcount &&
-              tsf_hd->ram && ts->file_segments == 0) {
-            tvhtrace(LS_TIMESHIFT, "ts %d remove RAM segment %"PRId64" (fit)", ts->id, tsf_hd->time);
-            timeshift_filemgr_remove(ts, tsf_hd, 0);
+              tsf_hd->ram && tsb->file_segments == 0) {
+            tvhtrace(LS_TIMESHIFT, "ts %d remove RAM segment %"PRId64" (fit)", tsb->id, tsf_hd->time);
+            timeshift_filemgr_remove(tsb, tsf_hd, 0);
           } else {
             break;
           }
@@ -348,43 +484,52 @@ timeshift_file_t *timeshift_filemgr_get ( timeshift_t *ts, int64_t start_time )
       
       if (!tsf_tmp && !timeshift_conf.ram_only) {
         /* Create directories */
-        if (!ts->path) {
-          if (timeshift_filemgr_makedirs(ts->id, path, sizeof(path)))
+        if (!tsb->path) {
+          if (timeshift_filemgr_makedirs(tsb->id, path, sizeof(path)))
             return NULL;
-          ts->path = strdup(path);
+          tsb->path = strdup(path);
         }
 
         /* Create File */
-        snprintf(path, sizeof(path), "%s/tvh-%"PRId64, ts->path, start_time);
-        tvhtrace(LS_TIMESHIFT, "ts %d create file %s", ts->id, path);
-        if ((fd = tvh_open(path, O_WRONLY | O_CREAT, 0600)) > 0) {
-          tsf_tmp = timeshift_filemgr_file_init(ts, start_time);
-          tsf_tmp->wfd = fd;
-          tsf_tmp->path = strdup(path);
-          ts->file_segments++;
+        snprintf(path, sizeof(path), "%s/tvh-%"PRId64, tsb->path, start_time);
+        tvhtrace(LS_TIMESHIFT, "ts %d create file %s", tsb->id, path);
+        if ((fd = tvh_open(path, O_RDWR | O_CREAT, 0600)) >= 0) {
+          size = TIMESHIFT_SEGMENT_SIZE;
+          if (ftruncate(fd, size) || (data = timeshift_filemgr_map(fd, size)) == NULL) {
+            tvherror(LS_TIMESHIFT, "ts %d unable to map file %s [e=%s]",
+                     tsb->id, path, strerror(errno));
+            close(fd);
+            unlink(path);
+          } else {
+            tsf_tmp = timeshift_filemgr_file_init(tsb, start_time, data, size);
+            tsf_tmp->wfd = fd;
+            tsf_tmp->path = strdup(path);
+            tsf_tmp->rsv_hi = size;
+            tsb->file_segments++;
+          }
         }
       }
 
       if (tsf_tmp && tsf_tl) {
         /* Copy across last start message */
-        if ((ti = TAILQ_LAST(&tsf_tl->sstart, timeshift_index_data_list)) || ts->smt_start) {
+        if ((ti = TAILQ_LAST(&tsf_tl->sstart, timeshift_index_data_list)) || tsb->smt_start) {
           tvhtrace(LS_TIMESHIFT, "ts %d copy smt_start to new file%s",
-                   ts->id, ti ? " (from last file)" : "");
+                   tsb->id, ti ? " (from last file)" : "");
           timeshift_index_data_t *ti2 = calloc(1, sizeof(timeshift_index_data_t));
           if (ti) {
             memoryinfo_alloc(&timeshift_memoryinfo, sizeof(timeshift_index_data_t));
             sm = streaming_msg_clone(ti->data);
           } else {
             sm = streaming_msg_create(SMT_START);
-            streaming_start_ref(ts->smt_start);
-            sm->sm_data = ts->smt_start;
+            streaming_start_ref(tsb->smt_start);
+            sm->sm_data = tsb->smt_start;
           }
           ti2->data = sm;
           TAILQ_INSERT_TAIL(&tsf_tmp->sstart, ti2, link);
         }
       }
     }
-    timeshift_filemgr_dump(ts);
+    timeshift_filemgr_dump(tsb);
     tsf_tl = tsf_tmp;
   }
 
@@ -414,18 +559,18 @@ timeshift_file_t *timeshift_filemgr_prev
 /*
  * Get the oldest file
  */
-timeshift_file_t *timeshift_filemgr_oldest ( timeshift_t *ts )
+timeshift_file_t *timeshift_filemgr_oldest ( timeshift_buffer_t *tsb )
 {
-  timeshift_file_t *tsf = TAILQ_FIRST(&ts->files);
+  timeshift_file_t *tsf = TAILQ_FIRST(&tsb->files);
   return timeshift_file_get(tsf);
 }
 
 /*
  * Get the newest file
  */
-timeshift_file_t *timeshift_filemgr_newest ( timeshift_t *ts )
+timeshift_file_t *timeshift_filemgr_newest ( timeshift_buffer_t *tsb )
 {
-  timeshift_file_t *tsf = TAILQ_LAST(&ts->files, timeshift_file_list);
+  timeshift_file_t *tsf = TAILQ_LAST(&tsb->files, timeshift_file_list);
   return timeshift_file_get(tsf);
 }
 
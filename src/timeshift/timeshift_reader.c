@@ -55,17 +55,12 @@ static timeshift_seek_t *_seek_set_file
 {
   seek->file  = tsf;
   seek->frame = NULL;
-  if (tsf)
-    tsf->roff = roff;
+  seek->roff  = roff;
   return seek;
 }
 
 static timeshift_seek_t *_read_close ( timeshift_seek_t *seek )
 {
-  if (seek->file && seek->file->rfd >= 0) {
-    close(seek->file->rfd);
-    seek->file->rfd = -1;
-  }
   return _seek_reset(seek);
 }
 
@@ -73,75 +68,34 @@ static timeshift_seek_t *_read_close ( timeshift_seek_t *seek )
  * File Reading
  * *************************************************************************/
 
-static ssize_t _read_buf ( timeshift_file_t *tsf, int fd, void *buf, size_t size )
+static ssize_t _read_buf ( int fd, void *buf, size_t size )
 {
   ssize_t r;
-  size_t ret;
-
-  if (tsf && tsf->ram) {
-    if (tsf->roff == tsf->woff) return 0;
-    if (tsf->roff + size > tsf->woff) return -1;
-    tvh_mutex_lock(&tsf->ram_lock);
-    memcpy(buf, tsf->ram + tsf->roff, size);
-    tsf->roff += size;
-    tvh_mutex_unlock(&tsf->ram_lock);
-    return size;
-  } else {
-    ret = 0;
-    while (size > 0) {
-      r = read(tsf ? tsf->rfd : fd, buf, size);
-      if (r < 0) {
-        if (ERRNO_AGAIN(errno))
-          continue;
-        tvhtrace(LS_TIMESHIFT, "read errno %d", errno);
-        return -1;
-      }
-      if (r > 0) {
-        size -= r;
-        ret += r;
-        buf += r;
-      }
-      if (r == 0)
-        return 0;
-    }
-    if (ret > 0 && tsf)
-      tsf->roff += ret;
-    return ret;
-  }
-}
+  size_t ret = 0;
 
-static ssize_t _read_pktbuf ( timeshift_file_t *tsf, int fd, pktbuf_t **pktbuf )
-{
-  ssize_t r, cnt = 0;
-  size_t sz;
-
-  /* Size */
-  r = _read_buf(tsf, fd, &sz, sizeof(sz));
-  if (r < 0) return -1;
-  if (r != sizeof(sz)) return 0;
-  cnt += r;
-
-  /* Empty And Sanity Check */
-  if (!sz || sz > 1024 * 1024) {
-    *pktbuf = NULL;
-    return cnt;
-  }
-
-  /* Data */
-  *pktbuf = pktbuf_alloc(NULL, sz);
-  r = _read_buf(tsf, fd, pktbuf_ptr(*pktbuf), sz);
-  if (r != sz) {
-    pktbuf_destroy(*pktbuf);
-    *pktbuf = NULL;
-    return r < 0 ? -1 : 0;
+  while (size > 0) {
+    r = read(fd, buf, size);
+    if (r < 0) {
+      if (ERRNO_AGAIN(errno))
+        continue;
+      tvhtrace(LS_TIMESHIFT, "read errno %d", errno);
+      return -1;
+    }
+    if (r > 0) {
+      size -= r;
+      ret += r;
+      buf += r;
+    }
+    if (r == 0)
+      return 0;
   }
-  cnt += r;
-
-  return cnt;
+  return ret;
 }
 
-
-static ssize_t _read_msg ( timeshift_file_t *tsf, int fd, streaming_message_t **sm )
+/*
+ * Read control message (from pipe)
+ */
+static ssize_t _read_msg ( int fd, streaming_message_t **sm )
 {
   ssize_t r, cnt = 0;
   size_t sz;
@@ -154,7 +108,7 @@ static ssize_t _read_msg ( timeshift_file_t *tsf, int fd, streaming_message_t **
   *sm = NULL;
 
   /* Size */
-  r = _read_buf(tsf, fd, &sz, sizeof(sz));
+  r = _read_buf(fd, &sz, sizeof(sz));
   if (r < 0) return -1;
   if (r != sizeof(sz)) return 0;
   cnt += r;
@@ -169,13 +123,13 @@ static ssize_t _read_msg ( timeshift_file_t *tsf, int fd, streaming_message_t **
   }
 
   /* Type */
-  r = _read_buf(tsf, fd, &type, sizeof(type));
+  r = _read_buf(fd, &type, sizeof(type));
   if (r < 0) return -1;
   if (r != sizeof(type)) return 0;
   cnt += r;
 
   /* Time */
-  r = _read_buf(tsf, fd, &time, sizeof(time));
+  r = _read_buf(fd, &time, sizeof(time));
   if (r < 0) return -1;
   if (r != sizeof(time)) return 0;
   cnt += r;
@@ -187,21 +141,12 @@ static ssize_t _read_msg ( timeshift_file_t *tsf, int fd, streaming_message_t **
   /* Standard messages */
   switch (type) {
 
-    /* Unhandled */
-    case SMT_START:
-    case SMT_NOSTART:
-    case SMT_NOSTART_WARN:
-    case SMT_SERVICE_STATUS:
-    case SMT_DESCRAMBLE_INFO:
-      return -1;
-      break;
-
     /* Code */
     case SMT_STOP:
     case SMT_EXIT:
     case SMT_SPEED:
       if (sz != sizeof(code)) return -1;
-      r = _read_buf(tsf, fd, &code, sz);
+      r = _read_buf(fd, &code, sz);
       if (r != sz) {
         if (r < 0) return -1;
         return 0;
@@ -211,36 +156,14 @@ static ssize_t _read_msg ( timeshift_file_t *tsf, int fd, streaming_message_t **
 
     /* Data */
     case SMT_SKIP:
-    case SMT_SIGNAL_STATUS:
-    case SMT_MPEGTS:
-    case SMT_PACKET:
       data = malloc(sz);
-      r = _read_buf(tsf, fd, data, sz);
+      r = _read_buf(fd, data, sz);
       if (r != sz) {
         free(data);
         if (r < 0) return -1;
         return 0;
       }
-      if (type == SMT_PACKET) {
-        th_pkt_t *pkt = data;
-        pkt->pkt_payload  = pkt->pkt_meta = NULL;
-        pkt->pkt_refcount = 0;
-        *sm = streaming_msg_create_pkt(pkt);
-        r   = _read_pktbuf(tsf, fd, &pkt->pkt_meta);
-        if (r < 0) {
-          streaming_msg_free(*sm);
-          return r;
-        }
-        cnt += r;
-        r   = _read_pktbuf(tsf, fd, &pkt->pkt_payload);
-        if (r < 0) {
-          streaming_msg_free(*sm);
-          return r;
-        }
-        cnt += r;
-      } else {
-        *sm = streaming_msg_create_data(type, data);
-      }
+      *sm = streaming_msg_create_data(type, data);
       (*sm)->sm_time = time;
       break;
 
@@ -252,6 +175,72 @@ static ssize_t _read_msg ( timeshift_file_t *tsf, int fd, streaming_message_t **
   return cnt;
 }
 
+/*
+ * Read message from the segment
+ */
+static ssize_t _read_record ( timeshift_seek_t *seek, streaming_message_t **sm )
+{
+  timeshift_file_t *tsf = seek->file;
+  timeshift_record_t *rec;
+  timeshift_record_pkt_t *rp;
+  th_pkt_t *pkt;
+  uint8_t *p;
+  size_t len;
+  void *data;
+
+  /* Clear */
+  *sm = NULL;
+
+  /* EOF */
+  if (seek->roff >= tsf->woff)
+    return 0;
+
+  rec = (timeshift_record_t *)(tsf->data + seek->roff);
+  if (rec->len < sizeof(*rec) || seek->roff + rec->len > tsf->woff) {
+    tvhtrace(LS_TIMESHIFT, "wrong record size (%u) at %jd",
+             rec->len, (intmax_t)seek->roff);
+    return -1;
+  }
+  len = rec->len - sizeof(*rec);
+
+  switch (rec->type) {
+
+    case SMT_PACKET:
+      rp = (timeshift_record_pkt_t *)(rec + 1);
+      if (len < sizeof(*rp) + rp->meta_len + rp->payload_len)
+        return -1;
+      p = (uint8_t *)(rp + 1);
+      pkt = pkt_alloc(rp->type, p + rp->meta_len, rp->payload_len,
+                      rp->pts, rp->dts, rp->pcr);
+      if (pkt == NULL)
+        return -1;
+      pkt->pkt_duration       = rp->duration;
+      pkt->pkt_err            = rp->err;
+      pkt->pkt_componentindex = rp->componentindex;
+      pkt->pkt_commercial     = rp->commercial;
+      memcpy(&pkt->v, rp->av, sizeof(pkt->v));
+      if (rp->meta_len)
+        pkt->pkt_meta = pktbuf_alloc(p, rp->meta_len);
+      *sm = streaming_msg_create_pkt(pkt);
+      pkt_ref_dec(pkt);
+      break;
+
+    case SMT_SIGNAL_STATUS:
+    case SMT_MPEGTS:
+      data = malloc(len);
+      memcpy(data, rec + 1, len);
+      *sm = streaming_msg_create_data(rec->type, data);
+      break;
+
+    default:
+      return -1;
+  }
+
+  (*sm)->sm_time = rec->time;
+  seek->roff += rec->len;
+  return rec->len;
+}
+
 /* **************************************************************************
  * Utilities
  * *************************************************************************/
@@ -259,107 +248,82 @@ static ssize_t _read_msg ( timeshift_file_t *tsf, int fd, streaming_message_t **
 static int64_t _timeshift_first_time
   ( timeshift_t *ts, int *active )
 { 
-  int64_t ret = 0;
-  int end;
-  timeshift_index_iframe_t *tsi = NULL;
-  timeshift_file_t *tsf = timeshift_filemgr_oldest(ts);
-  while (tsf && !tsi) {
-    if (!(tsi = TAILQ_FIRST(&tsf->iframes)))
-      tsf = timeshift_filemgr_next(tsf, &end, 0);
-  }
-  if (tsi) {
-    *active = 1;
-    ret = tsi->time;
-  }
-  timeshift_file_put(tsf);
-  return ret;
+  timeshift_index_entry_t *e = timeshift_index_first(ts->tsb);
+
+  if (e == NULL)
+    return 0;
+  *active = 1;
+  return e->time + ts->delta;
 }
 
 static int _timeshift_skip
   ( timeshift_t *ts, int64_t req_time, int64_t cur_time,
     timeshift_seek_t *seek, timeshift_seek_t *nseek )
 {
-  timeshift_index_iframe_t *tsi  = seek->frame;
-  timeshift_file_t         *tsf  = seek->file, *tsf_last;
-  int64_t                   sec  = mono2sec(req_time) / TIMESHIFT_FILE_PERIOD;
+  timeshift_buffer_t       *tsb  = ts->tsb;
+  timeshift_index_entry_t  *e;
+  timeshift_file_t         *tsf;
   int                       back = (req_time < cur_time) ? 1 : 0;
   int                       end  = 0;
 
-  /* Coarse search */
-  if (!tsi) {
-    while (tsf && !end) {
-      if (back) {
-        if ((tsf->time <= sec) &&
-            (tsi = TAILQ_LAST(&tsf->iframes, timeshift_index_iframe_list)))
-          break;
-        tsf = timeshift_filemgr_prev(tsf, &end, 1);
-      } else {
-        if ((tsf->time >= sec) &&
-            (tsi = TAILQ_FIRST(&tsf->iframes)))
-          break;
-        tsf = timeshift_filemgr_next(tsf, &end, 0);
-      }
-      tsi = NULL;
-    }
-  }
+  /* Find (binary search in the buffer index) */
+  e = timeshift_index_find_time(tsb, req_time, back);
 
-  /* Fine search */
-  if (back) {
-    while (!end && tsf && tsi && (tsi->time > req_time)) {
-      tsi = TAILQ_PREV(tsi, timeshift_index_iframe_list, link);
-      while (!end && tsf && !tsi) {
-        if ((tsf = timeshift_filemgr_prev(tsf, &end, 1)))
-          tsi = TAILQ_LAST(&tsf->iframes, timeshift_index_iframe_list);
-      }
-    }
-  } else {
-    while (!end && tsf && tsi && (tsi->time < req_time)) {
-      tsi = TAILQ_NEXT(tsi, link);
-      while (!end && tsf && !tsi) {
-        if ((tsf = timeshift_filemgr_next(tsf, &end, 0)))
-          tsi = TAILQ_FIRST(&tsf->iframes);
-      }
-    }
-  }
-
-  /* End */
-  if (!tsf || !tsi)
-    end = 1;
-
-  /* Find start/end of buffer */
-  if (end) {
-    timeshift_file_put(tsf);
+  /* Start/end of buffer */
+  if (e == NULL) {
     if (back) {
-      tsf = tsf_last = timeshift_filemgr_oldest(ts);
-      tsi = NULL;
-      while (tsf && !tsi) {
-        tsf_last = tsf;
-        if (!(tsi = TAILQ_FIRST(&tsf->iframes)))
-          tsf = timeshift_filemgr_next(tsf, &end, 0);
-      }
-      if (!tsf)
-        tsf = tsf_last;
+      e = timeshift_index_first(tsb);
       end = -1;
     } else {
-      tsf = tsf_last = timeshift_filemgr_newest(ts);
-      tsi = NULL;
-      while (tsf && !tsi) {
-        tsf_last = tsf;
-        if (!(tsi = TAILQ_LAST(&tsf->iframes, timeshift_index_iframe_list)))
-          tsf = timeshift_filemgr_prev(tsf, &end, 0);
-      }
-      if (!tsf)
-        tsf = tsf_last;
+      e = timeshift_index_last(tsb);
       end = 1;
     }
   }
 
   /* Done */
-  nseek->file  = tsf;
-  nseek->frame = tsi;
+  timeshift_file_put(seek->file);
+  if (e) {
+    nseek->file  = timeshift_file_get(e->file);
+    nseek->frame = timeshift_file_iframe(e->file, e->idx);
+  } else {
+    /* no frames, use the start/end of buffer */
+    tsf = back ? timeshift_filemgr_oldest(tsb) : timeshift_filemgr_newest(tsb);
+    nseek->file  = tsf;
+    nseek->frame = NULL;
+  }
   return end;
 }
 
+/*
+ * Convert the buffer position to time
+ */
+static int _timeshift_size_to_time
+  ( timeshift_t *ts, timeshift_seek_t *seek, streaming_skip_t *skip,
+    int64_t *req_time )
+{
+  timeshift_buffer_t *tsb = ts->tsb;
+  timeshift_file_t *tsf;
+  timeshift_index_entry_t *e;
+  int64_t boff;
+
+  if (skip->type == SMT_SKIP_ABS_SIZE) {
+    tsf  = TAILQ_FIRST(&tsb->files);
+    boff = tsf ? tsf->boff : tsb->boff;
+  } else if (seek->file) {
+    boff = seek->file->boff + seek->roff;
+  } else {
+    boff = tsb->boff;
+  }
+  boff += skip->size;
+  if ((e = timeshift_index_find_boff(tsb, boff)) == NULL &&
+      (e = timeshift_index_first(tsb)) == NULL)
+    return -1;
+  *req_time = e->time + ts->delta;
+  tvhdebug(LS_TIMESHIFT, "ts %d skip size %"PRId64" to offset %"PRId64" time %"PRId64,
+           ts->id, (int64_t)skip->size, boff, *req_time);
+  return 0;
+}
+
 /*
  *
  */
@@ -373,6 +337,10 @@ static int _timeshift_do_skip
   tvhdebug(LS_TIMESHIFT, "ts %d skip to %"PRId64" from %"PRId64,
            ts->id, req_time, last_time);
 
+  /* Buffer time */
+  req_time  -= ts->delta;
+  last_time -= ts->delta;
+
   timeshift_file_get(seek->file);
 
   /* Find */
@@ -388,20 +356,37 @@ static int _timeshift_do_skip
   timeshift_file_put(seek->file);
 
   /* Position */
-  *seek = nseek;
+  nseek.roff = 0;
   if (nseek.file != NULL) {
     if (nseek.frame)
-      nseek.file->roff = nseek.frame->pos;
+      nseek.roff = nseek.frame->pos;
     else
-      nseek.file->roff = req_time > last_time ? nseek.file->size : 0;
+      nseek.roff = req_time > last_time ? nseek.file->size : 0;
     tvhtrace(LS_TIMESHIFT, "do skip seek->file %p roff %"PRId64,
-             nseek.file, (int64_t)nseek.file->roff);
+             nseek.file, (int64_t)nseek.roff);
   }
+  *seek = nseek;
 
   return end;
 }
 
 
+/*
+ * Convert the buffer times to the client times
+ */
+static void _timeshift_rebase ( timeshift_t *ts, streaming_message_t *sm )
+{
+  th_pkt_t *pkt;
+
+  sm->sm_time += ts->delta;
+  if (sm->sm_type == SMT_PACKET && ts->delta_pts) {
+    pkt = sm->sm_data;
+    if (pkt->pkt_pts != PTS_UNSET) pkt->pkt_pts += ts->delta_pts;
+    if (pkt->pkt_dts != PTS_UNSET) pkt->pkt_dts += ts->delta_pts;
+    if (pkt->pkt_pcr != PTS_UNSET) pkt->pkt_pcr += ts->delta_pts;
+  }
+}
+
 /*
  * Output packet
  */
@@ -411,44 +396,35 @@ static int _timeshift_read
 {
   timeshift_file_t *tsf = seek->file;
   ssize_t r;
-  off_t off = 0;
+  off_t off;
 
   *sm = NULL;
 
   if (tsf) {
 
-    /* Open file */
-    if (tsf->rfd < 0 && !tsf->ram) {
-      tsf->rfd = tvh_open(tsf->path, O_RDONLY, 0);
-      tvhtrace(LS_TIMESHIFT, "ts %d open file %s (fd %i)", ts->id, tsf->path, tsf->rfd);
-      if (tsf->rfd < 0)
-        return -1;
-    }
-    if (tsf->rfd >= 0)
-      if ((off = lseek(tsf->rfd, tsf->roff, SEEK_SET)) != tsf->roff)
-        tvherror(LS_TIMESHIFT, "ts %d seek to %s failed (off %"PRId64" != %"PRId64"): %s",
-                 ts->id, tsf->path, (int64_t)tsf->roff, (int64_t)off, strerror(errno));
-
     /* Read msg */
-    r = _read_msg(tsf, -1, sm);
+    off = seek->roff;
+    r = _read_record(seek, sm);
     if (r < 0) {
       streaming_message_t *e = streaming_msg_create_code(SMT_STOP, SM_CODE_UNDEFINED_ERROR);
       streaming_target_deliver2(ts->output, e);
-      tvhtrace(LS_TIMESHIFT, "ts %d seek to %jd (woff %jd) (fd %i)", ts->id, (intmax_t)off, (intmax_t)tsf->woff, tsf->rfd);
+      tvhtrace(LS_TIMESHIFT, "ts %d seek to %jd (woff %jd)", ts->id, (intmax_t)off, (intmax_t)tsf->woff);
       tvherror(LS_TIMESHIFT, "ts %d could not read buffer", ts->id);
       return -1;
     }
-    tvhtrace(LS_TIMESHIFT, "ts %d seek to %jd (fd %i) read msg %p/%"PRId64" (%"PRId64")",
-             ts->id, (intmax_t)off, tsf->rfd, *sm, *sm ? (*sm)->sm_time : -1, (int64_t)r);
+    if (*sm)
+      _timeshift_rebase(ts, *sm);
+    tvhtrace(LS_TIMESHIFT, "ts %d seek to %jd read msg %p/%"PRId64" (%"PRId64")",
+             ts->id, (intmax_t)off, *sm, *sm ? (*sm)->sm_time : -1, (int64_t)r);
 
     /* Special case - EOF */
-    if (r <= sizeof(size_t) || tsf->roff > tsf->size || *sm == NULL) {
+    if (*sm == NULL) {
       timeshift_file_get(seek->file); /* _read_close decreases file reference */
       _read_close(seek);
       _seek_set_file(seek, timeshift_filemgr_next(tsf, NULL, 0), 0);
       *wait     = 0;
       tvhtrace(LS_TIMESHIFT, "ts %d eof, seek->file %p (prev %p)", ts->id, seek->file, tsf);
-      timeshift_filemgr_dump(ts);
+      timeshift_filemgr_dump(ts->tsb);
     }
   }
   return 0;
@@ -491,7 +467,7 @@ static void timeshift_fill_status
     if (current_time > end)
       current_time = end;
   }
-  status->full = ts->full;
+  status->full = ts->tsb->full;
   tvhtrace(LS_TIMESHIFT, "ts %d status start %"PRId64" end %"PRId64
                         " current %"PRId64" state %d",
            ts->id, start, end, current_time, ts->state);
@@ -530,6 +506,7 @@ void *timeshift_reader ( void *p )
   timeshift_t *ts = p;
   int nfds, end, run = 1, wait = -1, state;
   timeshift_seek_t *seek = &ts->seek;
+  timeshift_buffer_t *tsb;
   timeshift_file_t *tmp_file;
   int cur_speed = 100, keyframe_mode = 0;
   int64_t mono_now, mono_play_time = 0, mono_last_status = 0;
@@ -563,8 +540,25 @@ void *timeshift_reader ( void *p )
 
     /* Control */
     tvh_mutex_lock(&ts->state_mutex);
+    tsb = ts->tsb;
+    tvh_mutex_lock(&tsb->lock);
+
+    /* The writer moved this reader forward (shared buffer full) */
+    if (seek->moved) {
+      seek->moved = 0;
+      if (sm) {
+        streaming_msg_free(sm);
+        sm = NULL;
+      }
+      if (seek->frame) {
+        pause_time     = seek->frame->time + ts->delta;
+        last_time      = pause_time;
+        mono_play_time = mono_now;
+      }
+    }
+
     if (nfds == 1) {
-      if (_read_msg(NULL, ts->rd_pipe.rd, &ctrl) > 0) {
+      if (_read_msg(ts->rd_pipe.rd, &ctrl) > 0) {
 
         /* Exit */
         if (ctrl->sm_type == SMT_EXIT) {
@@ -583,9 +577,13 @@ void *timeshift_reader ( void *p )
           if (speed < -3200) speed = -3200;
 
           /* Ignore negative */
-          if (!ts->dobuf && (speed < 0))
+          if (!tsb->dobuf && (speed < 0))
             speed = seek->file ? speed : 0;
 
+          /* Time offset to the shared buffer is not known yet */
+          if (!ts->synced && ts->state == TS_LIVE)
+            speed = 100;
+
           /* Process */
           if (cur_speed != speed) {
 
@@ -601,22 +599,22 @@ void *timeshift_reader ( void *p )
               /* Set position */
               } else {
                 tvhdebug(LS_TIMESHIFT, "ts %d enter timeshift mode", ts->id);
-                ts->dobuf = 1;
+                timeshift_buffer_dobuf(ts);
                 _seek_reset(seek);
-                tmp_file = timeshift_filemgr_newest(ts);
+                tmp_file = timeshift_filemgr_newest(tsb);
                 if (tmp_file != NULL) {
                   i64 = tmp_file->last;
                   timeshift_file_put(tmp_file);
                 } else {
-                  i64 = ts->buf_time;
+                  i64 = ts->buf_time - ts->delta;
                 }
-                seek->file = timeshift_filemgr_get(ts, i64);
+                seek->file = timeshift_filemgr_get(tsb, i64);
                 if (seek->file != NULL) {
-                  seek->file->roff = seek->file->size;
-                  pause_time       = seek->file->last;
+                  seek->roff       = seek->file->size;
+                  pause_time       = seek->file->last + ts->delta;
                   last_time        = pause_time;
                 } else {
-                  pause_time       = i64;
+                  pause_time       = i64 + ts->delta;
                   last_time        = pause_time;
                 }
               }
@@ -661,11 +659,14 @@ void *timeshift_reader ( void *p )
             case SMT_SKIP_LIVE:
               if (ts->state != TS_LIVE) {
 
-                /* Reset */
-                if (ts->full) {
-                  timeshift_filemgr_flush(ts, NULL);
-                  _seek_reset(seek);
-                  ts->full = 0;
+                /* Reset (keep the data used by the other readers) */
+                if (tsb->full) {
+                  _read_close(seek);
+                  if (tsb->refcount == 1)
+                    timeshift_filemgr_flush(tsb, NULL);
+                  else
+                    timeshift_filemgr_trim(tsb);
+                  tsb->full = 0;
                 }
 
                 /* Release */
@@ -678,33 +679,51 @@ void *timeshift_reader ( void *p )
               }
               break;
 
+            case SMT_SKIP_ABS_SIZE:
+            case SMT_SKIP_REL_SIZE:
             case SMT_SKIP_ABS_TIME:
               /* -fallthrough */
             case SMT_SKIP_REL_TIME:
 
+              /* Time offset to the shared buffer is not known yet */
+              if (ts->state == TS_LIVE && !ts->synced) {
+                tvhdebug(LS_TIMESHIFT, "ts %d skip ignored, not synced", ts->id);
+                skip = NULL;
+                break;
+              }
+
               /* Convert */
-              skip_time = ts_rescale(skip->time, 1000000);
-              tvhdebug(LS_TIMESHIFT, "ts %d skip %"PRId64" requested %"PRId64, ts->id, skip_time, skip->time);
+              if (skip->type == SMT_SKIP_ABS_TIME || skip->type == SMT_SKIP_REL_TIME) {
+                skip_time = ts_rescale(skip->time, 1000000);
+                tvhdebug(LS_TIMESHIFT, "ts %d skip %"PRId64" requested %"PRId64, ts->id, skip_time, skip->time);
+              }
 
               /* Live playback (stage1) */
               if (ts->state == TS_LIVE) {
                 _seek_reset(seek);
-                tmp_file = timeshift_filemgr_newest(ts);
+                tmp_file = timeshift_filemgr_newest(tsb);
                 if (tmp_file) {
                   i64 = tmp_file->last;
                   timeshift_file_put(tmp_file);
                 }
-                if (tmp_file && (seek->file = timeshift_filemgr_get(ts, i64)) != NULL) {
-                  seek->file->roff = seek->file->size;
-                  last_time        = seek->file->last;
+                if (tmp_file && (seek->file = timeshift_filemgr_get(tsb, i64)) != NULL) {
+                  seek->roff       = seek->file->size;
+                  last_time        = seek->file->last + ts->delta;
                 } else {
                   last_time        = ts->buf_time;
                 }
               }
 
               /* May have failed */
-              if (skip->type == SMT_SKIP_REL_TIME)
+              if (skip->type == SMT_SKIP_REL_TIME) {
                 skip_time += last_time;
+              } else if (skip->type == SMT_SKIP_ABS_SIZE || skip->type == SMT_SKIP_REL_SIZE) {
+                if (_timeshift_size_to_time(ts, seek, skip, &skip_time)) {
+                  tvhdebug(LS_TIMESHIFT, "ts %d skip by size failed, empty buffer", ts->id);
+                  skip = NULL;
+                  break;
+                }
+              }
               tvhdebug(LS_TIMESHIFT, "ts %d skip time %"PRId64, ts->id, skip_time);
 
               /* Live (stage2) */
@@ -714,7 +733,7 @@ void *timeshift_reader ( void *p )
                   skip = NULL;
                 } else {
                   ts->state = TS_PLAY;
-                  ts->dobuf = 1;
+                  timeshift_buffer_dobuf(ts);
                   tvhtrace(LS_TIMESHIFT, "reader - set TS_PLAY");
                 }
               }
@@ -725,7 +744,7 @@ void *timeshift_reader ( void *p )
                 seek->frame = NULL;
                 end = _timeshift_do_skip(ts, skip_time, last_time, seek);
                 if (seek->frame) {
-                  pause_time = seek->frame->time;
+                  pause_time = seek->frame->time + ts->delta;
                   tvhtrace(LS_TIMESHIFT, "ts %d skip - play buffer from %"PRId64" last_time %"PRId64,
                            ts->id, pause_time, last_time);
 
@@ -772,6 +791,7 @@ void *timeshift_reader ( void *p )
         timeshift_status(ts, last_time);
         mono_last_status = mono_now;
       }
+      tvh_mutex_unlock(&tsb->lock);
       tvh_mutex_unlock(&ts->state_mutex);
       continue;
     }
@@ -807,6 +827,7 @@ void *timeshift_reader ( void *p )
 
       /* Find packet */
       if (_timeshift_read(ts, seek, &sm, &wait) == -1) {
+        tvh_mutex_unlock(&tsb->lock);
         tvh_mutex_unlock(&ts->state_mutex);
         break;
       }
@@ -869,7 +890,7 @@ void *timeshift_reader ( void *p )
     if (!seek->file || end != 0) {
 
       /* Back to live (unless buffer is full) */
-      if ((end == 1 && !ts->full) || !seek->file) {
+      if ((end == 1 && !tsb->full) || !seek->file) {
         tvhdebug(LS_TIMESHIFT, "ts %d eob revert to live mode", ts->id);
         cur_speed = 100;
         ctrl      = streaming_msg_create_code(SMT_SPEED, cur_speed);
@@ -879,6 +900,7 @@ void *timeshift_reader ( void *p )
 
         /* Flush timeshift buffer to live */
         if (_timeshift_flush_to_live(ts, seek, &wait) == -1) {
+          tvh_mutex_unlock(&tsb->lock);
           tvh_mutex_unlock(&ts->state_mutex);
           break;
         }
@@ -899,7 +921,7 @@ void *timeshift_reader ( void *p )
           tvhtrace(LS_TIMESHIFT, "reader - set TS_PLAY");
           if (ts->state != TS_PLAY) {
             ts->state = TS_PLAY;
-            ts->dobuf = 1;
+            timeshift_buffer_dobuf(ts);
             if (mono_play_time != mono_now)
               tvhtrace(LS_TIMESHIFT, "update play time (pause) - %"PRId64, mono_now);
             mono_play_time = mono_now;
@@ -914,12 +936,17 @@ void *timeshift_reader ( void *p )
 
     }
 
+    tvh_mutex_unlock(&tsb->lock);
     tvh_mutex_unlock(&ts->state_mutex);
   }
 
   /* Cleanup */
   tvhpoll_destroy(pd);
+  tvh_mutex_lock(&ts->state_mutex);
+  tvh_mutex_lock(&ts->tsb->lock);
   _read_close(seek);
+  tvh_mutex_unlock(&ts->tsb->lock);
+  tvh_mutex_unlock(&ts->state_mutex);
   if (sm)       streaming_msg_free(sm);
   if (ctrl)     streaming_msg_free(ctrl);
   tvhtrace(LS_TIMESHIFT, "ts %d exit reader thread", ts->id);
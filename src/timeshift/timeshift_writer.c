@@ -54,38 +54,64 @@ static ssize_t _write_fd
   return count == n ? n : -1;
 }
 
-static ssize_t _write
-  ( timeshift_file_t *tsf, const void *buf, size_t count )
+/*
+ * Reserve the disk space for the mapped area (no SIGBUS when disk is full)
+ */
+static int _reserve ( timeshift_file_t *tsf, off_t start, off_t end )
 {
-  uint8_t *ram;
-  size_t alloc;
-  ssize_t ret;
-  if (tsf->ram) {
-    tvh_mutex_lock(&tsf->ram_lock);
-    if (tsf->ram_size < tsf->woff + count) {
-      if (tsf->ram_size >= timeshift_conf.ram_segment_size)
-        alloc = MAX(count, 64*1024);
-      else
-        alloc = MAX(count, 4*1024*1024);
-      ram = realloc(tsf->ram, tsf->ram_size + alloc);
-      if (ram == NULL) {
-        tvhwarn(LS_TIMESHIFT, "RAM timeshift memalloc failed");
-        tvh_mutex_unlock(&tsf->ram_lock);
-        return -1;
-      }
-      memoryinfo_append(&timeshift_memoryinfo_ram, alloc);
-      tsf->ram = ram;
-      tsf->ram_size += alloc;
-    }
-    memcpy(tsf->ram + tsf->woff, buf, count);
-    tsf->woff += count;
-    tvh_mutex_unlock(&tsf->ram_lock);
-    return count;
+#if !defined(PLATFORM_DARWIN)
+  int r;
+
+  if (tsf->wfd < 0 || start >= end)
+    return 0;
+  r = posix_fallocate(tsf->wfd, start, end - start);
+  if (r) {
+    tvherror(LS_TIMESHIFT, "unable to reserve space in %s [e=%s]",
+             tsf->path, strerror(r));
+    return -1;
   }
-  ret = _write_fd(tsf->wfd, buf, count);
-  if (ret > 0)
-    tsf->woff += ret;
-  return ret;
+#endif
+  return 0;
+}
+
+/*
+ * Allocate the record in the segment
+ */
+static timeshift_record_t *_write_begin
+  ( timeshift_file_t *tsf, streaming_message_type_t type, int64_t time,
+    size_t len )
+{
+  timeshift_record_t *rec;
+  off_t end;
+
+  len = sizeof(*rec) + len;
+  len = (len + TIMESHIFT_RECORD_ALIGN - 1) & ~(TIMESHIFT_RECORD_ALIGN - 1);
+  if (len > TIMESHIFT_RECORD_MAX || len > timeshift_file_free(tsf)) {
+    tvhwarn(LS_TIMESHIFT, "record too big (%zd bytes, free %zd bytes)",
+            len, timeshift_file_free(tsf));
+    return NULL;
+  }
+  end = tsf->woff + len;
+  if (end > tsf->rsv_lo) {
+    end = MIN(tsf->rsv_hi, (end + TIMESHIFT_SEGMENT_GROW - 1) &
+                           ~((off_t)TIMESHIFT_SEGMENT_GROW - 1));
+    if (_reserve(tsf, tsf->rsv_lo, end))
+      return NULL;
+    tsf->rsv_lo = end;
+  }
+  rec = (timeshift_record_t *)(tsf->data + tsf->woff);
+  rec->len  = len;
+  rec->type = type;
+  rec->spare[0] = rec->spare[1] = rec->spare[2] = 0;
+  rec->time = time;
+  return rec;
+}
+
+static inline ssize_t _write_end
+  ( timeshift_file_t *tsf, timeshift_record_t *rec )
+{
+  tsf->woff += rec->len;
+  return rec->len;
 }
 
 /*
@@ -95,22 +121,11 @@ static ssize_t _write_msg
   ( timeshift_file_t *tsf, streaming_message_type_t type, int64_t time,
     const void *buf, size_t len )
 {
-  size_t len2 = len + sizeof(type) + sizeof(time);
-  ssize_t err, ret;
-  ret = err = _write(tsf, &len2, sizeof(len2));
-  if (err < 0) return err;
-  err = _write(tsf, &type, sizeof(type));
-  if (err < 0) return err;
-  ret += err;
-  err = _write(tsf, &time, sizeof(time));
-  if (err < 0) return err;
-  ret += err;
-  if (len) {
-    err = _write(tsf, buf, len);
-    if (err < 0) return err;
-    ret += err;
-  }
-  return ret;
+  timeshift_record_t *rec = _write_begin(tsf, type, time, len);
+  if (rec == NULL)
+    return -1;
+  memcpy(rec + 1, buf, len);
+  return _write_end(tsf, rec);
 }
 
 static ssize_t _write_msg_fd
@@ -135,25 +150,6 @@ static ssize_t _write_msg_fd
   return ret;
 }
 
-/*
- * Write packet buffer
- */
-static int _write_pktbuf ( timeshift_file_t *tsf, pktbuf_t *pktbuf )
-{
-  ssize_t ret, err;
-  if (pktbuf) {
-    ret = err = _write(tsf, &pktbuf->pb_size, sizeof(pktbuf->pb_size));
-    if (err < 0) return err;
-    err = _write(tsf, pktbuf_ptr(pktbuf), pktbuf_len(pktbuf));
-    if (err < 0) return err;
-    ret += err;
-  } else {
-    size_t sz = 0;
-    ret = _write(tsf, &sz, sizeof(sz));
-  }
-  return ret;
-}
-
 /*
  * Write signal status
  */
@@ -169,16 +165,33 @@ ssize_t timeshift_write_sigstat
  */
 ssize_t timeshift_write_packet ( timeshift_file_t *tsf, int64_t time, th_pkt_t *pkt )
 {
-  ssize_t ret = 0, err;
-  ret = err = _write_msg(tsf, SMT_PACKET, time, pkt, sizeof(th_pkt_t));
-  if (err <= 0) return err;
-  err = _write_pktbuf(tsf, pkt->pkt_meta);
-  if (err <= 0) return err;
-  ret += err;
-  err = _write_pktbuf(tsf, pkt->pkt_payload);
-  if (err <= 0) return err;
-  ret += err;
-  return ret;
+  timeshift_record_t *rec;
+  timeshift_record_pkt_t *rp;
+  size_t mlen = pkt->pkt_meta ? pktbuf_len(pkt->pkt_meta) : 0;
+  size_t plen = pkt->pkt_payload ? pktbuf_len(pkt->pkt_payload) : 0;
+  uint8_t *p;
+
+  rec = _write_begin(tsf, SMT_PACKET, time, sizeof(*rp) + mlen + plen);
+  if (rec == NULL)
+    return -1;
+  rp = (timeshift_record_pkt_t *)(rec + 1);
+  rp->pts            = pkt->pkt_pts;
+  rp->dts            = pkt->pkt_dts;
+  rp->pcr            = pkt->pkt_pcr;
+  rp->duration       = pkt->pkt_duration;
+  rp->meta_len       = mlen;
+  rp->payload_len    = plen;
+  rp->type           = pkt->pkt_type;
+  rp->err            = pkt->pkt_err;
+  rp->componentindex = pkt->pkt_componentindex;
+  rp->commercial     = pkt->pkt_commercial;
+  memcpy(rp->av, &pkt->v, sizeof(pkt->v));
+  p = (uint8_t *)(rp + 1);
+  if (mlen)
+    memcpy(p, pktbuf_ptr(pkt->pkt_meta), mlen);
+  if (plen)
+    memcpy(p + mlen, pktbuf_ptr(pkt->pkt_payload), plen);
+  return _write_end(tsf, rec);
 }
 
 /*
@@ -222,40 +235,31 @@ ssize_t timeshift_write_exit ( int fd )
   return _write_msg_fd(fd, SMT_EXIT, 0, &code, sizeof(code));
 }
 
-/*
- * Write end of file (special internal message)
- */
-ssize_t timeshift_write_eof ( timeshift_file_t *tsf )
-{
-  size_t sz = 0;
-  return _write(tsf, &sz, sizeof(sz));
-}
-
 /*
  * Update smt_start
  */
-static void _update_smt_start ( timeshift_t *ts, streaming_start_t *ss )
+static void _update_smt_start ( timeshift_buffer_t *tsb, streaming_start_t *ss )
 {
   int i;
 
-  if (ts->smt_start)
-    streaming_start_unref(ts->smt_start);
+  if (tsb->smt_start)
+    streaming_start_unref(tsb->smt_start);
   streaming_start_ref(ss);
-  ts->smt_start = ss;
+  tsb->smt_start = ss;
 
-  ts->audio_packet_counter = 255;
+  tsb->audio_packet_counter = 255;
 
   /* Update video index */
   for (i = 0; i < ss->ss_num_components; i++)
     if (SCT_ISVIDEO(ss->ss_components[i].es_type)) {
-      ts->vididx = ss->ss_components[i].es_index;
+      tsb->vididx = ss->ss_components[i].es_index;
       break;
     }
 
   /* Update audio index */
   for (i = 0; i < ss->ss_num_components; i++)
     if (SCT_ISAUDIO(ss->ss_components[i].es_type)) {
-      ts->audidx = ss->ss_components[i].es_index;
+      tsb->audidx = ss->ss_components[i].es_index;
       break;
     }
 }
@@ -263,7 +267,7 @@ static void _update_smt_start ( timeshift_t *ts, streaming_start_t *ss )
 /*
  * Stream start handling
  */
-static void _handle_sstart ( timeshift_t *ts, timeshift_file_t *tsf, streaming_message_t *sm )
+static void _handle_sstart ( timeshift_file_t *tsf, streaming_message_t *sm )
 {
   timeshift_index_data_t *ti = calloc(1, sizeof(timeshift_index_data_t));
 
@@ -276,25 +280,37 @@ static void _handle_sstart ( timeshift_t *ts, timeshift_file_t *tsf, streaming_m
 /*
  * Index i-frames and every 100th audio frame
  */
-static void add_frame_to_index ( timeshift_t *ts, timeshift_file_t *tsf, streaming_message_t *sm )
+static void add_frame_to_index
+  ( timeshift_buffer_t *tsb, timeshift_file_t *tsf, th_pkt_t *pkt,
+    int64_t time, off_t pos )
 {
-  th_pkt_t *pkt = sm->sm_data;
+  timeshift_index_iframe_t *ti;
+  off_t off;
 
   /* Index video iframes or audio frames for audio-only streams*/
-  if ((pkt->pkt_componentindex == ts->vididx && pkt->v.pkt_frametype == PKT_I_FRAME) ||
-      (ts->vididx == -1 && pkt->pkt_componentindex == ts->audidx)) {
-
-    if(ts->vididx != -1 || ts->audio_packet_counter > 100) {    
-      timeshift_index_iframe_t *ti = calloc(1, sizeof(timeshift_index_iframe_t));
-      memoryinfo_alloc(&timeshift_memoryinfo, sizeof(*ti));
-      ti->pos  = tsf->size;
-      ti->time = sm->sm_time;
-      TAILQ_INSERT_TAIL(&tsf->iframes, ti, link);
-      if(ts->vididx == -1)
-        ts->audio_packet_counter = 0;
+  if ((pkt->pkt_componentindex == tsb->vididx && pkt->v.pkt_frametype == PKT_I_FRAME) ||
+      (tsb->vididx == -1 && pkt->pkt_componentindex == tsb->audidx)) {
+
+    if(tsb->vididx != -1 || tsb->audio_packet_counter > 100) {    
+      /* the space for one entry is always kept free */
+      ti  = (timeshift_index_iframe_t *)(tsf->data + tsf->data_size) -
+            (tsf->iframes + 1);
+      off = (uint8_t *)ti - tsf->data;
+      if (off < tsf->rsv_hi) {
+        off = MAX(tsf->rsv_lo, (off - 64*1024) & ~((off_t)64*1024 - 1));
+        if (_reserve(tsf, off, tsf->rsv_hi))
+          return;
+        tsf->rsv_hi = off;
+      }
+      ti->pos  = pos;
+      ti->time = time;
+      tsf->iframes++;
+      timeshift_index_add(tsb, tsf, tsf->iframes - 1);
+      if(tsb->vididx == -1)
+        tsb->audio_packet_counter = 0;
     }
-    if(ts->vididx == -1)
-      ts->audio_packet_counter++;
+    if(tsb->vididx == -1)
+      tsb->audio_packet_counter++;
   }
 }
 
@@ -305,20 +321,34 @@ static void add_frame_to_index ( timeshift_t *ts, timeshift_file_t *tsf, streami
 static inline ssize_t _process_msg0
   ( timeshift_t *ts, timeshift_file_t *tsf, streaming_message_t *sm )
 {
+  timeshift_buffer_t *tsb = ts->tsb;
+  int64_t time = sm->sm_time - ts->delta;
+  th_pkt_t *pkt, pkt2;
+  off_t pos = tsf->woff;
   ssize_t err;
+  int n;
 
   if (sm->sm_type == SMT_START) {
     err = 0;
-    _handle_sstart(ts, tsf, streaming_msg_clone(sm));
+    _handle_sstart(tsf, streaming_msg_clone(sm));
   } else if (sm->sm_type == SMT_SIGNAL_STATUS) {
-    err = timeshift_write_sigstat(tsf, sm->sm_time, sm->sm_data);
+    err = timeshift_write_sigstat(tsf, time, sm->sm_data);
   } else if (sm->sm_type == SMT_PACKET) {
-    err = timeshift_write_packet(tsf, sm->sm_time, sm->sm_data);
+    pkt = sm->sm_data;
+    if (ts->delta_pts) {
+      /* store with the buffer time base */
+      pkt2 = *pkt;
+      if (pkt2.pkt_pts != PTS_UNSET) pkt2.pkt_pts -= ts->delta_pts;
+      if (pkt2.pkt_dts != PTS_UNSET) pkt2.pkt_dts -= ts->delta_pts;
+      if (pkt2.pkt_pcr != PTS_UNSET) pkt2.pkt_pcr -= ts->delta_pts;
+      pkt = &pkt2;
+    }
+    err = timeshift_write_packet(tsf, time, pkt);
     if (err > 0) {
-      add_frame_to_index(ts, tsf, sm);
+      add_frame_to_index(tsb, tsf, pkt, time, pos);
     }
   } else if (sm->sm_type == SMT_MPEGTS) {
-    err = timeshift_write_mpegts(tsf, sm->sm_time, sm->sm_data);
+    err = timeshift_write_mpegts(tsf, time, sm->sm_data);
   }
   else {
     err = 0;
@@ -326,21 +356,56 @@ static inline ssize_t _process_msg0
 
   /* OK */
   if (err > 0) {
-    tsf->last  = sm->sm_time;
+    tsf->last  = time;
     tsf->size += err;
     atomic_add_u64(&timeshift_total_size, err);
     if (tsf->ram)
       atomic_add_u64(&timeshift_total_ram_size, err);
+    tsb->written += err;
+    tsb->boff    += err;
+    if ((n = timeshift_buffer_sharers(tsb)) > 1) {
+      tsb->saved += err * (n - 1);
+      atomic_add_u64(&timeshift_total_saved_size, err * (n - 1));
+    }
   }
   return err;
 }
 
+/*
+ * Store the message to the buffer (writer, must hold tsb->lock)
+ */
+static void _store_msg
+  ( timeshift_t *ts, timeshift_buffer_t *tsb, streaming_message_t *sm )
+{
+  timeshift_file_t *tsf;
+
+  if ((tsf = timeshift_filemgr_get(tsb, sm->sm_time - ts->delta)) != NULL) {
+    if (tsf->data && !tsf->bad) {
+      if (_process_msg0(ts, tsf, sm) < 0) {
+        timeshift_filemgr_close(tsf);
+        tsf->bad = 1;
+        tsb->full = 1; ///< Stop any more writing
+      } else {
+        timeshift_packet_log("sav", ts, sm);
+      }
+    }
+    timeshift_file_put(tsf);
+  }
+}
+
+static inline int _is_teletext ( streaming_message_t *sm )
+{
+  return timeshift_conf.teletext && sm->sm_type == SMT_PACKET &&
+         ((th_pkt_t *)sm->sm_data)->pkt_type == SCT_TELETEXT;
+}
+
 static void _process_msg
   ( timeshift_t *ts, streaming_message_t *sm, int *run )
 {
-  int err, teletext = 0;
-  timeshift_file_t *tsf;
-  th_pkt_t *pkt;
+  int teletext = 0, stored = 0;
+  timeshift_buffer_t *tsb;
+  streaming_message_t *sm2;
+  th_pkt_t *pkt = NULL;
 
   /* Process */
   switch (sm->sm_type) {
@@ -370,10 +435,8 @@ static void _process_msg
 
     /* Store */
     case SMT_PACKET:
-      if (timeshift_conf.teletext && sm->sm_type == SMT_PACKET) {
-        pkt = sm->sm_data;
-        teletext = pkt->pkt_type == SCT_TELETEXT;
-      }
+      teletext = _is_teletext(sm);
+      pkt = sm->sm_data;
       /* fall thru */
     case SMT_SIGNAL_STATUS:
     case SMT_START:
@@ -386,23 +449,43 @@ static void _process_msg
         if (sm->sm_type == SMT_PACKET)
           timeshift_packet_log("liv", ts, sm);
       }
+      timeshift_buffer_sync(ts, sm->sm_type == SMT_PACKET ? sm->sm_data : NULL);
+      tsb = ts->tsb;
+      tvh_mutex_lock(&tsb->lock);
+      if (pkt && pkt->pkt_payload)
+        ts->seq++;
+      /* only one instance stores the data to the shared buffer */
+      if (ts != tsb->writer) {
+        if (pkt && pkt->pkt_payload && ts->synced)
+          timeshift_buffer_follow(ts, sm);
+        goto unlock;
+      }
       if (sm->sm_type == SMT_START)
-        _update_smt_start(ts, (streaming_start_t *)sm->sm_data);
-      /* do buffering, but without teletext packets */
-      if (ts->dobuf && !teletext) {
-        if ((tsf = timeshift_filemgr_get(ts, sm->sm_time)) != NULL) {
-          if (tsf->wfd >= 0 || tsf->ram) {
-            if ((err = _process_msg0(ts, tsf, sm)) < 0) {
-              timeshift_filemgr_close(tsf);
-              tsf->bad = 1;
-              ts->full = 1; ///< Stop any more writing
-            } else {
-              timeshift_packet_log("sav", ts, sm);
+        _update_smt_start(tsb, (streaming_start_t *)sm->sm_data);
+      if (pkt && pkt->pkt_payload) {
+        if (ts->handover) {
+          /* continue exactly after the last packet of the previous writer */
+          if (ts->seq <= tsb->seq) {
+            stored = 1;
+          } else {
+            tvhdebug(LS_TIMESHIFT, "ts %d writer continues after packet %"PRId64,
+                     ts->id, tsb->seq);
+            while ((sm2 = timeshift_buffer_pending_next(ts)) != NULL) {
+              if (tsb->dobuf && !_is_teletext(sm2))
+                _store_msg(ts, tsb, sm2);
+              streaming_msg_free(sm2);
             }
+            ts->handover = 0;
           }
-          timeshift_file_put(tsf);
         }
+        if (!stored)
+          timeshift_buffer_record(tsb, pkt);
       }
+      /* do buffering, but without teletext packets */
+      if (tsb->dobuf && !teletext && !stored)
+        _store_msg(ts, tsb, sm);
+unlock:
+      tvh_mutex_unlock(&tsb->lock);
       tvh_mutex_unlock(&ts->state_mutex);
       break;
   }
@@ -434,7 +517,7 @@ void *timeshift_writer ( void *aux )
     /* Get message */
     sm = TAILQ_FIRST(&sq->sq_queue);
     if (sm == NULL) {
-      tvh_cond_wait(&sq->sq_cond, &sq->sq_mutex);
+      streaming_queue_wait(sq, 0);
       continue;
     }
     streaming_queue_remove(sq, sm);
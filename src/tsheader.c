@@ -0,0 +1,204 @@
+/*
+ *  Tvheadend - MPEG-TS header batch decoding
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tvheadend.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    BYTE_ORDER == LITTLE_ENDIAN
+#define TS_HDR_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+ * Scalar version
+ */
+static void
+ts_hdr_decode_c
+  ( const uint8_t *tsb, int count, uint16_t *pid, uint8_t *flags )
+{
+  for ( ; count > 0; count--, tsb += 188) {
+    *pid++ = (((tsb[1] & 0x9f) << 8) | tsb[2]) |
+             (tsb[0] != 0x47 ? TS_HDR_NOSYNC : 0);
+    *flags++ = tsb[3];
+  }
+}
+
+static int
+ts_hdr_run_c
+  ( const uint16_t *pid, const uint8_t *flags, int count,
+    uint16_t pmask, uint8_t fmask )
+{
+  uint16_t p = pid[0] & pmask;
+  uint8_t f = flags[0] & fmask;
+  uint64_t p4, pm4, w;
+  uint32_t f4, fm4, v;
+  int r = 1;
+
+  /* most runs in a multiplexed stream have a single packet */
+  if (count < 2 || (pid[1] & pmask) != p || (flags[1] & fmask) != f)
+    return 1;
+
+  /* four entries per round */
+  p4  = p * 0x0001000100010001ULL;
+  pm4 = pmask * 0x0001000100010001ULL;
+  f4  = f * 0x01010101U;
+  fm4 = fmask * 0x01010101U;
+  for ( ; count - r >= 4; r += 4) {
+    memcpy(&w, pid + r, sizeof(w));
+    memcpy(&v, flags + r, sizeof(v));
+    if ((w & pm4) != p4 || (v & fm4) != f4)
+      break;
+  }
+  for ( ; r < count; r++)
+    if ((pid[r] & pmask) != p || (flags[r] & fmask) != f)
+      break;
+  return r;
+}
+
+#if TS_HDR_X86
+
+/*
+ * SSE2 version of the run length scan - 8 entries per round
+ *
+ * Note: there is no SSE2 decoder, the strided header loads make it
+ * slower than the scalar code. The AVX2 gather loads are faster.
+ */
+__attribute__((target("sse2")))
+static int
+ts_hdr_run_sse2
+  ( const uint16_t *pid, const uint8_t *flags, int count,
+    uint16_t pmask, uint8_t fmask )
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i vpm = _mm_set1_epi16(pmask);
+  const __m128i vfm = _mm_set1_epi16(fmask);
+  const __m128i vp = _mm_set1_epi16(pid[0] & pmask);
+  const __m128i vf = _mm_set1_epi16(flags[0] & fmask);
+  __m128i p, f;
+  unsigned int m;
+  int r = 1;
+
+  /* most runs in a multiplexed stream have a single packet */
+  if (count < 2 || (pid[1] & pmask) != (pid[0] & pmask) ||
+      (flags[1] & fmask) != (flags[0] & fmask))
+    return 1;
+
+  while (count - r >= 8) {
+    p = _mm_and_si128(_mm_loadu_si128((const __m128i *)(pid + r)), vpm);
+    f = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(flags + r)), zero);
+    f = _mm_and_si128(f, vfm);
+    m = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(p, vp),
+                                        _mm_cmpeq_epi16(f, vf)));
+    if (m != 0xffff)
+      return r + __builtin_ctz(~m) / 2;
+    r += 8;
+  }
+  for ( ; r < count; r++)
+    if ((pid[r] & pmask) != (pid[0] & pmask) ||
+        (flags[r] & fmask) != (flags[0] & fmask))
+      break;
+  return r;
+}
+
+/*
+ * AVX2 version - 16 packets per round using the gather loads
+ */
+__attribute__((target("avx2")))
+static void
+ts_hdr_decode_avx2
+  ( const uint8_t *tsb, int count, uint16_t *pid, uint8_t *flags )
+{
+  const __m256i idx   = _mm256_setr_epi32(0*188, 1*188, 2*188, 3*188,
+                                          4*188, 5*188, 6*188, 7*188);
+  const __m256i mpid  = _mm256_set1_epi32(0x9f00);
+  const __m256i mlow  = _mm256_set1_epi32(0xff);
+  const __m256i msync = _mm256_set1_epi32(0x47);
+  const __m256i nsync = _mm256_set1_epi32(TS_HDR_NOSYNC);
+  const __m256i sign  = _mm256_set1_epi32(0x8000);
+  const __m256i sign16 = _mm256_set1_epi16((short)0x8000);
+  __m256i w0, w1, p0, p1, f;
+  __m128i f8;
+
+  for ( ; count >= 16; count -= 16, tsb += 16*188, pid += 16, flags += 16) {
+    w0 = _mm256_i32gather_epi32((const int *)tsb, idx, 1);
+    w1 = _mm256_i32gather_epi32((const int *)(tsb + 8*188), idx, 1);
+    p0 = _mm256_or_si256(_mm256_and_si256(w0, mpid),
+                         _mm256_and_si256(_mm256_srli_epi32(w0, 16), mlow));
+    p1 = _mm256_or_si256(_mm256_and_si256(w1, mpid),
+                         _mm256_and_si256(_mm256_srli_epi32(w1, 16), mlow));
+    p0 = _mm256_or_si256(p0, _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_and_si256(w0, mlow), msync), nsync));
+    p1 = _mm256_or_si256(p1, _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_and_si256(w1, mlow), msync), nsync));
+    /* the packs work per 128-bit lane, fix the order afterwards */
+    p0 = _mm256_xor_si256(_mm256_packs_epi32(_mm256_sub_epi32(p0, sign),
+                                             _mm256_sub_epi32(p1, sign)), sign16);
+    p0 = _mm256_permute4x64_epi64(p0, 0xd8);
+    _mm256_storeu_si256((__m256i *)pid, p0);
+    f = _mm256_packs_epi32(_mm256_srli_epi32(w0, 24), _mm256_srli_epi32(w1, 24));
+    f = _mm256_permute4x64_epi64(f, 0xd8);
+    f8 = _mm_packus_epi16(_mm256_castsi256_si128(f), _mm256_extracti128_si256(f, 1));
+    _mm_storeu_si128((__m128i *)flags, f8);
+  }
+  ts_hdr_decode_c(tsb, count, pid, flags);
+}
+
+#endif /* TS_HDR_X86 */
+
+/*
+ * Runtime selection
+ */
+typedef void (*ts_hdr_decode_t)(const uint8_t *, int, uint16_t *, uint8_t *);
+typedef int (*ts_hdr_run_t)(const uint16_t *, const uint8_t *, int, uint16_t, uint8_t);
+
+static ts_hdr_decode_t ts_hdr_decode_fcn;
+static ts_hdr_run_t ts_hdr_run_fcn;
+
+static void
+ts_hdr_select ( void )
+{
+  ts_hdr_decode_t d = ts_hdr_decode_c;
+  ts_hdr_run_t r = ts_hdr_run_c;
+#if TS_HDR_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2"))
+    r = ts_hdr_run_sse2;
+  if (__builtin_cpu_supports("avx2"))
+    d = ts_hdr_decode_avx2;
+#endif
+  ts_hdr_run_fcn = r;
+  ts_hdr_decode_fcn = d;
+}
+
+void
+mpegts_hdr_decode
+  ( const uint8_t *tsb, int count, uint16_t *pid, uint8_t *flags )
+{
+  if (ts_hdr_decode_fcn == NULL)
+    ts_hdr_select();
+  ts_hdr_decode_fcn(tsb, count, pid, flags);
+}
+
+int
+mpegts_hdr_run
+  ( const uint16_t *pid, const uint8_t *flags, int count,
+    uint16_t pmask, uint8_t fmask )
+{
+  if (count <= 0)
+    return 0;
+  if (ts_hdr_run_fcn == NULL)
+    ts_hdr_select();
+  return ts_hdr_run_fcn(pid, flags, count, pmask, fmask);
+}
@@ -247,6 +247,9 @@ void tvh_pipe_close(th_pipe_t *pipe);
 
 int tvh_write(int fd, const void *buf, size_t len);
 
+struct iovec;
+int tvh_writev(int fd, struct iovec *iov, int iovcnt);
+
 int tvh_write_in_chunks(int fd, const void *buf, size_t len, size_t chunkSize);
 
 int tvh_nonblock_write(int fd, const void *buf, size_t len);
@@ -289,6 +292,7 @@ char *regexp_escape ( const char *str );
 #if ENABLE_ZLIB
 uint8_t *tvh_gzip_inflate ( const uint8_t *data, size_t size, size_t orig );
 uint8_t *tvh_gzip_deflate ( const uint8_t *data, size_t orig, size_t *size );
+uint8_t *tvh_gzip_deflate_speed ( const uint8_t *data, size_t orig, size_t *size, int speed );
 int      tvh_gzip_deflate_fd ( int fd, const uint8_t *data, size_t orig, size_t *size, int speed );
 int      tvh_gzip_deflate_fd_header ( int fd, const uint8_t *data, size_t orig, size_t *size, int speed , const char *signature);
 #endif
@@ -300,6 +304,20 @@ void http_deescape(char *str);
 
 int mpegts_word_count(const uint8_t *tsb, int len, uint32_t mask);
 
+/*
+ * Batch TS header decoding (SIMD when available):
+ *  pid[]   - TEI (0x8000) | no sync byte (0x4000) | PID (0x1fff)
+ *  flags[] - the fourth header byte (scrambling 0xc0, adaptation 0x30, CC 0x0f)
+ */
+#define TS_HDR_TEI       0x8000
+#define TS_HDR_NOSYNC    0x4000
+#define TS_HDR_PID       0x1fff
+#define TS_HDR_BATCH     256
+
+void mpegts_hdr_decode(const uint8_t *tsb, int count, uint16_t *pid, uint8_t *flags);
+int mpegts_hdr_run(const uint16_t *pid, const uint8_t *flags, int count,
+                   uint16_t pmask, uint8_t fmask);
+
 int deferred_unlink(const char *filename, const char *rootdir);
 void dvr_cutpoint_delete_files (const char *s);
 
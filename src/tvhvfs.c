@@ -21,6 +21,12 @@
 #include <sys/sysmacros.h>
 #endif
 #include <sys/stat.h>
+#include <fcntl.h>
+#if defined(PLATFORM_LINUX)
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#include <linux/fiemap.h>
+#endif
 
 int tvh_vfs_fsid_build(const char *path, struct statvfs *vfs, tvh_fsid_t *dst)
 {
@@ -45,3 +51,23 @@ int tvh_vfs_fsid_build(const char *path, struct statvfs *vfs, tvh_fsid_t *dst)
 
   return 0;
 }
+
+int tvh_vfs_extents(const char *path)
+{
+#if defined(PLATFORM_LINUX) && defined(FS_IOC_FIEMAP)
+  struct fiemap fm;
+  int fd, r;
+
+  fd = tvh_open(path, O_RDONLY, 0);
+  if (fd < 0)
+    return -1;
+  memset(&fm, 0, sizeof(fm));
+  fm.fm_length = FIEMAP_MAX_OFFSET;
+  /* fm_extent_count == 0: only count the extents */
+  r = ioctl(fd, FS_IOC_FIEMAP, &fm);
+  close(fd);
+  return r < 0 ? -1 : (int)fm.fm_mapped_extents;
+#else
+  return -1;
+#endif
+}
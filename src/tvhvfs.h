@@ -38,6 +38,9 @@ typedef struct {
 
 int tvh_vfs_fsid_build(const char *path, struct statvfs *vfs, tvh_fsid_t *dst);
 
+/* Number of extents the file occupies, -1 if unknown */
+int tvh_vfs_extents(const char *path);
+
 static inline int tvh_vfs_fsid_match(tvh_fsid_t *a, tvh_fsid_t *b)
 {
   if (a->fsid != 0 && b->fsid != 0)
@@ -29,6 +29,7 @@
 #include <assert.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <netinet/udp.h>
 #include <netdb.h>
 #include <net/if.h>
 #ifndef IPV6_ADD_MEMBERSHIP
@@ -791,3 +792,44 @@ udp_multisend_send( udp_multisend_t *um, int fd, int packets )
   }
   return n;
 }
+
+/*
+ * UDP segmentation offload - the kernel splits one large write
+ * to the datagrams of the given size (the last one may be shorter)
+ */
+int
+udp_segment_probe( int fd )
+{
+#ifdef UDP_SEGMENT
+  int val = 0;
+  return setsockopt(fd, IPPROTO_UDP, UDP_SEGMENT, &val, sizeof(val)) == 0;
+#else
+  return 0;
+#endif
+}
+
+int
+udp_segment_send( int fd, struct iovec *iov, int iovcnt, int segsize )
+{
+#ifdef UDP_SEGMENT
+  char control[CMSG_SPACE(sizeof(uint16_t))];
+  struct msghdr msg;
+  struct cmsghdr *cm;
+
+  memset(&msg, 0, sizeof(msg));
+  memset(control, 0, sizeof(control));
+  msg.msg_iov        = iov;
+  msg.msg_iovlen     = iovcnt;
+  msg.msg_control    = control;
+  msg.msg_controllen = sizeof(control);
+  cm = CMSG_FIRSTHDR(&msg);
+  cm->cmsg_level = IPPROTO_UDP;
+  cm->cmsg_type  = UDP_SEGMENT;
+  cm->cmsg_len   = CMSG_LEN(sizeof(uint16_t));
+  *((uint16_t *)CMSG_DATA(cm)) = segsize;
+  return sendmsg(fd, &msg, MSG_DONTWAIT);
+#else
+  errno = EOPNOTSUPP;
+  return -1;
+#endif
+}
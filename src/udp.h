@@ -102,4 +102,9 @@ udp_multisend_free( udp_multisend_t *um );
 int
 udp_multisend_send( udp_multisend_t *um, int fd, int packets );
 
+int
+udp_segment_probe( int fd );
+int
+udp_segment_send( int fd, struct iovec *iov, int iovcnt, int segsize );
+
 #endif /* UDP_H_ */
@@ -133,7 +133,7 @@ udp_stream_thread ( void *aux )
     if(sm == NULL) {
       mono = mclk() + sec2mono(1);
       do {
-        r = tvh_cond_timedwait(&sq->sq_cond, &sq->sq_mutex, mono);
+        r = streaming_queue_wait(sq, mono);
         if (r == ETIMEDOUT) {
           break;
         }
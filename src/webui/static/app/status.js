@@ -22,6 +22,8 @@ tvheadend.status_subs = function(panel, index)
             r.data.state = m.state;
             if (m.pids) r.data.pids = m.pids;
             if (m.descramble) r.data.descramble = m.descramble;
+            r.data.descramble_fill = m.descramble_fill;
+            r.data.descramble_rate = m.descramble_rate;
             if (m.profile) r.data.profile = m.profile;
             r.data.errors = m.errors;
             r.data['in'] = m['in'];
@@ -53,6 +55,8 @@ tvheadend.status_subs = function(panel, index)
                 { name: 'state', sortType: stype },
                 { name: 'pids' },
                 { name: 'descramble', sortType: stype },
+                { name: 'descramble_fill', sortType: stypei },
+                { name: 'descramble_rate', sortType: stypei },
                 { name: 'errors', sortType: stypei },
                 { name: 'in', sortType: stypei },
                 { name: 'out', sortType: stypei },
@@ -180,6 +184,22 @@ tvheadend.status_subs = function(panel, index)
                 dataIndex: 'descramble',
                 sortable: true
             },
+            {
+                width: 50,
+                id: 'descramble_fill',
+                header: _("CSA batch fill (%)"),
+                dataIndex: 'descramble_fill',
+                hidden: true,
+                sortable: true
+            },
+            {
+                width: 50,
+                id: 'descramble_rate',
+                header: _("Descrambled (kb/s)"),
+                dataIndex: 'descramble_rate',
+                hidden: true,
+                sortable: true
+            },
             {
                 width: 50,
                 id: 'errors',
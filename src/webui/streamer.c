@@ -0,0 +1,998 @@
+/*
+ *  tvheadend, event driven HTTP streaming output
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The HTTP connection thread sets up the subscription, sends the reply
+ * header and initializes the muxer. The running stream is then passed
+ * to one of the streamer threads and the connection thread finishes.
+ *
+ * The streamer thread serves many clients. The muxer writes to a memory
+ * queue (output), the muxed data are moved to the reference counted
+ * chunks which are queued to the clients. The clients are sent using
+ * non-blocking writes when the socket is writable. When a client is too
+ * slow, the chunks are dropped until the queue is drained and the next
+ * keyframe (GOP start) is received.
+ *
+ * The pass-through (MPEG-TS) outputs can be shared. A next request for
+ * the same channel or service and profile does not create a new
+ * subscription, but it joins the running output at the next PAT.
+ */
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include "tvheadend.h"
+#include "config.h"
+#include "http.h"
+#include "tcp.h"
+#include "tvhpoll.h"
+#include "profile.h"
+#include "muxer.h"
+#include "subscriptions.h"
+#include "webui.h"
+
+#define STREAMER_OUTQ_HIGH  (4*1024*1024) /* start to drop packets */
+#define STREAMER_OUTQ_LOW   (1*1024*1024) /* resume at the next keyframe */
+#define STREAMER_DROP_MAX   sec2mono(3)   /* resume without keyframe */
+#define STREAMER_IOV        32
+#define STREAMER_EVENTS     64
+
+/* chunk start flags */
+#define STREAMER_SYNC_PAT   (1<<0)        /* MPEG-TS PAT (join point) */
+#define STREAMER_SYNC_KEY   (1<<1)        /* keyframe (resume point) */
+
+typedef struct streamer_thread streamer_thread_t;
+typedef struct streamer_output streamer_output_t;
+
+typedef struct streamer_chunk {
+  TAILQ_ENTRY(streamer_chunk) sk_link;
+  pktbuf_t          *sk_pb;
+} streamer_chunk_t;
+
+TAILQ_HEAD(streamer_chunk_queue, streamer_chunk);
+
+typedef struct streamer_client {
+  TAILQ_ENTRY(streamer_client) sc_link;
+  streamer_output_t *sc_output;
+  int                sc_shutdown;    /* cancelled (atomic) */
+  int                sc_run;
+  int                sc_error;       /* socket error */
+
+  int                sc_fd;
+  int                sc_events;      /* current poll events */
+  void              *sc_tcp_id;
+  char              *sc_url;
+  char              *sc_username;
+  char              *sc_proxy;
+
+  struct streamer_chunk_queue sc_chunks;
+  size_t             sc_off;         /* sent bytes from the first chunk */
+  size_t             sc_size;        /* queued bytes */
+
+  int                sc_wait;        /* waiting for the STREAMER_SYNC_ flag */
+  int64_t            sc_drop;        /* drop start time */
+  uint64_t           sc_dropped;     /* dropped bytes */
+} streamer_client_t;
+
+TAILQ_HEAD(streamer_client_queue, streamer_client);
+
+struct streamer_output {
+  TAILQ_ENTRY(streamer_output) so_link;
+  TAILQ_ENTRY(streamer_output) so_ready_link;
+  LIST_ENTRY(streamer_output) so_share_link;
+  streamer_thread_t *so_thread;
+  int                so_ready;       /* in the ready list (st_lock) */
+  int                so_new;         /* not registered in the thread yet */
+  int                so_shared;      /* in streamer_outputs (streamer_lock) */
+  int                so_run;
+
+  void              *so_id;          /* share key: channel or service */
+  profile_t         *so_pro;         /* share key: profile */
+  int                so_sflags;      /* share key: subscription flags */
+
+  profile_chain_t   *so_prch;
+  th_subscription_t *so_sub;
+  char              *so_url;
+  char              *so_mime;
+
+  struct streaming_message_queue so_batch;
+  htsbuf_queue_t     so_outq;        /* muxer output */
+  int                so_flags;       /* STREAMER_SYNC_ flags for so_outq */
+
+  int64_t            so_lastpkt;
+  int                so_ptimeout;
+  int                so_video;       /* video packets were seen */
+
+  struct streamer_client_queue so_clients;
+  int                so_nclients;
+};
+
+TAILQ_HEAD(streamer_output_queue, streamer_output);
+
+struct streamer_thread {
+  pthread_t          st_tid;
+  tvhpoll_t         *st_poll;
+  th_pipe_t          st_pipe;
+  tvh_mutex_t        st_lock;        /* protects st_ready and st_new */
+  struct streamer_output_queue st_ready;
+  struct streamer_client_queue st_new;
+  struct streamer_output_queue st_outputs; /* owned by the thread */
+  int                st_cancel;      /* a client was cancelled (atomic) */
+  int                st_count;       /* number of clients (streamer_lock) */
+};
+
+static tvh_mutex_t streamer_lock = TVH_THREAD_MUTEX_INITIALIZER;
+static streamer_thread_t *streamer_threads;
+static int streamer_nthreads;
+static int streamer_running;
+/* shared outputs, modified with streamer_lock and global_lock */
+static LIST_HEAD(, streamer_output) streamer_outputs;
+
+/*
+ * Wake up the thread for the output (called from the producers)
+ */
+static void
+streamer_wakeup(streamer_output_t *so)
+{
+  streamer_thread_t *st = so->so_thread;
+  int wake = 0;
+
+  tvh_mutex_lock(&st->st_lock);
+  if (!so->so_ready) {
+    wake = TAILQ_EMPTY(&st->st_ready);
+    TAILQ_INSERT_TAIL(&st->st_ready, so, so_ready_link);
+    so->so_ready = 1;
+  }
+  tvh_mutex_unlock(&st->st_lock);
+  if (wake)
+    tvh_write(st->st_pipe.wr, "", 1);
+}
+
+static void
+streamer_notify(void *aux)
+{
+  streamer_wakeup(aux);
+}
+
+/*
+ * Connection status (global_lock)
+ */
+static void
+streamer_status(void *opaque, htsmsg_t *m)
+{
+  streamer_client_t *sc = opaque;
+
+  htsmsg_add_str(m, "type", "HTTP");
+  if (sc->sc_proxy)
+    htsmsg_add_str(m, "proxy", sc->sc_proxy);
+  if (sc->sc_username)
+    htsmsg_add_str(m, "user", sc->sc_username);
+}
+
+/*
+ * Connection cancel (global_lock)
+ */
+static void
+streamer_cancel(void *opaque)
+{
+  streamer_client_t *sc = opaque;
+  streamer_thread_t *st = sc->sc_output->so_thread;
+
+  atomic_set(&sc->sc_shutdown, 1);
+  atomic_set(&st->st_cancel, 1);
+  tvh_write(st->st_pipe.wr, "", 1);
+}
+
+/*
+ * Send the queued chunks (non-blocking)
+ */
+static int
+streamer_write(streamer_client_t *sc)
+{
+  struct iovec iov[STREAMER_IOV];
+  streamer_chunk_t *sk;
+  size_t off;
+  ssize_t r;
+  int i;
+
+  while ((sk = TAILQ_FIRST(&sc->sc_chunks)) != NULL) {
+    i = 0;
+    off = sc->sc_off;
+    for ( ; sk; sk = TAILQ_NEXT(sk, sk_link)) {
+      iov[i].iov_base = pktbuf_ptr(sk->sk_pb) + off;
+      iov[i].iov_len  = pktbuf_len(sk->sk_pb) - off;
+      off = 0;
+      if (++i >= STREAMER_IOV)
+        break;
+    }
+    r = writev(sc->sc_fd, iov, i);
+    if (r < 0) {
+      if (ERRNO_AGAIN(errno))
+        break;
+      if (errno != EPIPE && errno != ECONNRESET)
+        tvhwarn(LS_WEBUI, "Stop streaming %s, write error -- %s",
+                sc->sc_url, strerror(errno));
+      else
+        tvhdebug(LS_WEBUI, "Stop streaming %s, client hung up", sc->sc_url);
+      sc->sc_error = 1;
+      return -1;
+    }
+    subscription_add_bytes_out(sc->sc_output->so_sub, r);
+    sc->sc_size -= r;
+    off = sc->sc_off + r;
+    while ((sk = TAILQ_FIRST(&sc->sc_chunks)) != NULL &&
+           off >= pktbuf_len(sk->sk_pb)) {
+      off -= pktbuf_len(sk->sk_pb);
+      TAILQ_REMOVE(&sc->sc_chunks, sk, sk_link);
+      pktbuf_ref_dec(sk->sk_pb);
+      free(sk);
+    }
+    sc->sc_off = off;
+  }
+  return 0;
+}
+
+/*
+ * Send the chunks, enable the write events when the socket is full
+ */
+static void
+streamer_flush(streamer_client_t *sc)
+{
+  int events;
+
+  if (streamer_write(sc)) {
+    sc->sc_run = 0;
+    return;
+  }
+  events = TVHPOLL_IN | (sc->sc_size > 0 ? TVHPOLL_OUT : 0);
+  if (events != sc->sc_events) {
+    tvhpoll_add1(sc->sc_output->so_thread->st_poll, sc->sc_fd, events, sc);
+    sc->sc_events = events;
+  }
+}
+
+/*
+ * Queue the chunk, skip the data for the slow and joining clients
+ */
+static void
+streamer_client_queue(streamer_client_t *sc, pktbuf_t *pb, int flags)
+{
+  streamer_chunk_t *sk;
+  size_t len = pktbuf_len(pb);
+
+  if (sc->sc_wait == STREAMER_SYNC_KEY) {
+    if (sc->sc_size >= STREAMER_OUTQ_LOW ||
+        ((flags & STREAMER_SYNC_KEY) == 0 &&
+         mclk() - sc->sc_drop < STREAMER_DROP_MAX)) {
+      sc->sc_dropped += len;
+      return;
+    }
+    tvhdebug(LS_WEBUI, "Streaming %s, resumed (%"PRIu64" bytes dropped)",
+             sc->sc_url, sc->sc_dropped);
+    sc->sc_wait = 0;
+  } else if (sc->sc_wait) {
+    if ((flags & sc->sc_wait) == 0)
+      return;
+    sc->sc_wait = 0;
+  } else if (sc->sc_size > STREAMER_OUTQ_HIGH) {
+    tvhdebug(LS_WEBUI, "Streaming %s, client is too slow, dropping data",
+             sc->sc_url);
+    sc->sc_wait = STREAMER_SYNC_KEY;
+    sc->sc_drop = mclk();
+    sc->sc_dropped = len;
+    return;
+  }
+
+  sk = malloc(sizeof(*sk));
+  sk->sk_pb = pktbuf_ref_inc(pb);
+  TAILQ_INSERT_TAIL(&sc->sc_chunks, sk, sk_link);
+  sc->sc_size += len;
+}
+
+/*
+ * Release the unsent chunks
+ */
+static void
+streamer_client_flush(streamer_client_t *sc)
+{
+  streamer_chunk_t *sk;
+
+  while ((sk = TAILQ_FIRST(&sc->sc_chunks)) != NULL) {
+    TAILQ_REMOVE(&sc->sc_chunks, sk, sk_link);
+    pktbuf_ref_dec(sk->sk_pb);
+    free(sk);
+  }
+  sc->sc_off = sc->sc_size = 0;
+}
+
+/*
+ * Move the muxed data to the clients
+ */
+static void
+streamer_output_cut(streamer_output_t *so)
+{
+  streamer_client_t *sc;
+  size_t size = so->so_outq.hq_size;
+  pktbuf_t *pb;
+
+  if (size == 0)
+    return;
+  pb = pktbuf_alloc(NULL, size);
+  if (pb == NULL) {
+    htsbuf_queue_flush(&so->so_outq);
+    return;
+  }
+  htsbuf_read(&so->so_outq, pktbuf_ptr(pb), size);
+  TAILQ_FOREACH(sc, &so->so_clients, sc_link)
+    streamer_client_queue(sc, pb, so->so_flags);
+  pktbuf_ref_dec(pb);
+  so->so_flags = 0;
+}
+
+/*
+ * Some clients wait for the sync point (or they will soon)
+ */
+static int
+streamer_output_need_sync(streamer_output_t *so)
+{
+  streamer_client_t *sc;
+
+  TAILQ_FOREACH(sc, &so->so_clients, sc_link)
+    if (sc->sc_wait || sc->sc_size > STREAMER_OUTQ_HIGH)
+      return 1;
+  return 0;
+}
+
+/*
+ * Check the sync points (PAT, GOP start) in the stream data
+ */
+static int
+streamer_output_sync(streamer_output_t *so, streaming_message_t *sm)
+{
+  const uint8_t *tsb;
+  pktbuf_t *pb;
+  th_pkt_t *pkt;
+  size_t len;
+  int flags = 0;
+
+  if (sm->sm_type == SMT_PACKET) {
+    pkt = sm->sm_data;
+    if (SCT_ISVIDEO(pkt->pkt_type)) {
+      so->so_video = 1;
+      return pkt->v.pkt_frametype == PKT_I_FRAME ? STREAMER_SYNC_KEY : 0;
+    }
+    return so->so_video ? 0 : STREAMER_SYNC_KEY;
+  }
+  /* MPEG-TS - PAT start and random access indicator */
+  pb = sm->sm_data;
+  tsb = pktbuf_ptr(pb);
+  for (len = pktbuf_len(pb); len >= 188; tsb += 188, len -= 188) {
+    if ((tsb[1] & 0x5f) == 0x40 && tsb[2] == 0)
+      flags |= STREAMER_SYNC_PAT;
+    if ((tsb[3] & 0x20) && tsb[4] > 0 && (tsb[5] & 0x40))
+      flags |= STREAMER_SYNC_KEY;
+  }
+  return flags;
+}
+
+/*
+ * Update the client count in the subscription status
+ */
+static void
+streamer_output_clients(streamer_output_t *so)
+{
+  if (so->so_id)
+    atomic_set(&so->so_sub->ths_clients, so->so_nclients);
+}
+
+/*
+ * Check the packet timeouts
+ */
+static void
+streamer_output_timeout(streamer_output_t *so)
+{
+  if (so->so_ptimeout > 0 &&
+      mclk() - so->so_lastpkt > sec2mono(so->so_ptimeout)) {
+    tvhwarn(LS_WEBUI, "Stop streaming %s, timeout waiting for packets",
+            so->so_url);
+    so->so_run = 0;
+  }
+}
+
+/*
+ * Process the queued messages (see http_stream_run)
+ */
+static void
+streamer_output_process(streamer_output_t *so)
+{
+  streaming_queue_t *sq = &so->so_prch->prch_sq;
+  muxer_t *mux = so->so_prch->prch_muxer;
+  streaming_message_t *sm;
+  streamer_client_t *sc;
+  pktbuf_t *pb;
+  int sync, flags, more = 0;
+
+  tvh_mutex_lock(&sq->sq_mutex);
+  streaming_queue_take(sq, &so->so_batch);
+  tvh_mutex_unlock(&sq->sq_mutex);
+
+  sync = streamer_output_need_sync(so);
+
+  while (so->so_run && (sm = TAILQ_FIRST(&so->so_batch)) != NULL) {
+    TAILQ_REMOVE(&so->so_batch, sm, sm_link);
+
+    switch(sm->sm_type) {
+    case SMT_MPEGTS:
+    case SMT_PACKET:
+      if (sm->sm_type == SMT_PACKET)
+        pb = ((th_pkt_t *)sm->sm_data)->pkt_payload;
+      else
+        pb = sm->sm_data;
+      if (pktbuf_len(pb) > 0)
+        so->so_lastpkt = mclk();
+      /* the chunks start at the sync points */
+      if (sync && (flags = streamer_output_sync(so, sm)) != 0) {
+        streamer_output_cut(so);
+        so->so_flags = flags;
+      }
+      muxer_write_pkt(mux, sm->sm_type, sm->sm_data);
+      sm->sm_data = NULL;
+      break;
+
+    case SMT_START:
+      if(muxer_reconfigure(mux, sm->sm_data) < 0)
+        tvhwarn(LS_WEBUI,  "Unable to reconfigure stream %s", so->so_url);
+      break;
+
+    case SMT_STOP:
+      if((mux->m_caps & MC_CAP_ANOTHER_SERVICE) != 0) /* give a chance to use another svc */
+        break;
+      if(sm->sm_code != SM_CODE_SOURCE_RECONFIGURED) {
+        tvhwarn(LS_WEBUI,  "Stop streaming %s, %s", so->so_url,
+                streaming_code2txt(sm->sm_code));
+        so->so_run = 0;
+      }
+      break;
+
+    case SMT_SERVICE_STATUS:
+    case SMT_SIGNAL_STATUS:
+    case SMT_DESCRAMBLE_INFO:
+      streamer_output_timeout(so);
+      break;
+
+    case SMT_GRACE:
+    case SMT_NOSTART_WARN:
+    case SMT_SKIP:
+    case SMT_SPEED:
+    case SMT_TIMESHIFT_STATUS:
+      break;
+
+    case SMT_NOSTART:
+      tvhwarn(LS_WEBUI,  "Couldn't start streaming %s, %s",
+              so->so_url, streaming_code2txt(sm->sm_code));
+      so->so_run = 0;
+      break;
+
+    case SMT_EXIT:
+      tvhwarn(LS_WEBUI,  "Stop streaming %s, %s", so->so_url,
+              streaming_code2txt(sm->sm_code));
+      so->so_run = 0;
+      break;
+    }
+
+    streaming_msg_free(sm);
+
+    if(mux->m_errors) {
+      if (!mux->m_eos)
+        tvhwarn(LS_WEBUI,  "Stop streaming %s, muxer reported errors", so->so_url);
+      so->so_run = 0;
+    }
+  }
+
+  if (!so->so_run)
+    return;
+
+  streamer_output_cut(so);
+  TAILQ_FOREACH(sc, &so->so_clients, sc_link)
+    if (sc->sc_run)
+      streamer_flush(sc);
+
+  /* re-arm the notification or continue with the next batch */
+  tvh_mutex_lock(&sq->sq_mutex);
+  if (TAILQ_EMPTY(&sq->sq_queue))
+    sq->sq_waiting = 1;
+  else
+    more = 1;
+  tvh_mutex_unlock(&sq->sq_mutex);
+  if (more)
+    streamer_wakeup(so);
+}
+
+/*
+ * Register the new clients (and outputs) in the thread
+ */
+static void
+streamer_thread_register(streamer_thread_t *st)
+{
+  streamer_output_t *so;
+  streamer_client_t *sc;
+
+  tvh_mutex_lock(&st->st_lock);
+  while ((sc = TAILQ_FIRST(&st->st_new)) != NULL) {
+    TAILQ_REMOVE(&st->st_new, sc, sc_link);
+    tvh_mutex_unlock(&st->st_lock);
+    so = sc->sc_output;
+    if (so->so_new) {
+      so->so_new = 0;
+      TAILQ_INSERT_TAIL(&st->st_outputs, so, so_link);
+    }
+    TAILQ_INSERT_TAIL(&so->so_clients, sc, sc_link);
+    so->so_nclients++;
+    streamer_output_clients(so);
+    sc->sc_events = TVHPOLL_IN;
+    tvhpoll_add1(st->st_poll, sc->sc_fd, sc->sc_events, sc);
+    tvh_mutex_lock(&st->st_lock);
+  }
+  tvh_mutex_unlock(&st->st_lock);
+}
+
+/*
+ * The client is finished, release the connection
+ */
+static void
+streamer_client_destroy(streamer_client_t *sc)
+{
+  streamer_output_t *so = sc->sc_output;
+  streamer_thread_t *st = so->so_thread;
+
+  TAILQ_REMOVE(&so->so_clients, sc, sc_link);
+  so->so_nclients--;
+  streamer_output_clients(so);
+  tvhpoll_rem1(st->st_poll, sc->sc_fd);
+  streamer_client_flush(sc);
+
+  tvh_mutex_lock(&global_lock);
+  tcp_connection_detach_done(sc->sc_tcp_id);
+  tvh_mutex_unlock(&global_lock);
+
+  tvh_mutex_lock(&streamer_lock);
+  st->st_count--;
+  tvh_mutex_unlock(&streamer_lock);
+
+  free(sc->sc_url);
+  free(sc->sc_username);
+  free(sc->sc_proxy);
+  free(sc);
+}
+
+/*
+ * The output is finished, release the clients and the subscription
+ */
+static void
+streamer_output_destroy(streamer_output_t *so)
+{
+  streamer_thread_t *st = so->so_thread;
+  streaming_queue_t *sq = &so->so_prch->prch_sq;
+  muxer_t *mux = so->so_prch->prch_muxer;
+  streamer_client_t *sc;
+
+  /* no joins from now */
+  if (so->so_shared) {
+    tvh_mutex_lock(&streamer_lock);
+    tvh_mutex_lock(&global_lock);
+    LIST_REMOVE(so, so_share_link);
+    tvh_mutex_unlock(&global_lock);
+    so->so_shared = 0;
+    tvh_mutex_unlock(&streamer_lock);
+    streamer_thread_register(st);
+  }
+
+  /* no wakeups from now */
+  tvh_mutex_lock(&sq->sq_mutex);
+  sq->sq_notify = NULL;
+  sq->sq_notify_aux = NULL;
+  sq->sq_waiting = 0;
+  tvh_mutex_unlock(&sq->sq_mutex);
+  tvh_mutex_lock(&st->st_lock);
+  if (so->so_ready) {
+    TAILQ_REMOVE(&st->st_ready, so, so_ready_link);
+    so->so_ready = 0;
+  }
+  tvh_mutex_unlock(&st->st_lock);
+
+  streaming_queue_clear(&so->so_batch);
+
+  /* write the trailer, if possible */
+  muxer_close(mux);
+  streamer_output_cut(so);
+  while ((sc = TAILQ_FIRST(&so->so_clients)) != NULL) {
+    if (!sc->sc_error)
+      streamer_write(sc);
+    streamer_client_destroy(sc);
+  }
+  mux->m_output = NULL;
+  htsbuf_queue_flush(&so->so_outq);
+
+  TAILQ_REMOVE(&st->st_outputs, so, so_link);
+
+  tvh_mutex_lock(&global_lock);
+  subscription_unsubscribe(so->so_sub, UNSUBSCRIBE_FINAL);
+  profile_chain_close(so->so_prch);
+  tvh_mutex_unlock(&global_lock);
+
+  free(so->so_prch);
+  free(so->so_url);
+  free(so->so_mime);
+  free(so);
+}
+
+/*
+ * Read (and ignore) the data from the client, detect the closed socket
+ */
+static void
+streamer_read(streamer_client_t *sc)
+{
+  char buf[256];
+  ssize_t r;
+
+  while (1) {
+    r = read(sc->sc_fd, buf, sizeof(buf));
+    if (r > 0)
+      continue;
+    if (r < 0 && ERRNO_AGAIN(errno))
+      return;
+    break;
+  }
+  tvhdebug(LS_WEBUI,  "Stop streaming %s, client hung up", sc->sc_url);
+  sc->sc_run = 0;
+}
+
+/*
+ *
+ */
+static void *
+streamer_thread(void *aux)
+{
+  streamer_thread_t *st = aux;
+  streamer_output_t *so, *so_next;
+  streamer_client_t *sc, *sc_next;
+  tvhpoll_event_t ev[STREAMER_EVENTS];
+  int64_t mono, timeouts = mclk() + sec2mono(1);
+  int i, n, r, run = 1;
+  char c;
+
+  while (run) {
+    r = tvhpoll_wait(st->st_poll, ev, STREAMER_EVENTS, 1000);
+    if (r < 0) {
+      if (ERRNO_AGAIN(errno))
+        continue;
+      tvherror(LS_WEBUI, "streamer: tvhpoll_wait: %s", strerror(errno));
+      break;
+    }
+
+    for (i = 0; i < r; i++) {
+      if (ev[i].ptr == &st->st_pipe) {
+        while (read(st->st_pipe.rd, &c, 1) > 0);
+        continue;
+      }
+      sc = ev[i].ptr;
+      if (!sc->sc_run)
+        continue;
+      if (ev[i].events & (TVHPOLL_ERR | TVHPOLL_HUP)) {
+        tvhdebug(LS_WEBUI,  "Stop streaming %s, client hung up", sc->sc_url);
+        sc->sc_run = 0;
+        continue;
+      }
+      if (ev[i].events & TVHPOLL_IN)
+        streamer_read(sc);
+      if (sc->sc_run && (ev[i].events & TVHPOLL_OUT))
+        streamer_flush(sc);
+    }
+
+    streamer_thread_register(st);
+
+    /* the outputs may be queued again while processed */
+    tvh_mutex_lock(&st->st_lock);
+    n = 0;
+    TAILQ_FOREACH(so, &st->st_ready, so_ready_link)
+      n++;
+    while (n-- > 0 && (so = TAILQ_FIRST(&st->st_ready)) != NULL) {
+      TAILQ_REMOVE(&st->st_ready, so, so_ready_link);
+      so->so_ready = 0;
+      tvh_mutex_unlock(&st->st_lock);
+      if (so->so_new)
+        streamer_thread_register(st);
+      if (so->so_run)
+        streamer_output_process(so);
+      tvh_mutex_lock(&st->st_lock);
+    }
+    tvh_mutex_unlock(&st->st_lock);
+
+    if (atomic_exchange(&st->st_cancel, 0))
+      TAILQ_FOREACH(so, &st->st_outputs, so_link)
+        TAILQ_FOREACH(sc, &so->so_clients, sc_link)
+          if (atomic_get(&sc->sc_shutdown))
+            sc->sc_run = 0;
+
+    mono = mclk();
+    if (mono > timeouts) {
+      timeouts = mono + sec2mono(1);
+      TAILQ_FOREACH(so, &st->st_outputs, so_link)
+        if (so->so_run)
+          streamer_output_timeout(so);
+    }
+
+    tvh_mutex_lock(&streamer_lock);
+    run = atomic_get(&streamer_running);
+    tvh_mutex_unlock(&streamer_lock);
+
+    /* a stopped output stops all its clients, the last client the output */
+    if (!run)
+      streamer_thread_register(st);
+    for (so = TAILQ_FIRST(&st->st_outputs); so; so = so_next) {
+      so_next = TAILQ_NEXT(so, so_link);
+      if (!run)
+        so->so_run = 0;
+      for (sc = TAILQ_FIRST(&so->so_clients); sc; sc = sc_next) {
+        sc_next = TAILQ_NEXT(sc, sc_link);
+        if (!sc->sc_run)
+          streamer_client_destroy(sc);
+      }
+      if (TAILQ_EMPTY(&so->so_clients))
+        so->so_run = 0;
+      if (!so->so_run)
+        streamer_output_destroy(so);
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Find the running output to share (streamer_lock or global_lock)
+ */
+static streamer_output_t *
+streamer_output_find(void *id, profile_t *pro, int sflags)
+{
+  streamer_output_t *so;
+
+  LIST_FOREACH(so, &streamer_outputs, so_share_link)
+    if (so->so_id == id && so->so_pro == pro && so->so_sflags == sflags)
+      return so;
+  return NULL;
+}
+
+/*
+ * Create the client and take over the socket (streamer_lock)
+ */
+static void
+streamer_client_create(http_connection_t *hc, void *tcp_id,
+                       streamer_output_t *so, int wait)
+{
+  streamer_thread_t *st = so->so_thread;
+  streamer_client_t *sc;
+  const char *username;
+  char buf[128];
+
+  sc = calloc(1, sizeof(*sc));
+  sc->sc_output = so;
+  sc->sc_fd = hc->hc_fd;
+  sc->sc_tcp_id = tcp_id;
+  sc->sc_run = 1;
+  sc->sc_wait = wait;
+  sc->sc_url = strdup(hc->hc_url_orig);
+  username = http_username(hc);
+  sc->sc_username = username ? strdup(username) : NULL;
+  if (hc->hc_proxy_ip) {
+    tcp_get_str_from_ip(hc->hc_proxy_ip, buf, sizeof(buf));
+    sc->sc_proxy = strdup(buf);
+  }
+  TAILQ_INIT(&sc->sc_chunks);
+  st->st_count++;
+
+  fcntl(sc->sc_fd, F_SETFL, fcntl(sc->sc_fd, F_GETFL) | O_NONBLOCK);
+
+  tvh_mutex_lock(&global_lock);
+  tcp_connection_detach(tcp_id, sc, streamer_status, streamer_cancel);
+  tvh_mutex_unlock(&global_lock);
+
+  hc->hc_detached = 1;
+  hc->hc_keep_alive = 0;
+
+  tvh_mutex_lock(&st->st_lock);
+  TAILQ_INSERT_TAIL(&st->st_new, sc, sc_link);
+  tvh_mutex_unlock(&st->st_lock);
+}
+
+/*
+ * Take over the running stream from the HTTP connection thread
+ *
+ * The subscription, profile chain (allocated) and the socket are owned
+ * by the streamer on success. Returns -1 when the stream cannot be
+ * passed (the connection thread continues).
+ */
+int
+streamer_attach(http_connection_t *hc, profile_chain_t *prch,
+                const char *mime, th_subscription_t *s, void *tcp_id,
+                struct streaming_message_queue *batch, int64_t lastpkt)
+{
+  streaming_queue_t *sq = &prch->prch_sq;
+  muxer_t *mux = prch->prch_muxer;
+  streamer_thread_t *st;
+  streamer_output_t *so;
+  int i;
+
+  if (tcp_id == NULL || mux == NULL ||
+      (mux->m_caps & MC_CAP_OUTPUT_QUEUE) == 0)
+    return -1;
+
+  tvh_mutex_lock(&streamer_lock);
+  if (!atomic_get(&streamer_running)) {
+    tvh_mutex_unlock(&streamer_lock);
+    return -1;
+  }
+  st = streamer_threads;
+  for (i = 1; i < streamer_nthreads; i++)
+    if (streamer_threads[i].st_count < st->st_count)
+      st = &streamer_threads[i];
+
+  so = calloc(1, sizeof(*so));
+  so->so_thread = st;
+  so->so_new = 1;
+  so->so_run = 1;
+  so->so_prch = prch;
+  so->so_sub = s;
+  so->so_url = strdup(hc->hc_url_orig);
+  so->so_mime = strdup(mime ?: "application/octet-stream");
+  so->so_lastpkt = lastpkt;
+  so->so_ptimeout = prch->prch_pro ? prch->prch_pro->pro_timeout : 5;
+  TAILQ_INIT(&so->so_batch);
+  TAILQ_CONCAT(&so->so_batch, batch, sm_link);
+  TAILQ_INIT(&so->so_clients);
+  htsbuf_queue_init(&so->so_outq, 0);
+  mux->m_output = &so->so_outq;
+
+  if (config.http_stream_share && mux->m_config.m_type == MC_PASS &&
+      prch->prch_id && prch->prch_pro) {
+    so->so_id = prch->prch_id;
+    so->so_pro = prch->prch_pro;
+    so->so_sflags = s->ths_flags & (SUBSCRIPTION_NODESCR|SUBSCRIPTION_EMM);
+    tvh_mutex_lock(&global_lock);
+    LIST_INSERT_HEAD(&streamer_outputs, so, so_share_link);
+    tvh_mutex_unlock(&global_lock);
+    so->so_shared = 1;
+  }
+
+  streamer_client_create(hc, tcp_id, so, 0);
+
+  tvh_mutex_lock(&sq->sq_mutex);
+  sq->sq_notify = streamer_notify;
+  sq->sq_notify_aux = so;
+  tvh_mutex_unlock(&sq->sq_mutex);
+  streamer_wakeup(so);
+  tvh_mutex_unlock(&streamer_lock);
+
+  tvhdebug(LS_WEBUI, "Streaming %s passed to the streamer thread %d",
+           hc->hc_url_orig, (int)(st - streamer_threads));
+  return 0;
+}
+
+/*
+ * Join the running output for the same channel or service and profile
+ * (global_lock)
+ *
+ * Returns -1 when there is no output to share (the connection thread
+ * continues), 0 when the socket is owned by the streamer and 1 when
+ * the output finished after the reply header was sent.
+ */
+int
+streamer_share(http_connection_t *hc, void *id, profile_t *pro,
+               int sflags, void *tcp_id)
+{
+  streamer_output_t *so;
+  struct timeval tp;
+  char *mime;
+
+  if (!config.http_stream_share || tcp_id == NULL || hc->hc_no_output ||
+      !atomic_get(&streamer_running))
+    return -1;
+
+  /* the list is modified with both locks held */
+  if ((so = streamer_output_find(id, pro, sflags)) == NULL)
+    return -1;
+  mime = tvh_strdupa(so->so_mime);
+  tvh_mutex_unlock(&global_lock);
+
+  tp.tv_sec  = 5;
+  tp.tv_usec = 0;
+  setsockopt(hc->hc_fd, SOL_SOCKET, SO_SNDTIMEO, &tp, sizeof(tp));
+  if (config.dscp >= 0)
+    socket_set_dscp(hc->hc_fd, config.dscp, NULL, 0);
+
+  tvhdebug(LS_WEBUI, "Start streaming %s (shared)", hc->hc_url_orig);
+  http_output_content(hc, mime);
+
+  tvh_mutex_lock(&streamer_lock);
+  so = atomic_get(&streamer_running) ?
+         streamer_output_find(id, pro, sflags) : NULL;
+  if (so == NULL) {
+    tvh_mutex_unlock(&streamer_lock);
+    tvhwarn(LS_WEBUI, "Stop streaming %s, shared output finished",
+            hc->hc_url_orig);
+    tvh_mutex_lock(&global_lock);
+    return 1;
+  }
+  streamer_client_create(hc, tcp_id, so, STREAMER_SYNC_PAT);
+  tvh_write(so->so_thread->st_pipe.wr, "", 1);
+  tvhdebug(LS_WEBUI, "Streaming %s joined the output of %s",
+           hc->hc_url_orig, so->so_url);
+  tvh_mutex_unlock(&streamer_lock);
+  tvh_mutex_lock(&global_lock);
+  return 0;
+}
+
+/*
+ *
+ */
+void
+streamer_init(int nthreads)
+{
+  streamer_thread_t *st;
+  int i;
+
+  if (nthreads <= 0)
+    return;
+  streamer_threads = calloc(nthreads, sizeof(streamer_thread_t));
+  for (i = 0; i < nthreads; i++) {
+    st = &streamer_threads[i];
+    tvh_mutex_init(&st->st_lock, NULL);
+    TAILQ_INIT(&st->st_ready);
+    TAILQ_INIT(&st->st_new);
+    TAILQ_INIT(&st->st_outputs);
+    tvh_pipe(O_NONBLOCK, &st->st_pipe);
+    st->st_poll = tvhpoll_create(STREAMER_EVENTS);
+    tvhpoll_add1(st->st_poll, st->st_pipe.rd, TVHPOLL_IN, &st->st_pipe);
+    tvh_thread_create(&st->st_tid, NULL, streamer_thread, st, "http-stream");
+  }
+  streamer_nthreads = nthreads;
+  atomic_set(&streamer_running, 1);
+  tvhinfo(LS_WEBUI, "Using %d HTTP streaming thread(s)", nthreads);
+}
+
+/*
+ *
+ */
+void
+streamer_done(void)
+{
+  streamer_thread_t *st;
+  int i;
+
+  tvh_mutex_lock(&streamer_lock);
+  atomic_set(&streamer_running, 0);
+  tvh_mutex_unlock(&streamer_lock);
+  for (i = 0; i < streamer_nthreads; i++)
+    tvh_write(streamer_threads[i].st_pipe.wr, "", 1);
+  for (i = 0; i < streamer_nthreads; i++) {
+    st = &streamer_threads[i];
+    pthread_join(st->st_tid, NULL);
+    tvhpoll_destroy(st->st_poll);
+    tvh_pipe_close(&st->st_pipe);
+    tvh_mutex_destroy(&st->st_lock);
+  }
+  free(streamer_threads);
+  streamer_threads = NULL;
+  streamer_nthreads = 0;
+}
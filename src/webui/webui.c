@@ -331,10 +331,13 @@ http_stream_postop ( void *tcp_id )
 
 /**
  * HTTP stream loop
+ *
+ * Returns 1 when the stream was passed to the streamer threads
+ * (the subscription and the profile chain are owned by the streamer).
  */
-static void
+static int
 http_stream_run(http_connection_t *hc, profile_chain_t *prch,
-		const char *name, th_subscription_t *s)
+		const char *name, th_subscription_t *s, void *tcp_id)
 {
   streaming_message_t *sm;
   int run = 1, started = 0;
@@ -344,6 +347,10 @@ http_stream_run(http_connection_t *hc, profile_chain_t *prch,
   struct timeval tp;
   streaming_start_t *ss_copy;
   int64_t lastpkt, mono;
+  struct streaming_message_queue batch;
+  const char *mime;
+
+  TAILQ_INIT(&batch);
 
   if(muxer_open_stream(mux, hc->hc_fd))
     run = 0;
@@ -365,31 +372,32 @@ http_stream_run(http_connection_t *hc, profile_chain_t *prch,
   }
 
   while(!hc->hc_shutdown && run && tvheadend_is_running()) {
-    tvh_mutex_lock(&sq->sq_mutex);
-    sm = TAILQ_FIRST(&sq->sq_queue);
-    if(sm == NULL) {
-      mono = mclk() + sec2mono(1);
-      do {
-        r = tvh_cond_timedwait(&sq->sq_cond, &sq->sq_mutex, mono);
-        if (r == ETIMEDOUT) {
-          /* Check socket status */
-          if (tcp_socket_dead(hc->hc_fd)) {
-            tvhdebug(LS_WEBUI,  "Stop streaming %s, client hung up", hc->hc_url_orig);
-            run = 0;
-          } else if((!started && mclk() - lastpkt > sec2mono(grace)) ||
-                     (started && ptimeout > 0 && mclk() - lastpkt > sec2mono(ptimeout))) {
-            tvhwarn(LS_WEBUI,  "Stop streaming %s, timeout waiting for packets", hc->hc_url_orig);
-            run = 0;
+    if((sm = TAILQ_FIRST(&batch)) == NULL) {
+      tvh_mutex_lock(&sq->sq_mutex);
+      streaming_queue_take(sq, &batch);
+      if((sm = TAILQ_FIRST(&batch)) == NULL) {
+        mono = mclk() + sec2mono(1);
+        do {
+          r = streaming_queue_wait(sq, mono);
+          if (r == ETIMEDOUT) {
+            /* Check socket status */
+            if (tcp_socket_dead(hc->hc_fd)) {
+              tvhdebug(LS_WEBUI,  "Stop streaming %s, client hung up", hc->hc_url_orig);
+              run = 0;
+            } else if((!started && mclk() - lastpkt > sec2mono(grace)) ||
+                       (started && ptimeout > 0 && mclk() - lastpkt > sec2mono(ptimeout))) {
+              tvhwarn(LS_WEBUI,  "Stop streaming %s, timeout waiting for packets", hc->hc_url_orig);
+              run = 0;
+            }
+            break;
           }
-          break;
-        }
-      } while (ERRNO_AGAIN(r));
+        } while (ERRNO_AGAIN(r));
+        tvh_mutex_unlock(&sq->sq_mutex);
+        continue;
+      }
       tvh_mutex_unlock(&sq->sq_mutex);
-      continue;
     }
-
-    streaming_queue_remove(sq, sm);
-    tvh_mutex_unlock(&sq->sq_mutex);
+    TAILQ_REMOVE(&batch, sm, sm_link);
 
     switch(sm->sm_type) {
     case SMT_MPEGTS:
@@ -418,17 +426,19 @@ http_stream_run(http_connection_t *hc, profile_chain_t *prch,
       if(!started) {
         tvhdebug(LS_WEBUI, "%s streaming %s",
                  hc->hc_no_output ? "Probe" : "Start", hc->hc_url_orig);
-        http_output_content(hc, muxer_mime(mux, sm->sm_data));
+        mime = muxer_mime(mux, sm->sm_data);
+        http_output_content(hc, mime);
 
         if (hc->hc_no_output) {
           streaming_msg_free(sm);
+          streaming_queue_clear(&batch);
           mono = mclk() + sec2mono(2);
           while (mclk() < mono) {
             if (tcp_socket_dead(hc->hc_fd))
               break;
             tvh_safe_usleep(50000);
           }
-          return;
+          return 0;
         }
 
         ss_copy = streaming_start_copy((streaming_start_t *)sm->sm_data);
@@ -437,6 +447,14 @@ http_stream_run(http_connection_t *hc, profile_chain_t *prch,
         streaming_start_unref(ss_copy);
 
         started = 1;
+
+        /* continue in the streamer thread */
+        if (run && !mux->m_errors) {
+          streaming_msg_free(sm);
+          if (streamer_attach(hc, prch, mime, s, tcp_id, &batch, lastpkt) == 0)
+            return 1;
+          continue;
+        }
       } else if(muxer_reconfigure(mux, sm->sm_data) < 0) {
         tvhwarn(LS_WEBUI,  "Unable to reconfigure stream %s", hc->hc_url_orig);
       }
@@ -494,8 +512,11 @@ http_stream_run(http_connection_t *hc, profile_chain_t *prch,
     }
   }
 
+  streaming_queue_clear(&batch);
+
   if(started)
     muxer_close(mux);
+  return 0;
 }
 
 /*
@@ -1123,13 +1144,13 @@ http_stream_service(http_connection_t *hc, service_t *service, int weight)
 {
   th_subscription_t *s;
   profile_t *pro;
-  profile_chain_t prch;
+  profile_chain_t *prch;
   muxer_hints_t *hints;
   const char *str;
   size_t qsize;
   const char *name;
   void *tcp_id;
-  int res = HTTP_STATUS_SERVICE;
+  int res = HTTP_STATUS_SERVICE, r;
   int flags, eflags = 0;
 
   if(http_access_verify(hc, ACCESS_ADVANCED_STREAMING))
@@ -1159,13 +1180,21 @@ http_stream_service(http_connection_t *hc, service_t *service, int weight)
   else
     qsize = 1500000;
 
+  /* join the running output */
+  if ((r = streamer_share(hc, service, pro, eflags, tcp_id)) >= 0) {
+    if (r > 0)
+      http_stream_postop(tcp_id);
+    return 0;
+  }
+
   hints = muxer_hints_create(http_arg_get(&hc->hc_args, "User-Agent"));
 
-  profile_chain_init(&prch, pro, service, 1);
-  if (!profile_chain_open(&prch, NULL, hints, 0, qsize)) {
+  prch = malloc(sizeof(*prch));
+  profile_chain_init(prch, pro, service, 1);
+  if (!profile_chain_open(prch, NULL, hints, 0, qsize)) {
 
-    s = subscription_create_from_service(&prch, NULL, weight, "HTTP",
-                                         prch.prch_flags | SUBSCRIPTION_STREAMING |
+    s = subscription_create_from_service(prch, NULL, weight, "HTTP",
+                                         prch->prch_flags | SUBSCRIPTION_STREAMING |
                                            eflags,
                                          hc->hc_peer_ipstr,
 				         http_username(hc),
@@ -1174,14 +1203,17 @@ http_stream_service(http_connection_t *hc, service_t *service, int weight)
     if(s) {
       name = tvh_strdupa(service->s_nicename);
       tvh_mutex_unlock(&global_lock);
-      http_stream_run(hc, &prch, name, s);
+      r = http_stream_run(hc, prch, name, s, tcp_id);
       tvh_mutex_lock(&global_lock);
+      if (r)
+        return 0;
       subscription_unsubscribe(s, UNSUBSCRIBE_FINAL);
       res = 0;
     }
   }
 
-  profile_chain_close(&prch);
+  profile_chain_close(prch);
+  free(prch);
   http_stream_postop(tcp_id);
   return res;
 }
@@ -1307,14 +1339,14 @@ static int
 http_stream_mux(http_connection_t *hc, mpegts_mux_t *mm, int weight)
 {
   th_subscription_t *s;
-  profile_chain_t prch;
+  profile_chain_t *prch;
   size_t qsize;
   const char *name, *str;
   void *tcp_id;
   char *p, *saveptr = NULL;
   mpegts_apids_t pids;
   mpegts_service_t *ms;
-  int res = HTTP_STATUS_SERVICE, i;
+  int res = HTTP_STATUS_SERVICE, i, r;
 
   if(http_access_verify(hc, ACCESS_ADVANCED_STREAMING))
     return http_noaccess_code(hc);
@@ -1351,10 +1383,11 @@ http_stream_mux(http_connection_t *hc, mpegts_mux_t *mm, int weight)
     pids.all = 1;
   }
 
-  if (!profile_chain_raw_open(&prch, mm, qsize, 1)) {
+  prch = malloc(sizeof(*prch));
+  if (!profile_chain_raw_open(prch, mm, qsize, 1)) {
 
-    s = subscription_create_from_mux(&prch, NULL, weight ?: 10, "HTTP",
-                                     prch.prch_flags |
+    s = subscription_create_from_mux(prch, NULL, weight ?: 10, "HTTP",
+                                     prch->prch_flags |
                                      SUBSCRIPTION_STREAMING,
                                      hc->hc_peer_ipstr, http_username(hc),
                                      http_arg_get(&hc->hc_args, "User-Agent"),
@@ -1364,15 +1397,18 @@ http_stream_mux(http_connection_t *hc, mpegts_mux_t *mm, int weight)
       ms = (mpegts_service_t *)s->ths_service;
       if (ms->s_update_pids(ms, &pids) == 0) {
         tvh_mutex_unlock(&global_lock);
-        http_stream_run(hc, &prch, name, s);
+        r = http_stream_run(hc, prch, name, s, tcp_id);
         tvh_mutex_lock(&global_lock);
+        if (r)
+          return 0;
       }
       subscription_unsubscribe(s, UNSUBSCRIBE_FINAL);
       res = 0;
     }
   }
 
-  profile_chain_close(&prch);
+  profile_chain_close(prch);
+  free(prch);
   http_stream_postop(tcp_id);
 
   return res;
@@ -1387,13 +1423,13 @@ http_stream_channel(http_connection_t *hc, channel_t *ch, int weight)
 {
   th_subscription_t *s;
   profile_t *pro;
-  profile_chain_t prch;
+  profile_chain_t *prch;
   muxer_hints_t *hints;
   char *str;
   size_t qsize;
   const char *name;
   void *tcp_id;
-  int res = HTTP_STATUS_SERVICE;
+  int res = HTTP_STATUS_SERVICE, r;
 
   if (http_access_verify_channel(hc, ACCESS_STREAMING, ch))
     return http_noaccess_code(hc);
@@ -1412,14 +1448,22 @@ http_stream_channel(http_connection_t *hc, channel_t *ch, int weight)
   else
     qsize = 1500000;
 
+  /* join the running output */
+  if ((r = streamer_share(hc, ch, pro, 0, tcp_id)) >= 0) {
+    if (r > 0)
+      http_stream_postop(tcp_id);
+    return 0;
+  }
+
   hints = muxer_hints_create(http_arg_get(&hc->hc_args, "User-Agent"));
 
-  profile_chain_init(&prch, pro, ch, 1);
-  if (!profile_chain_open(&prch, NULL, hints, 0, qsize)) {
+  prch = malloc(sizeof(*prch));
+  profile_chain_init(prch, pro, ch, 1);
+  if (!profile_chain_open(prch, NULL, hints, 0, qsize)) {
 
-    s = subscription_create_from_channel(&prch,
+    s = subscription_create_from_channel(prch,
                  NULL, weight, "HTTP",
-                 prch.prch_flags | SUBSCRIPTION_STREAMING,
+                 prch->prch_flags | SUBSCRIPTION_STREAMING,
                  hc->hc_peer_ipstr, http_username(hc),
                  http_arg_get(&hc->hc_args, "User-Agent"),
                  NULL);
@@ -1427,14 +1471,17 @@ http_stream_channel(http_connection_t *hc, channel_t *ch, int weight)
     if(s) {
       name = tvh_strdupa(channel_get_name(ch, channel_blank_name));
       tvh_mutex_unlock(&global_lock);
-      http_stream_run(hc, &prch, name, s);
+      r = http_stream_run(hc, prch, name, s, tcp_id);
       tvh_mutex_lock(&global_lock);
+      if (r)
+        return 0;
       subscription_unsubscribe(s, UNSUBSCRIBE_FINAL);
       res = 0;
     }
   }
 
-  profile_chain_close(&prch);
+  profile_chain_close(prch);
+  free(prch);
   http_stream_postop(tcp_id);
 
   return res;
@@ -2723,10 +2770,12 @@ webui_init(int xspf)
   extjs_start();
   comet_init();
   webui_api_init();
+  streamer_init(config.http_stream_threads);
 }
 
 void
 webui_done(void)
 {
+  streamer_done();
   comet_done();
 }
@@ -71,4 +71,24 @@ void comet_mailbox_add_logmsg(const char *txt, int isdebug, int rewrite);
 
 void comet_flush(void);
 
+/**
+ * Event driven HTTP streaming
+ */
+struct profile;
+struct profile_chain;
+struct th_subscription;
+struct streaming_message_queue;
+
+void streamer_init(int nthreads);
+
+void streamer_done(void);
+
+int streamer_attach(http_connection_t *hc, struct profile_chain *prch,
+                    const char *mime, struct th_subscription *s,
+                    void *tcp_id, struct streaming_message_queue *batch,
+                    int64_t lastpkt);
+
+int streamer_share(http_connection_t *hc, void *id, struct profile *pro,
+                   int sflags, void *tcp_id);
+
 #endif /* WEBUI_H_ */
@@ -57,6 +57,11 @@ uint8_t *tvh_gzip_inflate ( const uint8_t *data, size_t size, size_t orig )
 }
 
 uint8_t *tvh_gzip_deflate ( const uint8_t *data, size_t orig, size_t *size )
+{
+  return tvh_gzip_deflate_speed(data, orig, size, Z_BEST_COMPRESSION);
+}
+
+uint8_t *tvh_gzip_deflate_speed ( const uint8_t *data, size_t orig, size_t *size, int speed )
 {
   int err;
   z_stream zstr;
@@ -67,7 +72,7 @@ uint8_t *tvh_gzip_deflate ( const uint8_t *data, size_t orig, size_t *size )
 
   /* Setup zlib */
   memset(&zstr, 0, sizeof(zstr));
-  err = deflateInit2(&zstr, Z_BEST_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16 /* gzip */, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+  err = deflateInit2(&zstr, speed, Z_DEFLATED, MAX_WBITS + 16 /* gzip */, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
   zstr.avail_in  = orig;
   zstr.next_in   = (z_const uint8_t *)data;
   zstr.avail_out = orig;
@@ -0,0 +1,210 @@
+/*
+ *  AES128-ECB descrambler test and benchmark
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Builds src/descrambler/algo/libaes128dec.c into the test and compares
+ * aes128_decrypt_packets() with the AES-NI path and with the OpenSSL
+ * (software) path. The keys are random, they are changed every few
+ * chunks. The packets are random too: mixed even/odd parity, clear
+ * packets and adaptation fields of all lengths. The chunks have random
+ * packet counts. Both paths are also checked against the FIPS-197
+ * AES-128 test vector.
+ *
+ *   cc -O2 -Ibuild.linux -o aestest support/aestest.c -lcrypto
+ *   ./aestest [-n packets] [-c chunk] [-k chunks] [-s seed]
+ *
+ * -n  count of packets (default 200000)
+ * -c  max. packets in one chunk (default 256)
+ * -k  chunks between the key changes (default 16)
+ * -s  random seed (default time)
+ *
+ * The exit code is 1 when the outputs differ.
+ */
+
+#include "../src/descrambler/algo/libaes128dec.c"
+
+#include <inttypes.h>
+#include <unistd.h>
+#include <time.h>
+
+static uint64_t rnd_state;
+
+static uint32_t rnd(void)
+{
+  rnd_state = rnd_state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return rnd_state >> 33;
+}
+
+static void rnd_fill(uint8_t *p, size_t len)
+{
+  while (len--)
+    *p++ = rnd();
+}
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void make_packet(uint8_t *p)
+{
+  uint32_t r = rnd();
+
+  rnd_fill(p, 188);
+  p[0] = 0x47;
+  p[3] = (p[3] & 0x0f) | 0x10;
+  if ((r & 7) == 0)           /* clear */
+    return;
+  p[3] |= (r & 8) ? 0xc0 : 0x80;
+  if ((r & 0x30) == 0) {      /* adaptation field, all lengths */
+    p[3] |= 0x20;
+    p[4] = (r >> 8) % 184;
+  }
+}
+
+static int decrypt(void *keys, int ni, uint8_t *tsb, int len)
+{
+#if AES128_NI
+  aes128_ni = ni;
+#else
+  if (ni)
+    return -1;
+#endif
+  aes128_decrypt_packets(keys, tsb, len);
+  return 0;
+}
+
+/* FIPS-197 appendix C.1 */
+static int test_vector(void *keys, int ni)
+{
+  static const uint8_t key[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+  };
+  static const uint8_t plain[16] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+  };
+  static const uint8_t cipher[16] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+  };
+  uint8_t pkt[188];
+  int i, r = 0;
+
+  aes128_set_control_words(keys, plain, key);
+  memset(pkt, 0, sizeof(pkt));
+  pkt[0] = 0x47;
+  pkt[3] = 0xd0;              /* odd key */
+  for (i = 4; i + 16 <= 188; i += 16)
+    memcpy(pkt + i, cipher, 16);
+  if (decrypt(keys, ni, pkt, 188))
+    return 0;
+  for (i = 4; i + 16 <= 188; i += 16)
+    if (memcmp(pkt + i, plain, 16))
+      r = 1;
+  if (pkt[3] != 0x10 || pkt[184] || pkt[187])
+    r = 1;
+  printf("FIPS-197 vector %-8s %s\n", ni ? "AES-NI" : "OpenSSL", r ? "MISMATCH" : "ok");
+  return r;
+}
+
+int main(int argc, char **argv)
+{
+  int packets = 200000, chunk = 256, kchunks = 16, c, i, n, len;
+  int mismatch = 0, ni;
+  uint64_t seed = time(NULL), errors = 0;
+  uint8_t *src, *a, *b, ev[16], od[16];
+  double t_sw = 0, t_ni = 0, t;
+  void *keys;
+
+  while ((c = getopt(argc, argv, "n:c:k:s:")) != -1) {
+    switch (c) {
+    case 'n': packets = atoi(optarg); break;
+    case 'c': chunk = atoi(optarg); break;
+    case 'k': kchunks = atoi(optarg); break;
+    case 's': seed = strtoull(optarg, NULL, 0); break;
+    default:
+      fprintf(stderr, "usage: %s [-n packets] [-c chunk] [-k chunks] [-s seed]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (packets < 1 || chunk < 1 || kchunks < 1)
+    return 2;
+  rnd_state = seed;
+
+  keys = aes128_get_priv_struct();
+#if AES128_NI
+  ni = aes128_ni;
+#else
+  ni = 0;
+#endif
+  printf("seed %" PRIu64 ", AES-NI %s\n", seed, ni ? "available" : "not available");
+
+  mismatch |= test_vector(keys, 0);
+  if (ni)
+    mismatch |= test_vector(keys, 1);
+
+  src = malloc((size_t)chunk * 188);
+  a = malloc((size_t)chunk * 188);
+  b = malloc((size_t)chunk * 188);
+
+  for (i = n = 0; n < packets; i++) {
+    if (i % kchunks == 0) {
+      rnd_fill(ev, sizeof(ev));
+      rnd_fill(od, sizeof(od));
+      aes128_set_control_words(keys, ev, od);
+    }
+    len = 1 + rnd() % chunk;
+    if (len > packets - n)
+      len = packets - n;
+    for (c = 0; c < len; c++)
+      make_packet(src + c * 188);
+    len *= 188;
+    memcpy(a, src, len);
+    t = now();
+    decrypt(keys, 0, a, len);
+    t_sw += now() - t;
+    if (ni) {
+      memcpy(b, src, len);
+      t = now();
+      decrypt(keys, 1, b, len);
+      t_ni += now() - t;
+      for (c = 0; c < len; c += 188)
+        if (memcmp(a + c, b + c, 188)) {
+          if (errors++ < 10)
+            printf("packet %d (hdr %02x %02x) MISMATCH\n",
+                   n + c / 188, src[c + 3], src[c + 4]);
+        }
+    }
+    n += len / 188;
+  }
+
+  printf("%-8s %8.1f MB/s\n", "OpenSSL", packets * 188.0 / t_sw / 1e6);
+  if (ni) {
+    printf("%-8s %8.1f MB/s (x%.1f)\n", "AES-NI", packets * 188.0 / t_ni / 1e6, t_sw / t_ni);
+    printf("%d packets, %d chunks, %" PRIu64 " different%s\n",
+           packets, i, errors, errors ? "  MISMATCH" : "");
+  }
+  aes128_free_priv_struct(keys);
+  free(src);
+  free(a);
+  free(b);
+  return mismatch || errors ? 1 : 0;
+}
@@ -0,0 +1,276 @@
+/*
+ *  MPEG-TS PID lookup benchmark
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures the PID lookup done per packet run in mpegts_input_process().
+ * src/input/mpegts/mpegts_mux_pid.c is built into the benchmark, the
+ * PIDs are opened with mpegts_mux_find_pid(mm, pid, 1) on a real
+ * mpegts_mux_t:
+ *
+ *   tree   mpegts_mux_find_pid_() without mm_pid_table, RB_FIND over
+ *          mm_pids (the lookup before the PID table, the old one-entry
+ *          mm_last_pid cache in front of it is not included)
+ *   table  mpegts_mux_find_pid(), the direct-indexed mm_pid_table
+ *
+ * The synthetic mux carries -m services (video, two audios, subtitles,
+ * PMT) plus the PSI/SI tables and NULL padding, interleaved by bitrate
+ * like a real DVB mux. Only the PIDs of -s services and the tables are
+ * opened, the rest of the packets miss the lookup. With -f the PID
+ * sequence of a TS file is used and all its PIDs are opened. Both
+ * lookups must return the same PIDs, otherwise MISMATCH is printed.
+ *
+ *   make
+ *   cc -O2 -fms-extensions -Ibuild.linux -Isrc -o pidbench support/pidbench.c
+ *   ./pidbench [-m services] [-s services] [-n packets] [-f file.ts]
+ *
+ * -m  services in the mux (default 8)
+ * -s  subscribed services, 0 = all (default 1)
+ * -n  count of packets to look up (default 50000000)
+ * -f  take the PID sequence from a TS file
+ */
+
+#include "../src/input/mpegts/mpegts_mux_pid.c"
+
+#include <inttypes.h>
+#include <unistd.h>
+
+#define PID_NULL 0x1FFF
+
+typedef struct run {
+  uint16_t pid;
+  uint16_t count;
+} run_t;
+
+static int services = 8;
+static int subscribed = 1;
+static int64_t packets = 50000000;
+static run_t *runs;
+static int nruns;
+static int64_t run_packets;
+
+static int64_t now_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+/* **************************************************************************
+ * Mux
+ * *************************************************************************/
+
+static void mux_open_pid(mpegts_mux_t *mm, int pid)
+{
+  mpegts_mux_find_pid(mm, pid, 1);
+}
+
+/* like mpegts_mux_delete() */
+static void mux_free(mpegts_mux_t *mm)
+{
+  mpegts_pid_t *mp;
+
+  while ((mp = RB_FIRST(&mm->mm_pids)))
+    mpegts_mux_remove_pid(mm, mp);
+  free(mm->mm_pid_table);
+  mm->mm_pid_table = NULL;
+}
+
+/* the tree only, mm_pid_table is hidden by the caller */
+static inline mpegts_pid_t *find_pid_tree(mpegts_mux_t *mm, int pid)
+{
+  return mpegts_mux_find_pid_(mm, pid, 0);
+}
+
+static inline mpegts_pid_t *find_pid_table(mpegts_mux_t *mm, int pid)
+{
+  return mpegts_mux_find_pid(mm, pid, 0);
+}
+
+/* **************************************************************************
+ * Packet sequence
+ * *************************************************************************/
+
+static void add_packet(int pid)
+{
+  static int size;
+
+  if (nruns > 0 && runs[nruns - 1].pid == pid && runs[nruns - 1].count < 0xffff) {
+    runs[nruns - 1].count++;
+  } else {
+    if (nruns == size) {
+      size = size ? size * 2 : 4096;
+      runs = realloc(runs, size * sizeof(*runs));
+    }
+    runs[nruns].pid = pid;
+    runs[nruns++].count = 1;
+  }
+  run_packets++;
+}
+
+/* service i: PMT 0x100+i, video 0x200+16*i, audio +1 +2, subtitles +3 */
+static const struct {
+  int offset;
+  int weight;       /* packets per 1000 in one service */
+} service_pids[] = {
+  { 0, 900 }, { 1, 55 }, { 2, 35 }, { 3, 8 }, { -1, 2 }
+};
+
+static const struct {
+  int pid;
+  int weight;       /* packets per 10000 in the mux */
+} table_pids[] = {
+  { 0x00, 3 }, { 0x10, 2 }, { 0x11, 2 }, { 0x12, 40 }, { 0x14, 1 }
+};
+
+static void synth_sequence(mpegts_mux_t *mm)
+{
+  int i, j, k, total = 0, pid, w, *pids, *weights, count = 0;
+
+  pids = calloc(services * 5 + 6, sizeof(int));
+  weights = calloc(services * 5 + 6, sizeof(int));
+  for (i = 0; i < services; i++)
+    for (j = 0; j < 5; j++) {
+      pid = service_pids[j].offset < 0 ? 0x100 + i : 0x200 + 16 * i + service_pids[j].offset;
+      pids[count] = pid;
+      weights[count++] = service_pids[j].weight * 85 / 10;
+      if (subscribed == 0 || i < subscribed)
+        mux_open_pid(mm, pid);
+    }
+  for (j = 0; j < 5; j++) {
+    pids[count] = table_pids[j].pid;
+    weights[count++] = table_pids[j].weight;
+    mux_open_pid(mm, table_pids[j].pid);
+  }
+  pids[count] = PID_NULL;
+  weights[count++] = 300;
+  for (i = 0; i < count; i++)
+    total += weights[i];
+
+  /* one second of a 38 Mbit/s mux, repeated by the benchmark */
+  srand(1);
+  for (k = 0; k < 25000; k++) {
+    w = rand() % total;
+    for (i = 0; w >= weights[i]; i++)
+      w -= weights[i];
+    add_packet(pids[i]);
+  }
+  free(pids);
+  free(weights);
+}
+
+static int file_sequence(mpegts_mux_t *mm, const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  uint8_t pkt[188];
+  int pid;
+
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+  while (fread(pkt, sizeof(pkt), 1, f) == 1 && run_packets < packets) {
+    if (pkt[0] != 0x47)
+      continue;
+    pid = ((pkt[1] & 0x1f) << 8) | pkt[2];
+    if (pid != PID_NULL)
+      mux_open_pid(mm, pid);
+    add_packet(pid);
+  }
+  fclose(f);
+  return run_packets ? 0 : -1;
+}
+
+/* **************************************************************************
+ * Main
+ * *************************************************************************/
+
+/* the per-run work in mpegts_input_process(): lookup and CC update */
+#define LOOKUP_LOOP(find) \
+  for (n = 0; n < packets; ) \
+    for (i = 0; i < nruns && n < packets; n += runs[i++].count) { \
+      if (runs[i].pid == PID_NULL) continue; \
+      if ((mp = find(mm, runs[i].pid))) { \
+        mp->mp_cc = (mp->mp_cc + runs[i].count) & 0x0f; \
+        found += runs[i].count; \
+      } \
+    }
+
+int main(int argc, char **argv)
+{
+  const char *file = NULL;
+  mpegts_mux_t *mm;
+  mpegts_pid_t *mp, **table;
+  int64_t t0, t_old, t_new, n, found, found_old, mismatch = 0;
+  int c, i, pid;
+
+  while ((c = getopt(argc, argv, "m:s:n:f:")) != -1) {
+    switch (c) {
+    case 'm': services = atoi(optarg); break;
+    case 's': subscribed = atoi(optarg); break;
+    case 'n': packets = atoll(optarg); break;
+    case 'f': file = optarg; break;
+    default:
+      fprintf(stderr, "usage: %s [-m services] [-s services] [-n packets] [-f file.ts]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (services < 1 || services > 100 || packets < 1)
+    return 1;
+
+  mm = calloc(1, sizeof(*mm));
+  if (file ? file_sequence(mm, file) : (synth_sequence(mm), 0))
+    return 1;
+  table = mm->mm_pid_table;
+
+  /* both lookups must find the same PIDs */
+  for (pid = 0; pid < MPEGTS_PID_TABLE_SIZE; pid++) {
+    mm->mm_pid_table = NULL;
+    mp = find_pid_tree(mm, pid);
+    mm->mm_pid_table = table;
+    if (mp != find_pid_table(mm, pid)) {
+      printf("pid %04X MISMATCH\n", pid);
+      mismatch++;
+    }
+  }
+
+  printf("%d PIDs opened, %d runs in %"PRId64" packets (%.2f packets/run)\n",
+         mm->mm_pids.entries, nruns, run_packets, (double)run_packets / nruns);
+
+  found = 0;
+  mm->mm_pid_table = NULL;
+  t0 = now_us();
+  LOOKUP_LOOP(find_pid_tree);
+  t_old = now_us() - t0;
+  mm->mm_pid_table = table;
+  found_old = found;
+
+  found = 0;
+  t0 = now_us();
+  LOOKUP_LOOP(find_pid_table);
+  t_new = now_us() - t0;
+
+  printf("%-8s %8.2f ns/packet\n", "tree", t_old * 1000.0 / packets);
+  printf("%-8s %8.2f ns/packet (x%.1f)\n", "table", t_new * 1000.0 / packets,
+         (double)t_old / t_new);
+  printf("%"PRId64" packets found%s\n", found,
+         found != found_old || mismatch ? "  MISMATCH" : "");
+
+  mux_free(mm);
+  free(mm);
+  free(runs);
+  return found != found_old || mismatch ? 1 : 0;
+}
@@ -0,0 +1,355 @@
+/*
+ *  Streaming queue benchmark
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares the streaming_queue consumer loops on the real queue of
+ * src/streaming.c:
+ *
+ *   single  one lock per message, streaming_queue_remove() +
+ *           streaming_queue_wait() (src/dvr/dvr_rec.c)
+ *   batch   the consumer moves all queued messages to a local list
+ *           with streaming_queue_take() and processes them without
+ *           the lock (src/webui/webui.c)
+ *
+ * src/streaming.c, src/packet.c, src/slab.c and src/tvh_thread.c are
+ * built into the benchmark, the rest of the server is stubbed. The input
+ * threads (-p) deliver SMT_MPEGTS messages of one mux to all the queues
+ * (-q) with streaming_target_deliver(), in bursts like
+ * mpegts_input_process() does for an input chunk. One consumer thread
+ * per queue copies each payload to a small output buffer, like the
+ * muxer writes. The wakeups are counted through sq_notify. The counts
+ * of the delivered and processed messages and bytes must be equal and
+ * sq_size must return to zero, otherwise MISMATCH is printed.
+ *
+ *   make
+ *   cc -O2 -pthread -fms-extensions -Ibuild.linux -Isrc -o sqbench support/sqbench.c
+ *   ./sqbench [-p producers] [-q queues] [-n messages] [-b burst] [-s size] [-r runs]
+ *
+ * -p  producer threads (default 2)
+ * -q  queues per producer, one consumer thread each (default 8)
+ * -n  messages per producer (default 200000)
+ * -b  messages per input burst (default 20)
+ * -s  message payload size (default 1316)
+ * -r  runs of each variant (default 3)
+ */
+
+#define TVH_THREAD_C 1
+#include "../src/tvh_thread.c"
+#include "../src/slab.c"
+#include "../src/packet.c"
+#include "../src/streaming.c"
+
+#include <inttypes.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+/* **************************************************************************
+ * Stubs
+ * *************************************************************************/
+
+tvh_mutex_t global_lock;
+int tvhlog_level = LOG_ERR;
+struct memoryinfo_list memoryinfo_entries;
+const idclass_t memoryinfo_class;
+const char *tvh_doc_memoryinfo_class[] = { NULL };
+
+void doexit(int x) { abort(); }
+void tvh_safe_usleep(int64_t us) { usleep(us); }
+int64_t tvh_usleep(int64_t us) { return usleep(us); }
+int tvh_write(int fd, const void *buf, size_t len) { return write(fd, buf, len) != len; }
+void tvhlogv(const char *file, int line, int severity, int subsys,
+             const char *fmt, va_list *args) { }
+void _tvhlog(const char *file, int line, int severity, int subsys,
+             const char *fmt, ...) { }
+void tvhdbg(int subsys, const char *fmt, ...) { }
+int hts_settings_open_file(int flags, const char *pathfmt, ...) { return -1; }
+void htsbuf_queue_init(htsbuf_queue_t *hq, unsigned int maxsize) { }
+void htsbuf_qprintf(htsbuf_queue_t *hq, const char *fmt, ...) { }
+char *htsbuf_to_string(htsbuf_queue_t *hq) { return NULL; }
+void htsmsg_add_str(htsmsg_t *msg, const char *name, const char *str) { }
+int idnode_insert(idnode_t *in, const char *uuid, const idclass_t *idc, int flags) { return 0; }
+void idnode_unlink(idnode_t *in) { }
+void service_restart_streams(service_t *t) { }
+void service_source_info_copy(source_info_t *dst, const source_info_t *src) { }
+void service_source_info_free(source_info_t *si) { }
+const char *tvh_gettext_lang(const char *lang, const char *s) { return s; }
+
+/* **************************************************************************
+ * Queues
+ * *************************************************************************/
+
+typedef struct queue {
+  streaming_queue_t sq;
+  /* consumer statistics */
+  uint64_t msgs;
+  uint64_t bytes;
+  uint64_t locks;
+  uint64_t wakeups;
+  /* producer statistics, protected by sq_mutex */
+  uint64_t signals;
+  pthread_t tid;
+} queue_t;
+
+typedef struct producer {
+  queue_t *queues;
+  int64_t time;
+  pthread_t tid;
+} producer_t;
+
+static int producers = 2;
+static int queues = 8;
+static int64_t messages = 200000;
+static int burst = 20;
+static size_t size = 1316;
+static int repeat = 3;
+static int batch;
+
+static int64_t now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/* called by streaming_queue_deliver() for a waiting consumer */
+static void
+notify(void *aux)
+{
+  queue_t *q = aux;
+
+  q->signals++;
+  tvh_cond_signal(&q->sq.sq_cond, 0);
+}
+
+/* returns 1 on SMT_EXIT */
+static int
+process(queue_t *q, streaming_message_t *sm)
+{
+  static __thread uint8_t out[64 * 1024];
+  static __thread size_t pos;
+  pktbuf_t *pb;
+  int r = 0;
+
+  if (sm->sm_type == SMT_MPEGTS) {
+    pb = sm->sm_data;
+    if (pos + pktbuf_len(pb) > sizeof(out))
+      pos = 0;
+    memcpy(out + pos, pktbuf_ptr(pb), pktbuf_len(pb));
+    pos += pktbuf_len(pb);
+    q->msgs++;
+    q->bytes += pktbuf_len(pb);
+  } else if (sm->sm_type == SMT_EXIT) {
+    r = 1;
+  }
+  streaming_msg_free(sm);
+  return r;
+}
+
+/* src/dvr/dvr_rec.c - one lock per message */
+static void
+consume_single(queue_t *q)
+{
+  streaming_queue_t *sq = &q->sq;
+  streaming_message_t *sm;
+
+  for (;;) {
+    tvh_mutex_lock(&sq->sq_mutex);
+    q->locks++;
+    while ((sm = TAILQ_FIRST(&sq->sq_queue)) == NULL) {
+      streaming_queue_wait(sq, 0);
+      q->wakeups++;
+    }
+    streaming_queue_remove(sq, sm);
+    tvh_mutex_unlock(&sq->sq_mutex);
+    if (process(q, sm))
+      break;
+  }
+}
+
+/* src/webui/webui.c - streaming_queue_take() + streaming_queue_wait() */
+static void
+consume_batch(queue_t *q)
+{
+  streaming_queue_t *sq = &q->sq;
+  struct streaming_message_queue list;
+  streaming_message_t *sm;
+  int run = 1;
+
+  TAILQ_INIT(&list);
+  while (run) {
+    tvh_mutex_lock(&sq->sq_mutex);
+    q->locks++;
+    for (;;) {
+      streaming_queue_take(sq, &list);
+      if (TAILQ_FIRST(&list))
+        break;
+      streaming_queue_wait(sq, 0);
+      q->wakeups++;
+    }
+    tvh_mutex_unlock(&sq->sq_mutex);
+    while ((sm = TAILQ_FIRST(&list)) != NULL) {
+      TAILQ_REMOVE(&list, sm, sm_link);
+      if (process(q, sm))
+        run = 0;
+    }
+  }
+  /* release the bytes of the last batch */
+  tvh_mutex_lock(&sq->sq_mutex);
+  streaming_queue_take(sq, &list);
+  tvh_mutex_unlock(&sq->sq_mutex);
+}
+
+static void *
+consumer_thread(void *aux)
+{
+  queue_t *q = aux;
+
+  if (batch)
+    consume_batch(q);
+  else
+    consume_single(q);
+  return NULL;
+}
+
+static void *
+producer_thread(void *aux)
+{
+  producer_t *p = aux;
+  streaming_message_t *sm;
+  pktbuf_t *pb;
+  int64_t n, t0;
+  int i, j;
+
+  for (n = 0; n < messages; n += burst) {
+    t0 = now_ns();
+    for (j = 0; j < burst && n + j < messages; j++)
+      for (i = 0; i < queues; i++) {
+        pb = pktbuf_alloc(NULL, size);
+        memset(pktbuf_ptr(pb), j, 16);
+        sm = streaming_msg_create_data(SMT_MPEGTS, pb);
+        streaming_target_deliver(&p->queues[i].sq.sq_st, sm);
+      }
+    p->time += now_ns() - t0;
+    /* wait for the next input chunk */
+    sched_yield();
+  }
+  return NULL;
+}
+
+/* **************************************************************************
+ * Main
+ * *************************************************************************/
+
+static int
+run(const char *name)
+{
+  producer_t *p = calloc(producers, sizeof(*p));
+  uint64_t msgs = 0, bytes = 0, locks = 0, wakeups = 0, signals = 0;
+  int64_t t0, t, ptime = 0;
+  size_t left = 0;
+  struct rusage ru0, ru1;
+  int i, j, mismatch;
+  queue_t *q;
+
+  for (i = 0; i < producers; i++) {
+    p[i].queues = calloc(queues, sizeof(queue_t));
+    for (j = 0; j < queues; j++) {
+      q = &p[i].queues[j];
+      streaming_queue_init(&q->sq, 0, 0);
+      q->sq.sq_notify = notify;
+      q->sq.sq_notify_aux = q;
+      pthread_create(&q->tid, NULL, consumer_thread, q);
+    }
+  }
+
+  getrusage(RUSAGE_SELF, &ru0);
+  t0 = now_ns();
+  for (i = 0; i < producers; i++)
+    pthread_create(&p[i].tid, NULL, producer_thread, &p[i]);
+  for (i = 0; i < producers; i++)
+    pthread_join(p[i].tid, NULL);
+  for (i = 0; i < producers; i++)
+    for (j = 0; j < queues; j++) {
+      q = &p[i].queues[j];
+      streaming_target_deliver(&q->sq.sq_st, streaming_msg_create(SMT_EXIT));
+    }
+  for (i = 0; i < producers; i++) {
+    for (j = 0; j < queues; j++) {
+      q = &p[i].queues[j];
+      pthread_join(q->tid, NULL);
+      msgs += q->msgs;
+      bytes += q->bytes;
+      locks += q->locks;
+      wakeups += q->wakeups;
+      signals += q->signals;
+      left += q->sq.sq_size;
+      streaming_queue_deinit(&q->sq);
+    }
+    ptime += p[i].time;
+    free(p[i].queues);
+  }
+  t = now_ns() - t0;
+  getrusage(RUSAGE_SELF, &ru1);
+
+  mismatch = msgs != (uint64_t)producers * queues * messages ||
+             bytes != msgs * size || left != 0;
+  printf("%-7s %8.0f kmsg/s  deliver %6.1f ns  locks/msg %.3f  signals/msg %.3f"
+         "  wakeups %"PRIu64"  csw %ld%s\n", name,
+         msgs / (t / 1e6), (double)ptime / msgs, (double)locks / msgs,
+         (double)signals / msgs, wakeups,
+         (ru1.ru_nvcsw - ru0.ru_nvcsw) + (ru1.ru_nivcsw - ru0.ru_nivcsw),
+         mismatch ? "  MISMATCH" : "");
+  free(p);
+  return mismatch;
+}
+
+int main(int argc, char **argv)
+{
+  int c, i, r = 0;
+
+  while ((c = getopt(argc, argv, "p:q:n:b:s:r:")) != -1) {
+    switch (c) {
+    case 'p': producers = atoi(optarg); break;
+    case 'q': queues = atoi(optarg); break;
+    case 'n': messages = atoll(optarg); break;
+    case 'b': burst = atoi(optarg); break;
+    case 's': size = atoi(optarg); break;
+    case 'r': repeat = atoi(optarg); break;
+    default:
+      fprintf(stderr, "usage: %s [-p producers] [-q queues] [-n messages] [-b burst] [-s size] [-r runs]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (producers < 1 || queues < 1 || messages < 1 || burst < 1 || size < 16 || repeat < 1)
+    return 1;
+
+  tvh_thread_init(0);
+  slab_module_init(1);
+  streaming_init();
+  pkt_init();
+
+  printf("%d producers x %d queues, %"PRId64" messages of %zd bytes, bursts of %d, %ld CPUs\n",
+         producers, queues, messages, size, burst, sysconf(_SC_NPROCESSORS_ONLN));
+  /* interleaved, the scheduler noise is large */
+  for (i = 0; i < repeat; i++) {
+    batch = 0;
+    r |= run("single");
+    batch = 1;
+    r |= run("batch");
+  }
+  return r;
+}
@@ -0,0 +1,459 @@
+/*
+ *  Timeshift segment benchmark
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures the timeshift buffer of src/timeshift on a real
+ * timeshift_buffer_t. src/timeshift/timeshift_{buffer,filemgr,writer,
+ * reader}.c and the streaming/packet code are built into the benchmark,
+ * the rest of the server is stubbed:
+ *
+ *   write  the packets are stored by the writer (_store_msg(): segment
+ *          from timeshift_filemgr_get(), timeshift_write_packet() and
+ *          the i-frame index)
+ *   read   all records are read back by the reader (_read_record())
+ *          and freed like the reader does after the delivery
+ *   seek   random seeks by time with timeshift_index_find_time()
+ *
+ * The read payload bytes must match the written ones, otherwise
+ * MISMATCH is printed.
+ *
+ * With -i only the index is built (timeshift_index_add() for the
+ * segments from timeshift_filemgr_file_init()) and the seek latency is
+ * measured against the buffer length:
+ *
+ *   segment  walk of tsb->files + binary search in the segment index
+ *            (the reader lookup before the buffer index)
+ *   buffer   timeshift_index_find_time()
+ *   boff     timeshift_index_find_boff()
+ *
+ * The segment walk and timeshift_index_find_time() must return the
+ * same frames, otherwise MISMATCH is printed.
+ *
+ *   make
+ *   cc -O2 -pthread -fms-extensions -Ibuild.linux -Isrc -o tsbench support/tsbench.c
+ *   ./tsbench [-d dir] [-r] [-t seconds] [-b kbit/s] [-g gop/min] [-s seeks]
+ *   ./tsbench -i [-g gop/min] [-s seeks]
+ *
+ * -i  seek latency against the buffer length (index only, no data)
+ * -d  directory for the segment files (default /tmp)
+ * -r  RAM segments
+ * -t  buffer length in seconds (default 1800)
+ * -b  stream bitrate (default 8000 kbit/s)
+ * -g  i-frames per minute (default 50)
+ * -s  count of random seeks (default 100000)
+ */
+
+#define TVH_THREAD_C 1
+#include "../src/tvh_thread.c"
+#include "../src/slab.c"
+#include "../src/packet.c"
+#include "../src/streaming.c"
+#include "../src/timeshift/timeshift_buffer.c"
+#include "../src/timeshift/timeshift_filemgr.c"
+#include "../src/timeshift/timeshift_writer.c"
+#include "../src/timeshift/timeshift_reader.c"
+
+#include <inttypes.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* **************************************************************************
+ * Stubs
+ * *************************************************************************/
+
+tvh_mutex_t global_lock;
+int tvhlog_level = LOG_ERR;
+struct memoryinfo_list memoryinfo_entries;
+const idclass_t memoryinfo_class;
+const char *tvh_doc_memoryinfo_class[] = { NULL };
+struct timeshift_conf timeshift_conf;
+memoryinfo_t timeshift_memoryinfo;
+memoryinfo_t timeshift_memoryinfo_ram;
+
+void doexit(int x) { abort(); }
+void tvh_safe_usleep(int64_t us) { usleep(us); }
+int64_t tvh_usleep(int64_t us) { return usleep(us); }
+int tvh_write(int fd, const void *buf, size_t len) { return write(fd, buf, len) != len; }
+int tvh_open(const char *pathname, int flags, mode_t mode) { return open(pathname, flags | O_CLOEXEC, mode); }
+void tvhlogv(const char *file, int line, int severity, int subsys,
+             const char *fmt, va_list *args) { }
+void _tvhlog(const char *file, int line, int severity, int subsys,
+             const char *fmt, ...) { }
+void tvhdbg(int subsys, const char *fmt, ...) { }
+int hts_settings_open_file(int flags, const char *pathfmt, ...) { return -1; }
+int hts_settings_buildpath(char *dst, size_t dstsize, const char *pathfmt, ...) { return -1; }
+void htsbuf_queue_init(htsbuf_queue_t *hq, unsigned int maxsize) { }
+void htsbuf_qprintf(htsbuf_queue_t *hq, const char *fmt, ...) { }
+char *htsbuf_to_string(htsbuf_queue_t *hq) { return NULL; }
+void htsmsg_add_str(htsmsg_t *msg, const char *name, const char *str) { }
+int idnode_insert(idnode_t *in, const char *uuid, const idclass_t *idc, int flags) { return 0; }
+void idnode_unlink(idnode_t *in) { }
+void service_restart_streams(service_t *t) { }
+void service_source_info_copy(source_info_t *dst, const source_info_t *src) { }
+void service_source_info_free(source_info_t *si) { }
+const char *tvh_gettext_lang(const char *lang, const char *s) { return s; }
+int rmtree(const char *path) { return 0; }
+void timeshift_packet_log0(const char *prefix, timeshift_t *ts, streaming_message_t *sm) { }
+tvhpoll_t *tvhpoll_create(size_t num) { return NULL; }
+void tvhpoll_destroy(tvhpoll_t *tp) { }
+int tvhpoll_add1(tvhpoll_t *tp, int fd, uint32_t events, void *ptr) { return -1; }
+int tvhpoll_wait(tvhpoll_t *tp, tvhpoll_event_t *evs, size_t num, int ms) { return -1; }
+
+int makedirs(int subsys, const char *path, int mode, int mstrict, gid_t gid, uid_t uid)
+{
+  char buf[PATH_MAX], *p;
+
+  strlcpy(buf, path, sizeof(buf));
+  for (p = buf + 1; *p; p++)
+    if (*p == '/') {
+      *p = '\0';
+      if (mkdir(buf, mode) && errno != EEXIST)
+        return -1;
+      *p = '/';
+    }
+  return mkdir(buf, mode) && errno != EEXIST ? -1 : 0;
+}
+
+/* **************************************************************************
+ * Stream
+ * *************************************************************************/
+
+#define AUDIO_PKT      384
+#define VIDEO_IDX      1
+#define AUDIO_IDX      2
+
+static char *dir = "/tmp";
+static int ram;
+static int64_t total_time = 1800, bitrate = 8000, gops = 50, seeks = 100000;
+static uint8_t payload[1316 * 64];
+static volatile uint8_t sink;
+
+static int64_t now_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+static int64_t rnd_time(void)
+{
+  return (((int64_t)rand() << 31) | rand()) % (total_time * 1000000LL);
+}
+
+/*
+ * Generated stream: one video frame per 40ms (+ 2 audio packets),
+ * i-frame every 60/gops seconds, the bitrate divided among the frames
+ */
+typedef struct gen {
+  int64_t time, frame, iframe_period;
+  size_t vsize;
+  int i;
+} gen_t;
+
+static void gen_init(gen_t *g)
+{
+  memset(g, 0, sizeof(*g));
+  g->iframe_period = 1500 / gops; /* frames */
+  if (g->iframe_period < 1) g->iframe_period = 1;
+  g->vsize = bitrate * 1000 / 8 / 25 - 2 * AUDIO_PKT;
+  if (g->vsize > sizeof(payload)) g->vsize = sizeof(payload);
+}
+
+static streaming_message_t *gen_next(gen_t *g)
+{
+  streaming_message_t *sm;
+  th_pkt_t *pkt;
+  int64_t pts;
+  size_t len;
+  int iframe = 0;
+
+  if (g->time >= total_time * 1000000LL)
+    return NULL;
+  pts = g->time * 9 / 100;
+  if (g->i < 2) {
+    pkt = pkt_alloc(SCT_MPEG2AUDIO, payload, AUDIO_PKT, pts, pts, PTS_UNSET);
+    pkt->pkt_componentindex = AUDIO_IDX;
+  } else {
+    iframe = (g->frame % g->iframe_period) == 0;
+    len = iframe ? g->vsize * 3 : g->vsize;
+    if (len > sizeof(payload)) len = sizeof(payload);
+    pkt = pkt_alloc(SCT_H264, payload, len, pts, pts, pts);
+    pkt->pkt_componentindex = VIDEO_IDX;
+    pkt->v.pkt_frametype = iframe ? PKT_I_FRAME : PKT_P_FRAME;
+  }
+  sm = streaming_msg_create_pkt(pkt);
+  pkt_ref_dec(pkt);
+  sm->sm_time = g->time;
+  if (++g->i == 3) {
+    g->i = 0;
+    g->frame++;
+    g->time += 40000;
+  }
+  return sm;
+}
+
+/* **************************************************************************
+ * Buffer
+ * *************************************************************************/
+
+static void tsb_init(timeshift_t *ts, timeshift_buffer_t *tsb)
+{
+  memset(ts, 0, sizeof(*ts));
+  memset(tsb, 0, sizeof(*tsb));
+  tvh_mutex_init(&tsb->lock, NULL);
+  TAILQ_INIT(&tsb->files);
+  LIST_INIT(&tsb->instances);
+  tsb->vididx = VIDEO_IDX;
+  tsb->audidx = AUDIO_IDX;
+  tsb->writer = ts;
+  ts->tsb = tsb;
+  ts->dobuf = 1;
+}
+
+static void tsb_free(timeshift_buffer_t *tsb)
+{
+  int empty;
+
+  timeshift_filemgr_flush(tsb, NULL);
+  timeshift_index_free(tsb);
+  /* wait for the reaper */
+  do {
+    tvh_mutex_lock(&timeshift_reaper_lock);
+    empty = TAILQ_EMPTY(&timeshift_reaper_list);
+    tvh_mutex_unlock(&timeshift_reaper_lock);
+    if (!empty)
+      usleep(1000);
+  } while (!empty);
+  if (tsb->path) {
+    rmdir(tsb->path);
+    rmdir(dirname(tsb->path));
+  }
+  free(tsb->path);
+  tvh_mutex_destroy(&tsb->lock);
+}
+
+static int64_t tsb_write(timeshift_t *ts, timeshift_buffer_t *tsb)
+{
+  streaming_message_t *sm;
+  int64_t total = 0;
+  gen_t g;
+
+  gen_init(&g);
+  while ((sm = gen_next(&g)) != NULL) {
+    total += pktbuf_len(((th_pkt_t *)sm->sm_data)->pkt_payload);
+    _store_msg(ts, tsb, sm);
+    streaming_msg_free(sm);
+  }
+  if (tsb->full)
+    fprintf(stderr, "buffer full after %"PRId64" bytes\n", tsb->boff);
+  return total;
+}
+
+static int64_t tsb_read(timeshift_buffer_t *tsb)
+{
+  timeshift_seek_t seek;
+  streaming_message_t *sm;
+  th_pkt_t *pkt;
+  int64_t total = 0;
+  int end = 0;
+
+  memset(&seek, 0, sizeof(seek));
+  _seek_set_file(&seek, timeshift_filemgr_oldest(tsb), 0);
+  while (seek.file) {
+    if (_read_record(&seek, &sm) <= 0) {
+      seek.file = timeshift_filemgr_next(seek.file, &end, 0);
+      seek.roff = 0;
+      continue;
+    }
+    pkt = sm->sm_data;
+    sink = pktbuf_ptr(pkt->pkt_payload)[pktbuf_len(pkt->pkt_payload) - 1];
+    total += pktbuf_len(pkt->pkt_payload);
+    streaming_msg_free(sm);
+  }
+  return total;
+}
+
+/* **************************************************************************
+ * Index only
+ * *************************************************************************/
+
+/* the reader lookup before the buffer index */
+static timeshift_index_iframe_t *seg_seek(timeshift_buffer_t *tsb, int64_t req)
+{
+  timeshift_file_t *tsf, *prev = NULL;
+  int lo, hi, mid;
+
+  TAILQ_FOREACH(tsf, &tsb->files, link) {
+    if (tsf->iframes && timeshift_file_iframe(tsf, 0)->time > req)
+      break;
+    prev = tsf;
+  }
+  if (prev == NULL)
+    return NULL;
+  lo = 0; hi = prev->iframes;
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    if (timeshift_file_iframe(prev, mid)->time <= req) lo = mid + 1; else hi = mid;
+  }
+  return lo ? timeshift_file_iframe(prev, lo - 1) : NULL;
+}
+
+static int index_bench(void)
+{
+  static const int minutes[] = { 15, 30, 60, 120, 240, 480 };
+  int64_t t, t0, d1, d2, d3, period = 60000000 / gops, chk = 0, bytes;
+  timeshift_buffer_t tsb;
+  timeshift_t ts;
+  timeshift_file_t *tsf;
+  timeshift_index_iframe_t *fi;
+  timeshift_index_entry_t *e;
+  size_t m, size = 64 * 1024 * 16;
+  int i, n, mismatch = 0;
+
+  printf("%8s %8s %12s %12s %12s\n", "minutes", "frames",
+         "segment us", "buffer us", "boff us");
+  for (m = 0; m < sizeof(minutes) / sizeof(minutes[0]); m++) {
+    total_time = minutes[m] * 60;
+    n = total_time * 1000000 / period;
+    bytes = bitrate * 1000 / 8 * total_time;
+    tsb_init(&ts, &tsb);
+    tsf = NULL;
+    for (i = 0; i < n; i++) {
+      t = i * period;
+      if (!tsf || t / 1000000 / TIMESHIFT_FILE_PERIOD !=
+                  (t - period) / 1000000 / TIMESHIFT_FILE_PERIOD) {
+        tsb.boff = bytes * i / n;
+        tsf = timeshift_filemgr_file_init(&tsb, t, malloc(size), size);
+      }
+      fi = timeshift_file_iframe(tsf, tsf->iframes++);
+      fi->time = t;
+      fi->pos = bytes * i / n - tsf->boff;
+      timeshift_index_add(&tsb, tsf, tsf->iframes - 1);
+    }
+
+    srand(1);
+    t0 = now_us();
+    for (i = 0; i < seeks; i++) {
+      fi = seg_seek(&tsb, rnd_time());
+      chk += fi ? fi->time : -1;
+    }
+    d1 = now_us() - t0;
+    srand(1);
+    t0 = now_us();
+    for (i = 0; i < seeks; i++) {
+      e = timeshift_index_find_time(&tsb, rnd_time(), 1);
+      chk -= e ? e->time : -1;
+    }
+    d2 = now_us() - t0;
+    srand(2);
+    t0 = now_us();
+    for (i = 0; i < seeks; i++) {
+      e = timeshift_index_find_boff(&tsb, rnd_time() * bytes / (total_time * 1000000LL));
+      sink = e ? e->idx : 0;
+    }
+    d3 = now_us() - t0;
+    printf("%8d %8d %12.3f %12.3f %12.3f%s\n", minutes[m], n,
+           (double)d1 / seeks, (double)d2 / seeks, (double)d3 / seeks,
+           chk ? "  MISMATCH" : "");
+    mismatch |= chk != 0;
+
+    /* the segments are not mapped here */
+    while ((tsf = TAILQ_FIRST(&tsb.files))) {
+      TAILQ_REMOVE(&tsb.files, tsf, link);
+      free(tsf->data);
+      free(tsf);
+    }
+    timeshift_index_free(&tsb);
+    tvh_mutex_destroy(&tsb.lock);
+  }
+  return mismatch;
+}
+
+/* **************************************************************************
+ * Main
+ * *************************************************************************/
+
+int main(int argc, char **argv)
+{
+  timeshift_buffer_t tsb;
+  timeshift_t ts;
+  timeshift_index_entry_t *e;
+  int64_t t0, wr, rd, sk, bytes, rbytes, n = 0;
+  int c, i, index = 0;
+
+  while ((c = getopt(argc, argv, "d:rt:b:g:s:i")) != -1) {
+    switch (c) {
+    case 'i': index = 1; break;
+    case 'd': dir = optarg; break;
+    case 'r': ram = 1; break;
+    case 't': total_time = atoll(optarg); break;
+    case 'b': bitrate = atoll(optarg); break;
+    case 'g': gops = atoll(optarg); break;
+    case 's': seeks = atoll(optarg); break;
+    default:
+      fprintf(stderr, "usage: %s [-i] [-d dir] [-r] [-t sec] [-b kbit/s] [-g gop/min] [-s seeks]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (total_time < 1 || bitrate < 100 || gops < 1 || seeks < 1)
+    return 1;
+
+  tvh_thread_init(0);
+  slab_module_init(1);
+  streaming_init();
+  pkt_init();
+  timeshift_conf.path = dir;
+  timeshift_filemgr_init();
+  timeshift_conf.unlimited_period = 1;
+  timeshift_conf.unlimited_size = 1;
+  if (ram) {
+    timeshift_conf.ram_only = 1;
+    timeshift_conf.ram_size = UINT64_MAX / 2;
+    timeshift_conf.ram_segment_size = 64*1024*1024;
+  }
+
+  if (index) {
+    c = index_bench();
+    timeshift_filemgr_term();
+    return c;
+  }
+
+  printf("buffer %"PRId64" s, %"PRId64" kbit/s, %"PRId64" i-frames/min, %s\n",
+         total_time, bitrate, gops, ram ? "RAM" : dir);
+
+  tsb_init(&ts, &tsb);
+  t0 = now_us(); bytes = tsb_write(&ts, &tsb); wr = now_us() - t0;
+  if (!ram) sync();
+  t0 = now_us(); rbytes = tsb_read(&tsb); rd = now_us() - t0;
+  srand(1);
+  t0 = now_us();
+  for (i = 0; i < seeks; i++) {
+    e = timeshift_index_find_time(&tsb, rnd_time(), 1);
+    n += e != NULL;
+  }
+  sk = now_us() - t0;
+  printf("%d %s segments, %d i-frames\n",
+         ram ? tsb.ram_segments : tsb.file_segments, ram ? "RAM" : "file",
+         tsb.index.count - tsb.index.first);
+  printf("write %8.1f MB/s  read %8.1f MB/s  seek %8.3f us%s\n",
+         (double)bytes / wr, (double)rbytes / rd, (double)sk / seeks,
+         bytes != rbytes ? "  MISMATCH" : "");
+  tsb_free(&tsb);
+  timeshift_filemgr_term();
+
+  return bytes != rbytes || n == 0;
+}
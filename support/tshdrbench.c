@@ -0,0 +1,342 @@
+/*
+ *  MPEG-TS header decoding benchmark
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares the header walk of mpegts_input_process() before and after
+ * the batch decoding in src/tsheader.c:
+ *
+ *   word    mpegts_word_count() runs, PID and CC read from the packets
+ *   scalar  mpegts_hdr_decode() + mpegts_hdr_run(), plain C
+ *   simd    the same with the runtime selected AVX2/SSE2 functions
+ *
+ * src/tsheader.c is built into the benchmark. Each variant walks the
+ * runs (PID + scrambling/CC flags) and does the low-level CC check. The
+ * PIDs of all packets and the CC error count must be the same for all
+ * variants, otherwise MISMATCH is printed.
+ *
+ * The synthetic mux interleaves video, audio, tables and NULL packets
+ * by bitrate with some CC errors, scrambled and TEI packets. With -f
+ * the packets of a TS file are used.
+ *
+ *   cc -O2 -o tshdrbench support/tshdrbench.c
+ *   ./tshdrbench [-m services] [-c chunk] [-l loops] [-f file.ts]
+ *
+ * -m  services in the mux (default 8)
+ * -c  packets per input chunk (default 348, the 64kB of the DVB input)
+ * -l  loops over the buffer (default 200)
+ * -f  take the packets from a TS file
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <endian.h>
+#include <byteswap.h>
+
+/* from src/tvheadend.h */
+#define TVHEADEND_H
+#define TS_HDR_TEI       0x8000
+#define TS_HDR_NOSYNC    0x4000
+#define TS_HDR_PID       0x1fff
+#define TS_HDR_BATCH     256
+
+#include "../src/tsheader.c"
+
+#define BUF_PACKETS 25000
+
+static uint8_t *buf;
+static int buf_packets;
+static int services = 8;
+static int chunk = 348;
+static int loops = 200;
+
+typedef struct result {
+  uint64_t packets;
+  uint64_t hash;
+  uint64_t cc_errors;
+} result_t;
+
+static int64_t now_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+/* **************************************************************************
+ * Old code (src/utils.c)
+ * *************************************************************************/
+
+static inline uint32_t mpegts_word32( const uint8_t *tsb )
+{
+  return *(uint32_t *)tsb;
+}
+
+static int
+mpegts_word_count ( const uint8_t *tsb, int len, uint32_t mask )
+{
+  uint32_t val;
+  int r = 0;
+
+#if BYTE_ORDER == LITTLE_ENDIAN
+  mask = bswap_32(mask);
+#endif
+
+  val  = mpegts_word32(tsb) & mask;
+
+  while (len >= 188) {
+    if (len >= 4*188 &&
+        (mpegts_word32(tsb+0*188) & mask) == val &&
+        (mpegts_word32(tsb+1*188) & mask) == val &&
+        (mpegts_word32(tsb+2*188) & mask) == val &&
+        (mpegts_word32(tsb+3*188) & mask) == val) {
+      r   += 4*188;
+      len -= 4*188;
+      tsb += 4*188;
+    } else if ((mpegts_word32(tsb) & mask) == val) {
+      r   += 188;
+      len -= 188;
+      tsb += 188;
+    } else {
+      break;
+    }
+  }
+
+  return r;
+}
+
+/* **************************************************************************
+ * Header walks
+ * *************************************************************************/
+
+static uint8_t cc_state[8192];
+
+/* the runs may be split on the batch boundaries, sum the PIDs by position */
+static inline void
+run_done(result_t *res, uint16_t pid, int npkt)
+{
+  res->hash += (uint64_t)pid * (npkt * res->packets + npkt * (npkt + 1) / 2);
+  res->packets += npkt;
+}
+
+static void
+walk_word(const uint8_t *tsb, int len, result_t *res)
+{
+  const uint8_t *tsb2, *tsb2_end;
+  uint16_t pid;
+  uint8_t cc, cc2;
+  int llen;
+
+  while (len > 0) {
+    llen = mpegts_word_count(tsb, len, 0xFF9FFFD0);
+    pid = (tsb[1] << 8) | tsb[2];
+    pid &= 0x1FFF;
+    if (pid != 0x1FFF && (tsb[3] & 0x10)) {
+      for (tsb2 = tsb, tsb2_end = tsb + llen, cc2 = cc_state[pid];
+           tsb2 < tsb2_end; tsb2 += 188) {
+        cc = tsb2[3] & 0x0f;
+        if (cc2 != 0xff && cc2 != cc)
+          res->cc_errors++;
+        cc2 = (cc + 1) & 0xF;
+      }
+      cc_state[pid] = cc2;
+    }
+    run_done(res, pid, llen / 188);
+    tsb += llen;
+    len -= llen;
+  }
+}
+
+static void
+walk_batch(const uint8_t *tsb, int len, result_t *res)
+{
+  uint16_t hpid[TS_HDR_BATCH], pid;
+  uint8_t hflags[TS_HDR_BATCH], cc, cc2;
+  int hidx = 0, hcount = 0, npkt, i;
+
+  while (len > 0) {
+    if (hidx >= hcount) {
+      hcount = len / 188 < TS_HDR_BATCH ? len / 188 : TS_HDR_BATCH;
+      mpegts_hdr_decode(tsb, hcount, hpid, hflags);
+      hidx = 0;
+    }
+    npkt = mpegts_hdr_run(hpid + hidx, hflags + hidx, hcount - hidx, 0xFFFF, 0xD0);
+    pid = hpid[hidx] & TS_HDR_PID;
+    if (pid != 0x1FFF && (hflags[hidx] & 0x10)) {
+      for (i = hidx, cc2 = cc_state[pid]; i < hidx + npkt; i++) {
+        cc = hflags[i] & 0x0f;
+        if (cc2 != 0xff && cc2 != cc)
+          res->cc_errors++;
+        cc2 = (cc + 1) & 0xF;
+      }
+      cc_state[pid] = cc2;
+    }
+    run_done(res, pid, npkt);
+    hidx += npkt;
+    tsb += npkt * 188;
+    len -= npkt * 188;
+  }
+}
+
+/* **************************************************************************
+ * Packets
+ * *************************************************************************/
+
+static void
+synth_buffer(void)
+{
+  static const int weights[] = { 900, 55, 35, 8, 2 };  /* per service */
+  int i, j, k, w, total = 0, count = 0, pid, *pids, *wts;
+  uint8_t ccs[8192], *p;
+
+  pids = calloc(services * 5 + 2, sizeof(int));
+  wts = calloc(services * 5 + 2, sizeof(int));
+  for (i = 0; i < services; i++)
+    for (j = 0; j < 5; j++) {
+      pids[count] = j == 4 ? 0x100 + i : 0x200 + 16 * i + j;
+      wts[count++] = weights[j];
+    }
+  pids[count] = 0x12;
+  wts[count++] = 40;
+  pids[count] = 0x1FFF;
+  wts[count++] = 300;
+  for (i = 0; i < count; i++)
+    total += wts[i];
+
+  buf_packets = BUF_PACKETS;
+  buf = malloc((size_t)buf_packets * 188);
+  memset(ccs, 0, sizeof(ccs));
+  srand(1);
+  for (k = 0; k < buf_packets; k++) {
+    w = rand() % total;
+    for (i = 0; w >= wts[i]; i++)
+      w -= wts[i];
+    pid = pids[i];
+    p = buf + k * 188;
+    memset(p, 0xff, 188);
+    p[0] = 0x47;
+    p[1] = (pid >> 8) | ((rand() % 20) == 0 ? 0x40 : 0);
+    p[2] = pid & 0xff;
+    if (rand() % 5000 == 0)
+      p[1] |= 0x80;                           /* TEI */
+    if (rand() % 2000 == 0)
+      ccs[pid]++;                             /* CC error */
+    p[3] = 0x10 | (ccs[pid]++ & 0x0f);
+    if (pid >= 0x200 && (pid & 15) < 3)
+      p[3] |= 0x80 | ((k / 5000) & 1 ? 0x40 : 0);
+  }
+  free(pids);
+  free(wts);
+}
+
+static int
+file_buffer(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  int size = 0;
+
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+  for (;;) {
+    if (buf_packets == size) {
+      size = size ? size * 2 : 4096;
+      buf = realloc(buf, (size_t)size * 188);
+    }
+    if (fread(buf + (size_t)buf_packets * 188, 188, 1, f) != 1)
+      break;
+    buf_packets++;
+  }
+  fclose(f);
+  return buf_packets ? 0 : -1;
+}
+
+/* **************************************************************************
+ * Main
+ * *************************************************************************/
+
+static int64_t
+bench(const char *name, void (*walk)(const uint8_t *, int, result_t *),
+      result_t *res)
+{
+  int64_t t0, t;
+  int i, k, n;
+
+  memset(res, 0, sizeof(*res));
+  memset(cc_state, 0xff, sizeof(cc_state));
+  t0 = now_us();
+  for (i = 0; i < loops; i++)
+    for (k = 0; k < buf_packets; k += n) {
+      n = buf_packets - k < chunk ? buf_packets - k : chunk;
+      walk(buf + (size_t)k * 188, n * 188, res);
+    }
+  t = now_us() - t0;
+  printf("%-8s %8.2f ns/packet  %"PRIu64" cc errors\n", name,
+         t * 1000.0 / ((double)loops * buf_packets), res->cc_errors);
+  return t;
+}
+
+int main(int argc, char **argv)
+{
+  const char *file = NULL;
+  result_t r0, r1, r2;
+  int64_t t0, t2;
+  int c, mismatch;
+
+  while ((c = getopt(argc, argv, "m:c:l:f:")) != -1) {
+    switch (c) {
+    case 'm': services = atoi(optarg); break;
+    case 'c': chunk = atoi(optarg); break;
+    case 'l': loops = atoi(optarg); break;
+    case 'f': file = optarg; break;
+    default:
+      fprintf(stderr, "usage: %s [-m services] [-c chunk] [-l loops] [-f file.ts]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (services < 1 || services > 100 || chunk < 1 || loops < 1)
+    return 1;
+  if (file ? file_buffer(file) : (synth_buffer(), 0))
+    return 1;
+
+  printf("%d packets, %d packets per chunk\n", buf_packets, chunk);
+
+  t0 = bench("word", walk_word, &r0);
+
+  ts_hdr_decode_fcn = ts_hdr_decode_c;
+  ts_hdr_run_fcn = ts_hdr_run_c;
+  bench("scalar", walk_batch, &r1);
+
+  ts_hdr_select();
+  t2 = bench("simd", walk_batch, &r2);
+  printf("%-8s decode %s, run %s (x%.2f against word)\n", "",
+         ts_hdr_decode_fcn == ts_hdr_decode_c ? "C" : "AVX2",
+         ts_hdr_run_fcn == ts_hdr_run_c ? "C" : "SSE2", (double)t0 / t2);
+
+  mismatch = memcmp(&r0, &r1, sizeof(r0)) || memcmp(&r0, &r2, sizeof(r0));
+  if (mismatch)
+    printf("PIDs or cc errors differ  MISMATCH\n");
+
+  free(buf);
+  return mismatch;
+}